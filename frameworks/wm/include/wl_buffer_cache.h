@@ -16,6 +16,10 @@
 #ifndef FRAMEWORKS_WM_INCLUDE_WL_BUFFER_CACHE_H
 #define FRAMEWORKS_WM_INCLUDE_WL_BUFFER_CACHE_H
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <refbase.h>
 #include <surface.h>
 
@@ -44,6 +48,9 @@ public:
                                    sptr<Surface> &surf,
                                    sptr<SurfaceBuffer> &sbuffer);
 
+    // drops the wl_buffer of a buffer the surface deleted, called by its delete buffer listener
+    MOCKABLE void InvalidateBuffer(const Surface *csurf, int32_t seqNum);
+
     MOCKABLE void CleanCache();
 
 private:
@@ -52,12 +59,40 @@ private:
     static inline sptr<WlBufferCache> instance = nullptr;
     static inline SingletonDelegator<WlBufferCache> delegator;
 
+    // a buffer is identified by its surface and its sequence number, the buffer pointer is checked on lookup as
+    // a deleted buffer's address and sequence number may be reused
+    struct BufferKey {
+        const Surface *csurf;
+        int32_t seqNum;
+
+        bool operator==(const BufferKey &other) const
+        {
+            return csurf == other.csurf && seqNum == other.seqNum;
+        }
+    };
+    struct BufferKeyHash {
+        size_t operator()(const BufferKey &key) const
+        {
+            return std::hash<const Surface *>()(key.csurf) ^ (std::hash<int32_t>()(key.seqNum) << 1);
+        }
+    };
     struct BufferCache {
         sptr<WlBuffer> wbuffer;
         wptr<Surface> csurf;
         wptr<SurfaceBuffer> sbuffer;
     };
-    std::vector<WlBufferCache::BufferCache> cache;
+    using BufferCacheMap = std::unordered_map<BufferKey, BufferCache, BufferKeyHash>;
+
+    sptr<WlBuffer> EraseLocked(BufferCacheMap::iterator it);
+    void ListenDeleteBuffer(const sptr<Surface> &csurf);
+    // stale wl_buffers are moved to staleBuffers so that they are destroyed after cacheMutex is released
+    void CleanCacheLocked(std::vector<sptr<WlBuffer>> &staleBuffers);
+
+    BufferCacheMap cache;
+    std::unordered_map<const struct wl_buffer *, BufferKey> wlBufferIndex;
+    // surfaces whose delete buffer listener is registered
+    std::unordered_map<const Surface *, wptr<Surface>> listenedSurfaces;
+    uint32_t missCount = 0;
     std::mutex cacheMutex;
 };
 } // namespace OHOS
@@ -15,6 +15,7 @@
 
 #include "wl_buffer_cache.h"
 
+#include <iterator>
 #include <mutex>
 
 #include "window_manager_hilog.h"
@@ -22,6 +23,8 @@
 namespace OHOS {
 namespace {
 constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, 0, "WMWlBufferCache"};
+// lookups that miss before the whole cache is swept for deleted buffers, misses come with new or reallocated buffers
+constexpr uint32_t CLEAN_CACHE_MISS_INTERVAL = 32;
 }
 
 void WlBufferCache::Init()
@@ -32,6 +35,9 @@ void WlBufferCache::Deinit()
 {
     std::lock_guard<std::mutex> lock(cacheMutex);
     cache.clear();
+    wlBufferIndex.clear();
+    listenedSurfaces.clear();
+    missCount = 0;
 }
 
 sptr<WlBufferCache> WlBufferCache::GetInstance()
@@ -46,6 +52,16 @@ sptr<WlBufferCache> WlBufferCache::GetInstance()
     return instance;
 }
 
+sptr<WlBuffer> WlBufferCache::EraseLocked(BufferCacheMap::iterator it)
+{
+    auto wbuffer = it->second.wbuffer;
+    if (wbuffer != nullptr) {
+        wlBufferIndex.erase(wbuffer->GetRawPtr());
+    }
+    cache.erase(it);
+    return wbuffer;
+}
+
 sptr<WlBuffer> WlBufferCache::GetWlBuffer(const sptr<Surface> &surf,
                                           const sptr<SurfaceBuffer> &buffer)
 {
@@ -53,18 +69,54 @@ sptr<WlBuffer> WlBufferCache::GetWlBuffer(const sptr<Surface> &surf,
         return nullptr;
     }
 
-    CleanCache();
-
+    // the stale wl_buffers are destroyed after the lock is released
+    std::vector<sptr<WlBuffer>> staleBuffers;
     std::lock_guard<std::mutex> lock(cacheMutex);
-    for (const auto &c : cache) {
-        if (c.csurf != nullptr && c.csurf.promote() == surf &&
-            c.sbuffer != nullptr && c.sbuffer.promote() == buffer) {
+    auto it = cache.find({surf.GetRefPtr(), buffer->GetSeqNum()});
+    if (it != cache.end()) {
+        const auto &c = it->second;
+        if (c.wbuffer != nullptr && c.csurf.promote() == surf &&
+            c.sbuffer.promote() == buffer && buffer->GetVirAddr() != nullptr) {
             return c.wbuffer;
         }
+        staleBuffers.push_back(EraseLocked(it));
+    }
+
+    // the delete buffer listener is not guaranteed: a surface keeps only the first one registered on it
+    if (++missCount >= CLEAN_CACHE_MISS_INTERVAL) {
+        missCount = 0;
+        CleanCacheLocked(staleBuffers);
     }
     return nullptr;
 }
 
+void WlBufferCache::ListenDeleteBuffer(const sptr<Surface> &csurf)
+{
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = listenedSurfaces.find(csurf.GetRefPtr());
+        if (it != listenedSurfaces.end() && it->second.promote() == csurf) {
+            return;
+        }
+        listenedSurfaces[csurf.GetRefPtr()] = csurf;
+    }
+
+    // the surface calls back with its queue locked, don't hold cacheMutex while registering
+    wptr<WlBufferCache> weakThis = this;
+    const Surface *key = csurf.GetRefPtr();
+    // returns GSERROR_OK as well if the surface already has another listener, which then gets the callbacks;
+    // the sweep in GetWlBuffer drops the deleted buffers of such surfaces
+    auto ret = csurf->RegisterDeleteBufferListener([weakThis, key](int32_t seqNum) {
+        auto cache = weakThis.promote();
+        if (cache != nullptr) {
+            cache->InvalidateBuffer(key, seqNum);
+        }
+    });
+    if (ret != GSERROR_OK) {
+        WMLOGFW("RegisterDeleteBufferListener failed: %{public}d", ret);
+    }
+}
+
 GSError WlBufferCache::AddWlBuffer(const sptr<WlBuffer> &wbuffer,
                                    const sptr<Surface> &csurf,
                                    const sptr<SurfaceBuffer> &sbuffer)
@@ -81,15 +133,25 @@ GSError WlBufferCache::AddWlBuffer(const sptr<WlBuffer> &wbuffer,
         WMLOGFW("sbuffer is nullptr");
         return GSERROR_INVALID_ARGUMENTS;
     }
-    if (GetWlBuffer(csurf, sbuffer) == nullptr) {
-        std::lock_guard<std::mutex> lock(cacheMutex);
-        struct BufferCache ele = {
-            .wbuffer = wbuffer,
-            .csurf = csurf,
-            .sbuffer = sbuffer,
-        };
-        cache.push_back(ele);
+
+    ListenDeleteBuffer(csurf);
+    sptr<WlBuffer> staleBuffer = nullptr;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    BufferKey key = {csurf.GetRefPtr(), sbuffer->GetSeqNum()};
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        if (it->second.wbuffer == wbuffer) {
+            return GSERROR_OK;
+        }
+        staleBuffer = EraseLocked(it);
     }
+    struct BufferCache ele = {
+        .wbuffer = wbuffer,
+        .csurf = csurf,
+        .sbuffer = sbuffer,
+    };
+    cache.emplace(key, ele);
+    wlBufferIndex[wbuffer->GetRawPtr()] = key;
     return GSERROR_OK;
 }
 
@@ -102,31 +164,51 @@ bool WlBufferCache::GetSurfaceBuffer(const struct wl_buffer *wbuffer,
     }
 
     std::lock_guard<std::mutex> lock(cacheMutex);
-    for (const auto &c : cache) {
-        if (c.wbuffer != nullptr && c.wbuffer->GetRawPtr() == wbuffer) {
-            csurf = c.csurf.promote();
-            sbuffer = c.sbuffer.promote();
-            return true;
-        }
+    auto index = wlBufferIndex.find(wbuffer);
+    if (index == wlBufferIndex.end()) {
+        return false;
+    }
+    auto it = cache.find(index->second);
+    if (it == cache.end()) {
+        return false;
+    }
+    csurf = it->second.csurf.promote();
+    sbuffer = it->second.sbuffer.promote();
+    return true;
+}
+
+void WlBufferCache::InvalidateBuffer(const Surface *csurf, int32_t seqNum)
+{
+    sptr<WlBuffer> staleBuffer = nullptr;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find({csurf, seqNum});
+    if (it != cache.end()) {
+        staleBuffer = EraseLocked(it);
     }
-    return false;
 }
 
 void WlBufferCache::CleanCache()
 {
+    std::vector<sptr<WlBuffer>> staleBuffers;
     std::lock_guard<std::mutex> lock(cacheMutex);
-    for (auto it = cache.begin(); it != cache.end(); it++) {
-        sptr<SurfaceBuffer> buffer = nullptr;
-        if (it->sbuffer != nullptr) {
-            buffer = it->sbuffer.promote();
-        }
+    CleanCacheLocked(staleBuffers);
+}
 
-        if (it->csurf == nullptr ||
-            it->csurf.promote() == nullptr || buffer == nullptr ||
-            buffer->GetVirAddr() == nullptr || it->wbuffer == nullptr) {
-            cache.erase(it);
-            it--;
+void WlBufferCache::CleanCacheLocked(std::vector<sptr<WlBuffer>> &staleBuffers)
+{
+    for (auto it = cache.begin(); it != cache.end();) {
+        sptr<SurfaceBuffer> buffer = it->second.sbuffer.promote();
+        if (it->second.csurf.promote() == nullptr || buffer == nullptr ||
+            buffer->GetVirAddr() == nullptr || it->second.wbuffer == nullptr) {
+            auto next = std::next(it);
+            staleBuffers.push_back(EraseLocked(it));
+            it = next;
+        } else {
+            it++;
         }
     }
+    for (auto it = listenedSurfaces.begin(); it != listenedSurfaces.end();) {
+        it = it->second.promote() == nullptr ? listenedSurfaces.erase(it) : std::next(it);
+    }
 }
 } // namespace OHOS
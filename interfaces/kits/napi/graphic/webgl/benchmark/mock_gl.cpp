@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mock_gl.h"
+
+#include <cstring>
+#include <GLES3/gl3.h>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr uint64_t CHECKSUM_PRIME = 1099511628211ULL;
+MockGlStats g_stats;
+
+template<typename T>
+void Fold(T value)
+{
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+    g_stats.checksum = (g_stats.checksum ^ bits) * CHECKSUM_PRIME;
+}
+
+template<typename... Args>
+void Call(Args... args)
+{
+    g_stats.calls++;
+    (Fold(args), ...);
+}
+}
+
+MockGlStats &GetMockGlStats()
+{
+    return g_stats;
+}
+
+void ResetMockGlStats()
+{
+    g_stats = {};
+}
+} // namespace Rosen
+} // namespace OHOS
+
+using OHOS::Rosen::Call;
+
+extern "C" {
+void GL_APIENTRY glUseProgram(GLuint program)
+{
+    Call(program);
+}
+
+void GL_APIENTRY glBindTexture(GLenum target, GLuint texture)
+{
+    Call(target, texture);
+}
+
+void GL_APIENTRY glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    Call(location, v0, v1, v2, v3);
+}
+
+void GL_APIENTRY glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+    Call(location, count, transpose);
+    for (GLsizei i = 0; i < count * 16; i++) { // 16 floats per matrix
+        OHOS::Rosen::Fold(value[i]);
+    }
+}
+
+void GL_APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    Call(mode, count, type, reinterpret_cast<uintptr_t>(indices));
+}
+}
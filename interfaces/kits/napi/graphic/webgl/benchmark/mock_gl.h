@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WEBGL_BENCHMARK_MOCK_GL_H
+#define WEBGL_BENCHMARK_MOCK_GL_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace Rosen {
+// What the mock GL functions have seen, to check that a replay issues the same calls as direct calls.
+struct MockGlStats {
+    uint64_t calls = 0;
+    // folds the arguments in call order
+    uint64_t checksum = 0;
+};
+
+MockGlStats &GetMockGlStats();
+void ResetMockGlStats();
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // WEBGL_BENCHMARK_MOCK_GL_H
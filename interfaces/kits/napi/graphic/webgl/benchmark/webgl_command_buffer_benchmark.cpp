@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "mock_gl.h"
+#include "webgl/include/util/webgl_command_buffer.h"
+
+using namespace OHOS::Rosen;
+
+namespace {
+constexpr int DEFAULT_FRAMES = 200;
+constexpr int DEFAULT_DRAWS = 1000;
+constexpr int CALLS_PER_DRAW = 5;
+constexpr int MATRIX_FLOATS = 16;
+constexpr GLuint PROGRAM_COUNT = 4;
+constexpr GLuint TEXTURE_COUNT = 8;
+constexpr GLsizei INDEX_COUNT = 36;
+constexpr double NS_PER_MS = 1000000.0;
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedNs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// what a sprite or mesh batch of a typical game frame issues per object
+template<typename Issue>
+void IssueFrame(int draws, GLfloat *matrix, Issue &&issue)
+{
+    for (int i = 0; i < draws; i++) {
+        matrix[0] = static_cast<GLfloat>(i);
+        issue(static_cast<GLuint>(i % PROGRAM_COUNT + 1), static_cast<GLuint>(i % TEXTURE_COUNT + 1),
+            static_cast<GLfloat>(i), matrix);
+    }
+}
+
+void Immediate(GLuint program, GLuint texture, GLfloat value, const GLfloat *matrix)
+{
+    glUseProgram(program);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glUniform4f(0, value, value, value, 1.0f);
+    glUniformMatrix4fv(1, 1, GL_FALSE, matrix);
+    glDrawElements(GL_TRIANGLES, INDEX_COUNT, GL_UNSIGNED_SHORT, nullptr);
+}
+
+void Recorded(GLuint program, GLuint texture, GLfloat value, const GLfloat *matrix)
+{
+    auto &commands = WebGLCommandBuffer::GetInstance();
+    commands.Record<glUseProgram>(program);
+    commands.Record<glBindTexture>(static_cast<GLenum>(GL_TEXTURE_2D), texture);
+    commands.Record<glUniform4f>(0, value, value, value, 1.0f);
+    commands.RecordArray<glUniformMatrix4fv>(matrix, MATRIX_FLOATS * sizeof(GLfloat), 1, 1,
+        static_cast<GLboolean>(GL_FALSE));
+    commands.Record<glDrawElements>(static_cast<GLenum>(GL_TRIANGLES), INDEX_COUNT,
+        static_cast<GLenum>(GL_UNSIGNED_SHORT), static_cast<const void *>(nullptr));
+}
+}
+
+int main(int argc, char *argv[])
+{
+    int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    int draws = argc > 2 ? atoi(argv[2]) : DEFAULT_DRAWS;
+    GLfloat matrix[MATRIX_FLOATS] = {};
+    double calls = static_cast<double>(frames) * draws * CALLS_PER_DRAW;
+
+    ResetMockGlStats();
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        IssueFrame(draws, matrix, Immediate);
+    }
+    double immediateNs = ElapsedNs(start);
+    MockGlStats immediateStats = GetMockGlStats();
+
+    ResetMockGlStats();
+    double recordNs = 0;
+    double replayNs = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        start = Clock::now();
+        IssueFrame(draws, matrix, Recorded);
+        recordNs += ElapsedNs(start);
+        start = Clock::now();
+        WebGLCommandBuffer::GetInstance().Replay();
+        replayNs += ElapsedNs(start);
+    }
+    MockGlStats recordedStats = GetMockGlStats();
+
+    std::cout << "webgl command buffer: " << frames << " frames x " << draws * CALLS_PER_DRAW << " calls" << std::endl;
+    std::cout << "  immediate: " << immediateNs / calls << " ns/call, " << immediateNs / frames / NS_PER_MS <<
+        " ms/frame" << std::endl;
+    std::cout << "  record:    " << recordNs / calls << " ns/call on the JS thread" << std::endl;
+    std::cout << "  replay:    " << replayNs / calls << " ns/call, " << replayNs / frames / NS_PER_MS <<
+        " ms/frame" << std::endl;
+    bool same = immediateStats.calls == recordedStats.calls && immediateStats.checksum == recordedStats.checksum;
+    std::cout << "  GL calls:  " << immediateStats.calls << " immediate, " << recordedStats.calls << " replayed, " <<
+        (same ? "same arguments in the same order" : "MISMATCH") << std::endl;
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
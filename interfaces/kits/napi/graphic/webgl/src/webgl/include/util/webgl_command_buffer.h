@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSENRENDER_ROSEN_WEBGL_COMMAND_BUFFER
+#define ROSENRENDER_ROSEN_WEBGL_COMMAND_BUFFER
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <GLES3/gl3.h>
+#include "napi/native_api.h"
+
+namespace OHOS {
+namespace Rosen {
+// Records void GL calls with their arguments in native form and replays them in one loop. The hot bindings
+// (state, uniforms, draws) record into it; every other binding replays it first (see
+// ReplayBeforeImmediateMethods), so GL still sees the calls in the order JS made them. All WebGL contexts
+// share one EGL context, hence one command buffer.
+class WebGLCommandBuffer {
+public:
+    // replays on its own once this much has been recorded (1 MB, some 20000 calls), to bound the memory of a
+    // frame that never flushes
+    static constexpr size_t MAX_WORDS = 128 * 1024;
+
+    static WebGLCommandBuffer &GetInstance();
+
+    // Wraps every method of props that is not in recordedMethods so that it replays the buffer before running.
+    static void ReplayBeforeImmediateMethods(napi_property_descriptor *props, size_t count,
+        const std::unordered_set<napi_callback> &recordedMethods);
+
+    template<auto func, typename... Values>
+    void Record(Values... values)
+    {
+        Append<func>(&ReplayCommand<func>, nullptr, 0, values...);
+    }
+
+    // For calls whose last parameter points to data, e.g. glUniform4fv: the data is copied behind the other
+    // arguments, since JS may change the array right after the call.
+    template<auto func, typename... Values>
+    void RecordArray(const void *data, size_t bytes, Values... values)
+    {
+        Append<func>(&ReplayArrayCommand<func>, data, bytes, values..., nullptr);
+    }
+
+    void Replay();
+
+    bool IsEmpty() const
+    {
+        return mSize == 0;
+    }
+    size_t GetCommandCount() const
+    {
+        return mCommandCount;
+    }
+
+private:
+    using ReplayFunc = void (*)(const uint64_t *args, const void *data);
+    // the replay function, then the argument count and the data size
+    static constexpr size_t HEADER_WORDS = 2;
+    static constexpr int ARG_COUNT_SHIFT = 32;
+    static constexpr uint64_t DATA_SIZE_MASK = 0xFFFFFFFF;
+
+    template<typename T>
+    struct GlFunction;
+    template<typename... Params>
+    struct GlFunction<void (*)(Params...)> {
+        using Args = std::tuple<Params...>;
+    };
+
+    // every argument takes one word, GL parameters being scalars or pointers
+    template<typename T, typename Value>
+    static void StoreArg(uint64_t *word, Value value)
+    {
+        static_assert(sizeof(T) <= sizeof(uint64_t) && std::is_trivially_copyable_v<T>, "not a GL parameter");
+        T arg = static_cast<T>(value);
+        memcpy(word, &arg, sizeof(T));
+    }
+
+    template<typename T>
+    static T LoadArg(const uint64_t *word)
+    {
+        T arg;
+        memcpy(&arg, word, sizeof(T));
+        return arg;
+    }
+
+    template<typename Args, size_t... index, typename... Values>
+    static void StoreArgs(uint64_t *words, std::index_sequence<index...>, Values... values)
+    {
+        (StoreArg<std::tuple_element_t<index, Args>>(words + index, values), ...);
+    }
+
+    template<typename Args, size_t... index>
+    static Args LoadArgs(const uint64_t *words, std::index_sequence<index...>)
+    {
+        return Args(LoadArg<std::tuple_element_t<index, Args>>(words + index)...);
+    }
+
+    template<auto func>
+    static void ReplayCommand(const uint64_t *args, const void *data)
+    {
+        using Args = typename GlFunction<decltype(func)>::Args;
+        std::apply(func, LoadArgs<Args>(args, std::make_index_sequence<std::tuple_size_v<Args>>()));
+    }
+
+    template<auto func>
+    static void ReplayArrayCommand(const uint64_t *args, const void *data)
+    {
+        using Args = typename GlFunction<decltype(func)>::Args;
+        constexpr size_t last = std::tuple_size_v<Args> - 1;
+        Args values = LoadArgs<Args>(args, std::make_index_sequence<last + 1>());
+        std::get<last>(values) = static_cast<std::tuple_element_t<last, Args>>(data);
+        std::apply(func, values);
+    }
+
+    template<auto func, typename... Values>
+    void Append(ReplayFunc replay, const void *data, size_t bytes, Values... values)
+    {
+        using Args = typename GlFunction<decltype(func)>::Args;
+        static_assert(sizeof...(Values) == std::tuple_size_v<Args>, "wrong argument count");
+        constexpr size_t argWords = sizeof...(Values);
+        size_t dataWords = (bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        size_t pos = mSize;
+        mSize += HEADER_WORDS + argWords + dataWords;
+        if (mSize > mWords.size()) {
+            // never shrinks, so a steady frame records without allocating
+            mWords.resize(mSize * 2);
+        }
+        uint64_t *words = mWords.data() + pos;
+        memcpy(&words[0], &replay, sizeof(replay));
+        words[1] = (static_cast<uint64_t>(argWords) << ARG_COUNT_SHIFT) | (bytes & DATA_SIZE_MASK);
+        StoreArgs<Args>(&words[HEADER_WORDS], std::index_sequence_for<Values...>(), values...);
+        if (bytes > 0) {
+            memcpy(&words[HEADER_WORDS + argWords], data, bytes);
+        }
+        mCommandCount++;
+        if (mSize >= MAX_WORDS) {
+            Replay();
+        }
+    }
+
+    static napi_value ReplayAndCall(napi_env env, napi_callback_info info);
+
+    std::vector<uint64_t> mWords;
+    size_t mSize = 0;
+    size_t mCommandCount = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // ROSENRENDER_ROSEN_WEBGL_COMMAND_BUFFER
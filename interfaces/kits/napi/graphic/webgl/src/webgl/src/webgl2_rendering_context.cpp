@@ -17,6 +17,7 @@
 
 #include "../include/util/object_manager.h"
 #include "../include/util/log.h"
+#include "../include/util/webgl_command_buffer.h"
 #include "../../common/napi/n_class.h"
 #include "../../common/napi/n_func_arg.h"
 
@@ -1745,6 +1746,17 @@ bool WebGL2RenderingContext::Export(napi_env env, napi_value exports)
         NVal::DeclareNapiGetter("MAX_CLIENT_WAIT_TIMEOUT_WEBGL", GetMaxClientWaitTimeoutWebgl),
         NVal::DeclareNapiProperty("WebGLRenderingContext", instanceValue),
     };
+    static const std::unordered_set<napi_callback> recordedMethods = {
+        WebGL2RenderingContextBase::Uniform1ui,
+        WebGL2RenderingContextBase::Uniform2ui,
+        WebGL2RenderingContextBase::Uniform3ui,
+        WebGL2RenderingContextBase::Uniform4ui,
+        WebGL2RenderingContextBase::VertexAttribDivisor,
+        WebGL2RenderingContextBase::DrawArraysInstanced,
+        WebGL2RenderingContextBase::DrawElementsInstanced,
+        WebGL2RenderingContextBase::BindVertexArray,
+    };
+    WebGLCommandBuffer::ReplayBeforeImmediateMethods(props, sizeof(props) / sizeof(props[0]), recordedMethods);
     status = napi_define_properties(env, exports, sizeof(props) / sizeof(props[0]), props);
     if (status != napi_ok) {
         return false;
@@ -30,6 +30,7 @@
 #include "../include/webgl/webgl_vertex_array_object.h"
 #include "../include/util/log.h"
 #include "../include/util/util.h"
+#include "../include/util/webgl_command_buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -1841,22 +1842,18 @@ napi_value WebGL2RenderingContextBase::Uniform1ui(napi_env env, napi_callback_in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL2 uniform1ui start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGL2RenderingContextBase::uniform1ui location = %{public}u", location);
     int32_t v0;
     tie(succ, v0) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform1ui v0 = %{public}u", v0);
-    glUniform1ui(static_cast<GLint>(location), static_cast<GLuint>(v0));
-    LOGI("WebGL uniform1ui end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform1ui>(static_cast<GLint>(location), static_cast<GLuint>(v0));
     return nullptr;
 }
 
@@ -1868,28 +1865,24 @@ napi_value WebGL2RenderingContextBase::Uniform2ui(napi_env env, napi_callback_in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL2 uniform2ui start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGL2RenderingContextBase::uniform2ui location = %{public}u", location);
     int32_t v0;
     tie(succ, v0) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform2ui v0 = %{public}u", v0);
     int32_t v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform2ui v1 = %{public}u", v1);
-    glUniform2ui(static_cast<GLint>(location), static_cast<GLuint>(v0), static_cast<GLuint>(v1));
-    LOGI("WebGL uniform2ui end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform2ui>(static_cast<GLint>(location), static_cast<GLuint>(v0),
+        static_cast<GLuint>(v1));
     return nullptr;
 }
 
@@ -1901,35 +1894,29 @@ napi_value WebGL2RenderingContextBase::Uniform3ui(napi_env env, napi_callback_in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL2 uniform3ui start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGL2RenderingContextBase::uniform3ui location = %{public}u", location);
     int32_t v0;
     tie(succ, v0) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform3ui v0 = %{public}u", v0);
     int32_t v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform3ui v1 = %{public}u", v1);
     int32_t v2;
     tie(succ, v2) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform3ui v2 = %{public}u", v2);
-    glUniform3ui(static_cast<GLint>(location), static_cast<GLuint>(v0), static_cast<GLuint>(v1),
-                 static_cast<GLuint>(v2));
-    LOGI("WebGL uniform3ui end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform3ui>(static_cast<GLint>(location), static_cast<GLuint>(v0),
+        static_cast<GLuint>(v1), static_cast<GLuint>(v2));
     return nullptr;
 }
 
@@ -1941,41 +1928,34 @@ napi_value WebGL2RenderingContextBase::Uniform4ui(napi_env env, napi_callback_in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL2 uniform4ui start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGL2RenderingContextBase::uniform4ui location = %{public}u", location);
     int32_t v0;
     tie(succ, v0) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform4ui v0 = %{public}u", v0);
     int32_t v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform4ui v1 = %{public}u", v1);
     int32_t v2;
     tie(succ, v2) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform4ui v2 = %{public}u", v2);
     int32_t v3;
     tie(succ, v3) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::uniform4ui v3 = %{public}u", v3);
-    glUniform4ui(static_cast<GLint>(location), static_cast<GLuint>(v0), static_cast<GLuint>(v1),
-                 static_cast<GLuint>(v2), static_cast<GLuint>(v3));
-    LOGI("WebGL uniform4ui end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform4ui>(static_cast<GLint>(location), static_cast<GLuint>(v0),
+        static_cast<GLuint>(v1), static_cast<GLuint>(v2), static_cast<GLuint>(v3));
     return nullptr;
 }
 
@@ -2122,21 +2102,18 @@ napi_value WebGL2RenderingContextBase::VertexAttribDivisor(napi_env env, napi_ca
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL2 vertexAttribDivisor start");
     int32_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::vertexAttribDivisor index = %{public}u", index);
     int32_t divisor;
     tie(succ, divisor) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::vertexAttribDivisor divisor = %{public}u", divisor);
-    glVertexAttribDivisor(static_cast<GLuint>(index), static_cast<GLuint>(divisor));
-    LOGI("WebGL vertexAttribDivisor end");
+    WebGLCommandBuffer::GetInstance().Record<glVertexAttribDivisor>(static_cast<GLuint>(index),
+        static_cast<GLuint>(divisor));
     return nullptr;
 }
 
@@ -2148,34 +2125,28 @@ napi_value WebGL2RenderingContextBase::DrawArraysInstanced(napi_env env, napi_ca
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL2 drawArraysInstanced start");
     int32_t mode;
     tie(succ, mode) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawArraysInstanced mode = %{public}u", mode);
     int32_t first;
     tie(succ, first) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawArraysInstanced first = %{public}u", first);
     int32_t count;
     tie(succ, count) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawArraysInstanced count = %{public}u", count);
     int32_t instanceCount;
     tie(succ, instanceCount) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawArraysInstanced instanceCount = %{public}u", instanceCount);
-    glDrawArraysInstanced(static_cast<GLenum>(mode), static_cast<GLint>(first), static_cast<GLsizei>(count),
-                          static_cast<GLsizei>(instanceCount));
-    LOGI("WebGL drawArraysInstanced end");
+    WebGLCommandBuffer::GetInstance().Record<glDrawArraysInstanced>(static_cast<GLenum>(mode),
+        static_cast<GLint>(first), static_cast<GLsizei>(count), static_cast<GLsizei>(instanceCount));
     return nullptr;
 }
 
@@ -2187,41 +2158,34 @@ napi_value WebGL2RenderingContextBase::DrawElementsInstanced(napi_env env, napi_
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL2 drawElementsInstanced start");
     int32_t mode;
     tie(succ, mode) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawElementsInstanced mode = %{public}u", mode);
     int32_t count;
     tie(succ, count) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawElementsInstanced count = %{public}u", count);
     int32_t type;
     tie(succ, type) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawElementsInstanced type = %{public}u", type);
     int32_t offset;
     tie(succ, offset) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawElementsInstanced offset = %{public}u", offset);
     int32_t instanceCount;
     tie(succ, instanceCount) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGL2RenderingContextBase::drawElementsInstanced instanceCount = %{public}u", instanceCount);
-    glDrawElementsInstanced(static_cast<GLenum>(mode), static_cast<GLsizei>(count), static_cast<GLenum>(type),
-                            reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)),
-                            static_cast<GLsizei>(instanceCount));
-    LOGI("WebGL drawElementsInstanced end");
+    WebGLCommandBuffer::GetInstance().Record<glDrawElementsInstanced>(static_cast<GLenum>(mode),
+        static_cast<GLsizei>(count), static_cast<GLenum>(type),
+        reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)), static_cast<GLsizei>(instanceCount));
     return nullptr;
 }
 
@@ -2934,15 +2898,13 @@ napi_value WebGL2RenderingContextBase::BindVertexArray(napi_env env, napi_callba
     if (funcArg[NARG_POS::FIRST] == nullptr) {
         return nullptr;
     }
-    LOGI("WebGL bindVertexArray start");
     WebGLVertexArrayObject *webGlVertexArrayObject = nullptr;
     napi_status vertexArraysStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGlVertexArrayObject);
     if (vertexArraysStatus != napi_ok) {
         return nullptr;
     }
     unsigned int vertexArrays = webGlVertexArrayObject->GetVertexArrays();
-    glBindVertexArray(static_cast<GLuint>(vertexArrays));
-    LOGI("WebGL bindVertexArray end");
+    WebGLCommandBuffer::GetInstance().Record<glBindVertexArray>(static_cast<GLuint>(vertexArrays));
     return nullptr;
 }
 
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../include/util/webgl_command_buffer.h"
+
+namespace OHOS {
+namespace Rosen {
+WebGLCommandBuffer &WebGLCommandBuffer::GetInstance()
+{
+    static WebGLCommandBuffer instance;
+    return instance;
+}
+
+void WebGLCommandBuffer::ReplayBeforeImmediateMethods(napi_property_descriptor *props, size_t count,
+    const std::unordered_set<napi_callback> &recordedMethods)
+{
+    for (size_t i = 0; i < count; i++) {
+        napi_callback method = props[i].method;
+        if (method == nullptr || recordedMethods.count(method) != 0) {
+            continue;
+        }
+        props[i].method = ReplayAndCall;
+        props[i].data = reinterpret_cast<void *>(method);
+    }
+}
+
+napi_value WebGLCommandBuffer::ReplayAndCall(napi_env env, napi_callback_info info)
+{
+    void *data = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data);
+    GetInstance().Replay();
+    return reinterpret_cast<napi_callback>(data)(env, info);
+}
+
+void WebGLCommandBuffer::Replay()
+{
+    const uint64_t *words = mWords.data();
+    for (size_t pos = 0; pos < mSize;) {
+        ReplayFunc replay = nullptr;
+        memcpy(&replay, &words[pos], sizeof(replay));
+        size_t argWords = words[pos + 1] >> ARG_COUNT_SHIFT;
+        size_t bytes = words[pos + 1] & DATA_SIZE_MASK;
+        const uint64_t *args = &words[pos + HEADER_WORDS];
+        replay(args, args + argWords);
+        pos += HEADER_WORDS + argWords + (bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    }
+    mSize = 0;
+    mCommandCount = 0;
+}
+} // namespace Rosen
+} // namespace OHOS
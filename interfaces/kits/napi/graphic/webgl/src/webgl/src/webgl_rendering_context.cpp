@@ -17,6 +17,7 @@
 
 #include "../include/util/object_manager.h"
 #include "../include/util/log.h"
+#include "../include/util/webgl_command_buffer.h"
 #include "../../common/napi/n_class.h"
 #include "../../common/napi/n_func_arg.h"
 
@@ -1967,6 +1968,69 @@ bool WebGLRenderingContext::Export(napi_env env, napi_value exports)
         NVal::DeclareNapiProperty("WebGLRenderingContext", instanceValue),
     };
 
+    static const std::unordered_set<napi_callback> recordedMethods = {
+        WebGLRenderingContextBase::ActiveTexture,
+        WebGLRenderingContextBase::BindBuffer,
+        WebGLRenderingContextBase::BindRenderbuffer,
+        WebGLRenderingContextBase::BindTexture,
+        WebGLRenderingContextBase::BlendColor,
+        WebGLRenderingContextBase::BlendEquation,
+        WebGLRenderingContextBase::BlendEquationSeparate,
+        WebGLRenderingContextBase::BlendFunc,
+        WebGLRenderingContextBase::BlendFuncSeparate,
+        WebGLRenderingContextBase::Clear,
+        WebGLRenderingContextBase::ClearColor,
+        WebGLRenderingContextBase::ClearDepth,
+        WebGLRenderingContextBase::ClearStencil,
+        WebGLRenderingContextBase::ColorMask,
+        WebGLRenderingContextBase::CullFace,
+        WebGLRenderingContextBase::DepthFunc,
+        WebGLRenderingContextBase::DepthMask,
+        WebGLRenderingContextBase::DepthRange,
+        WebGLRenderingContextBase::Disable,
+        WebGLRenderingContextBase::DisableVertexAttribArray,
+        WebGLRenderingContextBase::DrawArrays,
+        WebGLRenderingContextBase::DrawElements,
+        WebGLRenderingContextBase::Enable,
+        WebGLRenderingContextBase::EnableVertexAttribArray,
+        WebGLRenderingContextBase::FrontFace,
+        WebGLRenderingContextBase::LineWidth,
+        WebGLRenderingContextBase::PolygonOffset,
+        WebGLRenderingContextBase::Scissor,
+        WebGLRenderingContextBase::StencilFunc,
+        WebGLRenderingContextBase::StencilFuncSeparate,
+        WebGLRenderingContextBase::StencilMask,
+        WebGLRenderingContextBase::StencilMaskSeparate,
+        WebGLRenderingContextBase::StencilOp,
+        WebGLRenderingContextBase::StencilOpSeparate,
+        WebGLRenderingContextBase::Uniform1f,
+        WebGLRenderingContextBase::Uniform2f,
+        WebGLRenderingContextBase::Uniform3f,
+        WebGLRenderingContextBase::Uniform4f,
+        WebGLRenderingContextBase::Uniform1i,
+        WebGLRenderingContextBase::Uniform2i,
+        WebGLRenderingContextBase::Uniform3i,
+        WebGLRenderingContextBase::Uniform4i,
+        WebGLRenderingContextBase::UseProgram,
+        WebGLRenderingContextBase::VertexAttrib1f,
+        WebGLRenderingContextBase::VertexAttrib2f,
+        WebGLRenderingContextBase::VertexAttrib3f,
+        WebGLRenderingContextBase::VertexAttrib4f,
+        WebGLRenderingContextBase::VertexAttribPointer,
+        WebGLRenderingContextBase::Viewport,
+        WebGLRenderingContextOverloads::Uniform1fv,
+        WebGLRenderingContextOverloads::Uniform2fv,
+        WebGLRenderingContextOverloads::Uniform3fv,
+        WebGLRenderingContextOverloads::Uniform4fv,
+        WebGLRenderingContextOverloads::Uniform1iv,
+        WebGLRenderingContextOverloads::Uniform2iv,
+        WebGLRenderingContextOverloads::Uniform3iv,
+        WebGLRenderingContextOverloads::Uniform4iv,
+        WebGLRenderingContextOverloads::UniformMatrix2fv,
+        WebGLRenderingContextOverloads::UniformMatrix3fv,
+        WebGLRenderingContextOverloads::UniformMatrix4fv,
+    };
+    WebGLCommandBuffer::ReplayBeforeImmediateMethods(props, sizeof(props) / sizeof(props[0]), recordedMethods);
     status = napi_define_properties(env, exports, sizeof(props) / sizeof(props[0]), props);
     if (status != napi_ok) {
         return false;
@@ -32,6 +32,7 @@
 #include "../include/util/egl_manager.h"
 #include "../include/util/object_source.h"
 #include "../include/util/util.h"
+#include "../include/util/webgl_command_buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -118,15 +119,12 @@ napi_value WebGLRenderingContextBase::ActiveTexture(napi_env env, napi_callback_
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL activeTexture start");
     int64_t texture;
     tie(succ, texture) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::activeTexture texture = %{public}u", texture);
-    glActiveTexture(static_cast<GLenum>(texture));
-    LOGI("WebGL activeTexture end");
+    WebGLCommandBuffer::GetInstance().Record<glActiveTexture>(static_cast<GLenum>(texture));
     return nullptr;
 }
 
@@ -204,13 +202,11 @@ napi_value WebGLRenderingContextBase::BindBuffer(napi_env env, napi_callback_inf
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL bindBuffer start");
     int64_t target;
     tie(succ, target) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::bindBuffer target = %{public}u", target);
 
     if (funcArg[NARG_POS::SECOND] == nullptr) {
         return nullptr;
@@ -221,8 +217,7 @@ napi_value WebGLRenderingContextBase::BindBuffer(napi_env env, napi_callback_inf
         return nullptr;
     }
     unsigned int buffer = webGlBuffer->GetBuffer();
-    glBindBuffer(static_cast<GLenum>(target), static_cast<GLuint>(buffer));
-    LOGI("WebGL bindBuffer end");
+    WebGLCommandBuffer::GetInstance().Record<glBindBuffer>(static_cast<GLenum>(target), static_cast<GLuint>(buffer));
     return nullptr;
 }
 
@@ -264,13 +259,11 @@ napi_value WebGLRenderingContextBase::BindRenderbuffer(napi_env env, napi_callba
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL bindRenderbuffer start");
     int64_t target;
     tie(succ, target) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::bindFramebuffer target = %{public}u", target);
 
     if (funcArg[NARG_POS::SECOND] == nullptr) {
         return nullptr;
@@ -281,8 +274,8 @@ napi_value WebGLRenderingContextBase::BindRenderbuffer(napi_env env, napi_callba
         return nullptr;
     }
     unsigned int renderbuffer = webGlRenderbuffer->GetRenderbuffer();
-    glBindRenderbuffer(static_cast<GLenum>(target), static_cast<GLuint>(renderbuffer));
-    LOGI("WebGL bindRenderbuffer end");
+    WebGLCommandBuffer::GetInstance().Record<glBindRenderbuffer>(static_cast<GLenum>(target),
+        static_cast<GLuint>(renderbuffer));
     return nullptr;
 }
 
@@ -294,13 +287,11 @@ napi_value WebGLRenderingContextBase::BindTexture(napi_env env, napi_callback_in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL bindTexture start");
     int64_t target;
     tie(succ, target) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::bindTexture target = %{public}u", target);
 
     if (funcArg[NARG_POS::SECOND] == nullptr) {
         return nullptr;
@@ -311,9 +302,7 @@ napi_value WebGLRenderingContextBase::BindTexture(napi_env env, napi_callback_in
         return nullptr;
     }
     unsigned int texture = webGlTexture->GetTexture();
-    LOGI("WebGL WebGLRenderingContextBase::bindTexture textureId = %{public}u", texture);
-    glBindTexture(static_cast<GLenum>(target), static_cast<GLuint>(texture));
-    LOGI("WebGL bindTexture end");
+    WebGLCommandBuffer::GetInstance().Record<glBindTexture>(static_cast<GLenum>(target), static_cast<GLuint>(texture));
     return nullptr;
 }
 
@@ -325,7 +314,6 @@ napi_value WebGLRenderingContextBase::BlendColor(napi_env env, napi_callback_inf
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL blendColor start");
     double red;
     tie(succ, red) = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
     if (!succ) {
@@ -346,9 +334,9 @@ napi_value WebGLRenderingContextBase::BlendColor(napi_env env, napi_callback_inf
     if (!succ) {
         return nullptr;
     }
-    glBlendColor(static_cast<GLclampf>((float) red), static_cast<GLclampf>((float) green),
-        static_cast<GLclampf>((float) blue), static_cast<GLclampf>((float) alpha));
-    LOGI("WebGL blendColor end");
+    WebGLCommandBuffer::GetInstance().Record<glBlendColor>(static_cast<GLclampf>((float) red),
+        static_cast<GLclampf>((float) green), static_cast<GLclampf>((float) blue),
+        static_cast<GLclampf>((float) alpha));
     return nullptr;
 }
 
@@ -360,15 +348,12 @@ napi_value WebGLRenderingContextBase::BlendEquation(napi_env env, napi_callback_
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL blendEquation start");
     int64_t mode;
     tie(succ, mode) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendEquation mode = %{public}u", mode);
-    glBlendEquation(static_cast<GLenum>(mode));
-    LOGI("WebGL blendEquation end");
+    WebGLCommandBuffer::GetInstance().Record<glBlendEquation>(static_cast<GLenum>(mode));
     return nullptr;
 }
 
@@ -380,21 +365,18 @@ napi_value WebGLRenderingContextBase::BlendEquationSeparate(napi_env env, napi_c
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL blendEquationSeparate start");
     int64_t modeRGB;
     tie(succ, modeRGB) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendEquationSeparate modeRGB = %{public}u", modeRGB);
     int64_t modeAlpha;
     tie(succ, modeAlpha) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendEquationSeparate modeAlpha = %{public}u", modeAlpha);
-    glBlendEquationSeparate(static_cast<GLenum>(modeRGB), static_cast<GLenum>(modeAlpha));
-    LOGI("WebGL blendEquationSeparate end");
+    WebGLCommandBuffer::GetInstance().Record<glBlendEquationSeparate>(static_cast<GLenum>(modeRGB),
+        static_cast<GLenum>(modeAlpha));
     return nullptr;
 }
 
@@ -406,21 +388,17 @@ napi_value WebGLRenderingContextBase::BlendFunc(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL blendFunc start");
     int64_t sFactor;
     tie(succ, sFactor) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendFunc sFactor = %{public}u", sFactor);
     int64_t dFactor;
     tie(succ, dFactor) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendFunc dFactor = %{public}u", dFactor);
-    glBlendFunc(static_cast<GLenum>(sFactor), static_cast<GLenum>(dFactor));
-    LOGI("WebGL blendFunc end");
+    WebGLCommandBuffer::GetInstance().Record<glBlendFunc>(static_cast<GLenum>(sFactor), static_cast<GLenum>(dFactor));
     return nullptr;
 }
 
@@ -432,34 +410,28 @@ napi_value WebGLRenderingContextBase::BlendFuncSeparate(napi_env env, napi_callb
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL blendFuncSeparate start");
     int64_t srcRGB;
     tie(succ, srcRGB) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendFuncSeparate srcRGB = %{public}u", srcRGB);
     int64_t dstRGB;
     tie(succ, dstRGB) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendFuncSeparate dstRGB = %{public}u", dstRGB);
     int64_t srcAlpha;
     tie(succ, srcAlpha) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendFuncSeparate srcAlpha = %{public}u", srcAlpha);
     int64_t dstAlpha;
     tie(succ, dstAlpha) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::blendFuncSeparate dstAlpha = %{public}u", dstAlpha);
-    glBlendFuncSeparate(static_cast<GLenum>(srcRGB), static_cast<GLenum>(dstRGB), static_cast<GLenum>(srcAlpha),
-        static_cast<GLenum>(dstAlpha));
-    LOGI("WebGL blendFuncSeparate end");
+    WebGLCommandBuffer::GetInstance().Record<glBlendFuncSeparate>(static_cast<GLenum>(srcRGB),
+        static_cast<GLenum>(dstRGB), static_cast<GLenum>(srcAlpha), static_cast<GLenum>(dstAlpha));
     return nullptr;
 }
 
@@ -491,15 +463,12 @@ napi_value WebGLRenderingContextBase::Clear(napi_env env, napi_callback_info inf
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL clear start");
     int64_t mask;
     tie(succ, mask) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::clear mask = %{public}u", mask);
-    glClear(static_cast<GLbitfield>(mask));
-    LOGI("WebGL clear end");
+    WebGLCommandBuffer::GetInstance().Record<glClear>(static_cast<GLbitfield>(mask));
     return nullptr;
 }
 
@@ -511,7 +480,6 @@ napi_value WebGLRenderingContextBase::ClearColor(napi_env env, napi_callback_inf
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL clearColor start");
     double red;
     tie(succ, red) = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
     if (!succ) {
@@ -532,9 +500,9 @@ napi_value WebGLRenderingContextBase::ClearColor(napi_env env, napi_callback_inf
     if (!succ) {
         return nullptr;
     }
-    glClearColor(static_cast<GLclampf>((float) red), static_cast<GLclampf>((float) green),
-        static_cast<GLclampf>((float) blue), static_cast<GLclampf>((float) alpha));
-    LOGI("WebGL clearColor end");
+    WebGLCommandBuffer::GetInstance().Record<glClearColor>(static_cast<GLclampf>((float) red),
+        static_cast<GLclampf>((float) green), static_cast<GLclampf>((float) blue),
+        static_cast<GLclampf>((float) alpha));
     return nullptr;
 }
 
@@ -546,14 +514,12 @@ napi_value WebGLRenderingContextBase::ClearDepth(napi_env env, napi_callback_inf
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL clearDepth start");
     double depth;
     tie(succ, depth) = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    glClearDepthf(static_cast<GLclampf>((float) depth));
-    LOGI("WebGL clearDepth end");
+    WebGLCommandBuffer::GetInstance().Record<glClearDepthf>(static_cast<GLclampf>((float) depth));
     return nullptr;
 }
 
@@ -565,15 +531,12 @@ napi_value WebGLRenderingContextBase::ClearStencil(napi_env env, napi_callback_i
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL clearStencil start");
     int64_t s;
     tie(succ, s) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::clearStencil s = %{public}u", s);
-    glClearStencil(static_cast<GLint>(s));
-    LOGI("WebGL clearStencil end");
+    WebGLCommandBuffer::GetInstance().Record<glClearStencil>(static_cast<GLint>(s));
     return nullptr;
 }
 
@@ -585,34 +548,28 @@ napi_value WebGLRenderingContextBase::ColorMask(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL colorMask start");
     bool red = false;
     tie(succ, red) = NVal(env, funcArg[NARG_POS::FIRST]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::colorMask red = %{public}u", red);
     bool green = false;
     tie(succ, green) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::colorMask green = %{public}u", green);
     bool blue = false;
     tie(succ, blue) = NVal(env, funcArg[NARG_POS::THIRD]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::colorMask blue = %{public}u", blue);
     bool alpha = false;
     tie(succ, alpha) = NVal(env, funcArg[NARG_POS::FOURTH]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::colorMask alpha = %{public}u", alpha);
-    glColorMask(static_cast<GLboolean>(red), static_cast<GLboolean>(green), static_cast<GLboolean>(blue),
-        static_cast<GLboolean>(alpha));
-    LOGI("WebGL colorMask end");
+    WebGLCommandBuffer::GetInstance().Record<glColorMask>(static_cast<GLboolean>(red), static_cast<GLboolean>(green),
+        static_cast<GLboolean>(blue), static_cast<GLboolean>(alpha));
     return nullptr;
 }
 
@@ -900,15 +857,12 @@ napi_value WebGLRenderingContextBase::CullFace(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL cullFace start");
     int64_t mode;
     tie(succ, mode) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::cullFace mode = %{public}u", mode);
-    glCullFace(static_cast<GLenum>(mode));
-    LOGI("WebGL cullFace end");
+    WebGLCommandBuffer::GetInstance().Record<glCullFace>(static_cast<GLenum>(mode));
     return nullptr;
 }
 
@@ -1063,15 +1017,12 @@ napi_value WebGLRenderingContextBase::DepthFunc(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL depthFunc start");
     int64_t func;
     tie(succ, func) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::depthFunc func = %{public}u", func);
-    glDepthFunc(static_cast<GLenum>(func));
-    LOGI("WebGL depthFunc end");
+    WebGLCommandBuffer::GetInstance().Record<glDepthFunc>(static_cast<GLenum>(func));
     return nullptr;
 }
 
@@ -1083,15 +1034,12 @@ napi_value WebGLRenderingContextBase::DepthMask(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL depthMask start");
     bool flag = false;
     tie(succ, flag) = NVal(env, funcArg[NARG_POS::FIRST]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::depthMask flag = %{public}u", flag);
-    glDepthMask(static_cast<GLboolean>(flag));
-    LOGI("WebGL depthMask end");
+    WebGLCommandBuffer::GetInstance().Record<glDepthMask>(static_cast<GLboolean>(flag));
     return nullptr;
 }
 
@@ -1103,7 +1051,6 @@ napi_value WebGLRenderingContextBase::DepthRange(napi_env env, napi_callback_inf
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL depthRange start");
     double zNear;
     tie(succ, zNear) = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
     if (!succ) {
@@ -1114,8 +1061,8 @@ napi_value WebGLRenderingContextBase::DepthRange(napi_env env, napi_callback_inf
     if (!succ) {
         return nullptr;
     }
-    glDepthRangef(static_cast<GLclampf>((float) zNear), static_cast<GLclampf>((float) zFar));
-    LOGI("WebGL depthRange end");
+    WebGLCommandBuffer::GetInstance().Record<glDepthRangef>(static_cast<GLclampf>((float) zNear),
+        static_cast<GLclampf>((float) zFar));
     return nullptr;
 }
 
@@ -1157,15 +1104,12 @@ napi_value WebGLRenderingContextBase::Disable(napi_env env, napi_callback_info i
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL disable start");
     int64_t cap;
     tie(succ, cap) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::disable cap = %{public}u", cap);
-    glDisable(static_cast<GLenum>(cap));
-    LOGI("WebGL disable end");
+    WebGLCommandBuffer::GetInstance().Record<glDisable>(static_cast<GLenum>(cap));
     return nullptr;
 }
 
@@ -1177,15 +1121,12 @@ napi_value WebGLRenderingContextBase::DisableVertexAttribArray(napi_env env, nap
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL disableVertexAttribArray start");
     int64_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::disableVertexAttribArray index = %{public}u", index);
-    glDisableVertexAttribArray(static_cast<GLuint>(index));
-    LOGI("WebGL disableVertexAttribArray end");
+    WebGLCommandBuffer::GetInstance().Record<glDisableVertexAttribArray>(static_cast<GLuint>(index));
     return nullptr;
 }
 
@@ -1197,27 +1138,23 @@ napi_value WebGLRenderingContextBase::DrawArrays(napi_env env, napi_callback_inf
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL drawArrays start");
     int64_t mode;
     tie(succ, mode) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::drawArrays mode = %{public}u", mode);
     int64_t first;
     tie(succ, first) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::drawArrays first = %{public}u", first);
     int64_t count;
     tie(succ, count) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::drawArrays count = %{public}u", count);
-    glDrawArrays(static_cast<GLenum>(mode), static_cast<GLint>(first), static_cast<GLsizei>(count));
-    LOGI("WebGL drawArrays end");
+    WebGLCommandBuffer::GetInstance().Record<glDrawArrays>(static_cast<GLenum>(mode), static_cast<GLint>(first),
+        static_cast<GLsizei>(count));
     return nullptr;
 }
 
@@ -1229,34 +1166,28 @@ napi_value WebGLRenderingContextBase::DrawElements(napi_env env, napi_callback_i
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL drawElements start");
     int64_t mode;
     tie(succ, mode) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::drawElements mode = %{public}u", mode);
     int64_t count;
     tie(succ, count) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::drawElements count = %{public}u", count);
     int64_t type;
     tie(succ, type) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::drawElements type = %{public}u", type);
     int64_t offset;
     tie(succ, offset) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::drawElements offset = %{public}u", offset);
-    glDrawElements(static_cast<GLenum>(mode), static_cast<GLsizei>(count), static_cast<GLenum>(type),
-        reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)));
-    LOGI("WebGL drawElements end");
+    WebGLCommandBuffer::GetInstance().Record<glDrawElements>(static_cast<GLenum>(mode), static_cast<GLsizei>(count),
+        static_cast<GLenum>(type), reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)));
     return nullptr;
 }
 
@@ -1268,15 +1199,12 @@ napi_value WebGLRenderingContextBase::Enable(napi_env env, napi_callback_info in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL enable start");
     int64_t cap;
     tie(succ, cap) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::enable cap = %{public}u", cap);
-    glEnable(static_cast<GLenum>(cap));
-    LOGI("WebGL enable end");
+    WebGLCommandBuffer::GetInstance().Record<glEnable>(static_cast<GLenum>(cap));
     return nullptr;
 }
 
@@ -1288,15 +1216,12 @@ napi_value WebGLRenderingContextBase::EnableVertexAttribArray(napi_env env, napi
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL enableVertexAttribArray start");
     int64_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextBase::enableVertexAttribArray index = %{public}u", index);
-    glEnableVertexAttribArray(static_cast<GLuint>(index));
-    LOGI("WebGL enableVertexAttribArray end");
+    WebGLCommandBuffer::GetInstance().Record<glEnableVertexAttribArray>(static_cast<GLuint>(index));
     return nullptr;
 }
 
@@ -1658,34 +1583,28 @@ napi_value WebGLRenderingContextBase::Scissor(napi_env env, napi_callback_info i
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL scissor start");
     int32_t x;
     tie(succ, x) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::scissor x = %{public}u", x);
     int32_t y;
     tie(succ, y) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::scissor y = %{public}u", y);
     int32_t width;
     tie(succ, width) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::scissor width = %{public}u", width);
     int32_t height;
     tie(succ, height) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::scissor height = %{public}u", height);
-    glScissor(static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width),
-              static_cast<GLsizei>(height));
-    LOGI("WebGL scissor end");
+    WebGLCommandBuffer::GetInstance().Record<glScissor>(static_cast<GLint>(x), static_cast<GLint>(y),
+        static_cast<GLsizei>(width), static_cast<GLsizei>(height));
     return nullptr;
 }
 
@@ -1697,27 +1616,23 @@ napi_value WebGLRenderingContextBase::StencilFunc(napi_env env, napi_callback_in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL stencilFunc start");
     int32_t func;
     tie(succ, func) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilFunc func = %{public}u", func);
     int32_t ref;
     tie(succ, ref) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilFunc ref = %{public}u", ref);
     int32_t mask;
     tie(succ, mask) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilFunc mask = %{public}u", mask);
-    glStencilFunc(static_cast<GLenum>(func), static_cast<GLint>(ref), static_cast<GLuint>(mask));
-    LOGI("WebGL stencilFunc end");
+    WebGLCommandBuffer::GetInstance().Record<glStencilFunc>(static_cast<GLenum>(func), static_cast<GLint>(ref),
+        static_cast<GLuint>(mask));
     return nullptr;
 }
 
@@ -1729,34 +1644,28 @@ napi_value WebGLRenderingContextBase::StencilFuncSeparate(napi_env env, napi_cal
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL stencilFuncSeparate start");
     int32_t face;
     tie(succ, face) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilFuncSeparate face = %{public}u", face);
     int32_t func;
     tie(succ, func) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilFuncSeparate func = %{public}u", func);
     int32_t ref;
     tie(succ, ref) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilFuncSeparate ref = %{public}u", ref);
     int32_t mask;
     tie(succ, mask) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilFuncSeparate mask = %{public}u", mask);
-    glStencilFuncSeparate(static_cast<GLenum>(face), static_cast<GLenum>(func), static_cast<GLint>(ref),
-                          static_cast<GLuint>(mask));
-    LOGI("WebGL stencilFuncSeparate end");
+    WebGLCommandBuffer::GetInstance().Record<glStencilFuncSeparate>(static_cast<GLenum>(face),
+        static_cast<GLenum>(func), static_cast<GLint>(ref), static_cast<GLuint>(mask));
     return nullptr;
 }
 
@@ -1768,15 +1677,12 @@ napi_value WebGLRenderingContextBase::StencilMask(napi_env env, napi_callback_in
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL stencilMask start");
     int32_t mask;
     tie(succ, mask) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilMask mask = %{public}u", mask);
-    glStencilMask(static_cast<GLuint>(mask));
-    LOGI("WebGL stencilMask end");
+    WebGLCommandBuffer::GetInstance().Record<glStencilMask>(static_cast<GLuint>(mask));
     return nullptr;
 }
 
@@ -1788,21 +1694,18 @@ napi_value WebGLRenderingContextBase::StencilMaskSeparate(napi_env env, napi_cal
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL stencilMaskSeparate start");
     int32_t face;
     tie(succ, face) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilMaskSeparate face = %{public}u", face);
     int32_t mask;
     tie(succ, mask) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilMaskSeparate mask = %{public}u", mask);
-    glStencilMaskSeparate(static_cast<GLenum>(face), static_cast<GLuint>(mask));
-    LOGI("WebGL stencilMaskSeparate end");
+    WebGLCommandBuffer::GetInstance().Record<glStencilMaskSeparate>(static_cast<GLenum>(face),
+        static_cast<GLuint>(mask));
     return nullptr;
 }
 
@@ -1814,27 +1717,23 @@ napi_value WebGLRenderingContextBase::StencilOp(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL stencilOp start");
     int32_t fail;
     tie(succ, fail) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilOp fail = %{public}u", fail);
     int32_t zfail;
     tie(succ, zfail) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilOp zfail = %{public}u", zfail);
     int32_t zpass;
     tie(succ, zpass) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilOp zpass = %{public}u", zpass);
-    glStencilOp(static_cast<GLenum>(fail), static_cast<GLenum>(zfail), static_cast<GLenum>(zpass));
-    LOGI("WebGL stencilOp end");
+    WebGLCommandBuffer::GetInstance().Record<glStencilOp>(static_cast<GLenum>(fail), static_cast<GLenum>(zfail),
+        static_cast<GLenum>(zpass));
     return nullptr;
 }
 
@@ -1846,34 +1745,28 @@ napi_value WebGLRenderingContextBase::StencilOpSeparate(napi_env env, napi_callb
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL stencilOpSeparate start");
     int32_t face;
     tie(succ, face) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilOpSeparate face = %{public}u", face);
     int32_t sfail;
     tie(succ, sfail) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilOpSeparate sfail = %{public}u", sfail);
     int32_t dpfail;
     tie(succ, dpfail) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilOpSeparate dpfail = %{public}u", dpfail);
     int32_t dppass;
     tie(succ, dppass) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::stencilOpSeparate dppass = %{public}u", dppass);
-    glStencilOpSeparate(static_cast<GLenum>(face), static_cast<GLenum>(sfail), static_cast<GLenum>(dpfail),
-                        static_cast<GLenum>(dppass));
-    LOGI("WebGL stencilOpSeparate end");
+    WebGLCommandBuffer::GetInstance().Record<glStencilOpSeparate>(static_cast<GLenum>(face), static_cast<GLenum>(sfail),
+        static_cast<GLenum>(dpfail), static_cast<GLenum>(dppass));
     return nullptr;
 }
 
@@ -1949,7 +1842,6 @@ napi_value WebGLRenderingContextBase::Uniform1f(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform1f start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -1961,9 +1853,8 @@ napi_value WebGLRenderingContextBase::Uniform1f(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform1f v0 = %{public}f", v0);
-    glUniform1f(static_cast<GLint>(location), static_cast<GLfloat>((float) v0));
-    LOGI("WebGL uniform1f end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform1f>(static_cast<GLint>(location),
+        static_cast<GLfloat>((float) v0));
     return nullptr;
 }
 
@@ -1975,7 +1866,6 @@ napi_value WebGLRenderingContextBase::Uniform2f(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform2f start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -1987,15 +1877,13 @@ napi_value WebGLRenderingContextBase::Uniform2f(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform2f v0 = %{public}f", v0);
     double v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform2f v1 = %{public}f", v1);
-    glUniform2f(static_cast<GLint>(location), static_cast<GLfloat>((float) v0), static_cast<GLfloat>((float) v1));
-    LOGI("WebGL uniform2f end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform2f>(static_cast<GLint>(location),
+        static_cast<GLfloat>((float) v0), static_cast<GLfloat>((float) v1));
     return nullptr;
 }
 
@@ -2007,7 +1895,6 @@ napi_value WebGLRenderingContextBase::Uniform3f(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform3f start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -2019,22 +1906,18 @@ napi_value WebGLRenderingContextBase::Uniform3f(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform3f v0 = %{public}f", v0);
     double v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform3f v1 = %{public}f", v1);
     double v2;
     tie(succ, v2) = NVal(env, funcArg[NARG_POS::FOURTH]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform3f v2 = %{public}f", v2);
-    glUniform3f(static_cast<GLint>(location), static_cast<GLfloat>((float) v0), static_cast<GLfloat>((float) v1),
-                static_cast<GLfloat>((float) v2));
-    LOGI("WebGL uniform3f end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform3f>(static_cast<GLint>(location),
+        static_cast<GLfloat>((float) v0), static_cast<GLfloat>((float) v1), static_cast<GLfloat>((float) v2));
     return nullptr;
 }
 
@@ -2046,7 +1929,6 @@ napi_value WebGLRenderingContextBase::Uniform4f(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform4f start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -2058,28 +1940,24 @@ napi_value WebGLRenderingContextBase::Uniform4f(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4f v0 = %{public}f", v0);
     double v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4f v1 = %{public}f", v1);
     double v2;
     tie(succ, v2) = NVal(env, funcArg[NARG_POS::FOURTH]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4f v2 = %{public}f", v2);
     double v3;
     tie(succ, v3) = NVal(env, funcArg[NARG_POS::FIFTH]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4f v3 = %{public}f", v3);
-    glUniform4f(static_cast<GLint>(location), static_cast<GLfloat>((float) v0), static_cast<GLfloat>((float) v1),
-                static_cast<GLfloat>((float) v2), static_cast<GLfloat>((float) v3));
-    LOGI("WebGL uniform4f end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform4f>(static_cast<GLint>(location),
+        static_cast<GLfloat>((float) v0), static_cast<GLfloat>((float) v1), static_cast<GLfloat>((float) v2),
+        static_cast<GLfloat>((float) v3));
     return nullptr;
 }
 
@@ -2091,7 +1969,6 @@ napi_value WebGLRenderingContextBase::Uniform1i(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform1i start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -2103,9 +1980,7 @@ napi_value WebGLRenderingContextBase::Uniform1i(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform1i v0 = %{public}u", v0);
-    glUniform1i(static_cast<GLint>(location), static_cast<GLint>(v0));
-    LOGI("WebGL uniform1i end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform1i>(static_cast<GLint>(location), static_cast<GLint>(v0));
     return nullptr;
 }
 
@@ -2117,7 +1992,6 @@ napi_value WebGLRenderingContextBase::Uniform2i(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform2i start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -2129,15 +2003,13 @@ napi_value WebGLRenderingContextBase::Uniform2i(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform2i v0 = %{public}u", v0);
     int32_t v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform2i v1 = %{public}u", v1);
-    glUniform2i(static_cast<GLint>(location), static_cast<GLint>(v0), static_cast<GLint>(v1));
-    LOGI("WebGL uniform2i end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform2i>(static_cast<GLint>(location), static_cast<GLint>(v0),
+        static_cast<GLint>(v1));
     return nullptr;
 }
 
@@ -2149,7 +2021,6 @@ napi_value WebGLRenderingContextBase::Uniform3i(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform3i start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -2161,22 +2032,18 @@ napi_value WebGLRenderingContextBase::Uniform3i(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform3i v0 = %{public}u", v0);
     int32_t v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform3i v1 = %{public}u", v1);
     int32_t v2;
     tie(succ, v2) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform3i v2 = %{public}u", v2);
-    glUniform3i(static_cast<GLint>(location), static_cast<GLint>(v0), static_cast<GLint>(v1),
-                static_cast<GLint>(v2));
-    LOGI("WebGL uniform3i end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform3i>(static_cast<GLint>(location), static_cast<GLint>(v0),
+        static_cast<GLint>(v1), static_cast<GLint>(v2));
     return nullptr;
 }
 
@@ -2188,7 +2055,6 @@ napi_value WebGLRenderingContextBase::Uniform4i(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform4i start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGLUniformLocation);
     if (locationStatus != napi_ok) {
@@ -2200,28 +2066,23 @@ napi_value WebGLRenderingContextBase::Uniform4i(napi_env env, napi_callback_info
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4i v0 = %{public}u", v0);
     int32_t v1;
     tie(succ, v1) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4i v1 = %{public}u", v1);
     int32_t v2;
     tie(succ, v2) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4i v2 = %{public}u", v2);
     int32_t v3;
     tie(succ, v3) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::uniform4i v3 = %{public}u", v3);
-    glUniform4i(static_cast<GLint>(location), static_cast<GLint>(v0), static_cast<GLint>(v1),
-                static_cast<GLint>(v2), static_cast<GLint>(v3));
-    LOGI("WebGL uniform4i end");
+    WebGLCommandBuffer::GetInstance().Record<glUniform4i>(static_cast<GLint>(location), static_cast<GLint>(v0),
+        static_cast<GLint>(v1), static_cast<GLint>(v2), static_cast<GLint>(v3));
     return nullptr;
 }
 
@@ -2232,15 +2093,13 @@ napi_value WebGLRenderingContextBase::UseProgram(napi_env env, napi_callback_inf
     if (!funcArg.InitArgs(NARG_CNT::ONE)) {
         return nullptr;
     }
-    LOGI("WebGL useProgram start");
     WebGLProgram *webGlProgram = nullptr;
     napi_status programStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **) &webGlProgram);
     if (programStatus != napi_ok) {
         return nullptr;
     }
     int program = webGlProgram->GetProgramId();
-    glUseProgram(static_cast<GLuint>(program));
-    LOGI("WebGL useProgram end");
+    WebGLCommandBuffer::GetInstance().Record<glUseProgram>(static_cast<GLuint>(program));
     return nullptr;
 }
 
@@ -2272,21 +2131,18 @@ napi_value WebGLRenderingContextBase::VertexAttrib1f(napi_env env, napi_callback
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL vertexAttrib1f start");
     int32_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib1f index = %{public}u", index);
     double v0;
     tie(succ, v0) = NVal(env, funcArg[NARG_POS::SECOND]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib1f v0 = %{public}f", v0);
-    glVertexAttrib1f(static_cast<GLuint>(index), static_cast<GLfloat>((float) v0));
-    LOGI("WebGL vertexAttrib1f end");
+    WebGLCommandBuffer::GetInstance().Record<glVertexAttrib1f>(static_cast<GLuint>(index),
+        static_cast<GLfloat>((float) v0));
     return nullptr;
 }
 
@@ -2298,27 +2154,23 @@ napi_value WebGLRenderingContextBase::VertexAttrib2f(napi_env env, napi_callback
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL vertexAttrib2f start");
     int32_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib2f index = %{public}u", index);
     double x;
     tie(succ, x) = NVal(env, funcArg[NARG_POS::SECOND]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib2f x = %{public}f", x);
     double y;
     tie(succ, y) = NVal(env, funcArg[NARG_POS::THIRD]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib2f y = %{public}f", y);
-    glVertexAttrib2f(static_cast<GLint>(index), static_cast<GLfloat>((float) x), static_cast<GLfloat>((float) y));
-    LOGI("WebGL vertexAttrib2f end");
+    WebGLCommandBuffer::GetInstance().Record<glVertexAttrib2f>(static_cast<GLint>(index),
+        static_cast<GLfloat>((float) x), static_cast<GLfloat>((float) y));
     return nullptr;
 }
 
@@ -2330,34 +2182,28 @@ napi_value WebGLRenderingContextBase::VertexAttrib3f(napi_env env, napi_callback
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL vertexAttrib3f start");
     int32_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib3f index = %{public}u", index);
     double x;
     tie(succ, x) = NVal(env, funcArg[NARG_POS::SECOND]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib3f x = %{public}f", x);
     double y;
     tie(succ, y) = NVal(env, funcArg[NARG_POS::THIRD]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib3f y = %{public}f", y);
     double z;
     tie(succ, z) = NVal(env, funcArg[NARG_POS::FOURTH]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib3f z = %{public}f", z);
-    glVertexAttrib3f(static_cast<GLuint>(index), static_cast<GLfloat>((float) x), static_cast<GLfloat>((float) y),
-                     static_cast<GLfloat>(z));
-    LOGI("WebGL vertexAttrib3f end");
+    WebGLCommandBuffer::GetInstance().Record<glVertexAttrib3f>(static_cast<GLuint>(index),
+        static_cast<GLfloat>((float) x), static_cast<GLfloat>((float) y), static_cast<GLfloat>(z));
     return nullptr;
 }
 
@@ -2369,40 +2215,34 @@ napi_value WebGLRenderingContextBase::VertexAttrib4f(napi_env env, napi_callback
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL vertexAttrib4f start");
     int32_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib4f index = %{public}u", index);
     double x;
     tie(succ, x) = NVal(env, funcArg[NARG_POS::SECOND]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib4f x = %{public}f", x);
     double y;
     tie(succ, y) = NVal(env, funcArg[NARG_POS::THIRD]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib4f y = %{public}f", y);
     double z;
     tie(succ, z) = NVal(env, funcArg[NARG_POS::FOURTH]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib4f z = %{public}f", z);
     double w;
     tie(succ, w) = NVal(env, funcArg[NARG_POS::FIFTH]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttrib4f w = %{public}f", w);
-    glVertexAttrib4f(static_cast<GLuint>(index), static_cast<GLfloat>((float) x), static_cast<GLfloat>((float) y),
-                     static_cast<GLfloat>((float) z), static_cast<GLfloat>((float) w));
-    LOGI("WebGL vertexAttrib4f end");
+    WebGLCommandBuffer::GetInstance().Record<glVertexAttrib4f>(static_cast<GLuint>(index),
+        static_cast<GLfloat>((float) x), static_cast<GLfloat>((float) y), static_cast<GLfloat>((float) z),
+        static_cast<GLfloat>((float) w));
     return nullptr;
 }
 
@@ -2414,47 +2254,39 @@ napi_value WebGLRenderingContextBase::VertexAttribPointer(napi_env env, napi_cal
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL vertexAttribPointer start");
     int32_t index;
     tie(succ, index) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttribPointer index = %{public}u", index);
     int32_t size;
     tie(succ, size) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttribPointer size = %{public}u", size);
     int32_t type;
     tie(succ, type) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttribPointer type = %{public}u", type);
     bool normalized = false;
     tie(succ, normalized) = NVal(env, funcArg[NARG_POS::FOURTH]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttribPointer normalized = %{public}u", normalized);
     int32_t stride;
     tie(succ, stride) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttribPointer stride = %{public}u", stride);
     int32_t offset;
     tie(succ, offset) = NVal(env, funcArg[NARG_POS::SIXTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::vertexAttribPointer offset = %{public}u", offset);
-    glVertexAttribPointer(static_cast<GLuint>(index), static_cast<GLint>(size), static_cast<GLenum>(type),
-                          static_cast<GLboolean>(normalized), static_cast<GLsizei>(stride),
-                          reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)));
-    LOGI("WebGL vertexAttribPointer end");
+    WebGLCommandBuffer::GetInstance().Record<glVertexAttribPointer>(static_cast<GLuint>(index),
+        static_cast<GLint>(size), static_cast<GLenum>(type), static_cast<GLboolean>(normalized),
+        static_cast<GLsizei>(stride), reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)));
     return nullptr;
 }
 
@@ -2466,34 +2298,28 @@ napi_value WebGLRenderingContextBase::Viewport(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("webgl viewport start");
     int32_t x;
     tie(succ, x) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("webgl WebGLRenderContext::viewport x = %{public}u", x);
     int32_t y;
     tie(succ, y) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("webgl WebGLRenderContext::viewport y = %{public}u", y);
     int32_t width;
     tie(succ, width) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("webgl WebGLRenderContext::viewport width = %{public}u", width);
     int32_t height;
     tie(succ, height) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
     if (!succ) {
         return nullptr;
     }
-    LOGI("webgl WebGLRenderContext::viewport height = %{public}u", height);
-    glViewport(static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width),
-               static_cast<GLsizei>(height));
-    LOGI("webgl viewport end");
+    WebGLCommandBuffer::GetInstance().Record<glViewport>(static_cast<GLint>(x), static_cast<GLint>(y),
+        static_cast<GLsizei>(width), static_cast<GLsizei>(height));
     return nullptr;
 }
 
@@ -2622,15 +2448,12 @@ napi_value WebGLRenderingContextBase::LineWidth(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL lineWidth start");
     double linewidth;
     tie(succ, linewidth) = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::lineWidth linewidth = %{public}f", linewidth);
-    glLineWidth(static_cast<GLfloat>((float) linewidth));
-    LOGI("WebGL lineWidth end");
+    WebGLCommandBuffer::GetInstance().Record<glLineWidth>(static_cast<GLfloat>((float) linewidth));
     return nullptr;
 }
 
@@ -2696,21 +2519,18 @@ napi_value WebGLRenderingContextBase::PolygonOffset(napi_env env, napi_callback_
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL polygonOffset start");
     double factor;
     tie(succ, factor) = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::polygonOffset factor = %{public}f", factor);
     double units;
     tie(succ, units) = NVal(env, funcArg[NARG_POS::SECOND]).ToDouble();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::polygonOffset units = %{public}f", units);
-    glPolygonOffset(static_cast<GLfloat>((float) factor), static_cast<GLfloat>((float) units));
-    LOGI("WebGL polygonOffset end");
+    WebGLCommandBuffer::GetInstance().Record<glPolygonOffset>(static_cast<GLfloat>((float) factor),
+        static_cast<GLfloat>((float) units));
     return nullptr;
 }
 
@@ -2721,15 +2541,12 @@ napi_value WebGLRenderingContextBase::FrontFace(napi_env env, napi_callback_info
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL frontFace start");
     int64_t mode;
     tie(succ, mode) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderContext::frontFace mode = %{public}u", mode);
-    glFrontFace(static_cast<GLenum>(mode));
-    LOGI("WebGL frontFace end");
+    WebGLCommandBuffer::GetInstance().Record<glFrontFace>(static_cast<GLenum>(mode));
     return nullptr;
 }
 
@@ -20,6 +20,7 @@
 #include "../../common/napi/n_class.h"
 #include "../include/util/log.h"
 #include "../include/util/object_manager.h"
+#include "../include/util/webgl_command_buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -83,6 +84,7 @@ void WebGLRenderingContextBasicBase::Attach(uint64_t id) {}
 
 void WebGLRenderingContextBasicBase::Update()
 {
+    WebGLCommandBuffer::GetInstance().Replay();
     if (mEglWindow) {
         LOGI("WebGLRenderingContextBasicBase eglSwapBuffers");
         EGLDisplay eglDisplay = EglManager::GetInstance().GetEGLDisplay();
@@ -23,6 +23,7 @@
 #include "../include/webgl/webgl_texture.h"
 #include "../include/util/log.h"
 #include "../include/webgl/webgl_uniform_location.h"
+#include "../include/util/webgl_command_buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +33,15 @@ namespace OHOS {
 namespace Rosen {
 using namespace std;
 
+namespace {
+constexpr size_t VEC2_COMPONENTS = 2;
+constexpr size_t VEC3_COMPONENTS = 3;
+constexpr size_t VEC4_COMPONENTS = 4;
+constexpr size_t MAT2_COMPONENTS = 4;
+constexpr size_t MAT3_COMPONENTS = 9;
+constexpr size_t MAT4_COMPONENTS = 16;
+}
+
 napi_value WebGLRenderingContextOverloads::BufferData(napi_env env, napi_callback_info info)
 {
     NFuncArg funcArg(env, info);
@@ -686,14 +696,12 @@ napi_value WebGLRenderingContextOverloads::Uniform1fv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform1fv start");
     WebGLUniformLocation *webGLUniformlocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformlocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformlocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv location = %{public}u", location);
 
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
 
@@ -701,39 +709,33 @@ napi_value WebGLRenderingContextOverloads::Uniform1fv(napi_env env, napi_callbac
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
         float* a = nullptr;
-        LOGI("WebGL uniform1fv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv count = %{public}u", count);
         float uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
             napi_value element;
             napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv element = %{public}u", element);
             if (eleStatus != napi_ok) {
                 return nullptr;
             }
             double ele;
             napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv ele = %{public}f", (float)ele);
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
             uniformfv[i] = (float)ele;
         }
         a = uniformfv;
-        glUniform1fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform1fv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform1fv>(uniformfv, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -745,16 +747,11 @@ napi_value WebGLRenderingContextOverloads::Uniform1fv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv count = %{public}u", count);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv type = %{public}u", type);
     if (type == napi_float32_array) {
         float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv input_float32_array = %{public}u", inputFloat32);
-        glUniform1fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform1fv>(inputFloat32, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count));
     }
-    LOGI("WebGL uniform1fv end");
     return nullptr;
 }
 
@@ -768,26 +765,22 @@ napi_value WebGLRenderingContextOverloads::Uniform2fv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform2fv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv location = %{public}u", location);
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
     bool isUniformArray = false;
     float* a = nullptr;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
-        LOGI("WebGL uniform2fv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv count = %{public}u", count);
         float uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -801,19 +794,16 @@ napi_value WebGLRenderingContextOverloads::Uniform2fv(napi_env env, napi_callbac
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv ele = %{public}f", (float)ele);
             uniformfv[i] = (float)ele;
         }
         a = uniformfv;
-        glUniform2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform2fv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform2fv>(uniformfv, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC2_COMPONENTS));
         return nullptr;
     }
 
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -825,16 +815,11 @@ napi_value WebGLRenderingContextOverloads::Uniform2fv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv count = %{public}u", count);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv type = %{public}u", type);
     if (type == napi_float32_array) {
         float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv input_float32_array = %{public}u", inputFloat32);
-        glUniform2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform2fv>(inputFloat32, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC2_COMPONENTS));
     }
-    LOGI("WebGL uniform2fv end");
     return nullptr;
 }
 
@@ -849,26 +834,22 @@ napi_value WebGLRenderingContextOverloads::Uniform3fv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform3fv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv location = %{public}u", location);
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
-        LOGI("WebGL uniform3fv is isUniformArray");
         float* a = nullptr;
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv count = %{public}u", count);
         float uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -882,18 +863,15 @@ napi_value WebGLRenderingContextOverloads::Uniform3fv(napi_env env, napi_callbac
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv ele = %{public}f", (float)ele);
             uniformfv[i] = (float)ele;
         }
         a = uniformfv;
-        glUniform3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform3fv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform3fv>(uniformfv, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC3_COMPONENTS));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -905,15 +883,11 @@ napi_value WebGLRenderingContextOverloads::Uniform3fv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv count = %{public}u", count);
     if (type == napi_float32_array) {
         float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv input_float32_array = %{public}u", inputFloat32);
-        glUniform3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform3fv>(inputFloat32, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC3_COMPONENTS));
     }
-    LOGI("WebGL uniform3fv end");
     return nullptr;
 }
 
@@ -928,25 +902,21 @@ napi_value WebGLRenderingContextOverloads::Uniform4fv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform4fv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv location = %{public}u", location);
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
-        LOGI("WebGL uniform4fv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv count = %{public}u", count);
         float* a = nullptr;
         float uniformfv[count];
         uint32_t i;
@@ -961,18 +931,15 @@ napi_value WebGLRenderingContextOverloads::Uniform4fv(napi_env env, napi_callbac
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv ele = %{public}f", (float)ele);
             uniformfv[i] = (float)ele;
         }
         a = uniformfv;
-        glUniform4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform4fv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform4fv>(uniformfv, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC4_COMPONENTS));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -984,15 +951,11 @@ napi_value WebGLRenderingContextOverloads::Uniform4fv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv count = %{public}u", count);
     if (type == napi_float32_array) {
         float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv input_float32_array = %{public}u", inputFloat32);
-        glUniform4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform4fv>(inputFloat32, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC4_COMPONENTS));
     }
-    LOGI("WebGL uniform4fv end");
     return nullptr;
 }
 
@@ -1006,26 +969,22 @@ napi_value WebGLRenderingContextOverloads::Uniform1iv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform1iv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv location = %{public}u", location);
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
         int* a = nullptr;
-        LOGI("WebGL uniform1iv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv count = %{public}u", count);
         int uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -1039,18 +998,15 @@ napi_value WebGLRenderingContextOverloads::Uniform1iv(napi_env env, napi_callbac
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv ele = %{public}f", (float)ele);
             uniformfv[i] = (int)ele;
         }
         a = uniformfv;
-        glUniform1iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform1iv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform1iv>(a, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -1062,15 +1018,11 @@ napi_value WebGLRenderingContextOverloads::Uniform1iv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv count = %{public}u", count);
     if (type == napi_int32_array) {
         int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv int_int32_array = %{public}u", intInt32);
-        glUniform1iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform1iv>(intInt32, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count));
     }
-    LOGI("WebGL uniform1iv end");
     return nullptr;
 }
 
@@ -1084,26 +1036,22 @@ napi_value WebGLRenderingContextOverloads::Uniform2iv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform2iv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv location = %{public}u", location);
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
-        LOGI("WebGL uniform2iv is isUniformArray");
         int* a = nullptr;
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv count = %{public}u", count);
         int uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -1117,18 +1065,15 @@ napi_value WebGLRenderingContextOverloads::Uniform2iv(napi_env env, napi_callbac
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv ele = %{public}d", ele);
             uniformfv[i] = (int)ele;
         }
         a = uniformfv;
-        glUniform2iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform2iv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform2iv>(a, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC2_COMPONENTS));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -1140,15 +1085,11 @@ napi_value WebGLRenderingContextOverloads::Uniform2iv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv count = %{public}u", count);
     if (type == napi_int32_array) {
         int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv int_int32_array = %{public}u", intInt32);
-        glUniform2iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform2iv>(intInt32, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC2_COMPONENTS));
     }
-    LOGI("WebGL uniform2iv end");
     return nullptr;
 }
 
@@ -1162,26 +1103,22 @@ napi_value WebGLRenderingContextOverloads::Uniform3iv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform3iv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv location = %{public}u", location);
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
         int* a = nullptr;
-        LOGI("WebGL uniform3iv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv count = %{public}u", count);
         int uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -1195,18 +1132,15 @@ napi_value WebGLRenderingContextOverloads::Uniform3iv(napi_env env, napi_callbac
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv ele = %{public}f", (float)ele);
             uniformfv[i] = (int)ele;
         }
         a = uniformfv;
-        glUniform3iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform3iv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform3iv>(a, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC3_COMPONENTS));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -1218,15 +1152,11 @@ napi_value WebGLRenderingContextOverloads::Uniform3iv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv count = %{public}u", count);
     if (type == napi_int32_array) {
         int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv int_int32_array = %{public}u", intInt32);
-        glUniform3iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform3iv>(intInt32, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC3_COMPONENTS));
     }
-    LOGI("WebGL uniform3iv end");
     return nullptr;
 }
 
@@ -1240,26 +1170,22 @@ napi_value WebGLRenderingContextOverloads::Uniform4iv(napi_env env, napi_callbac
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniform4iv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv location = %{public}u", location);
     napi_value uniformarray = funcArg[NARG_POS::SECOND];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
         int* a = nullptr;
-        LOGI("WebGL uniform4iv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv count = %{public}u", count);
         int uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -1273,18 +1199,15 @@ napi_value WebGLRenderingContextOverloads::Uniform4iv(napi_env env, napi_callbac
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv ele = %{public}f", (float)ele);
             uniformfv[i] = (int)ele;
         }
         a = uniformfv;
-        glUniform4iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform4iv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform4iv>(a, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC4_COMPONENTS));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -1296,15 +1219,11 @@ napi_value WebGLRenderingContextOverloads::Uniform4iv(napi_env env, napi_callbac
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv count = %{public}u", count);
     if (type == napi_int32_array) {
         int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv int_int32_array = %{public}u", intInt32);
-        glUniform4iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniform4iv>(intInt32, count * sizeof(GLint),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / VEC4_COMPONENTS));
     }
-    LOGI("WebGL uniform4iv end");
     return nullptr;
 }
 
@@ -1318,33 +1237,27 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix2fv(napi_env env, napi_c
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniformMatrix2fv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv location = %{public}d", location);
     bool transpose = false;
     tie(succ, transpose) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv succ = %{public}u", succ);
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv transpose = %{public}u", transpose);
     napi_value uniformarray = funcArg[NARG_POS::THIRD];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
         float* a = nullptr;
-        LOGI("WebGL uniformMatrix2fv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv count = %{public}u", count);
         float uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -1358,18 +1271,16 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix2fv(napi_env env, napi_c
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv ele = %{public}f", (float)ele);
             uniformfv[i] = (float)ele;
         }
         a = uniformfv;
-        glUniformMatrix2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(a));
-        LOGI("WebGL uniformMatrix2fv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniformMatrix2fv>(a, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / MAT2_COMPONENTS),
+            static_cast<GLboolean>(transpose));
         return nullptr;
     }
     bool isTypedarray = false;
     tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv isTypedarray = %{public}u", isTypedarray);
     if (!isTypedarray || !succ) {
         return nullptr;
     }
@@ -1381,15 +1292,12 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix2fv(napi_env env, napi_c
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv count = %{public}u", count);
     if (type == napi_float32_array) {
         float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv aint32 = %{public}u", inputFloat32);
-        glUniformMatrix2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(inputFloat32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniformMatrix2fv>(inputFloat32, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / MAT2_COMPONENTS),
+            static_cast<GLboolean>(transpose));
     }
-    LOGI("WebGL uniformMatrix2fv end");
     return nullptr;
 }
 
@@ -1404,32 +1312,27 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix3fv(napi_env env, napi_c
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniformMatrix3fv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv location = %{public}d", location);
     bool transpose = false;
     tie(succ, transpose) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv transpose = %{public}u", transpose);
     napi_value uniformarray = funcArg[NARG_POS::THIRD];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
         float* a = nullptr;
-        LOGI("WebGL uniformMatrix3fv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv count = %{public}u", count);
         float uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -1443,13 +1346,12 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix3fv(napi_env env, napi_c
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv ele = %{public}f", (float)ele);
             uniformfv[i] = (float)ele;
         }
         a = uniformfv;
-        glUniformMatrix3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose),  static_cast<GLfloat*>(a));
-        LOGI("WebGL uniformMatrix3fv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniformMatrix3fv>(a, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / MAT3_COMPONENTS),
+            static_cast<GLboolean>(transpose));
         return nullptr;
     }
     void *value = nullptr;
@@ -1460,15 +1362,12 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix3fv(napi_env env, napi_c
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv count = %{public}u", count);
     if (type == napi_float32_array) {
         float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv aint32 = %{public}u", inputFloat32);
-        glUniformMatrix3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(inputFloat32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniformMatrix3fv>(inputFloat32, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / MAT3_COMPONENTS),
+            static_cast<GLboolean>(transpose));
     }
-    LOGI("WebGL uniformMatrix3fv end");
     return nullptr;
 }
 
@@ -1482,32 +1381,27 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix4fv(napi_env env, napi_c
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniformMatrix4fv start");
     WebGLUniformLocation *webGLUniformLocation = nullptr;
     napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
     if (uniformlocationStatus != napi_ok) {
         return nullptr;
     }
     int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix4fv location = %{public}u", location);
     bool transpose = false;
     tie(succ, transpose) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix4fv transpose = %{public}u", transpose);
     napi_value uniformarray = funcArg[NARG_POS::THIRD];
     bool isUniformArray = false;
     tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
     if (isUniformArray) {
         float* a = nullptr;
-        LOGI("WebGL glUniformMatrix4fv is isUniformArray");
         uint32_t count;
         napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
         if (countStatus != napi_ok) {
             return nullptr;
         }
-        LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv count = %{public}u", count);
         float uniformfv[count];
         uint32_t i;
         for (i = 0; i < count; i++) {
@@ -1521,13 +1415,12 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix4fv(napi_env env, napi_c
             if (doubleStatus != napi_ok) {
                 return nullptr;
             }
-            LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv ele = %{public}f", (float)ele);
             uniformfv[i] = (float)ele;
         }
         a = uniformfv;
-        glUniformMatrix4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(a));
-        LOGI("WebGL glUniformMatrix4fv uniformarray end");
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniformMatrix4fv>(a, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / MAT4_COMPONENTS),
+            static_cast<GLboolean>(transpose));
         return nullptr;
     }
     void *value = nullptr;
@@ -1538,15 +1431,12 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix4fv(napi_env env, napi_c
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv count = %{public}u", count);
     if (type == napi_float32_array) {
         float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix4fv aint32 = %{public}u", inputFloat32);
-        glUniformMatrix4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(inputFloat32));
+        WebGLCommandBuffer::GetInstance().RecordArray<glUniformMatrix4fv>(inputFloat32, count * sizeof(GLfloat),
+            static_cast<GLint>(location), static_cast<GLsizei>(count / MAT4_COMPONENTS),
+            static_cast<GLboolean>(transpose));
     }
-    LOGI("WebGL uniformMatrix4fv end");
     return nullptr;
 }
 } // namespace Rosen
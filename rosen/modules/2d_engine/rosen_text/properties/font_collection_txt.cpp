@@ -26,10 +26,16 @@
 
 #include "engine_adapter/skia_adapter/skia_canvas.h"
 #include "rosen_text/properties/rosen_converter_txt.h"
+#include "rosen_text/properties/system_font_index.h"
+#include "rosen_text/properties/typography_cache.h"
 #include "rosen_text/properties/typography_txt.h"
 
 namespace rosen {
-FontCollectionTxt::FontCollectionTxt()
+namespace {
+std::atomic<uint64_t> g_nextGeneration { 1 };
+}
+
+FontCollectionTxt::FontCollectionTxt() : generation_(g_nextGeneration++)
 {
     SkGraphics::Init();
     fml::icu::InitializeICU("/system/usr/ohos_icu/icudt67l.dat"); // position of icu
@@ -38,7 +44,11 @@ FontCollectionTxt::FontCollectionTxt()
 
     dynamicFontManager = sk_make_sp<txt::DynamicFontManager>();
     txtCollection->SetDynamicFontManager(dynamicFontManager);
-    LoadSystemFont();
+    // scanning and loading every system font costs each process tens of milliseconds at its first text, the index
+    // built once and shared by all processes only loads the fonts the text actually uses
+    if (!LoadSystemFontIndex()) {
+        LoadSystemFont();
+    }
 }
 
 FontCollectionTxt::~FontCollectionTxt()
@@ -52,6 +62,28 @@ std::shared_ptr<txt::FontCollection> FontCollectionTxt::GetFontCollection() cons
     return txtCollection;
 }
 
+uint64_t FontCollectionTxt::GetGeneration() const
+{
+    return generation_.load();
+}
+
+sk_sp<IndexedFontManager> FontCollectionTxt::GetIndexedFontManager() const
+{
+    return indexedFontManager;
+}
+
+bool FontCollectionTxt::LoadSystemFontIndex()
+{
+    auto index = std::make_shared<SystemFontIndex>();
+    if (!index->Load({ SystemFontIndex::SYSTEM_FONT_DIR }, SystemFontIndex::CACHE_PATH)) {
+        return false;
+    }
+    indexedFontManager = sk_make_sp<IndexedFontManager>(index,
+        IndexedFontManager::LoadFallbackConfig(IndexedFontManager::FONT_CONFIG_PATH));
+    txtCollection->SetAssetFontManager(indexedFontManager);
+    return true;
+}
+
 void FontCollectionTxt::LoadSystemFont()
 {
     txtCollection->LoadSystemFont();
@@ -80,5 +112,8 @@ void FontCollectionTxt::LoadFontFromList(const uint8_t* font_data,
         font_provider.RegisterTypeface(typeface, family_name);
     }
     txtCollection->ClearFontFamilyCache();
+    // paragraphs shaped before may resolve to other fonts now
+    generation_ = g_nextGeneration++;
+    TypographyCache::Instance().Clear();
 }
 } // namespace rosen
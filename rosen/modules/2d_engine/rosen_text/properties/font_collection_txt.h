@@ -16,10 +16,12 @@
 #ifndef ROSEN_TEXT_PROPERTIES_FONT_COLLECTION_TXT_H_
 #define ROSEN_TEXT_PROPERTIES_FONT_COLLECTION_TXT_H_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 #include "rosen_text/properties/font_collection_txt_base.h"
+#include "rosen_text/properties/indexed_font_manager.h"
 #include "txt/asset_font_manager.h"
 #include "txt/font_collection.h"
 
@@ -30,6 +32,8 @@ public:
 
     ~FontCollectionTxt();
     std::shared_ptr<txt::FontCollection> GetFontCollection() const;
+    // process wide unique value, renewed whenever fonts are added to the collection
+    uint64_t GetGeneration() const;
 
     void RegisterTestFonts() override;
 
@@ -37,9 +41,15 @@ public:
                           int length,
                           std::string family_name) override;
     void LoadSystemFont() override;
+    // nullptr when the system fonts were loaded by LoadSystemFont() instead of from the index
+    sk_sp<IndexedFontManager> GetIndexedFontManager() const;
 private:
+    bool LoadSystemFontIndex();
+
     std::shared_ptr<txt::FontCollection> txtCollection;
     sk_sp<txt::DynamicFontManager> dynamicFontManager;
+    sk_sp<IndexedFontManager> indexedFontManager;
+    std::atomic<uint64_t> generation_;
     FontCollectionTxt(const FontCollectionTxt&) = delete;
     FontCollectionTxt& operator=(const FontCollectionTxt&) = delete;
 };
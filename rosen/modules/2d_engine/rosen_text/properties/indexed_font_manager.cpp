@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rosen_text/properties/indexed_font_manager.h"
+
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "cJSON.h"
+#include "third_party/flutter/skia/include/core/SkFontStyle.h"
+#include "third_party/flutter/skia/include/core/SkString.h"
+#include "third_party/flutter/skia/include/core/SkTypeface.h"
+#include "txt/font_asset_provider.h"
+
+namespace rosen {
+namespace {
+constexpr int SLANT_MISMATCH_PENALTY = 10000;
+constexpr int WIDTH_MISMATCH_PENALTY = 100;
+
+enum LanguageMatch {
+    LANGUAGE_MATCH_NONE,
+    LANGUAGE_MATCH_PRIMARY, // same primary language, e.g. zh-Hant for zh-CN
+    LANGUAGE_MATCH_PREFIX,  // equal or one refines the other, e.g. zh-Hans for zh-Hans-CN
+};
+
+SkFontStyle GetFontStyle(const SystemFontIndex& index, size_t font)
+{
+    return SkFontStyle(index.GetWeight(font), index.GetWidth(font),
+        index.IsItalic(font) ? SkFontStyle::kItalic_Slant : SkFontStyle::kUpright_Slant);
+}
+
+int StyleDistance(const SkFontStyle& a, const SkFontStyle& b)
+{
+    bool aUpright = a.slant() == SkFontStyle::kUpright_Slant;
+    bool bUpright = b.slant() == SkFontStyle::kUpright_Slant;
+    return (aUpright == bUpright ? 0 : SLANT_MISMATCH_PENALTY) +
+        std::abs(a.width() - b.width()) * WIDTH_MISMATCH_PENALTY + std::abs(a.weight() - b.weight());
+}
+
+std::string ToLower(const std::string& text)
+{
+    std::string lower = text;
+    for (auto& c : lower) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return lower;
+}
+
+std::string GetPrimaryLanguage(const std::string& tag)
+{
+    return tag.substr(0, tag.find('-'));
+}
+
+LanguageMatch MatchLanguage(const std::string& language, const std::string& tag)
+{
+    if (language.empty()) {
+        return LANGUAGE_MATCH_NONE;
+    }
+    std::string a = ToLower(language);
+    std::string b = ToLower(tag);
+    const std::string& shorter = a.size() < b.size() ? a : b;
+    const std::string& longer = a.size() < b.size() ? b : a;
+    if (longer.compare(0, shorter.size(), shorter) == 0 &&
+        (longer.size() == shorter.size() || longer[shorter.size()] == '-')) {
+        return LANGUAGE_MATCH_PREFIX;
+    }
+    return GetPrimaryLanguage(a) == GetPrimaryLanguage(b) ? LANGUAGE_MATCH_PRIMARY : LANGUAGE_MATCH_NONE;
+}
+
+// [ { "<bcp47>": "<family>" }, ... ]
+void AppendFallbackFamilies(const cJSON* familyList, std::vector<FontFallbackEntry>& fallbacks)
+{
+    const cJSON* entry = nullptr;
+    cJSON_ArrayForEach(entry, familyList) {
+        const cJSON* family = nullptr;
+        cJSON_ArrayForEach(family, entry) {
+            if (cJSON_IsString(family) && family->string != nullptr && family->valuestring != nullptr) {
+                fallbacks.push_back({ family->string, family->valuestring });
+            }
+        }
+    }
+}
+
+class IndexedFontStyleSet : public SkFontStyleSet {
+public:
+    IndexedFontStyleSet(std::shared_ptr<IndexedTypefaces> typefaces, std::vector<size_t> fonts)
+        : typefaces_(std::move(typefaces)), fonts_(std::move(fonts)) {}
+    ~IndexedFontStyleSet() override = default;
+
+    int count() override
+    {
+        return static_cast<int>(fonts_.size());
+    }
+
+    void getStyle(int index, SkFontStyle* style, SkString* name) override
+    {
+        if (index < 0 || index >= count()) {
+            return;
+        }
+        if (style != nullptr) {
+            *style = GetFontStyle(typefaces_->GetIndex(), fonts_[index]);
+        }
+        if (name != nullptr) {
+            name->reset();
+        }
+    }
+
+    SkTypeface* createTypeface(int index) override
+    {
+        if (index < 0 || index >= count()) {
+            return nullptr;
+        }
+        return typefaces_->GetTypeface(fonts_[index]).release();
+    }
+
+    SkTypeface* matchStyle(const SkFontStyle& pattern) override
+    {
+        return matchStyleCSS3(pattern);
+    }
+
+private:
+    std::shared_ptr<IndexedTypefaces> typefaces_;
+    std::vector<size_t> fonts_;
+};
+
+class IndexedFontAssetProvider : public txt::FontAssetProvider {
+public:
+    explicit IndexedFontAssetProvider(std::shared_ptr<IndexedTypefaces> typefaces)
+        : typefaces_(std::move(typefaces)), families_(typefaces_->GetIndex().GetFamilies()) {}
+    ~IndexedFontAssetProvider() override = default;
+
+    size_t GetFamilyCount() const override
+    {
+        return families_.size();
+    }
+
+    std::string GetFamilyName(int index) const override
+    {
+        return index >= 0 && static_cast<size_t>(index) < families_.size() ? families_[index] : "";
+    }
+
+    SkFontStyleSet* MatchFamily(const std::string& familyName) override
+    {
+        std::vector<size_t> fonts = typefaces_->GetIndex().FindFamily(familyName);
+        if (fonts.empty()) {
+            return nullptr;
+        }
+        return new IndexedFontStyleSet(typefaces_, std::move(fonts));
+    }
+
+private:
+    std::shared_ptr<IndexedTypefaces> typefaces_;
+    std::vector<std::string> families_;
+};
+}
+
+IndexedTypefaces::IndexedTypefaces(std::shared_ptr<const SystemFontIndex> index)
+    : index_(std::move(index)), typefaces_(index_->GetFontCount()) {}
+
+sk_sp<SkTypeface> IndexedTypefaces::GetTypeface(size_t font)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (font >= typefaces_.size()) {
+        return nullptr;
+    }
+    if (typefaces_[font] == nullptr) {
+        // skia maps the font file instead of reading it
+        typefaces_[font] = SkTypeface::MakeFromFile(index_->GetPath(font), index_->GetTtcIndex(font));
+    }
+    return typefaces_[font];
+}
+
+size_t IndexedTypefaces::GetMaterializedCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (auto& typeface : typefaces_) {
+        count += typeface != nullptr ? 1 : 0;
+    }
+    return count;
+}
+
+IndexedFontManager::IndexedFontManager(std::shared_ptr<const SystemFontIndex> index,
+    std::vector<FontFallbackEntry> fallbacks)
+    : IndexedFontManager(std::make_shared<IndexedTypefaces>(std::move(index)), std::move(fallbacks)) {}
+
+IndexedFontManager::IndexedFontManager(std::shared_ptr<IndexedTypefaces> typefaces,
+    std::vector<FontFallbackEntry> fallbacks)
+    : txt::AssetFontManager(std::make_unique<IndexedFontAssetProvider>(typefaces)), typefaces_(typefaces)
+{
+    for (auto& fallback : fallbacks) {
+        std::vector<size_t> fonts = typefaces_->GetIndex().FindFamily(fallback.family);
+        if (!fonts.empty()) {
+            fallbacks_.push_back({ std::move(fallback.language), std::move(fonts) });
+        }
+    }
+}
+
+std::vector<FontFallbackEntry> IndexedFontManager::ParseFallbackConfig(const std::string& config)
+{
+    std::vector<FontFallbackEntry> fallbacks;
+    cJSON* root = cJSON_Parse(config.c_str());
+    if (root == nullptr) {
+        return fallbacks;
+    }
+    // "fallback": [ { "<fallback set>": [ { "<bcp47>": "<family>" }, ... ] }, ... ]
+    const cJSON* fallbackSet = nullptr;
+    cJSON_ArrayForEach(fallbackSet, cJSON_GetObjectItem(root, "fallback")) {
+        const cJSON* familyList = nullptr;
+        cJSON_ArrayForEach(familyList, fallbackSet) {
+            AppendFallbackFamilies(familyList, fallbacks);
+        }
+    }
+    cJSON_Delete(root);
+    return fallbacks;
+}
+
+std::vector<FontFallbackEntry> IndexedFontManager::LoadFallbackConfig(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return {};
+    }
+    std::stringstream config;
+    config << file.rdbuf();
+    return ParseFallbackConfig(config.str());
+}
+
+size_t IndexedFontManager::MatchStyle(const std::vector<size_t>& fonts, const SkFontStyle& style,
+    SkUnichar character) const
+{
+    const SystemFontIndex& index = typefaces_->GetIndex();
+    size_t best = index.GetFontCount();
+    int bestDistance = INT_MAX;
+    for (size_t font : fonts) {
+        if (!index.HasCharacter(font, static_cast<uint32_t>(character))) {
+            continue;
+        }
+        int distance = StyleDistance(style, GetFontStyle(index, font));
+        if (distance < bestDistance) {
+            best = font;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+size_t IndexedFontManager::MatchFallbackFont(const SkFontStyle& style, const char* bcp47[], int bcp47Count,
+    SkUnichar character) const
+{
+    const SystemFontIndex& index = typefaces_->GetIndex();
+    const size_t none = index.GetFontCount();
+    // skia orders the languages from the least to the most significant one
+    for (int i = bcp47Count - 1; i >= 0 && bcp47 != nullptr; i--) {
+        if (bcp47[i] == nullptr) {
+            continue;
+        }
+        for (auto level : { LANGUAGE_MATCH_PREFIX, LANGUAGE_MATCH_PRIMARY }) {
+            for (auto& fallback : fallbacks_) {
+                size_t font = MatchLanguage(fallback.language, bcp47[i]) == level ?
+                    MatchStyle(fallback.fonts, style, character) : none;
+                if (font != none) {
+                    return font;
+                }
+            }
+        }
+    }
+    for (auto& fallback : fallbacks_) {
+        size_t font = MatchStyle(fallback.fonts, style, character);
+        if (font != none) {
+            return font;
+        }
+    }
+    // characters the fallback list does not cover may still be in any other system font
+    std::vector<size_t> fonts(index.GetFontCount());
+    for (size_t font = 0; font < fonts.size(); font++) {
+        fonts[font] = font;
+    }
+    return MatchStyle(fonts, style, character);
+}
+
+SkTypeface* IndexedFontManager::onMatchFamilyStyleCharacter(const char familyName[], const SkFontStyle& style,
+    const char* bcp47[], int bcp47Count, SkUnichar character) const
+{
+    size_t font = MatchFallbackFont(style, bcp47, bcp47Count, character);
+    if (font == typefaces_->GetIndex().GetFontCount()) {
+        return nullptr;
+    }
+    return typefaces_->GetTypeface(font).release();
+}
+} // namespace rosen
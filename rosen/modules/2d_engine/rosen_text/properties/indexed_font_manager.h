@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSEN_TEXT_PROPERTIES_INDEXED_FONT_MANAGER_H_
+#define ROSEN_TEXT_PROPERTIES_INDEXED_FONT_MANAGER_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rosen_text/properties/system_font_index.h"
+#include "txt/asset_font_manager.h"
+
+namespace rosen {
+// Typefaces of a SystemFontIndex, created from their mapped font file the first time one is matched.
+class IndexedTypefaces final {
+public:
+    explicit IndexedTypefaces(std::shared_ptr<const SystemFontIndex> index);
+    ~IndexedTypefaces() = default;
+
+    const SystemFontIndex& GetIndex() const
+    {
+        return *index_;
+    }
+    sk_sp<SkTypeface> GetTypeface(size_t font);
+    size_t GetMaterializedCount() const;
+
+private:
+    std::shared_ptr<const SystemFontIndex> index_;
+    mutable std::mutex mutex_;
+    std::vector<sk_sp<SkTypeface>> typefaces_;
+};
+
+// one entry of the fallback list of the font config, the language is a bcp47 tag and empty for any language
+struct FontFallbackEntry {
+    std::string language;
+    std::string family;
+};
+
+// Font manager serving the system fonts from a SystemFontIndex. Families are matched by name. Fallback fonts are
+// searched in the configured fallback list first, the families for the requested languages before the others, and
+// only then by the character coverage of the whole index. Only the typefaces actually matched are ever loaded.
+class IndexedFontManager : public txt::AssetFontManager {
+public:
+    static constexpr const char* FONT_CONFIG_PATH = "/system/etc/fontconfig.json";
+
+    IndexedFontManager(std::shared_ptr<const SystemFontIndex> index, std::vector<FontFallbackEntry> fallbacks = {});
+    ~IndexedFontManager() override = default;
+
+    // the "fallback" section of a font config in file order, empty if there is none
+    static std::vector<FontFallbackEntry> ParseFallbackConfig(const std::string& config);
+    static std::vector<FontFallbackEntry> LoadFallbackConfig(const std::string& path);
+
+    // the font of the index matchFamilyStyleCharacter() returns, GetFontCount() of the index if none has character
+    size_t MatchFallbackFont(const SkFontStyle& style, const char* bcp47[], int bcp47Count,
+        SkUnichar character) const;
+
+    size_t GetMaterializedCount() const
+    {
+        return typefaces_->GetMaterializedCount();
+    }
+
+private:
+    struct FallbackFamily {
+        std::string language;
+        std::vector<size_t> fonts;
+    };
+
+    IndexedFontManager(std::shared_ptr<IndexedTypefaces> typefaces, std::vector<FontFallbackEntry> fallbacks);
+
+    // the font closest to style among fonts having character, GetFontCount() of the index if none has it
+    size_t MatchStyle(const std::vector<size_t>& fonts, const SkFontStyle& style, SkUnichar character) const;
+
+    // |SkFontMgr|
+    SkTypeface* onMatchFamilyStyleCharacter(const char familyName[], const SkFontStyle& style, const char* bcp47[],
+        int bcp47Count, SkUnichar character) const override;
+
+    std::shared_ptr<IndexedTypefaces> typefaces_;
+    std::vector<FallbackFamily> fallbacks_;
+};
+} // namespace rosen
+#endif // ROSEN_TEXT_PROPERTIES_INDEXED_FONT_MANAGER_H_
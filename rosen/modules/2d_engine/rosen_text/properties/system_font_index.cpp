@@ -0,0 +1,758 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rosen_text/properties/system_font_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rosen {
+namespace {
+constexpr uint32_t INDEX_MAGIC = 0x52464958; // "RFIX"
+constexpr uint32_t INDEX_VERSION = 1;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+constexpr uint32_t MAX_CODE_POINT = 0x10FFFF;
+
+constexpr uint32_t TAG_TTCF = 0x74746366; // "ttcf"
+constexpr uint32_t TAG_NAME = 0x6e616d65; // "name"
+constexpr uint32_t TAG_OS2 = 0x4f532f32;  // "OS/2"
+constexpr uint32_t TAG_CMAP = 0x636d6170; // "cmap"
+constexpr uint32_t TAG_HEAD = 0x68656164; // "head"
+constexpr size_t OFFSET_TABLE_SIZE = 12;
+constexpr size_t TABLE_RECORD_SIZE = 16;
+constexpr size_t NAME_RECORD_SIZE = 12;
+constexpr size_t CMAP_RECORD_SIZE = 8;
+constexpr size_t CMAP_GROUP_SIZE = 12;
+constexpr uint16_t NAME_ID_FAMILY = 1;
+constexpr uint16_t PLATFORM_UNICODE = 0;
+constexpr uint16_t PLATFORM_MAC = 1;
+constexpr uint16_t PLATFORM_WINDOWS = 3;
+constexpr uint16_t LANGUAGE_EN_US = 0x409;
+constexpr uint16_t ENCODING_WINDOWS_UCS4 = 10;
+constexpr uint16_t OS2_WEIGHT_OFFSET = 4;
+constexpr uint16_t OS2_WIDTH_OFFSET = 6;
+constexpr uint16_t OS2_SELECTION_OFFSET = 62;
+constexpr uint16_t OS2_SELECTION_ITALIC = 0x1;
+constexpr uint16_t OS2_SELECTION_OBLIQUE = 0x200;
+constexpr uint16_t HEAD_MAC_STYLE_OFFSET = 44;
+constexpr uint16_t HEAD_MAC_STYLE_BOLD = 0x1;
+constexpr uint16_t HEAD_MAC_STYLE_ITALIC = 0x2;
+constexpr uint16_t WEIGHT_BOLD = 700;
+
+bool ReadU16(const uint8_t* data, size_t size, size_t offset, uint16_t& value)
+{
+    if (offset > size || size - offset < sizeof(uint16_t)) {
+        return false;
+    }
+    value = static_cast<uint16_t>((data[offset] << 8) | data[offset + 1]); // big endian
+    return true;
+}
+
+bool ReadU32(const uint8_t* data, size_t size, size_t offset, uint32_t& value)
+{
+    uint16_t high = 0;
+    uint16_t low = 0;
+    if (!ReadU16(data, size, offset, high) || !ReadU16(data, size, offset + sizeof(uint16_t), low)) {
+        return false;
+    }
+    value = (static_cast<uint32_t>(high) << 16) | low; // big endian
+    return true;
+}
+
+struct TableSpan {
+    size_t offset = 0;
+    size_t length = 0;
+};
+
+bool FindTable(const uint8_t* data, size_t size, size_t fontOffset, uint32_t tag, TableSpan& table)
+{
+    uint16_t numTables = 0;
+    if (!ReadU16(data, size, fontOffset + sizeof(uint32_t), numTables)) {
+        return false;
+    }
+    for (uint16_t i = 0; i < numTables; i++) {
+        size_t record = fontOffset + OFFSET_TABLE_SIZE + i * TABLE_RECORD_SIZE;
+        uint32_t recordTag = 0;
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        if (!ReadU32(data, size, record, recordTag) ||
+            !ReadU32(data, size, record + 8, offset) || !ReadU32(data, size, record + 12, length)) { // 8, 12: fields
+            return false;
+        }
+        if (recordTag != tag) {
+            continue;
+        }
+        if (offset > size || size - offset < length) {
+            return false;
+        }
+        table = { offset, length };
+        return true;
+    }
+    return false;
+}
+
+void AppendUtf8(std::string& out, uint32_t codePoint)
+{
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+std::string DecodeUtf16Be(const uint8_t* data, size_t length)
+{
+    std::string out;
+    for (size_t i = 0; i + 1 < length; i += sizeof(uint16_t)) {
+        uint32_t unit = (data[i] << 8) | data[i + 1];
+        if (unit >= 0xD800 && unit < 0xDC00 && i + 3 < length) {
+            uint32_t low = (data[i + 2] << 8) | data[i + 3];
+            if (low >= 0xDC00 && low < 0xE000) {
+                unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                i += sizeof(uint16_t);
+            }
+        }
+        AppendUtf8(out, unit);
+    }
+    return out;
+}
+
+bool ParseFamilyName(const uint8_t* data, const TableSpan& table, std::string& family)
+{
+    const uint8_t* name = data + table.offset;
+    uint16_t count = 0;
+    uint16_t stringOffset = 0;
+    if (!ReadU16(name, table.length, 2, count) || !ReadU16(name, table.length, 4, stringOffset)) { // 2, 4: fields
+        return false;
+    }
+    int bestScore = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        size_t record = 6 + i * NAME_RECORD_SIZE; // 6: size of the name table header
+        uint16_t platform = 0;
+        uint16_t language = 0;
+        uint16_t nameId = 0;
+        uint16_t length = 0;
+        uint16_t offset = 0;
+        if (!ReadU16(name, table.length, record, platform) || !ReadU16(name, table.length, record + 4, language) ||
+            !ReadU16(name, table.length, record + 6, nameId) || !ReadU16(name, table.length, record + 8, length) ||
+            !ReadU16(name, table.length, record + 10, offset)) { // 4, 6, 8, 10: fields of a name record
+            return !family.empty();
+        }
+        if (nameId != NAME_ID_FAMILY) {
+            continue;
+        }
+        int score = 0;
+        if (platform == PLATFORM_WINDOWS) {
+            score = language == LANGUAGE_EN_US ? 3 : 2; // 3: english windows names first
+        } else if (platform == PLATFORM_UNICODE) {
+            score = 2; // 2: as good as other windows names
+        } else if (platform == PLATFORM_MAC) {
+            score = 1;
+        }
+        size_t begin = static_cast<size_t>(stringOffset) + offset;
+        if (score <= bestScore || begin > table.length || table.length - begin < length) {
+            continue;
+        }
+        const uint8_t* string = name + begin;
+        if (platform == PLATFORM_MAC) {
+            family.clear();
+            for (uint16_t c = 0; c < length; c++) {
+                family.push_back(string[c] < 0x80 ? static_cast<char>(string[c]) : '?');
+            }
+        } else {
+            family = DecodeUtf16Be(string, length);
+        }
+        bestScore = score;
+    }
+    return !family.empty();
+}
+
+void AddRange(std::vector<FontIndexRange>& ranges, uint32_t first, uint32_t last)
+{
+    if (first > last || first > MAX_CODE_POINT) {
+        return;
+    }
+    last = std::min(last, MAX_CODE_POINT);
+    if (!ranges.empty() && first <= ranges.back().last + 1 && first >= ranges.back().first) {
+        ranges.back().last = std::max(ranges.back().last, last);
+        return;
+    }
+    ranges.push_back({ first, last });
+}
+
+void NormalizeRanges(std::vector<FontIndexRange>& ranges)
+{
+    std::sort(ranges.begin(), ranges.end(), [](const FontIndexRange& a, const FontIndexRange& b) {
+        return a.first < b.first;
+    });
+    std::vector<FontIndexRange> merged;
+    for (auto& range : ranges) {
+        AddRange(merged, range.first, range.last);
+    }
+    ranges.swap(merged);
+}
+
+bool ParseCmapFormat4(const uint8_t* cmap, size_t size, std::vector<FontIndexRange>& ranges)
+{
+    uint16_t segCountX2 = 0;
+    if (!ReadU16(cmap, size, 6, segCountX2)) { // 6: offset of segCountX2
+        return false;
+    }
+    size_t endCodes = 14; // 14: size of the format 4 header
+    size_t startCodes = endCodes + segCountX2 + sizeof(uint16_t);
+    size_t idDeltas = startCodes + segCountX2;
+    size_t idRangeOffsets = idDeltas + segCountX2;
+    for (size_t seg = 0; seg < segCountX2 / sizeof(uint16_t); seg++) {
+        size_t field = seg * sizeof(uint16_t);
+        uint16_t end = 0;
+        uint16_t start = 0;
+        uint16_t delta = 0;
+        uint16_t rangeOffset = 0;
+        if (!ReadU16(cmap, size, endCodes + field, end) || !ReadU16(cmap, size, startCodes + field, start) ||
+            !ReadU16(cmap, size, idDeltas + field, delta) ||
+            !ReadU16(cmap, size, idRangeOffsets + field, rangeOffset)) {
+            return false;
+        }
+        if (start > end || start == 0xFFFF) {
+            continue;
+        }
+        if (rangeOffset == 0) {
+            // every code point maps to (code point + delta), only the one wrapping to glyph 0 is missing
+            uint32_t missing = static_cast<uint16_t>(0x10000 - delta);
+            if (missing < start || missing > end) {
+                AddRange(ranges, start, end);
+            } else {
+                AddRange(ranges, start, missing - 1);
+                AddRange(ranges, missing + 1, end);
+            }
+            continue;
+        }
+        for (uint32_t code = start; code <= end; code++) {
+            uint16_t glyph = 0;
+            size_t glyphOffset = idRangeOffsets + field + rangeOffset + (code - start) * sizeof(uint16_t);
+            if (ReadU16(cmap, size, glyphOffset, glyph) && glyph != 0 && static_cast<uint16_t>(glyph + delta) != 0) {
+                AddRange(ranges, code, code);
+            }
+        }
+    }
+    return true;
+}
+
+bool ParseCmapFormat12(const uint8_t* cmap, size_t size, std::vector<FontIndexRange>& ranges)
+{
+    uint32_t numGroups = 0;
+    if (!ReadU32(cmap, size, 12, numGroups)) { // 12: offset of numGroups
+        return false;
+    }
+    for (uint32_t i = 0; i < numGroups; i++) {
+        size_t group = 16 + static_cast<size_t>(i) * CMAP_GROUP_SIZE; // 16: size of the format 12 header
+        uint32_t first = 0;
+        uint32_t last = 0;
+        if (!ReadU32(cmap, size, group, first) || !ReadU32(cmap, size, group + sizeof(uint32_t), last)) {
+            return false;
+        }
+        AddRange(ranges, first, last);
+    }
+    return true;
+}
+
+bool ParseCoverage(const uint8_t* data, const TableSpan& table, std::vector<FontIndexRange>& ranges)
+{
+    const uint8_t* cmap = data + table.offset;
+    uint16_t numTables = 0;
+    if (!ReadU16(cmap, table.length, 2, numTables)) { // 2: offset of numTables
+        return false;
+    }
+    // a full unicode (format 12) subtable is preferred over a BMP only (format 4) one
+    size_t bestOffset = 0;
+    uint16_t bestFormat = 0;
+    for (uint16_t i = 0; i < numTables; i++) {
+        size_t record = 4 + i * CMAP_RECORD_SIZE; // 4: size of the cmap header
+        uint16_t platform = 0;
+        uint16_t encoding = 0;
+        uint32_t offset = 0;
+        uint16_t format = 0;
+        if (!ReadU16(cmap, table.length, record, platform) || !ReadU16(cmap, table.length, record + 2, encoding) ||
+            !ReadU32(cmap, table.length, record + 4, offset) || !ReadU16(cmap, table.length, offset, format)) {
+            continue;
+        }
+        bool unicode = platform == PLATFORM_UNICODE || (platform == PLATFORM_WINDOWS &&
+            (encoding <= 1 || encoding == ENCODING_WINDOWS_UCS4));
+        if (!unicode || (format != 4 && format != 12) || format <= bestFormat) { // 4, 12: supported formats
+            continue;
+        }
+        bestOffset = offset;
+        bestFormat = format;
+    }
+    if (bestFormat == 0) {
+        return false;
+    }
+    const uint8_t* subtable = cmap + bestOffset;
+    size_t subtableSize = table.length - bestOffset;
+    bool parsed = bestFormat == 12 ? ParseCmapFormat12(subtable, subtableSize, ranges) : // 12: format
+        ParseCmapFormat4(subtable, subtableSize, ranges);
+    NormalizeRanges(ranges);
+    return parsed && !ranges.empty();
+}
+
+bool ParseFace(const uint8_t* data, size_t size, size_t fontOffset, FontIndexFace& face)
+{
+    TableSpan name;
+    TableSpan cmap;
+    if (!FindTable(data, size, fontOffset, TAG_NAME, name) || !FindTable(data, size, fontOffset, TAG_CMAP, cmap)) {
+        return false;
+    }
+    if (!ParseFamilyName(data, name, face.family) || !ParseCoverage(data, cmap, face.coverage)) {
+        return false;
+    }
+    TableSpan os2;
+    TableSpan head;
+    uint16_t value = 0;
+    if (FindTable(data, size, fontOffset, TAG_OS2, os2)) {
+        const uint8_t* table = data + os2.offset;
+        if (ReadU16(table, os2.length, OS2_WEIGHT_OFFSET, value) && value != 0) {
+            face.weight = value;
+        }
+        if (ReadU16(table, os2.length, OS2_WIDTH_OFFSET, value) && value != 0) {
+            face.width = value;
+        }
+        if (ReadU16(table, os2.length, OS2_SELECTION_OFFSET, value)) {
+            face.italic = (value & (OS2_SELECTION_ITALIC | OS2_SELECTION_OBLIQUE)) != 0;
+        }
+    } else if (FindTable(data, size, fontOffset, TAG_HEAD, head) &&
+        ReadU16(data + head.offset, head.length, HEAD_MAC_STYLE_OFFSET, value)) {
+        face.weight = (value & HEAD_MAC_STYLE_BOLD) ? WEIGHT_BOLD : face.weight;
+        face.italic = (value & HEAD_MAC_STYLE_ITALIC) != 0;
+    }
+    return true;
+}
+
+bool HasFontExtension(const std::string& name)
+{
+    static const char* extensions[] = { ".ttf", ".otf", ".ttc", ".otc" };
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    std::string extension = name.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return std::find(std::begin(extensions), std::end(extensions), extension) != std::end(extensions);
+}
+
+void HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+}
+
+struct SystemFontIndex::Header {
+    uint32_t magic;
+    uint32_t version;
+    // hash of the path, size and modification time of the font files the index was built from
+    uint64_t stamp;
+    uint32_t fontCount;
+    uint32_t rangeCount;
+    uint32_t stringSize;
+    uint32_t reserved;
+};
+
+struct SystemFontIndex::Record {
+    uint32_t pathOffset;
+    uint32_t familyOffset;
+    uint32_t ttcIndex;
+    uint16_t weight;
+    uint16_t width;
+    uint32_t italic;
+    uint32_t rangeStart;
+    uint32_t rangeCount;
+    uint32_t reserved;
+};
+
+SystemFontIndex::~SystemFontIndex()
+{
+    Reset();
+}
+
+bool SystemFontIndex::Load(const std::vector<std::string>& fontDirs, const std::string& cachePath)
+{
+    Reset();
+    std::vector<std::string> files = ListFontFiles(fontDirs);
+    if (files.empty()) {
+        return false;
+    }
+    uint64_t stamp = ComputeStamp(files);
+    if (!cachePath.empty() && MapCacheFile(cachePath, stamp)) {
+        return GetFontCount() > 0;
+    }
+
+    std::vector<FontIndexFace> faces;
+    for (auto& file : files) {
+        int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        struct stat st = {};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            // only the pages of the table directory, name, OS/2 and cmap tables are read
+            void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                ParseFontData(static_cast<const uint8_t*>(data), st.st_size, file, faces);
+                munmap(data, st.st_size);
+            }
+        }
+        close(fd);
+    }
+    ownedData_ = Serialize(faces, stamp);
+    if (!Attach(ownedData_.data(), ownedData_.size(), stamp)) {
+        Reset();
+        return false;
+    }
+    if (!cachePath.empty()) {
+        WriteCacheFile(cachePath, ownedData_);
+    }
+    return GetFontCount() > 0;
+}
+
+size_t SystemFontIndex::GetFontCount() const
+{
+    return header_ == nullptr ? 0 : header_->fontCount;
+}
+
+const char* SystemFontIndex::GetPath(size_t font) const
+{
+    const Record* record = GetRecord(font);
+    return record == nullptr ? "" : GetString(record->pathOffset);
+}
+
+const char* SystemFontIndex::GetFamily(size_t font) const
+{
+    const Record* record = GetRecord(font);
+    return record == nullptr ? "" : GetString(record->familyOffset);
+}
+
+uint32_t SystemFontIndex::GetTtcIndex(size_t font) const
+{
+    const Record* record = GetRecord(font);
+    return record == nullptr ? 0 : record->ttcIndex;
+}
+
+uint16_t SystemFontIndex::GetWeight(size_t font) const
+{
+    const Record* record = GetRecord(font);
+    return record == nullptr ? 0 : record->weight;
+}
+
+uint16_t SystemFontIndex::GetWidth(size_t font) const
+{
+    const Record* record = GetRecord(font);
+    return record == nullptr ? 0 : record->width;
+}
+
+bool SystemFontIndex::IsItalic(size_t font) const
+{
+    const Record* record = GetRecord(font);
+    return record != nullptr && record->italic != 0;
+}
+
+bool SystemFontIndex::HasCharacter(size_t font, uint32_t codePoint) const
+{
+    const Record* record = GetRecord(font);
+    if (record == nullptr || record->rangeCount == 0) {
+        return false;
+    }
+    const FontIndexRange* begin = ranges_ + record->rangeStart;
+    const FontIndexRange* end = begin + record->rangeCount;
+    // the first range that ends at or after the code point
+    const FontIndexRange* range = std::lower_bound(begin, end, codePoint,
+        [](const FontIndexRange& r, uint32_t value) { return r.last < value; });
+    return range != end && range->first <= codePoint;
+}
+
+std::vector<std::string> SystemFontIndex::GetFamilies() const
+{
+    std::vector<std::string> families;
+    for (size_t font = 0; font < GetFontCount(); font++) {
+        std::string family = GetFamily(font);
+        if (std::find(families.begin(), families.end(), family) == families.end()) {
+            families.push_back(family);
+        }
+    }
+    return families;
+}
+
+std::vector<size_t> SystemFontIndex::FindFamily(const std::string& family) const
+{
+    std::vector<size_t> fonts;
+    for (size_t font = 0; font < GetFontCount(); font++) {
+        if (strcasecmp(GetFamily(font), family.c_str()) == 0) {
+            fonts.push_back(font);
+        }
+    }
+    return fonts;
+}
+
+bool SystemFontIndex::ParseFontData(const uint8_t* data, size_t size, const std::string& path,
+    std::vector<FontIndexFace>& faces)
+{
+    uint32_t tag = 0;
+    if (data == nullptr || !ReadU32(data, size, 0, tag)) {
+        return false;
+    }
+    std::vector<uint32_t> fontOffsets;
+    if (tag == TAG_TTCF) {
+        uint32_t numFonts = 0;
+        if (!ReadU32(data, size, 8, numFonts)) { // 8: offset of numFonts
+            return false;
+        }
+        for (uint32_t i = 0; i < numFonts; i++) {
+            uint32_t offset = 0;
+            if (!ReadU32(data, size, 12 + i * sizeof(uint32_t), offset)) { // 12: offset of the font offsets
+                return false;
+            }
+            fontOffsets.push_back(offset);
+        }
+    } else {
+        fontOffsets.push_back(0);
+    }
+
+    bool parsed = false;
+    for (uint32_t i = 0; i < fontOffsets.size(); i++) {
+        FontIndexFace face;
+        face.path = path;
+        face.ttcIndex = i;
+        if (ParseFace(data, size, fontOffsets[i], face)) {
+            faces.push_back(std::move(face));
+            parsed = true;
+        }
+    }
+    return parsed;
+}
+
+uint64_t SystemFontIndex::ComputeStamp(const std::vector<std::string>& files)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    HashBytes(hash, &INDEX_VERSION, sizeof(INDEX_VERSION));
+    for (auto& file : files) {
+        struct stat st = {};
+        if (stat(file.c_str(), &st) != 0) {
+            continue;
+        }
+        int64_t values[] = { static_cast<int64_t>(st.st_size), static_cast<int64_t>(st.st_mtim.tv_sec),
+            static_cast<int64_t>(st.st_mtim.tv_nsec) };
+        HashBytes(hash, file.data(), file.size() + 1);
+        HashBytes(hash, values, sizeof(values));
+    }
+    return hash;
+}
+
+std::vector<std::string> SystemFontIndex::ListFontFiles(const std::vector<std::string>& fontDirs)
+{
+    std::vector<std::string> files;
+    for (auto& dir : fontDirs) {
+        DIR* handle = opendir(dir.c_str());
+        if (handle == nullptr) {
+            continue;
+        }
+        struct dirent* entry = nullptr;
+        while ((entry = readdir(handle)) != nullptr) {
+            std::string name = entry->d_name;
+            if (entry->d_type != DT_DIR && HasFontExtension(name)) {
+                files.push_back(dir + "/" + name);
+            }
+        }
+        closedir(handle);
+    }
+    // readdir order differs between file systems, the stamp and the index must not
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::vector<uint8_t> SystemFontIndex::Serialize(const std::vector<FontIndexFace>& faces, uint64_t stamp)
+{
+    std::vector<Record> records;
+    std::vector<FontIndexRange> ranges;
+    std::string strings;
+    for (auto& face : faces) {
+        Record record = {};
+        record.pathOffset = static_cast<uint32_t>(strings.size());
+        strings.append(face.path).push_back('\0');
+        record.familyOffset = static_cast<uint32_t>(strings.size());
+        strings.append(face.family).push_back('\0');
+        record.ttcIndex = face.ttcIndex;
+        record.weight = face.weight;
+        record.width = face.width;
+        record.italic = face.italic ? 1 : 0;
+        record.rangeStart = static_cast<uint32_t>(ranges.size());
+        record.rangeCount = static_cast<uint32_t>(face.coverage.size());
+        ranges.insert(ranges.end(), face.coverage.begin(), face.coverage.end());
+        records.push_back(record);
+    }
+
+    Header header = {};
+    header.magic = INDEX_MAGIC;
+    header.version = INDEX_VERSION;
+    header.stamp = stamp;
+    header.fontCount = static_cast<uint32_t>(records.size());
+    header.rangeCount = static_cast<uint32_t>(ranges.size());
+    header.stringSize = static_cast<uint32_t>(strings.size());
+    size_t recordBytes = records.size() * sizeof(Record);
+    size_t rangeBytes = ranges.size() * sizeof(FontIndexRange);
+    std::vector<uint8_t> data(sizeof(Header) + recordBytes + rangeBytes + strings.size());
+    uint8_t* out = data.data();
+    memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header);
+    if (recordBytes > 0) {
+        memcpy(out, records.data(), recordBytes);
+        out += recordBytes;
+    }
+    if (rangeBytes > 0) {
+        memcpy(out, ranges.data(), rangeBytes);
+        out += rangeBytes;
+    }
+    if (!strings.empty()) {
+        memcpy(out, strings.data(), strings.size());
+    }
+    return data;
+}
+
+bool SystemFontIndex::WriteCacheFile(const std::string& cachePath, const std::vector<uint8_t>& data)
+{
+    // written aside and renamed, so other processes map either the old or the complete new index
+    std::string tempPath = cachePath + "." + std::to_string(getpid());
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t ret = write(fd, data.data() + written, data.size() - written);
+        if (ret <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    bool ok = written == data.size() && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SystemFontIndex::MapCacheFile(const std::string& cachePath, uint64_t stamp)
+{
+    int fd = open(cachePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    if (!Attach(static_cast<const uint8_t*>(data), st.st_size, stamp)) {
+        munmap(data, st.st_size);
+        return false;
+    }
+    mappedData_ = data;
+    return true;
+}
+
+bool SystemFontIndex::Attach(const uint8_t* data, size_t size, uint64_t stamp)
+{
+    if (size < sizeof(Header)) {
+        return false;
+    }
+    const Header* header = reinterpret_cast<const Header*>(data);
+    if (header->magic != INDEX_MAGIC || header->version != INDEX_VERSION || header->stamp != stamp) {
+        return false;
+    }
+    size_t recordBytes = static_cast<size_t>(header->fontCount) * sizeof(Record);
+    size_t rangeBytes = static_cast<size_t>(header->rangeCount) * sizeof(FontIndexRange);
+    if (sizeof(Header) + recordBytes + rangeBytes + header->stringSize != size) {
+        return false;
+    }
+    const Record* records = reinterpret_cast<const Record*>(data + sizeof(Header));
+    const char* strings = reinterpret_cast<const char*>(data + sizeof(Header) + recordBytes + rangeBytes);
+    if (header->fontCount > 0 && (header->stringSize == 0 || strings[header->stringSize - 1] != '\0')) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->fontCount; i++) {
+        const Record& record = records[i];
+        if (record.pathOffset >= header->stringSize || record.familyOffset >= header->stringSize ||
+            record.rangeStart > header->rangeCount || header->rangeCount - record.rangeStart < record.rangeCount) {
+            return false;
+        }
+    }
+    data_ = data;
+    dataSize_ = size;
+    header_ = header;
+    records_ = records;
+    ranges_ = reinterpret_cast<const FontIndexRange*>(data + sizeof(Header) + recordBytes);
+    strings_ = strings;
+    return true;
+}
+
+void SystemFontIndex::Reset()
+{
+    if (mappedData_ != nullptr) {
+        munmap(mappedData_, dataSize_);
+        mappedData_ = nullptr;
+    }
+    ownedData_.clear();
+    data_ = nullptr;
+    dataSize_ = 0;
+    header_ = nullptr;
+    records_ = nullptr;
+    ranges_ = nullptr;
+    strings_ = nullptr;
+}
+
+const SystemFontIndex::Record* SystemFontIndex::GetRecord(size_t font) const
+{
+    return font < GetFontCount() ? records_ + font : nullptr;
+}
+
+const char* SystemFontIndex::GetString(uint32_t offset) const
+{
+    return strings_ + offset;
+}
+} // namespace rosen
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSEN_TEXT_PROPERTIES_SYSTEM_FONT_INDEX_H_
+#define ROSEN_TEXT_PROPERTIES_SYSTEM_FONT_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rosen {
+// unicode code points first..last, both included, mapped to glyphs by a font
+struct FontIndexRange {
+    uint32_t first = 0;
+    uint32_t last = 0;
+};
+
+// one face of a font file as read from its name, OS/2 and cmap tables
+struct FontIndexFace {
+    std::string path;
+    std::string family;
+    uint32_t ttcIndex = 0;
+    uint16_t weight = 400;
+    uint16_t width = 5;
+    bool italic = false;
+    std::vector<FontIndexRange> coverage;
+};
+
+// Compact index of the system fonts: family, style and character coverage of every face, built by reading only the
+// table directories of the font files. It is persisted to a cache file which later processes map read only, so the
+// fonts are neither scanned nor loaded at startup and the pages of the index are shared between processes. The
+// typefaces themselves are created on demand, see IndexedFontManager.
+class SystemFontIndex final {
+public:
+    static constexpr const char* SYSTEM_FONT_DIR = "/system/fonts";
+    static constexpr const char* CACHE_PATH = "/data/service/el0/graphic/system_font_index";
+
+    SystemFontIndex() = default;
+    ~SystemFontIndex();
+
+    // maps the cache file if it was built from the current files of fontDirs, scans them and rewrites the cache file
+    // otherwise; the cache path may be empty or not writable, the index is kept in memory then
+    // returns false when there is no font at all
+    bool Load(const std::vector<std::string>& fontDirs, const std::string& cachePath);
+    bool IsLoadedFromCache() const
+    {
+        return mappedData_ != nullptr;
+    }
+    // bytes of the index, mapped or in memory
+    size_t GetDataSize() const
+    {
+        return dataSize_;
+    }
+
+    size_t GetFontCount() const;
+    const char* GetPath(size_t font) const;
+    const char* GetFamily(size_t font) const;
+    uint32_t GetTtcIndex(size_t font) const;
+    uint16_t GetWeight(size_t font) const;
+    uint16_t GetWidth(size_t font) const;
+    bool IsItalic(size_t font) const;
+    bool HasCharacter(size_t font, uint32_t codePoint) const;
+    // distinct family names in index order
+    std::vector<std::string> GetFamilies() const;
+    std::vector<size_t> FindFamily(const std::string& family) const;
+
+    // appends the faces of a font file, one for a single font, one per font for a collection
+    static bool ParseFontData(const uint8_t* data, size_t size, const std::string& path,
+        std::vector<FontIndexFace>& faces);
+
+    SystemFontIndex(const SystemFontIndex&) = delete;
+    SystemFontIndex& operator=(const SystemFontIndex&) = delete;
+
+private:
+    struct Header;
+    struct Record;
+
+    static uint64_t ComputeStamp(const std::vector<std::string>& files);
+    static std::vector<std::string> ListFontFiles(const std::vector<std::string>& fontDirs);
+    static std::vector<uint8_t> Serialize(const std::vector<FontIndexFace>& faces, uint64_t stamp);
+    static bool WriteCacheFile(const std::string& cachePath, const std::vector<uint8_t>& data);
+    bool MapCacheFile(const std::string& cachePath, uint64_t stamp);
+    bool Attach(const uint8_t* data, size_t size, uint64_t stamp);
+    void Reset();
+    const Record* GetRecord(size_t font) const;
+    const char* GetString(uint32_t offset) const;
+
+    // either the mapped cache file or ownedData_
+    const uint8_t* data_ = nullptr;
+    size_t dataSize_ = 0;
+    void* mappedData_ = nullptr;
+    std::vector<uint8_t> ownedData_;
+    const Header* header_ = nullptr;
+    const Record* records_ = nullptr;
+    const FontIndexRange* ranges_ = nullptr;
+    const char* strings_ = nullptr;
+};
+} // namespace rosen
+#endif // ROSEN_TEXT_PROPERTIES_SYSTEM_FONT_INDEX_H_
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rosen_text/properties/typography_cache.h"
+
+#include <cmath>
+#include <thread>
+
+namespace rosen {
+namespace {
+// glyph ids, positions, clusters and line records kept per UTF-16 code unit by a laid out paragraph
+constexpr size_t BYTES_PER_CODE_UNIT = 48;
+constexpr size_t PARAGRAPH_OVERHEAD = 2048;
+}
+
+TypographyCache& TypographyCache::Instance()
+{
+    static TypographyCache instance;
+    return instance;
+}
+
+TypographyCache::TypographyCache(size_t memoryBudget) : memoryBudget_(memoryBudget) {}
+
+void TypographyCache::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = enabled;
+    if (!enabled_) {
+        EvictLocked(0);
+    }
+}
+
+bool TypographyCache::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_;
+}
+
+void TypographyCache::SetMemoryBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    memoryBudget_ = bytes;
+    EvictLocked(memoryBudget_);
+}
+
+size_t TypographyCache::GetMemoryBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memoryBudget_;
+}
+
+std::shared_ptr<txt::Paragraph> TypographyCache::Find(const std::string& key, double width)
+{
+    std::string entryKey = MakeEntryKey(key, width);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        return nullptr;
+    }
+    auto iter = entries_.find(entryKey);
+    if (iter == entries_.end()) {
+        stats_.missCount++;
+        return nullptr;
+    }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.lruIter);
+    stats_.hitCount++;
+    return iter->second.paragraph;
+}
+
+bool TypographyCache::Insert(const std::string& key, double width, std::shared_ptr<txt::Paragraph> paragraph,
+    size_t bytes)
+{
+    if (paragraph == nullptr) {
+        return false;
+    }
+    std::string entryKey = MakeEntryKey(key, width);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(entryKey);
+    if (iter != entries_.end()) {
+        EraseLocked(iter);
+    }
+    if (!enabled_) {
+        return false;
+    }
+    if (bytes > memoryBudget_) {
+        stats_.rejectCount++;
+        return false;
+    }
+    EvictLocked(memoryBudget_ - bytes);
+    lruList_.push_front(entryKey);
+    entries_[entryKey] = { paragraph, bytes, lruList_.begin() };
+    memoryUsage_ += bytes;
+    stats_.insertCount++;
+    return true;
+}
+
+void TypographyCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lruList_.clear();
+    memoryUsage_ = 0;
+}
+
+void TypographyCache::RecordSkip()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.skipCount++;
+}
+
+TypographyCacheStats TypographyCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    TypographyCacheStats stats = stats_;
+    stats.cachedCount = entries_.size();
+    stats.memoryUsage = memoryUsage_;
+    stats.memoryBudget = memoryBudget_;
+    return stats;
+}
+
+void TypographyCache::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = {};
+}
+
+size_t TypographyCache::EstimateBytes(const std::string& key, size_t textLength)
+{
+    // the entry key is held twice, by the entry map and by the lru list
+    return PARAGRAPH_OVERHEAD + (key.size() + sizeof(double) + sizeof(std::thread::id)) * 2 +
+        textLength * BYTES_PER_CODE_UNIT;
+}
+
+std::string TypographyCache::MakeEntryKey(const std::string& key, double width)
+{
+    // libtxt lays a paragraph out at the floor of the width, so widths in the same pixel share an entry
+    double layoutWidth = std::floor(width);
+    std::string entryKey = key;
+    entryKey.append(reinterpret_cast<const char*>(&layoutWidth), sizeof(layoutWidth));
+    std::thread::id threadId = std::this_thread::get_id();
+    entryKey.append(reinterpret_cast<const char*>(&threadId), sizeof(threadId));
+    return entryKey;
+}
+
+void TypographyCache::EraseLocked(std::unordered_map<std::string, CacheEntry>::iterator iter)
+{
+    memoryUsage_ -= iter->second.bytes;
+    lruList_.erase(iter->second.lruIter);
+    entries_.erase(iter);
+}
+
+void TypographyCache::EvictLocked(size_t budget)
+{
+    while (memoryUsage_ > budget && !lruList_.empty()) {
+        auto iter = entries_.find(lruList_.back());
+        if (iter == entries_.end()) {
+            lruList_.pop_back();
+            continue;
+        }
+        EraseLocked(iter);
+        stats_.evictCount++;
+    }
+}
+} // namespace rosen
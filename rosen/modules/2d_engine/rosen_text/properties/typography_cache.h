@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSEN_TEXT_PROPERTIES_TYPOGRAPHY_CACHE_H_
+#define ROSEN_TEXT_PROPERTIES_TYPOGRAPHY_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "txt/paragraph.h"
+
+namespace rosen {
+struct TypographyCacheStats {
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint64_t insertCount = 0;
+    uint64_t evictCount = 0;
+    uint64_t rejectCount = 0;
+    // Layout() calls with an unchanged width that did not break the lines again
+    uint64_t skipCount = 0;
+    size_t cachedCount = 0;
+    size_t memoryUsage = 0;
+    size_t memoryBudget = 0;
+};
+
+// Process wide cache of laid out paragraphs. An entry is keyed by everything the paragraph was built from (the
+// typography style, the pushed text styles, text and placeholders, and the generation of the font collection, see
+// TypographyCreateTxt::GetCacheKey) together with the layout width, so typographies built again for the same UI
+// string share the shaped runs and line breaks of the first one instead of shaping it again.
+// Cached paragraphs are shared and must not be laid out again, TypographyTxt builds a paragraph of its own for that.
+// txt::Paragraph is not thread safe, so an entry is only found on the thread which inserted it: a typography has to be
+// used on the thread which laid it out.
+class TypographyCache final {
+public:
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 4 * 1024 * 1024;
+
+    static TypographyCache& Instance();
+
+    explicit TypographyCache(size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+    ~TypographyCache() = default;
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+    void SetMemoryBudget(size_t bytes);
+    size_t GetMemoryBudget() const;
+
+    // returns the paragraph laid out at the width and marks it most recently used, nullptr if there is none
+    std::shared_ptr<txt::Paragraph> Find(const std::string& key, double width);
+    // stores a laid out paragraph, evicting the least recently used ones to stay under the budget
+    bool Insert(const std::string& key, double width, std::shared_ptr<txt::Paragraph> paragraph, size_t bytes);
+    void Clear();
+
+    void RecordSkip();
+    TypographyCacheStats GetStats() const;
+    void ResetStats();
+
+    // memory estimate of a laid out paragraph of textLength UTF-16 code units
+    static size_t EstimateBytes(const std::string& key, size_t textLength);
+
+private:
+    struct CacheEntry {
+        std::shared_ptr<txt::Paragraph> paragraph;
+        size_t bytes = 0;
+        std::list<std::string>::iterator lruIter;
+    };
+
+    static std::string MakeEntryKey(const std::string& key, double width);
+    void EraseLocked(std::unordered_map<std::string, CacheEntry>::iterator iter);
+    void EvictLocked(size_t budget);
+
+    mutable std::mutex mutex_;
+    bool enabled_ = true;
+    size_t memoryBudget_;
+    size_t memoryUsage_ = 0;
+    std::unordered_map<std::string, CacheEntry> entries_;
+    // most recently used first
+    std::list<std::string> lruList_;
+    TypographyCacheStats stats_;
+};
+} // namespace rosen
+#endif // ROSEN_TEXT_PROPERTIES_TYPOGRAPHY_CACHE_H_
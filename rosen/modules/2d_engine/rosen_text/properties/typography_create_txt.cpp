@@ -22,15 +22,135 @@
 #include "txt/text_style.h"
 
 namespace rosen {
+namespace {
+template<typename T>
+void AppendKey(std::string& key, const T& value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendKey(std::string& key, const std::string& value)
+{
+    AppendKey(key, value.size());
+    key.append(value);
+}
+
+void AppendKey(std::string& key, const std::u16string& value)
+{
+    AppendKey(key, value.size());
+    key.append(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(char16_t));
+}
+
+void AppendKey(std::string& key, const std::vector<std::string>& values)
+{
+    AppendKey(key, values.size());
+    for (auto& value : values) {
+        AppendKey(key, value);
+    }
+}
+
+// shaders, path effects and filters can not be compared by value, text painted with them is not cached
+bool AppendKey(std::string& key, const OHOS::Rosen::Drawing::Pen& pen)
+{
+    OHOS::Rosen::Drawing::Filter filter = pen.GetFilter();
+    if (pen.GetShaderEffect() != nullptr || pen.GetPathEffect() != nullptr || pen.GetColorSpace() != nullptr ||
+        filter.GetColorFilter() != nullptr || filter.GetImageFilter() != nullptr || filter.GetMaskFilter() != nullptr) {
+        return false;
+    }
+    AppendKey(key, pen.GetColor().CastToColorQuad());
+    AppendKey(key, pen.GetWidth());
+    AppendKey(key, pen.GetMiterLimit());
+    AppendKey(key, pen.GetCapStyle());
+    AppendKey(key, pen.GetJoinStyle());
+    AppendKey(key, pen.GetBlendMode());
+    AppendKey(key, pen.IsAntiAlias());
+    AppendKey(key, filter.GetFilterQuality());
+    return true;
+}
+
+bool AppendKey(std::string& key, const TextStyle& style)
+{
+    AppendKey(key, style.color_.CastToColorQuad());
+    AppendKey(key, style.decoration_);
+    AppendKey(key, style.decorationColor_.CastToColorQuad());
+    AppendKey(key, style.decorationStyle_);
+    AppendKey(key, style.decorationThicknessMultiplier_);
+    AppendKey(key, style.fontWeight_);
+    AppendKey(key, style.fontStyle_);
+    AppendKey(key, style.textBaseline_);
+    AppendKey(key, style.fontFamilies_);
+    AppendKey(key, style.fontSize_);
+    AppendKey(key, style.letterSpacing_);
+    AppendKey(key, style.wordSpacing_);
+    AppendKey(key, style.height_);
+    AppendKey(key, style.hasHeightOverride_);
+    AppendKey(key, style.locale_);
+    AppendKey(key, style.hasBackground_);
+    if (style.hasBackground_ && !AppendKey(key, style.background_)) {
+        return false;
+    }
+    AppendKey(key, style.hasForeground_);
+    if (style.hasForeground_ && !AppendKey(key, style.foreground_)) {
+        return false;
+    }
+    AppendKey(key, style.textShadows_.size());
+    for (auto& shadow : style.textShadows_) {
+        AppendKey(key, shadow.color_.CastToColorQuad());
+        AppendKey(key, shadow.offset_.GetX());
+        AppendKey(key, shadow.offset_.GetY());
+        AppendKey(key, shadow.blurRadius_);
+    }
+    AppendKey(key, style.fontFeatures_.GetFeatureSettings());
+    return true;
+}
+
+void AppendKey(std::string& key, const TypographyStyle& style)
+{
+    AppendKey(key, style.fontWeight_);
+    AppendKey(key, style.fontStyle_);
+    AppendKey(key, style.fontFamily_);
+    AppendKey(key, style.fontSize_);
+    AppendKey(key, style.height_);
+    AppendKey(key, style.hasHeightOverride_);
+    AppendKey(key, style.strutEnabled_);
+    AppendKey(key, style.strutFontWeight_);
+    AppendKey(key, style.strutFontStyle_);
+    AppendKey(key, style.strutFontFamilies_);
+    AppendKey(key, style.strutFontSize_);
+    AppendKey(key, style.strutHeight_);
+    AppendKey(key, style.strutHasHeightOverride_);
+    AppendKey(key, style.strutLeading_);
+    AppendKey(key, style.forceStrutHeight_);
+    AppendKey(key, style.textAlign_);
+    AppendKey(key, style.textDirection_);
+    AppendKey(key, style.maxLines_);
+    AppendKey(key, style.ellipsis_);
+    AppendKey(key, style.locale_);
+    AppendKey(key, style.breakStrategy_);
+    AppendKey(key, style.wordBreakType_);
+}
+
+void AppendKey(std::string& key, const PlaceholderRun& span)
+{
+    AppendKey(key, span.width_);
+    AppendKey(key, span.height_);
+    AppendKey(key, span.placeholderalignment_);
+    AppendKey(key, span.textbaseline_);
+    AppendKey(key, span.baselineOffset_);
+}
+}
+
 TypographyCreateTxt::TypographyCreateTxt(const TypographyStyle& style,
     std::shared_ptr<FontCollection> font_collection)
 {
-    txt::ParagraphStyle txtParagraphStyle;
-    RosenConvertTypographyStyle(style, txtParagraphStyle);
+    RosenConvertTypographyStyle(style, txtParagraphStyle_);
     const FontCollectionTxt* fontCollectionTxt = static_cast<const FontCollectionTxt*>(
         font_collection->GetFontCollection().get());
-    paragraphBuilderTxt_ = std::make_shared<txt::ParagraphBuilderTxt>(
-        txtParagraphStyle, fontCollectionTxt->GetFontCollection());
+    txtFontCollection_ = fontCollectionTxt->GetFontCollection();
+    paragraphBuilderTxt_ = std::make_shared<txt::ParagraphBuilderTxt>(txtParagraphStyle_, txtFontCollection_);
+    // the generation changes whenever fonts are added, so paragraphs shaped with other fonts are never reused
+    AppendKey(cacheKey_, fontCollectionTxt->GetGeneration());
+    AppendKey(cacheKey_, style);
 }
 
 TypographyCreateTxt::~TypographyCreateTxt()
@@ -42,26 +162,86 @@ void TypographyCreateTxt::PushStyle(const TextStyle& style)
     txt::TextStyle textStyle;
     RosenConvertTxtStyle(style, textStyle);
     paragraphBuilderTxt_->PushStyle(textStyle);
+    if (cacheKey_.empty()) {
+        return;
+    }
+    AppendKey(cacheKey_, BuildOpType::PUSH_STYLE);
+    if (!AppendKey(cacheKey_, style)) {
+        DisableCache();
+        return;
+    }
+    buildOps_.push_back({ BuildOpType::PUSH_STYLE, textStyle, {}, {} });
 }
 
 void TypographyCreateTxt::Pop()
 {
     paragraphBuilderTxt_->Pop();
+    if (cacheKey_.empty()) {
+        return;
+    }
+    AppendKey(cacheKey_, BuildOpType::POP);
+    buildOps_.push_back({ BuildOpType::POP, {}, {}, {} });
 }
 
 void TypographyCreateTxt::AddText(const std::u16string& text)
 {
     paragraphBuilderTxt_->AddText(text);
+    textLength_ += text.size();
+    if (cacheKey_.empty()) {
+        return;
+    }
+    AppendKey(cacheKey_, BuildOpType::ADD_TEXT);
+    AppendKey(cacheKey_, text);
+    buildOps_.push_back({ BuildOpType::ADD_TEXT, {}, text, {} });
 }
 
 void TypographyCreateTxt::AddPlaceholder(PlaceholderRun& span)
 {
     txt::PlaceholderRun txtPlaceholderRun = RosenConvertPlaceholderRun(span);
     paragraphBuilderTxt_->AddPlaceholder(txtPlaceholderRun);
+    if (cacheKey_.empty()) {
+        return;
+    }
+    AppendKey(cacheKey_, BuildOpType::ADD_PLACEHOLDER);
+    AppendKey(cacheKey_, span);
+    buildOps_.push_back({ BuildOpType::ADD_PLACEHOLDER, {}, {}, txtPlaceholderRun });
 }
 
 std::unique_ptr<Typography> TypographyCreateTxt::Build()
 {
     return std::make_unique<Typography>();
 }
+
+std::unique_ptr<txt::Paragraph> TypographyCreateTxt::BuildParagraph() const
+{
+    txt::ParagraphBuilderTxt builder(txtParagraphStyle_, txtFontCollection_);
+    for (auto& op : buildOps_) {
+        switch (op.type) {
+            case BuildOpType::PUSH_STYLE:
+                builder.PushStyle(op.style);
+                break;
+            case BuildOpType::POP:
+                builder.Pop();
+                break;
+            case BuildOpType::ADD_TEXT:
+                builder.AddText(op.text);
+                break;
+            case BuildOpType::ADD_PLACEHOLDER: {
+                txt::PlaceholderRun placeholder = op.placeholder;
+                builder.AddPlaceholder(placeholder);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return builder.Build();
+}
+
+void TypographyCreateTxt::DisableCache()
+{
+    cacheKey_.clear();
+    buildOps_.clear();
+    buildOps_.shrink_to_fit();
+}
 } // namespace rosen
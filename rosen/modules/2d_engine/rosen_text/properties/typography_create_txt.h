@@ -17,6 +17,7 @@
 #define ROSEN_TEXT_PROPERTIES_TYPOGRAPHY_CREATE_TXT_H_
 
 #include <string>
+#include <vector>
 
 #include "rosen_text/properties/placeholder_run.h"
 #include "rosen_text/properties/text_style.h"
@@ -24,6 +25,8 @@
 #include "rosen_text/properties/typography_style.h"
 #include "rosen_text/ui/font_collection.h"
 #include "txt/paragraph_builder_txt.h"
+#include "txt/placeholder_run.h"
+#include "txt/text_style.h"
 
 namespace rosen {
 class TypographyCreateTxt : public TypographyCreateBase {
@@ -39,9 +42,41 @@ public:
     {
         return paragraphBuilderTxt_;
     }
+    // everything the typography is built from, see TypographyCache; empty when it can not be cached
+    const std::string& GetCacheKey() const
+    {
+        return cacheKey_;
+    }
+    size_t GetTextLength() const
+    {
+        return textLength_;
+    }
+    // builds another paragraph from the same styles, text and placeholders, only for a typography with a cache key
+    std::unique_ptr<txt::Paragraph> BuildParagraph() const;
     TypographyCreateTxt(const TypographyCreateTxt&) = delete;
     TypographyCreateTxt& operator = (const TypographyCreateTxt&) = delete;
     std::shared_ptr<txt::ParagraphBuilderTxt> paragraphBuilderTxt_;
+
+private:
+    enum class BuildOpType {
+        PUSH_STYLE,
+        POP,
+        ADD_TEXT,
+        ADD_PLACEHOLDER,
+    };
+    struct BuildOp {
+        BuildOpType type;
+        txt::TextStyle style;
+        std::u16string text;
+        txt::PlaceholderRun placeholder;
+    };
+    void DisableCache();
+
+    txt::ParagraphStyle txtParagraphStyle_;
+    std::shared_ptr<txt::FontCollection> txtFontCollection_;
+    std::vector<BuildOp> buildOps_;
+    std::string cacheKey_;
+    size_t textLength_ = 0;
 };
 } // namespace rosen
 #endif // ROSEN_TEXT_PROPERTIES_TYPOGRAPHY_CREATE_TXT_H_
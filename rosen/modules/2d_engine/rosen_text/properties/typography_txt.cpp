@@ -13,8 +13,11 @@
  * limitations under the License.
  */
 
+#include <cmath>
+
 #include "engine_adapter/skia_adapter/skia_canvas.h"
 #include "rosen_text/properties/rosen_converter_txt.h"
+#include "rosen_text/properties/typography_cache.h"
 #include "rosen_text/properties/typography_create_base.h"
 #include "rosen_text/properties/typography_create_txt.h"
 #include "rosen_text/properties/typography_txt.h"
@@ -32,9 +35,10 @@ TypographyTxt::~TypographyTxt()
 
 void TypographyTxt::Init(std::shared_ptr<TypographyCreateBase> typographyCreateBase)
 {
-    const TypographyCreateTxt* typographyCreateTxt = static_cast<const TypographyCreateTxt*>(
-        typographyCreateBase.get());
-    paragraphTxt_ = typographyCreateTxt->GetParagraphBuilderTxt()->Build();
+    typographyCreateTxt_ = std::static_pointer_cast<TypographyCreateTxt>(typographyCreateBase);
+    paragraphTxt_ = typographyCreateTxt_->GetParagraphBuilderTxt()->Build();
+    paragraphShared_ = false;
+    laidOut_ = false;
 }
 
 
@@ -80,13 +84,39 @@ bool TypographyTxt::DidExceedMaxLines()
 
 void TypographyTxt::Layout(double width)
 {
+    // libtxt breaks the lines at the floor of the width, a width in the same pixel keeps the current lines
+    double layoutWidth = std::floor(width);
+    if (laidOut_ && layoutWidth == layoutWidth_) {
+        TypographyCache::Instance().RecordSkip();
+        return;
+    }
+    laidOut_ = true;
+    layoutWidth_ = layoutWidth;
+    if (typographyCreateTxt_ == nullptr || typographyCreateTxt_->GetCacheKey().empty()) {
+        paragraphTxt_->Layout(width);
+        return;
+    }
+
+    auto& cache = TypographyCache::Instance();
+    const std::string& key = typographyCreateTxt_->GetCacheKey();
+    std::shared_ptr<txt::Paragraph> paragraph = cache.Find(key, width);
+    if (paragraph != nullptr) {
+        paragraphTxt_ = paragraph;
+        paragraphShared_ = true;
+        return;
+    }
+    if (paragraphShared_) {
+        paragraphTxt_ = typographyCreateTxt_->BuildParagraph();
+    }
     paragraphTxt_->Layout(width);
+    paragraphShared_ = cache.Insert(key, width, paragraphTxt_,
+        TypographyCache::EstimateBytes(key, typographyCreateTxt_->GetTextLength()));
 }
 
 void TypographyTxt::Paint(Canvas* drawCanvas, double x, double y)
 {
     std::shared_ptr<CoreCanvasImpl> coreCanvas = drawCanvas->GetCanvasData();
-    const SkiaCanvas* skiacavas = static_cast<const SkiaCanvas*>(coreCanvas.get());
+    SkiaCanvas* skiacavas = static_cast<SkiaCanvas*>(coreCanvas.get());
     SkCanvas *canvas = skiacavas->ExportSkCanvas();
     paragraphTxt_->Paint(canvas, x, y);
 }
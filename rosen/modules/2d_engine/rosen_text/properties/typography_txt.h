@@ -16,6 +16,8 @@
 #ifndef ROSEN_TEXT_PROPERITES_TYPOGRAPHY_TXT_H_
 #define ROSEN_TEXT_PROPERITES_TYPOGRAPHY_TXT_H_
 
+#include <memory>
+#include <string>
 #include <vector>
 #include "rosen_text/properties/text_style.h"
 #include "rosen_text/properties/typography_style.h"
@@ -26,6 +28,7 @@
 
 namespace rosen {
 using namespace OHOS::Rosen::Drawing;
+class TypographyCreateTxt;
 class TypographyTxt : public TypographyBase {
 public:
     TypographyTxt();
@@ -55,7 +58,12 @@ public:
         double dy) override;
     TypographyProperties::Range<size_t> GetWordBoundary(size_t offset) override;
 private:
-    std::unique_ptr<txt::Paragraph> paragraphTxt_;
+    std::shared_ptr<txt::Paragraph> paragraphTxt_;
+    std::shared_ptr<TypographyCreateTxt> typographyCreateTxt_;
+    // paragraphTxt_ is held by the TypographyCache and must not be laid out again
+    bool paragraphShared_ = false;
+    bool laidOut_ = false;
+    double layoutWidth_ = 0;
 };
 } // namespace rosen
 #endif // ROSEN_TEXT_PROPERITES_TYPOGRAPHY_TXT_H_
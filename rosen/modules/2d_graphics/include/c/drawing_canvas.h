@@ -175,6 +175,17 @@ void OH_Drawing_CanvasDrawPath(OH_Drawing_Canvas*, const OH_Drawing_Path*);
  */
 void OH_Drawing_CanvasClear(OH_Drawing_Canvas*, uint32_t color);
 
+/**
+ * @brief Draws a picture, that is, plays back the drawing commands recorded in it.
+ *
+ * @syscap SystemCapability.Graphic.Graphic2D.NativeDrawing
+ * @param OH_Drawing_Canvas Indicates the pointer to an <b>OH_Drawing_Canvas</b> object.
+ * @param OH_Drawing_Picture Indicates the pointer to an <b>OH_Drawing_Picture</b> object.
+ * @since 9
+ * @version 1.0
+ */
+void OH_Drawing_CanvasDrawPicture(OH_Drawing_Canvas*, const OH_Drawing_Picture*);
+
 #ifdef __cplusplus
 }
 #endif
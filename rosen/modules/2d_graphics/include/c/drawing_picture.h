@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef C_INCLUDE_DRAWING_PICTURE_H
+#define C_INCLUDE_DRAWING_PICTURE_H
+
+/**
+ * @addtogroup Drawing
+ * @{
+ *
+ * @brief Provides functions such as 2D graphics rendering, text drawing, and image display.
+ * 
+ * @syscap SystemCapability.Graphic.Graphic2D.NativeDrawing
+ *
+ * @since 9
+ * @version 1.0
+ */
+
+/**
+ * @file drawing_picture.h
+ *
+ * @brief Declares functions related to the <b>picture</b> object and the recording canvas in the drawing module.
+ * A picture is recorded once and can then be drawn many times, also on other threads than the recording one.
+ *
+ * @since 9
+ * @version 1.0
+ */
+
+#include "drawing_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Creates a recording canvas. Everything drawn on it with the <b>OH_Drawing_Canvas</b> functions
+ * is recorded instead of drawn. Destroy it with <b>OH_Drawing_CanvasDestroy</b>.
+ *
+ * @syscap SystemCapability.Graphic.Graphic2D.NativeDrawing
+ * @param width Indicates the width of the area to record.
+ * @param height Indicates the height of the area to record.
+ * @return Returns the pointer to the <b>OH_Drawing_Canvas</b> object created.
+ * @since 9
+ * @version 1.0
+ */
+OH_Drawing_Canvas* OH_Drawing_RecordingCanvasCreate(float width, float height);
+
+/**
+ * @brief Ends a recording and returns what was recorded as a picture.
+ * The canvas starts a new, empty recording afterwards.
+ *
+ * @syscap SystemCapability.Graphic.Graphic2D.NativeDrawing
+ * @param OH_Drawing_Canvas Indicates the pointer to an <b>OH_Drawing_Canvas</b> object
+ *                          created by <b>OH_Drawing_RecordingCanvasCreate</b>.
+ * @return Returns the pointer to the <b>OH_Drawing_Picture</b> object created, or NULL if the recording failed
+ *         or the canvas is not a recording canvas.
+ * @since 9
+ * @version 1.0
+ */
+OH_Drawing_Picture* OH_Drawing_RecordingCanvasFinish(OH_Drawing_Canvas*);
+
+/**
+ * @brief Destroys an <b>OH_Drawing_Picture</b> object and reclaims the memory occupied by the object.
+ *
+ * @syscap SystemCapability.Graphic.Graphic2D.NativeDrawing
+ * @param OH_Drawing_Picture Indicates the pointer to an <b>OH_Drawing_Picture</b> object.
+ * @since 9
+ * @version 1.0
+ */
+void OH_Drawing_PictureDestroy(OH_Drawing_Picture*);
+
+/**
+ * @brief Obtains the bounds of the area covered by the commands recorded in a picture.
+ *
+ * @syscap SystemCapability.Graphic.Graphic2D.NativeDrawing
+ * @param OH_Drawing_Picture Indicates the pointer to an <b>OH_Drawing_Picture</b> object.
+ * @param left Indicates the x coordinate of the left side of the bounds.
+ * @param top Indicates the y coordinate of the top side of the bounds.
+ * @param right Indicates the x coordinate of the right side of the bounds.
+ * @param bottom Indicates the y coordinate of the bottom side of the bounds.
+ * @since 9
+ * @version 1.0
+ */
+void OH_Drawing_PictureGetBounds(const OH_Drawing_Picture*, float* left, float* top, float* right, float* bottom);
+
+#ifdef __cplusplus
+}
+#endif
+/** @} */
+#endif
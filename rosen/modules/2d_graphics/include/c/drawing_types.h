@@ -84,6 +84,14 @@ typedef struct OH_Drawing_Path OH_Drawing_Path;
  */
 typedef struct OH_Drawing_Bitmap OH_Drawing_Bitmap;
 
+/**
+ * @brief Defines a picture, which is an immutable sequence of drawing commands recorded by a recording canvas.
+ * 
+ * @since 9
+ * @version 1.0
+ */
+typedef struct OH_Drawing_Picture OH_Drawing_Picture;
+
 /**
  * @brief Enumerates storage formats of bitmap pixels.
  * 
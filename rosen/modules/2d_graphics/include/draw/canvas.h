@@ -25,10 +25,23 @@
 namespace OHOS {
 namespace Rosen {
 namespace Drawing {
+enum class CanvasType {
+    COMMON_CANVAS,
+    RECORDING_CANVAS,
+};
+
 class Canvas : public CoreCanvas {
 public:
     Canvas() {}
     virtual ~Canvas() {};
+
+    virtual CanvasType GetType() const
+    {
+        return CanvasType::COMMON_CANVAS;
+    }
+
+protected:
+    explicit Canvas(std::shared_ptr<CoreCanvasImpl> impl) : CoreCanvas(std::move(impl)) {}
 };
 } // namespace Drawing
 } // namespace Rosen
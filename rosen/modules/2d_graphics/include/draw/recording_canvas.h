@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RECORDING_CANVAS_H
+#define RECORDING_CANVAS_H
+
+#include "draw/canvas.h"
+#include "engine_adapter/impl_interface/picture_recorder_impl.h"
+#include "image/picture.h"
+#include "utils/rect.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Drawing {
+/*
+ * A canvas which records what is drawn on it instead of rasterizing it. The recording is turned into a Picture by
+ * FinishRecording, which can then be drawn on any canvas, any number of times and from any thread.
+ */
+class RecordingCanvas : public Canvas {
+public:
+    explicit RecordingCanvas(const Rect& bounds);
+    ~RecordingCanvas() override {};
+
+    CanvasType GetType() const override
+    {
+        return CanvasType::RECORDING_CANVAS;
+    }
+
+    /*
+     * Returns the commands recorded so far, nullptr if recording failed. The canvas starts a new, empty recording
+     * with the same bounds and a reset matrix and clip afterwards.
+     */
+    std::shared_ptr<Picture> FinishRecording();
+
+private:
+    RecordingCanvas(std::shared_ptr<PictureRecorderImpl> recorderImpl, const Rect& bounds);
+
+    std::shared_ptr<PictureRecorderImpl> recorderImpl_;
+};
+} // namespace Drawing
+} // namespace Rosen
+} // namespace OHOS
+#endif
@@ -21,10 +21,20 @@
 namespace OHOS {
 namespace Rosen {
 namespace Drawing {
+/*
+ * A recorded sequence of drawing commands, see RecordingCanvas. A picture never changes once it is recorded, so
+ * copies of it share the commands and may be played back on several threads at the same time.
+ */
 class Picture {
 public:
     Picture() noexcept;
+    explicit Picture(std::shared_ptr<PictureImpl> pictureImpl) noexcept;
     virtual ~Picture() {};
+
+    // the area covered by the recorded commands, before the transform of the canvas it is drawn on
+    Rect GetBounds() const;
+    int ApproximateOpCount() const;
+
     template<typename T>
     const std::shared_ptr<T> GetImpl() const
     {
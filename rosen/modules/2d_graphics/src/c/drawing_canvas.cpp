@@ -46,6 +46,11 @@ static const Bitmap& CastToBitmap(const OH_Drawing_Bitmap& cBitmap)
     return reinterpret_cast<const Bitmap&>(cBitmap);
 }
 
+static const Picture& CastToPicture(const OH_Drawing_Picture& cPicture)
+{
+    return reinterpret_cast<const Picture&>(cPicture);
+}
+
 OH_Drawing_Canvas* OH_Drawing_CanvasCreate()
 {
     return (OH_Drawing_Canvas*)new Canvas;
@@ -107,3 +112,8 @@ void OH_Drawing_CanvasClear(OH_Drawing_Canvas* cCanvas, uint32_t color)
 {
     CastToCanvas(cCanvas)->Clear(color);
 }
+
+void OH_Drawing_CanvasDrawPicture(OH_Drawing_Canvas* cCanvas, const OH_Drawing_Picture* cPicture)
+{
+    CastToCanvas(cCanvas)->DrawPicture(CastToPicture(*cPicture));
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "c/drawing_picture.h"
+
+#include "draw/recording_canvas.h"
+
+using namespace OHOS;
+using namespace Rosen;
+using namespace Drawing;
+
+static RecordingCanvas* CastToRecordingCanvas(OH_Drawing_Canvas* cCanvas)
+{
+    Canvas* canvas = reinterpret_cast<Canvas*>(cCanvas);
+    if (canvas == nullptr || canvas->GetType() != CanvasType::RECORDING_CANVAS) {
+        return nullptr;
+    }
+    return static_cast<RecordingCanvas*>(canvas);
+}
+
+static const Picture* CastToPicture(const OH_Drawing_Picture* cPicture)
+{
+    return reinterpret_cast<const Picture*>(cPicture);
+}
+
+OH_Drawing_Canvas* OH_Drawing_RecordingCanvasCreate(float width, float height)
+{
+    Canvas* canvas = new RecordingCanvas(Rect(0, 0, width, height));
+    return (OH_Drawing_Canvas*)canvas;
+}
+
+OH_Drawing_Picture* OH_Drawing_RecordingCanvasFinish(OH_Drawing_Canvas* cCanvas)
+{
+    RecordingCanvas* recordingCanvas = CastToRecordingCanvas(cCanvas);
+    if (recordingCanvas == nullptr) {
+        return nullptr;
+    }
+    auto picture = recordingCanvas->FinishRecording();
+    if (picture == nullptr) {
+        return nullptr;
+    }
+    return (OH_Drawing_Picture*)new Picture(*picture);
+}
+
+void OH_Drawing_PictureDestroy(OH_Drawing_Picture* cPicture)
+{
+    delete CastToPicture(cPicture);
+}
+
+void OH_Drawing_PictureGetBounds(
+    const OH_Drawing_Picture* cPicture, float* left, float* top, float* right, float* bottom)
+{
+    Rect bounds = CastToPicture(cPicture)->GetBounds();
+    if (left != nullptr) {
+        *left = bounds.GetLeft();
+    }
+    if (top != nullptr) {
+        *top = bounds.GetTop();
+    }
+    if (right != nullptr) {
+        *right = bounds.GetRight();
+    }
+    if (bottom != nullptr) {
+        *bottom = bounds.GetBottom();
+    }
+}
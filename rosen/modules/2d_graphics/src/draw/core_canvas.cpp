@@ -22,6 +22,8 @@ namespace Rosen {
 namespace Drawing {
 CoreCanvas::CoreCanvas() : impl_(ImplFactory::CreateCoreCanvasImpl()) {}
 
+CoreCanvas::CoreCanvas(std::shared_ptr<CoreCanvasImpl> impl) : impl_(std::move(impl)) {}
+
 void CoreCanvas::Bind(const Bitmap& bitmap)
 {
     impl_->Bind(bitmap);
@@ -194,6 +196,11 @@ void CoreCanvas::Restore()
     impl_->Restore();
 }
 
+void CoreCanvas::SetRasterThreadCount(uint32_t count)
+{
+    impl_->SetRasterThreadCount(count);
+}
+
 CoreCanvas& CoreCanvas::AttachPen(const Pen& pen)
 {
     impl_->AttachPen(pen);
@@ -77,6 +77,13 @@ public:
     void Save();
     void SaveLayer(const Rect& rect, const Brush& brush);
     void Restore();
+    /*
+     * Rasterizes the bitmap bound next in tiles on up to count threads, 1 (the default) draws on the calling thread.
+     * With more than one thread the draw calls are recorded and only reach the bitmap on Flush, Bind or
+     * destruction; the output is the same as drawing directly. Layers, image and mask filters, shadows, pictures
+     * and clips that grow the clip need the whole bitmap, they make the canvas draw directly until the next Bind.
+     */
+    void SetRasterThreadCount(uint32_t count);
 
     // paint
     CoreCanvas& AttachPen(const Pen& pen);
@@ -91,6 +98,9 @@ public:
     }
     std::shared_ptr<CoreCanvasImpl> GetCanvasData() const;
 
+protected:
+    explicit CoreCanvas(std::shared_ptr<CoreCanvasImpl> impl);
+
 private:
     std::shared_ptr<CoreCanvasImpl> impl_;
 };
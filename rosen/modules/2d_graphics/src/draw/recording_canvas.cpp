@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "draw/recording_canvas.h"
+
+#include "impl_factory.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Drawing {
+RecordingCanvas::RecordingCanvas(const Rect& bounds)
+    : RecordingCanvas(ImplFactory::CreatePictureRecorderImpl(), bounds)
+{}
+
+RecordingCanvas::RecordingCanvas(std::shared_ptr<PictureRecorderImpl> recorderImpl, const Rect& bounds)
+    : Canvas(recorderImpl->BeginRecording(bounds)), recorderImpl_(std::move(recorderImpl))
+{}
+
+std::shared_ptr<Picture> RecordingCanvas::FinishRecording()
+{
+    auto pictureImpl = recorderImpl_->FinishRecording();
+    if (pictureImpl == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<Picture>(pictureImpl);
+}
+} // namespace Drawing
+} // namespace Rosen
+} // namespace OHOS
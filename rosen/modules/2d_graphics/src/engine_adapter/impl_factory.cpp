@@ -42,6 +42,11 @@ std::unique_ptr<PictureImpl> ImplFactory::CreatePictureImpl()
     return EngineImplFactory::CreatePicture();
 }
 
+std::unique_ptr<PictureRecorderImpl> ImplFactory::CreatePictureRecorderImpl()
+{
+    return EngineImplFactory::CreatePictureRecorder();
+}
+
 std::unique_ptr<PathImpl> ImplFactory::CreatePathImpl()
 {
     return EngineImplFactory::CreatePath();
@@ -28,6 +28,7 @@
 #include "impl_interface/path_effect_impl.h"
 #include "impl_interface/path_impl.h"
 #include "impl_interface/picture_impl.h"
+#include "impl_interface/picture_recorder_impl.h"
 #include "impl_interface/shader_effect_impl.h"
 
 namespace OHOS {
@@ -43,6 +44,7 @@ public:
     static std::unique_ptr<MaskFilterImpl> CreateMaskFilterImpl();
     static std::unique_ptr<ImageFilterImpl> CreateImageFilterImpl();
     static std::unique_ptr<PictureImpl> CreatePictureImpl();
+    static std::unique_ptr<PictureRecorderImpl> CreatePictureRecorderImpl();
     static std::unique_ptr<ShaderEffectImpl> CreateShaderEffectImpl();
     static std::unique_ptr<PathEffectImpl> CreatePathEffectImpl();
     static std::unique_ptr<ColorSpaceImpl> CreateColorSpaceImpl();
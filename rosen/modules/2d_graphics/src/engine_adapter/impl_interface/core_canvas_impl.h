@@ -101,6 +101,7 @@ public:
     virtual void Save() = 0;
     virtual void SaveLayer(const Rect& rect, const Brush& brush) = 0;
     virtual void Restore() = 0;
+    virtual void SetRasterThreadCount(uint32_t count) = 0;
 
     // paint
     virtual void AttachPen(const Pen& pen) = 0;
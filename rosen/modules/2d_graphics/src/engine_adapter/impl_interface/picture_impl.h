@@ -18,6 +18,8 @@
 
 #include "base_impl.h"
 
+#include "utils/rect.h"
+
 namespace OHOS {
 namespace Rosen {
 namespace Drawing {
@@ -30,6 +32,9 @@ public:
     {
         return AdapterType::BASE_INTERFACE;
     }
+
+    virtual Rect GetBounds() const = 0;
+    virtual int ApproximateOpCount() const = 0;
 };
 } // namespace Drawing
 } // namespace Rosen
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PICTURE_RECORDER_IMPL_H
+#define PICTURE_RECORDER_IMPL_H
+
+#include "base_impl.h"
+#include "core_canvas_impl.h"
+#include "picture_impl.h"
+
+#include "utils/rect.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Drawing {
+class PictureRecorderImpl : public BaseImpl {
+public:
+    static inline constexpr AdapterType TYPE = AdapterType::BASE_INTERFACE;
+    PictureRecorderImpl() {}
+    ~PictureRecorderImpl() override {}
+    AdapterType GetType() const override
+    {
+        return AdapterType::BASE_INTERFACE;
+    }
+
+    // returns the canvas recording the commands, it must not be used after the recorder is destroyed
+    virtual std::shared_ptr<CoreCanvasImpl> BeginRecording(const Rect& bounds) = 0;
+    // returns nullptr if nothing is being recorded, otherwise a new recording with the same bounds begins
+    virtual std::shared_ptr<PictureImpl> FinishRecording() = 0;
+};
+} // namespace Drawing
+} // namespace Rosen
+} // namespace OHOS
+#endif
@@ -15,8 +15,11 @@
 
 #include "skia_canvas.h"
 
+#include <algorithm>
+
 #include "pixel_map.h"
 #include "skia_path.h"
+#include "skia_tile_rasterizer.h"
 
 #include "image/bitmap.h"
 #include "image/image.h"
@@ -24,18 +27,124 @@
 namespace OHOS {
 namespace Rosen {
 namespace Drawing {
+// tiles are drawn one by one into disjoint parts of the bitmap, which only gives the result of a direct draw if every
+// pixel depends on nothing but the draw calls covering it. Filters read the pixels around them and a layer is
+// composited only on its restore, so canvases using them are drawn directly.
+static bool IsTileSafe(const SkPaint& paint)
+{
+    return paint.getImageFilter() == nullptr && paint.getMaskFilter() == nullptr;
+}
+
+// a clip which is not only cut further could reach outside of the tile and draw over the pixels of another one
+static bool IsTileSafe(ClipOp op)
+{
+    return op == ClipOp::INTERSECT || op == ClipOp::DIFFERENCE;
+}
+
 SkiaCanvas::SkiaCanvas() : skiaCanvas_(std::make_shared<SkCanvas>()), skiaPaint_() {}
 
-SkCanvas* SkiaCanvas::ExportSkCanvas() const
+SkiaCanvas::~SkiaCanvas()
+{
+    RasterizeTiles();
+}
+
+SkCanvas* SkiaCanvas::ExportSkCanvas()
 {
+    // the caller may draw anything on it and expects it to be backed by the bitmap
+    EndTiledRecording();
     return skiaCanvas_.get();
 }
 
+void SkiaCanvas::ImportSkCanvas(SkCanvas* skCanvas)
+{
+    if (skCanvas == nullptr) {
+        return;
+    }
+    RasterizeTiles();
+    recorder_ = nullptr;
+    bitmap_.reset();
+    stateOps_.clear();
+    saveStack_.clear();
+    skiaCanvas_ = std::shared_ptr<SkCanvas>(skCanvas, [](SkCanvas*) {});
+}
+
 void SkiaCanvas::Bind(const Bitmap& bitmap)
 {
     auto skBitmapImpl = bitmap.GetImpl<SkiaBitmap>();
     if (skBitmapImpl != nullptr) {
-        skiaCanvas_ = std::make_shared<SkCanvas>(skBitmapImpl->ExportSkiaBitmap());
+        RasterizeTiles();
+        BindBitmap(skBitmapImpl->ExportSkiaBitmap());
+    }
+}
+
+void SkiaCanvas::BindBitmap(const SkBitmap& bitmap)
+{
+    bitmap_ = bitmap;
+    stateOps_.clear();
+    saveStack_.clear();
+    if (rasterThreadCount_ > 1 && HasTileSafePaints()) {
+        BeginTiledRecording();
+    } else {
+        recorder_ = nullptr;
+        skiaCanvas_ = std::make_shared<SkCanvas>(bitmap_);
+    }
+}
+
+bool SkiaCanvas::IsTiledRecording() const
+{
+    return recorder_ != nullptr && recorder_->getRecordingCanvas() != nullptr;
+}
+
+void SkiaCanvas::BeginTiledRecording()
+{
+    if (recorder_ == nullptr) {
+        recorder_ = std::make_unique<SkPictureRecorder>();
+    }
+    SkCanvas* recordingCanvas = recorder_->beginRecording(SkRect::Make(bitmap_.bounds()));
+    skiaCanvas_ = std::shared_ptr<SkCanvas>(recordingCanvas, [](SkCanvas*) {});
+    for (auto& op : stateOps_) {
+        op(*skiaCanvas_);
+    }
+}
+
+void SkiaCanvas::RasterizeTiles()
+{
+    if (!IsTiledRecording()) {
+        return;
+    }
+    sk_sp<SkPicture> picture = recorder_->finishRecordingAsPicture();
+    SkiaTileRasterizer::Rasterize(bitmap_, picture, static_cast<int>(rasterThreadCount_));
+}
+
+// draws what is recorded so far and continues with a canvas on the bitmap in the same state until the next Bind
+void SkiaCanvas::EndTiledRecording()
+{
+    if (!IsTiledRecording()) {
+        return;
+    }
+    RasterizeTiles();
+    skiaCanvas_ = std::make_shared<SkCanvas>(bitmap_);
+    for (auto& op : stateOps_) {
+        op(*skiaCanvas_);
+    }
+    stateOps_.clear();
+    saveStack_.clear();
+}
+
+bool SkiaCanvas::HasTileSafePaints()
+{
+    for (auto d : skiaPaint_.GetSortedPaints()) {
+        if (d != nullptr && !IsTileSafe(d->paint)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SkiaCanvas::RecordState(std::function<void(SkCanvas&)> op)
+{
+    if (IsTiledRecording()) {
+        stateOps_.emplace_back(std::move(op));
     }
 }
 
@@ -147,6 +256,9 @@ void SkiaCanvas::DrawBackground(const Brush& brush)
 {
     SkPaint paint;
     skiaPaint_.BrushToSkPaint(brush, paint);
+    if (!IsTileSafe(paint)) {
+        EndTiledRecording();
+    }
     skiaCanvas_->drawPaint(paint);
 }
 
@@ -160,6 +272,8 @@ void SkiaCanvas::DrawShadow(const Path& path, const Point3& planeParams, const P
     SkColor color2 = spotColor.CastToColorQuad();
     SkShadowFlags flags = static_cast<SkShadowFlags>(flag);
     if (skPathImpl != nullptr) {
+        // shadows are blurred
+        EndTiledRecording();
         SkShadowUtils::DrawShadow(skiaCanvas_.get(), skPathImpl->GetPath(), point1, point2, color1, color2, flags);
     }
 }
@@ -173,7 +287,7 @@ void SkiaCanvas::DrawBitmap(const Bitmap& bitmap, const scalar px, const scalar
         bmp = skBitmapImpl->ExportSkiaBitmap();
     }
 
-    auto paints = skiaPaint_.GetSortedPaints();
+    const auto& paints = skiaPaint_.GetSortedPaints();
     if (paints.empty()) {
 #if defined(USE_CANVASKIT0310_SKIA)
         skiaCanvas_->drawImage(bmp.asImage(), px, py);
@@ -258,7 +372,7 @@ void SkiaCanvas::DrawBitmap(Media::PixelMap& pixelMap, const scalar px, const sc
     auto imageInfo = MakeSkImageInfoFromPixelMap(pixelMap);
     bitmap.installPixels(imageInfo, (void*)pixelMap.GetPixels(), static_cast<uint32_t>(pixelMap.GetRowBytes()));
 
-    auto paints = skiaPaint_.GetSortedPaints();
+    const auto& paints = skiaPaint_.GetSortedPaints();
     if (paints.empty()) {
 #if defined(USE_CANVASKIT0310_SKIA)
         skiaCanvas_->drawImage(bitmap.asImage(), px, py);
@@ -288,7 +402,7 @@ void SkiaCanvas::DrawImage(const Image& image, const scalar px, const scalar py,
         img = skImageImpl->GetImage();
     }
 
-    auto paints = skiaPaint_.GetSortedPaints();
+    const auto& paints = skiaPaint_.GetSortedPaints();
     if (paints.empty()) {
         skiaCanvas_->drawImage(img, px, py);
         return;
@@ -324,7 +438,7 @@ void SkiaCanvas::DrawImageRect(
     SkRect srcRect = SkRect::MakeLTRB(src.GetLeft(), src.GetTop(), src.GetRight(), src.GetBottom());
     SkRect dstRect = SkRect::MakeLTRB(dst.GetLeft(), dst.GetTop(), dst.GetRight(), dst.GetBottom());
 
-    auto paints = skiaPaint_.GetSortedPaints();
+    const auto& paints = skiaPaint_.GetSortedPaints();
     if (paints.empty()) {
 #if defined(USE_CANVASKIT0310_SKIA)
         skiaCanvas_->drawImageRect(
@@ -366,7 +480,7 @@ void SkiaCanvas::DrawImageRect(const Image& image, const Rect& dst, const Sampli
 
     SkRect dstRect = SkRect::MakeLTRB(dst.GetLeft(), dst.GetTop(), dst.GetRight(), dst.GetBottom());
 
-    auto paints = skiaPaint_.GetSortedPaints();
+    const auto& paints = skiaPaint_.GetSortedPaints();
     if (paints.empty()) {
 #if defined(USE_CANVASKIT0310_SKIA)
         skiaCanvas_->drawImageRect(img, dstRect, samplingOptions, nullptr);
@@ -396,22 +510,24 @@ void SkiaCanvas::DrawImageRect(const Image& image, const Rect& dst, const Sampli
 
 void SkiaCanvas::DrawPicture(const Picture& picture)
 {
-    LOGI("+++++++ DrawPicture");
-    sk_sp<SkPicture> p;
-
     auto skPictureImpl = picture.GetImpl<SkiaPicture>();
     if (skPictureImpl != nullptr) {
-        p = skPictureImpl->GetPicture();
+        sk_sp<SkPicture> p = skPictureImpl->GetPicture();
+        // the picture may hold layers and filters
+        EndTiledRecording();
         skiaCanvas_->drawPicture(p.get());
     }
-    LOGI("------- DrawPicture");
 }
 
 void SkiaCanvas::ClipRect(const Rect& rect, ClipOp op)
 {
     SkRect clipRect = SkRect::MakeLTRB(rect.GetLeft(), rect.GetTop(), rect.GetRight(), rect.GetBottom());
     SkClipOp clipOp = static_cast<SkClipOp>(op);
+    if (!IsTileSafe(op)) {
+        EndTiledRecording();
+    }
     skiaCanvas_->clipRect(clipRect, clipOp);
+    RecordState([clipRect, clipOp](SkCanvas& canvas) { canvas.clipRect(clipRect, clipOp); });
 }
 
 void SkiaCanvas::ClipRoundRect(const RoundRect& roundRect, ClipOp op)
@@ -419,7 +535,11 @@ void SkiaCanvas::ClipRoundRect(const RoundRect& roundRect, ClipOp op)
     SkRRect rRect;
     RoundRectCastToSkRRect(roundRect, rRect);
     SkClipOp clipOp = static_cast<SkClipOp>(op);
+    if (!IsTileSafe(op)) {
+        EndTiledRecording();
+    }
     skiaCanvas_->clipRRect(rRect, clipOp);
+    RecordState([rRect, clipOp](SkCanvas& canvas) { canvas.clipRRect(rRect, clipOp); });
 }
 
 void SkiaCanvas::ClipPath(const Path& path, ClipOp op)
@@ -427,7 +547,12 @@ void SkiaCanvas::ClipPath(const Path& path, ClipOp op)
     auto skPathImpl = path.GetImpl<SkiaPath>();
     if (skPathImpl != nullptr) {
         SkClipOp clipOp = static_cast<SkClipOp>(op);
-        skiaCanvas_->clipPath(skPathImpl->GetPath(), clipOp);
+        if (!IsTileSafe(op)) {
+            EndTiledRecording();
+        }
+        const SkPath& path = skPathImpl->GetPath();
+        skiaCanvas_->clipPath(path, clipOp);
+        RecordState([path, clipOp](SkCanvas& canvas) { canvas.clipPath(path, clipOp); });
     }
 }
 
@@ -435,45 +560,58 @@ void SkiaCanvas::SetMatrix(const Matrix& matrix)
 {
     auto m = matrix.GetImpl<SkiaMatrix>();
     if (m != nullptr) {
-        skiaCanvas_->setMatrix(m->ExportSkiaMatrix());
+        const SkMatrix& skMatrix = m->ExportSkiaMatrix();
+        skiaCanvas_->setMatrix(skMatrix);
+        RecordState([skMatrix](SkCanvas& canvas) { canvas.setMatrix(skMatrix); });
     }
 }
 
 void SkiaCanvas::ResetMatrix()
 {
     skiaCanvas_->resetMatrix();
+    RecordState([](SkCanvas& canvas) { canvas.resetMatrix(); });
 }
 
 void SkiaCanvas::ConcatMatrix(const Matrix& matrix)
 {
     auto m = matrix.GetImpl<SkiaMatrix>();
     if (m != nullptr) {
-        skiaCanvas_->concat(m->ExportSkiaMatrix());
+        const SkMatrix& skMatrix = m->ExportSkiaMatrix();
+        skiaCanvas_->concat(skMatrix);
+        RecordState([skMatrix](SkCanvas& canvas) { canvas.concat(skMatrix); });
     }
 }
 
 void SkiaCanvas::Translate(scalar dx, scalar dy)
 {
     skiaCanvas_->translate(dx, dy);
+    RecordState([dx, dy](SkCanvas& canvas) { canvas.translate(dx, dy); });
 }
 
 void SkiaCanvas::Scale(scalar sx, scalar sy)
 {
     skiaCanvas_->scale(sx, sy);
+    RecordState([sx, sy](SkCanvas& canvas) { canvas.scale(sx, sy); });
 }
 
 void SkiaCanvas::Rotate(scalar deg)
 {
     skiaCanvas_->rotate(deg);
+    RecordState([deg](SkCanvas& canvas) { canvas.rotate(deg); });
 }
 
 void SkiaCanvas::Shear(scalar sx, scalar sy)
 {
     skiaCanvas_->skew(sx, sy);
+    RecordState([sx, sy](SkCanvas& canvas) { canvas.skew(sx, sy); });
 }
 
 void SkiaCanvas::Flush()
 {
+    if (IsTiledRecording()) {
+        RasterizeTiles();
+        BeginTiledRecording();
+    }
     skiaCanvas_->flush();
 }
 
@@ -485,6 +623,10 @@ void SkiaCanvas::Clear(ColorQuad color)
 void SkiaCanvas::Save()
 {
     skiaCanvas_->save();
+    if (IsTiledRecording()) {
+        saveStack_.push_back(stateOps_.size());
+        RecordState([](SkCanvas& canvas) { canvas.save(); });
+    }
 }
 
 void SkiaCanvas::SaveLayer(const Rect& rect, const Brush& brush)
@@ -492,22 +634,38 @@ void SkiaCanvas::SaveLayer(const Rect& rect, const Brush& brush)
     SkRect bounds = SkRect::MakeLTRB(rect.GetLeft(), rect.GetTop(), rect.GetRight(), rect.GetBottom());
     SkPaint paint;
     skiaPaint_.BrushToSkPaint(brush, paint);
+    EndTiledRecording();
     skiaCanvas_->saveLayer(bounds, &paint);
 }
 
 void SkiaCanvas::Restore()
 {
     skiaCanvas_->restore();
+    if (IsTiledRecording() && !saveStack_.empty()) {
+        stateOps_.resize(saveStack_.back());
+        saveStack_.pop_back();
+    }
+}
+
+void SkiaCanvas::SetRasterThreadCount(uint32_t count)
+{
+    rasterThreadCount_ = std::max(count, 1u);
 }
 
 void SkiaCanvas::AttachPen(const Pen& pen)
 {
     skiaPaint_.ApplyPenToStroke(pen);
+    if (!HasTileSafePaints()) {
+        EndTiledRecording();
+    }
 }
 
 void SkiaCanvas::AttachBrush(const Brush& brush)
 {
     skiaPaint_.ApplyBrushToFill(brush);
+    if (!HasTileSafePaints()) {
+        EndTiledRecording();
+    }
 }
 
 void SkiaCanvas::DetachPen()
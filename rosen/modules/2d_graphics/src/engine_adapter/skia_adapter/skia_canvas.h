@@ -16,12 +16,16 @@
 #ifndef SKIACANVAS_H
 #define SKIACANVAS_H
 
+#include <functional>
+#include <vector>
+
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPoint3.h"
 #include "include/core/SkRRect.h"
 #include "include/utils/SkShadowUtils.h"
@@ -41,7 +45,7 @@ class SkiaCanvas : public CoreCanvasImpl {
 public:
     static inline constexpr AdapterType TYPE = AdapterType::SKIA_ADAPTER;
     SkiaCanvas();
-    ~SkiaCanvas() override {};
+    ~SkiaCanvas() override;
     AdapterType GetType() const override
     {
         return AdapterType::SKIA_ADAPTER;
@@ -93,6 +97,7 @@ public:
     void Save() override;
     void SaveLayer(const Rect& rect, const Brush& brush) override;
     void Restore() override;
+    void SetRasterThreadCount(uint32_t count) override;
 
     // paint
     void AttachPen(const Pen& pen) override;
@@ -100,12 +105,30 @@ public:
     void DetachPen() override;
     void DetachBrush() override;
 
-    SkCanvas* ExportSkCanvas() const;
+    // while the draw calls are recorded for the tiles, this ends the recording and returns a canvas on the bitmap
+    SkCanvas* ExportSkCanvas();
+    // draws on a canvas owned by someone else, such as a picture recorder
+    void ImportSkCanvas(SkCanvas* skCanvas);
 
 private:
     void RoundRectCastToSkRRect(const RoundRect& roundRect, SkRRect& skRRect) const;
+    void BindBitmap(const SkBitmap& bitmap);
+    bool IsTiledRecording() const;
+    void BeginTiledRecording();
+    void RasterizeTiles();
+    void EndTiledRecording();
+    bool HasTileSafePaints();
+    void RecordState(std::function<void(SkCanvas&)> op);
+
     std::shared_ptr<SkCanvas> skiaCanvas_;
     SkiaPaint skiaPaint_;
+    // with more than one raster thread the draw calls on the bound bitmap are recorded and rasterized in tiles
+    SkBitmap bitmap_;
+    uint32_t rasterThreadCount_ = 1;
+    std::unique_ptr<SkPictureRecorder> recorder_;
+    // the saves, clips and matrix changes still in effect, replayed when a recording is continued after a Flush
+    std::vector<std::function<void(SkCanvas&)>> stateOps_;
+    std::vector<size_t> saveStack_; // size of stateOps_ at each open Save
 };
 } // namespace Drawing
 } // namespace Rosen
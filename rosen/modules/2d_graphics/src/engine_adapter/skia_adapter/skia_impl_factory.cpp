@@ -27,6 +27,7 @@
 #include "skia_adapter/skia_path.h"
 #include "skia_adapter/skia_path_effect.h"
 #include "skia_adapter/skia_picture.h"
+#include "skia_adapter/skia_picture_recorder.h"
 #include "skia_adapter/skia_shader_effect.h"
 
 namespace OHOS {
@@ -52,6 +53,11 @@ std::unique_ptr<PictureImpl> SkiaImplFactory::CreatePicture()
     return std::make_unique<SkiaPicture>();
 }
 
+std::unique_ptr<PictureRecorderImpl> SkiaImplFactory::CreatePictureRecorder()
+{
+    return std::make_unique<SkiaPictureRecorder>();
+}
+
 std::unique_ptr<PathImpl> SkiaImplFactory::CreatePath()
 {
     return std::make_unique<SkiaPath>();
@@ -28,6 +28,7 @@
 #include "impl_interface/path_effect_impl.h"
 #include "impl_interface/path_impl.h"
 #include "impl_interface/picture_impl.h"
+#include "impl_interface/picture_recorder_impl.h"
 #include "impl_interface/shader_effect_impl.h"
 
 namespace OHOS {
@@ -39,6 +40,7 @@ public:
     static std::unique_ptr<BitmapImpl> CreateBitmap();
     static std::unique_ptr<ImageImpl> CreateImage();
     static std::unique_ptr<PictureImpl> CreatePicture();
+    static std::unique_ptr<PictureRecorderImpl> CreatePictureRecorder();
     static std::unique_ptr<PathImpl> CreatePath();
     static std::unique_ptr<ColorFilterImpl> CreateColorFilter();
     static std::unique_ptr<MaskFilterImpl> CreateMaskFilter();
@@ -26,22 +26,30 @@
 namespace OHOS {
 namespace Rosen {
 namespace Drawing {
-SkiaPaint::SkiaPaint() noexcept
-    : stroke_(std::make_shared<PaintData>()), fill_(std::make_shared<PaintData>()), isStrokeFirst_(false)
-{}
+SkiaPaint::SkiaPaint() noexcept : isStrokeFirst_(false) {}
 
 void SkiaPaint::ApplyBrushToFill(const Brush& brush)
 {
-    fill_->paint.reset();
-    fill_->isEnabled = true;
-    BrushToSkPaint(brush, fill_->paint);
+    if (brush_ != brush) {
+        brush_ = brush;
+        isBrushDirty_ = true;
+    }
+    if (!fill_.isEnabled) {
+        fill_.isEnabled = true;
+        UpdateSortedPaints();
+    }
 }
 
 void SkiaPaint::ApplyPenToStroke(const Pen& pen)
 {
-    stroke_->paint.reset();
-    stroke_->isEnabled = true;
-    PenToSkPaint(pen, stroke_->paint);
+    if (pen_ != pen) {
+        pen_ = pen;
+        isPenDirty_ = true;
+    }
+    if (!stroke_.isEnabled) {
+        stroke_.isEnabled = true;
+        UpdateSortedPaints();
+    }
 }
 
 void SkiaPaint::BrushToSkPaint(const Brush& brush, SkPaint& paint) const
@@ -141,35 +149,58 @@ void SkiaPaint::PenToSkPaint(const Pen& pen, SkPaint& paint) const
 
 void SkiaPaint::DisableStroke()
 {
-    stroke_->isEnabled = false;
+    if (stroke_.isEnabled) {
+        stroke_.isEnabled = false;
+        UpdateSortedPaints();
+    }
 }
 
 void SkiaPaint::DisableFill()
 {
-    fill_->isEnabled = false;
+    if (fill_.isEnabled) {
+        fill_.isEnabled = false;
+        UpdateSortedPaints();
+    }
+}
+
+const SortedPaints& SkiaPaint::GetSortedPaints()
+{
+    if (isPenDirty_ && stroke_.isEnabled) {
+        stroke_.paint.reset();
+        PenToSkPaint(pen_, stroke_.paint);
+        isPenDirty_ = false;
+    }
+    if (isBrushDirty_ && fill_.isEnabled) {
+        fill_.paint.reset();
+        BrushToSkPaint(brush_, fill_.paint);
+        isBrushDirty_ = false;
+    }
+    return sortedPaints_;
 }
 
-std::vector<std::shared_ptr<PaintData>> SkiaPaint::GetSortedPaints() const
+void SkiaPaint::UpdateSortedPaints()
 {
-    std::vector<std::shared_ptr<PaintData>> paints;
-    if (IsStrokeFirst() && stroke_->isEnabled && fill_->isEnabled) {
-        paints.push_back(stroke_);
-        paints.push_back(fill_);
-        return paints;
+    sortedPaints_.count_ = 0;
+    if (IsStrokeFirst() && stroke_.isEnabled && fill_.isEnabled) {
+        sortedPaints_.paints_[sortedPaints_.count_++] = &stroke_;
+        sortedPaints_.paints_[sortedPaints_.count_++] = &fill_;
+        return;
     }
 
-    if (stroke_->isEnabled) {
-        paints.push_back(stroke_);
+    if (stroke_.isEnabled) {
+        sortedPaints_.paints_[sortedPaints_.count_++] = &stroke_;
     }
-    if (fill_->isEnabled) {
-        paints.push_back(fill_);
+    if (fill_.isEnabled) {
+        sortedPaints_.paints_[sortedPaints_.count_++] = &fill_;
     }
-    return paints;
 }
 
 void SkiaPaint::SetStrokeFirst(bool isStrokeFirst)
 {
-    isStrokeFirst_ = isStrokeFirst;
+    if (isStrokeFirst_ != isStrokeFirst) {
+        isStrokeFirst_ = isStrokeFirst;
+        UpdateSortedPaints();
+    }
 }
 
 bool SkiaPaint::IsStrokeFirst() const
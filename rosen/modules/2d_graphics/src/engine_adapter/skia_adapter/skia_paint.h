@@ -16,8 +16,7 @@
 #ifndef SKIA_PAINT_H
 #define SKIA_PAINT_H
 
-#include <memory>
-#include <vector>
+#include <array>
 
 #include "include/core/SkPaint.h"
 
@@ -32,10 +31,40 @@ struct PaintData {
     bool isEnabled = false;
 };
 
+// The enabled paints of a draw call in drawing order, at most a stroke and a fill.
+class SortedPaints {
+public:
+    static constexpr size_t MAX_PAINT_COUNT = 2;
+
+    PaintData* const* begin() const
+    {
+        return paints_.data();
+    }
+    PaintData* const* end() const
+    {
+        return paints_.data() + count_;
+    }
+    bool empty() const
+    {
+        return count_ == 0;
+    }
+    size_t size() const
+    {
+        return count_;
+    }
+
+private:
+    friend class SkiaPaint;
+    std::array<PaintData*, MAX_PAINT_COUNT> paints_ = {};
+    size_t count_ = 0;
+};
+
 class SkiaPaint {
 public:
     SkiaPaint() noexcept;
     ~SkiaPaint() {};
+    SkiaPaint(const SkiaPaint&) = delete;
+    SkiaPaint& operator=(const SkiaPaint&) = delete;
 
     void ApplyBrushToFill(const Brush& brush);
     void ApplyPenToStroke(const Pen& pen);
@@ -46,15 +75,26 @@ public:
     void DisableStroke();
     void DisableFill();
 
-    std::vector<std::shared_ptr<PaintData>> GetSortedPaints() const;
+    /*
+     * The returned paints stay valid until the next attach, detach or SetStrokeFirst. An attached pen or brush is
+     * turned into its SkPaint here, once per change, not on every attach.
+     */
+    const SortedPaints& GetSortedPaints();
     void SetStrokeFirst(bool isStrokeFirst);
     bool IsStrokeFirst() const;
 
 private:
     void ApplyFilter(SkPaint& paint, const Filter& filter) const;
+    void UpdateSortedPaints();
 
-    std::shared_ptr<PaintData> stroke_;
-    std::shared_ptr<PaintData> fill_;
+    PaintData stroke_;
+    PaintData fill_;
+    Pen pen_;
+    Brush brush_;
+    // dirty from the start, since pen_ and brush_ compare equal to a default pen and brush that has no SkPaint yet.
+    bool isPenDirty_ = true;
+    bool isBrushDirty_ = true;
+    SortedPaints sortedPaints_;
     bool isStrokeFirst_;
 };
 } // namespace Drawing
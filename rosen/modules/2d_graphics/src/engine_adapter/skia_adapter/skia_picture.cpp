@@ -20,10 +20,26 @@ namespace Rosen {
 namespace Drawing {
 SkiaPicture::SkiaPicture() noexcept : skiaPicture_(nullptr) {}
 
+SkiaPicture::SkiaPicture(sk_sp<SkPicture> picture) noexcept : skiaPicture_(std::move(picture)) {}
+
 const sk_sp<SkPicture> SkiaPicture::GetPicture() const
 {
     return skiaPicture_;
 }
+
+Rect SkiaPicture::GetBounds() const
+{
+    if (skiaPicture_ == nullptr) {
+        return Rect();
+    }
+    const SkRect& cullRect = skiaPicture_->cullRect();
+    return Rect(cullRect.left(), cullRect.top(), cullRect.right(), cullRect.bottom());
+}
+
+int SkiaPicture::ApproximateOpCount() const
+{
+    return (skiaPicture_ != nullptr) ? skiaPicture_->approximateOpCount() : 0;
+}
 } // namespace Drawing
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -27,6 +27,7 @@ class SkiaPicture : public PictureImpl {
 public:
     static inline constexpr AdapterType TYPE = AdapterType::SKIA_ADAPTER;
     SkiaPicture() noexcept;
+    explicit SkiaPicture(sk_sp<SkPicture> picture) noexcept;
     ~SkiaPicture() override {}
     AdapterType GetType() const override
     {
@@ -34,6 +35,9 @@ public:
     }
     const sk_sp<SkPicture> GetPicture() const;
 
+    Rect GetBounds() const override;
+    int ApproximateOpCount() const override;
+
 private:
     sk_sp<SkPicture> skiaPicture_;
 };
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "skia_picture_recorder.h"
+
+#include "skia_picture.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Drawing {
+SkiaPictureRecorder::SkiaPictureRecorder() noexcept : bounds_(SkRect::MakeEmpty()), canvas_(nullptr) {}
+
+std::shared_ptr<CoreCanvasImpl> SkiaPictureRecorder::BeginRecording(const Rect& bounds)
+{
+    bounds_ = SkRect::MakeLTRB(bounds.GetLeft(), bounds.GetTop(), bounds.GetRight(), bounds.GetBottom());
+    SkCanvas* recordingCanvas = recorder_.beginRecording(bounds_, &bbhFactory_);
+    if (canvas_ == nullptr) {
+        canvas_ = std::make_shared<SkiaCanvas>();
+    }
+    canvas_->ImportSkCanvas(recordingCanvas);
+    return canvas_;
+}
+
+std::shared_ptr<PictureImpl> SkiaPictureRecorder::FinishRecording()
+{
+    if (recorder_.getRecordingCanvas() == nullptr) {
+        LOGE("nothing is being recorded");
+        return nullptr;
+    }
+    sk_sp<SkPicture> picture = recorder_.finishRecordingAsPicture();
+    BeginRecording(Rect(bounds_.left(), bounds_.top(), bounds_.right(), bounds_.bottom()));
+    return std::make_shared<SkiaPicture>(picture);
+}
+} // namespace Drawing
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SKIA_PICTURE_RECORDER_H
+#define SKIA_PICTURE_RECORDER_H
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkPictureRecorder.h"
+#include "skia_canvas.h"
+
+#include "impl_interface/picture_recorder_impl.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Drawing {
+/*
+ * Records into an SkPicture. The R-tree built at the end of a recording trims the bounds of the picture to what
+ * was actually drawn and lets a clipped playback skip the commands outside of the clip.
+ */
+class SkiaPictureRecorder : public PictureRecorderImpl {
+public:
+    static inline constexpr AdapterType TYPE = AdapterType::SKIA_ADAPTER;
+    SkiaPictureRecorder() noexcept;
+    ~SkiaPictureRecorder() override {}
+    AdapterType GetType() const override
+    {
+        return AdapterType::SKIA_ADAPTER;
+    }
+
+    std::shared_ptr<CoreCanvasImpl> BeginRecording(const Rect& bounds) override;
+    std::shared_ptr<PictureImpl> FinishRecording() override;
+
+private:
+    SkPictureRecorder recorder_;
+    SkRTreeFactory bbhFactory_;
+    SkRect bounds_;
+    std::shared_ptr<SkiaCanvas> canvas_;
+};
+} // namespace Drawing
+} // namespace Rosen
+} // namespace OHOS
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "skia_tile_rasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Drawing {
+namespace {
+SkExecutor& GetExecutor()
+{
+    // the calling thread draws tiles as well, so the pool needs one thread less than there are cores
+    static std::unique_ptr<SkExecutor> executor =
+        SkExecutor::MakeFIFOThreadPool(std::max(SkiaTileRasterizer::GetMaxThreadCount() - 1, 1));
+    return *executor;
+}
+
+void DrawTile(const SkBitmap& bitmap, const sk_sp<SkPicture>& picture, const SkIRect& tileRect)
+{
+    // a canvas on the whole bitmap keeps the device coordinates and matrices of a direct draw, the tile is its clip
+    SkCanvas canvas(bitmap);
+    canvas.clipRect(SkRect::Make(tileRect));
+    canvas.drawPicture(picture);
+}
+}
+
+int SkiaTileRasterizer::GetMaxThreadCount()
+{
+    return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+}
+
+void SkiaTileRasterizer::Rasterize(const SkBitmap& bitmap, const sk_sp<SkPicture>& picture, int threadCount)
+{
+    if (picture == nullptr || bitmap.drawsNothing()) {
+        return;
+    }
+    int columns = (bitmap.width() + TILE_SIZE - 1) / TILE_SIZE;
+    int tileCount = columns * ((bitmap.height() + TILE_SIZE - 1) / TILE_SIZE);
+    std::atomic<int> nextTile { 0 };
+    auto drawTiles = [&]() {
+        for (int i = nextTile++; i < tileCount; i = nextTile++) {
+            SkIRect tileRect = SkIRect::MakeXYWH((i % columns) * TILE_SIZE, (i / columns) * TILE_SIZE,
+                TILE_SIZE, TILE_SIZE);
+            if (tileRect.intersect(bitmap.bounds())) {
+                DrawTile(bitmap, picture, tileRect);
+            }
+        }
+    };
+
+    int helperCount = std::min({ threadCount, tileCount, GetMaxThreadCount() }) - 1;
+    std::mutex mutex;
+    std::condition_variable cv;
+    int runningHelpers = helperCount;
+    for (int i = 0; i < helperCount; i++) {
+        GetExecutor().add([&]() {
+            drawTiles();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--runningHelpers == 0) {
+                cv.notify_one();
+            }
+        });
+    }
+    drawTiles();
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&runningHelpers]() { return runningHelpers == 0; });
+}
+} // namespace Drawing
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SKIA_TILE_RASTERIZER_H
+#define SKIA_TILE_RASTERIZER_H
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkPicture.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Drawing {
+/*
+ * Plays a picture back into a bitmap tile by tile, spreading the tiles over a thread pool shared by all canvases.
+ * Every tile is drawn on the whole bitmap clipped to the tile, so the result is the same as drawing the picture
+ * directly as long as no pixel depends on pixels of another tile: the picture must not hold layers, filters or
+ * clips that grow the clip.
+ */
+class SkiaTileRasterizer {
+public:
+    static constexpr int TILE_SIZE = 256;
+
+    // draws the tiles on up to threadCount threads, the calling one included, and returns when all are done
+    static void Rasterize(const SkBitmap& bitmap, const sk_sp<SkPicture>& picture, int threadCount);
+    static int GetMaxThreadCount();
+};
+} // namespace Drawing
+} // namespace Rosen
+} // namespace OHOS
+#endif
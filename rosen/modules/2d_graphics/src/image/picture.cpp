@@ -21,6 +21,18 @@ namespace OHOS {
 namespace Rosen {
 namespace Drawing {
 Picture::Picture() noexcept : pictureImplPtr(ImplFactory::CreatePictureImpl()) {}
+
+Picture::Picture(std::shared_ptr<PictureImpl> pictureImpl) noexcept : pictureImplPtr(std::move(pictureImpl)) {}
+
+Rect Picture::GetBounds() const
+{
+    return pictureImplPtr->GetBounds();
+}
+
+int Picture::ApproximateOpCount() const
+{
+    return pictureImplPtr->ApproximateOpCount();
+}
 } // namespace Drawing
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
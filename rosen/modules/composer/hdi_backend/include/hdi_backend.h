@@ -16,6 +16,7 @@
 #ifndef HDI_BACKEND_HDI_BACKEND_H
 #define HDI_BACKEND_HDI_BACKEND_H
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 #include <refbase.h>
@@ -48,8 +49,13 @@ public:
     RosenError RegScreenHotplug(OnScreenHotplugFunc func, void* data);
     RosenError RegPrepareComplete(OnPrepareCompleteFunc func, void* data);
     void Repaint(std::vector<OutputPtr> &outputs);
+    /* the default screen of the screen manager, committed first and the source of vsync */
+    void SetPrimaryScreen(uint32_t screenId);
     /* for RS end */
 
+    /* only used for mock and fake devices, before RegScreenHotplug */
+    void SetHdiDevice(Base::HdiDevice* device);
+
 private:
     HdiBackend() = default;
     virtual ~HdiBackend() = default;
@@ -60,6 +66,7 @@ private:
     HdiBackend& operator=(HdiBackend&& rhs) = delete;
 
     Base::HdiDevice *device_ = nullptr;
+    bool hotPlugRegistered_ = false;
     void* onHotPlugCbData_ = nullptr;
     void* onPrepareCompleteCbData_ = nullptr;
     OnScreenHotplugFunc onScreenHotplugCb_ = nullptr;
@@ -71,6 +78,8 @@ private:
     void OnHdiBackendConnected(uint32_t screenId, bool connected);
     void CreateHdiOutput(uint32_t screenId);
     void OnScreenHotplug(uint32_t screenId, bool connected);
+    void RepaintOutput(OutputPtr &output);
+    sptr<SyncFence> &GetLastPresentFence(uint32_t screenId);
     void ReorderLayerInfo(std::vector<LayerInfoPtr> &newLayerInfos);
     void SetHdiLayerInfo(uint32_t screenId, uint32_t layerId, LayerPtr &layer);
     void OnPrepareComplete(bool needFlush, OutputPtr &output, std::vector<LayerInfoPtr> &newLayerInfos);
@@ -83,7 +92,9 @@ private:
 
     sptr<VSyncSampler> sampler_ = nullptr;
     std::unordered_map<int, sptr<SurfaceBuffer>> lastFrameBuffers_;
-    sptr<SyncFence> lastPresentFence_ = SyncFence::INVALID_FENCE;
+    // screenId -- present fence of the last commit
+    std::unordered_map<uint32_t, sptr<SyncFence>> lastPresentFences_;
+    std::atomic<uint32_t> primaryScreenId_ = UINT32_MAX;
 };
 } // namespace Rosen
 } // namespace OHOS
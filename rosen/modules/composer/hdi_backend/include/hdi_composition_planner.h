@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HDI_BACKEND_HDI_COMPOSITION_PLANNER_H
+#define HDI_BACKEND_HDI_COMPOSITION_PLANNER_H
+
+#include <stdint.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "display_type.h"
+
+namespace OHOS {
+namespace Rosen {
+struct HdiPlannerLayer {
+    uint32_t layerId = 0;
+    uint32_t zorder = 0;
+    int64_t area = 0;
+    int32_t format = PIXEL_FMT_RGBA_8888;
+    bool bufferChanged = true;
+    // requested by RS, or demoted by the device last frame
+    bool clientOnly = false;
+    // result of Plan
+    CompositionType compositionType = CompositionType::COMPOSITION_DEVICE;
+};
+
+/*
+ * Chooses which layers of an output are composed by the client (GPU) and which take a plane, seeing all layers of
+ * the output at once. Client layers form one contiguous range of the z-order, composed into the client target which
+ * takes a plane itself; among the ranges leaving no more layers than planes, the one of the lowest GPU cost is taken.
+ * The assignment of the last frame is kept unless the best one is clearly cheaper, so that layers do not ping-pong
+ * between device and client composition.
+ */
+class HdiCompositionPlanner {
+public:
+    HdiCompositionPlanner() = default;
+    ~HdiCompositionPlanner() = default;
+
+    // 0, the default, leaves the composition types requested by RS as they are
+    void SetPlaneCount(uint32_t planeCount);
+    uint32_t GetPlaneCount() const;
+
+    void Plan(std::vector<HdiPlannerLayer> &layers);
+    // the device composes the layer by the client although it was planned on a plane
+    void OnDeviceReject(const HdiPlannerLayer &layer);
+
+    // GPU cost of composing the layer into the client target
+    static int64_t GetClientCost(const HdiPlannerLayer &layer);
+
+private:
+    struct Rejection {
+        int32_t format;
+        int64_t area;
+        uint64_t frame;
+    };
+
+    bool IsRejected(const HdiPlannerLayer &layer) const;
+    void PruneRejections(const std::vector<HdiPlannerLayer> &layers);
+
+    uint32_t planeCount_ = 0;
+    uint64_t frame_ = 0;
+    std::unordered_set<uint32_t> lastClientLayers_;
+    // layerId -- what the layer looked like when the device demoted it
+    std::unordered_map<uint32_t, Rejection> rejections_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // HDI_BACKEND_HDI_COMPOSITION_PLANNER_H
@@ -27,6 +27,39 @@
 
 namespace OHOS {
 namespace Rosen {
+// fields of HdiLayerState, a SetLayerState call sets the ones flagged in its mask
+enum HdiLayerStateField : uint32_t {
+    LAYER_STATE_ALPHA = 1 << 0,
+    LAYER_STATE_SIZE = 1 << 1,
+    LAYER_STATE_TRANSFORM = 1 << 2,
+    LAYER_STATE_VISIBLE_REGION = 1 << 3,
+    LAYER_STATE_DIRTY_REGION = 1 << 4,
+    LAYER_STATE_BUFFER = 1 << 5,
+    LAYER_STATE_COMPOSITION_TYPE = 1 << 6,
+    LAYER_STATE_BLEND_TYPE = 1 << 7,
+    LAYER_STATE_CROP = 1 << 8,
+    LAYER_STATE_ZORDER = 1 << 9,
+    LAYER_STATE_PREMULTI = 1 << 10,
+    LAYER_STATE_ALL = (1 << 11) - 1,
+};
+
+// everything HdiLayer programs into a device layer per frame
+struct HdiLayerState {
+    LayerAlpha alpha = {};
+    IRect layerSize = {};
+    TransformType transform = TransformType::ROTATE_NONE;
+    uint32_t visibleNum = 0;
+    IRect visibleRegion = {};
+    IRect dirtyRegion = {};
+    const BufferHandle *buffer = nullptr;
+    sptr<SyncFence> acquireFence = SyncFence::INVALID_FENCE;
+    CompositionType compositionType = CompositionType::COMPOSITION_DEVICE;
+    BlendType blendType = BlendType::BLEND_NONE;
+    IRect crop = {};
+    uint32_t zorder = 0;
+    bool preMulti = false;
+};
+
 namespace Base {
 class HdiDevice {
 public:
@@ -83,6 +116,11 @@ public:
     virtual int32_t SetLayerMetaData(uint32_t screenId, uint32_t layerId, const std::vector<HDRMetaData> &metaData) = 0;
     virtual int32_t SetLayerMetaDataSet(uint32_t screenId, uint32_t layerId, HDRMetadataKey key,
                                         const std::vector<uint8_t> &metaData) = 0;
+    /* sets the fields of state flagged in fields at once, devices returning DISPLAY_NOT_SUPPORT get a call per field */
+    virtual int32_t SetLayerState(uint32_t screenId, uint32_t layerId, const HdiLayerState &state, uint32_t fields)
+    {
+        return DISPLAY_NOT_SUPPORT;
+    }
     /* set & get device layer info end */
 
     virtual int32_t CreateLayer(uint32_t screenId, const LayerInfo &layerInfo, uint32_t &layerId) = 0;
@@ -16,10 +16,12 @@
 #ifndef HDI_BACKEND_HDI_FRAMEBUFFER_SURFACE_H
 #define HDI_BACKEND_HDI_FRAMEBUFFER_SURFACE_H
 
+#include <atomic>
 #include <condition_variable>
 #include <queue>
 #include <refbase.h>
 #include <surface.h>
+#include <fence_watcher.h>
 #include <sync_fence.h>
 #include "surface_buffer.h"
 
@@ -43,6 +45,9 @@ public:
     static sptr<HdiFramebufferSurface> CreateFramebufferSurface();
     sptr<OHOS::Surface> GetSurface();
     std::unique_ptr<FrameBufferEntry> GetFramebuffer();
+    // The release is deferred until the release fence signals, or until RELEASE_FENCE_TIMEOUT_MS passed, in which
+    // case the buffer is released with the pending fence for the producer to wait on. A deferred release only
+    // reports its failure or timeout through the return value of the next call.
     int32_t ReleaseFramebuffer(
         sptr<SurfaceBuffer> &buffer, const sptr<SyncFence> &releaseFence);
 
@@ -54,13 +59,18 @@ private:
     sptr<OHOS::Surface> consumerSurface_ = nullptr;
     sptr<OHOS::Surface> producerSurface_ = nullptr;
     std::queue<std::unique_ptr<FrameBufferEntry>> availableBuffers_;
+    // the first error of the releases deferred since the last ReleaseFramebuffer
+    std::atomic<int32_t> deferredReleaseRet_ = SURFACE_ERROR_OK;
 
     static constexpr uint32_t MAX_BUFFER_SIZE = 3;
+    static constexpr int32_t RELEASE_FENCE_TIMEOUT_MS = 3000;
 
     HdiFramebufferSurface();
     virtual ~HdiFramebufferSurface() noexcept;
 
     void OnBufferAvailable() override;
+    int32_t ReleaseFramebufferNow(sptr<SurfaceBuffer> &buffer, const sptr<SyncFence> &releaseFence);
+    void OnReleaseFenceDone(sptr<SurfaceBuffer> &buffer, const sptr<SyncFence> &releaseFence, FenceStatus status);
     OHOS::SurfaceError SetBufferQueueSize(uint32_t bufferSize);
     OHOS::SurfaceError CreateSurface(sptr<HdiFramebufferSurface> &fbSurface);
 };
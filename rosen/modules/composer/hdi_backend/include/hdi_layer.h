@@ -24,6 +24,7 @@
 #include "surface_type.h"
 #include "display_type.h"
 
+#include "hdi_device.h"
 #include "hdi_layer_info.h"
 
 namespace OHOS {
@@ -53,6 +54,9 @@ public:
     void UpdateLayerInfo(const LayerInfoPtr &layerInfo);
     void SetHdiLayerInfo();
     uint32_t GetLayerId() const;
+    bool IsBufferChanged() const;
+    // the device composes the layer by the client this frame although it was sent as a device layer
+    bool IsRejectedByDevice() const;
     void RecordPresentTime(int64_t timestamp);
     void Dump(std::string &result);
 
@@ -61,6 +65,9 @@ public:
     int32_t GetLayerColorDataSpace(ColorDataSpace &colorSpace) const;
     int32_t SetLayerMetaData(const std::vector<HDRMetaData> &metaData) const;
     int32_t SetLayerMetaDataSet(HDRMetadataKey key, const std::vector<uint8_t> &metaData) const;
+
+    /* only used for mock and fake devices, before Init */
+    void SetHdiDevice(Base::HdiDevice* device);
 private:
     // layer buffer & fence
     class LayerBufferInfo : public RefBase {
@@ -81,11 +88,18 @@ private:
     sptr<LayerBufferInfo> currSbuffer_ = nullptr;
     sptr<LayerBufferInfo> prevSbuffer_ = nullptr;
     LayerInfoPtr layerInfo_ = nullptr;
+    Base::HdiDevice *device_ = nullptr;
+    // what the device layer holds, only the fields flagged in sentFields_ are known
+    HdiLayerState sentState_;
+    uint32_t sentFields_ = 0;
+    bool rejectedByDevice_ = false;
 
     void CloseLayer();
     int32_t CreateLayer(const LayerInfoPtr &layerInfo);
     sptr<SyncFence> Merge(const sptr<SyncFence> &fence1, const sptr<SyncFence> &fence2);
     SurfaceError ReleasePrevBuffer();
+    uint32_t GetChangedFields(const HdiLayerState &state) const;
+    uint32_t SetLayerFields(HdiLayerState &state, uint32_t fields);
 
     inline void CheckRet(int32_t ret, const char* func);
 };
@@ -21,6 +21,8 @@
 #include <vector>
 #include <unordered_map>
 
+#include "hdi_composition_planner.h"
+#include "hdi_device.h"
 #include "hdi_log.h"
 #include "surface_type.h"
 #include "hdi_layer.h"
@@ -63,6 +65,13 @@ public:
     void Dump(std::string &result) const;
     void DumpFps(std::string &result, const std::string &arg) const;
     void RecordCompositionTime(int64_t timeStamp);
+    // planes of the screen available to its layers, 0 leaves the composition types requested by RS as they are
+    void SetPlaneCount(uint32_t planeCount);
+    // chooses the client layers before the layers are sent to the device
+    void PlanComposition();
+
+    /* only used for mock and fake devices, the layers created afterwards use it */
+    void SetHdiDevice(Base::HdiDevice* device);
 
 private:
     std::array<int64_t, COMPOSITION_RECORDS_NUM> compositionTimeRecords_ = {};
@@ -75,6 +84,8 @@ private:
     uint32_t screenId_;
     IRect outputDamage_;
     uint32_t outputDamageNum_;
+    Base::HdiDevice *device_ = nullptr;
+    HdiCompositionPlanner planner_;
 
     int32_t CreateLayer(uint64_t surfaceId, const LayerInfoPtr &layerInfo);
     void DeletePrevLayers();
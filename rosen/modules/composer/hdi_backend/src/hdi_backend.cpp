@@ -15,6 +15,7 @@
 
 #include "hdi_backend.h"
 
+#include <algorithm>
 #include <scoped_bytrace.h>
 #include "surface_buffer.h"
 
@@ -54,6 +55,20 @@ RosenError HdiBackend::RegPrepareComplete(OnPrepareCompleteFunc func, void* data
     return ROSEN_ERROR_OK;
 }
 
+void HdiBackend::SetHdiDevice(Base::HdiDevice* device)
+{
+    if (device == nullptr) {
+        HLOGE("Input HdiDevice is null");
+        return;
+    }
+
+    if (device_ != nullptr) {
+        HLOGW("HdiDevice has been changed");
+        return;
+    }
+    device_ = device;
+}
+
 void HdiBackend::Repaint(std::vector<OutputPtr> &outputs)
 {
     ScopedBytrace bytrace(__func__);
@@ -68,83 +83,108 @@ void HdiBackend::Repaint(std::vector<OutputPtr> &outputs)
         sampler_ = CreateVSyncSampler();
     }
 
-    int32_t ret = DISPLAY_SUCCESS;
-    for (auto &output : outputs) {
+    /* the primary screen is committed first, a slow external or virtual screen must not delay it */
+    uint32_t primaryScreenId = primaryScreenId_.load();
+    std::vector<OutputPtr> orderedOutputs(outputs);
+    std::stable_partition(orderedOutputs.begin(), orderedOutputs.end(), [primaryScreenId](const OutputPtr &output) {
+        return output != nullptr && output->GetScreenId() == primaryScreenId;
+    });
+    for (auto &output : orderedOutputs) {
         if (output == nullptr) {
             continue;
         }
-        const std::unordered_map<uint32_t, LayerPtr> &layersMap = output->GetLayers();
-        if (layersMap.empty()) {
-            HLOGI("layer map is empty, drop this frame");
-            continue;
-        }
+        RepaintOutput(output);
+    }
+    HLOGD("%{public}s: end", __func__);
+}
 
-        uint32_t screenId = output->GetScreenId();
-        for (auto iter = layersMap.begin(); iter != layersMap.end(); ++iter) {
-            const LayerPtr &layer = iter->second;
-            layer->SetHdiLayerInfo();
-        }
+void HdiBackend::RepaintOutput(OutputPtr &output)
+{
+    const std::unordered_map<uint32_t, LayerPtr> &layersMap = output->GetLayers();
+    if (layersMap.empty()) {
+        HLOGI("layer map is empty, drop this frame");
+        return;
+    }
 
-        bool needFlush = false;
-        ret = device_->PrepareScreenLayers(screenId, needFlush);
-        if (ret != DISPLAY_SUCCESS) {
-            HLOGE("PrepareScreenLayers failed, ret is %{public}d", ret);
-            return;
-        }
+    uint32_t screenId = output->GetScreenId();
+    output->PlanComposition();
+    for (auto iter = layersMap.begin(); iter != layersMap.end(); ++iter) {
+        const LayerPtr &layer = iter->second;
+        layer->SetHdiLayerInfo();
+    }
 
-        ret = UpdateLayerCompType(screenId, layersMap);
-        if (ret != DISPLAY_SUCCESS) {
-            return;
-        }
+    bool needFlush = false;
+    int32_t ret = device_->PrepareScreenLayers(screenId, needFlush);
+    if (ret != DISPLAY_SUCCESS) {
+        HLOGE("PrepareScreenLayers failed, ret is %{public}d", ret);
+        return;
+    }
 
-        std::vector<LayerPtr> compClientLayers;
-        std::vector<LayerInfoPtr> newLayerInfos;
-        for (auto iter = layersMap.begin(); iter != layersMap.end(); ++iter) {
-            const LayerPtr &layer = iter->second;
-            newLayerInfos.emplace_back(layer->GetLayerInfo());
-            if (layer->GetLayerInfo()->GetCompositionType() == CompositionType::COMPOSITION_CLIENT) {
-                compClientLayers.emplace_back(layer);
-            }
-        }
+    ret = UpdateLayerCompType(screenId, layersMap);
+    if (ret != DISPLAY_SUCCESS) {
+        return;
+    }
 
-        if (compClientLayers.size() > 0) {
-            needFlush = true;
-            HLOGD("Need flush framebuffer, client composition layer num is %{public}zu", compClientLayers.size());
+    std::vector<LayerPtr> compClientLayers;
+    std::vector<LayerInfoPtr> newLayerInfos;
+    for (auto iter = layersMap.begin(); iter != layersMap.end(); ++iter) {
+        const LayerPtr &layer = iter->second;
+        newLayerInfos.emplace_back(layer->GetLayerInfo());
+        if (layer->GetLayerInfo()->GetCompositionType() == CompositionType::COMPOSITION_CLIENT) {
+            compClientLayers.emplace_back(layer);
         }
+    }
 
-        OnPrepareComplete(needFlush, output, newLayerInfos);
+    if (compClientLayers.size() > 0) {
+        needFlush = true;
+        HLOGD("Need flush framebuffer, client composition layer num is %{public}zu", compClientLayers.size());
+    }
 
-        if (needFlush) {
-            if (FlushScreen(output, compClientLayers) != DISPLAY_SUCCESS) {
-                // return
-            }
-        }
+    OnPrepareComplete(needFlush, output, newLayerInfos);
 
-        sptr<SyncFence> fbFence = SyncFence::INVALID_FENCE;
-        ret = device_->Commit(screenId, fbFence);
-        if (ret != DISPLAY_SUCCESS) {
-            HLOGE("commit failed, ret is %{public}d", ret);
+    if (needFlush) {
+        if (FlushScreen(output, compClientLayers) != DISPLAY_SUCCESS) {
             // return
         }
+    }
 
-        ReleaseLayerBuffer(screenId, layersMap);
-
-        int64_t timestamp = lastPresentFence_->SyncFileReadTimestamp();
-        bool ret = false;
-        if (timestamp != SyncFence::FENCE_PENDING_TIMESTAMP) {
-            ret = sampler_->AddPresentFenceTime(timestamp);
-            for (auto iter = layersMap.begin(); iter != layersMap.end(); ++iter) {
-                const LayerPtr &layer = iter->second;
-                layer->RecordPresentTime(timestamp);
-                output->RecordCompositionTime(timestamp);
-            }
+    sptr<SyncFence> fbFence = SyncFence::INVALID_FENCE;
+    ret = device_->Commit(screenId, fbFence);
+    if (ret != DISPLAY_SUCCESS) {
+        HLOGE("commit failed, ret is %{public}d", ret);
+        // return
+    }
+
+    ReleaseLayerBuffer(screenId, layersMap);
+
+    /* the present fence of the last frame of this screen, the screens do not share a refresh */
+    sptr<SyncFence> &lastPresentFence = GetLastPresentFence(screenId);
+    int64_t timestamp = lastPresentFence->SyncFileReadTimestamp();
+    bool startSample = false;
+    if (timestamp != SyncFence::FENCE_PENDING_TIMESTAMP) {
+        for (auto iter = layersMap.begin(); iter != layersMap.end(); ++iter) {
+            const LayerPtr &layer = iter->second;
+            layer->RecordPresentTime(timestamp);
         }
-        if (ret) {
-            sampler_->BeginSample();
+        output->RecordCompositionTime(timestamp);
+        /* vsync is generated for the primary screen only */
+        if (screenId == primaryScreenId_) {
+            startSample = sampler_->AddPresentFenceTime(timestamp);
         }
-        lastPresentFence_ = fbFence;
-        HLOGD("%{public}s: end", __func__);
     }
+    if (startSample) {
+        sampler_->BeginSample();
+    }
+    lastPresentFence = fbFence;
+}
+
+sptr<SyncFence> &HdiBackend::GetLastPresentFence(uint32_t screenId)
+{
+    auto iter = lastPresentFences_.find(screenId);
+    if (iter == lastPresentFences_.end()) {
+        iter = lastPresentFences_.emplace(screenId, SyncFence::INVALID_FENCE).first;
+    }
+    return iter->second;
 }
 
 int32_t HdiBackend::UpdateLayerCompType(uint32_t screenId, const std::unordered_map<uint32_t, LayerPtr> &layersMap)
@@ -208,8 +248,12 @@ int32_t HdiBackend::FlushScreen(const OutputPtr &output, std::vector<LayerPtr> &
     }
 
     if (lastFrameBuffers_.find(output->GetScreenId()) != lastFrameBuffers_.end()) {
-        // wrong check
-        (void)output->ReleaseFramebuffer(lastFrameBuffers_[output->GetScreenId()], lastPresentFence_);
+        // the framebuffer is released asynchronously, a failure of an earlier release is reported here
+        int32_t ret = output->ReleaseFramebuffer(lastFrameBuffers_[output->GetScreenId()],
+                                                 GetLastPresentFence(output->GetScreenId()));
+        if (ret != SURFACE_ERROR_OK) {
+            HLOGE("ReleaseFramebuffer failed, ret is %{public}d", ret);
+        }
     }
     lastFrameBuffers_[output->GetScreenId()] = fbEntry->buffer;
 
@@ -299,8 +343,19 @@ void HdiBackend::OnHdiBackendConnected(uint32_t screenId, bool connected)
 void HdiBackend::CreateHdiOutput(uint32_t screenId)
 {
     OutputPtr newOutput = HdiOutput::CreateHdiOutput(screenId);
+    newOutput->SetHdiDevice(device_);
+    DisplayCapability capability = {};
+    if (device_ != nullptr && device_->GetScreenCapability(screenId, capability) == DISPLAY_SUCCESS) {
+        newOutput->SetPlaneCount(capability.supportLayers);
+    }
     newOutput->Init();
     outputs_.emplace(screenId, newOutput);
+
+}
+
+void HdiBackend::SetPrimaryScreen(uint32_t screenId)
+{
+    primaryScreenId_.store(screenId);
 }
 
 void HdiBackend::OnScreenHotplug(uint32_t screenId, bool connected)
@@ -317,16 +372,20 @@ void HdiBackend::OnScreenHotplug(uint32_t screenId, bool connected)
 
     if (!connected) {
         outputs_.erase(iter);
+        lastFrameBuffers_.erase(screenId);
+        lastPresentFences_.erase(screenId);
     }
 }
 
 RosenError HdiBackend::InitDevice()
 {
-    if (device_ != nullptr) {
+    if (hotPlugRegistered_) {
         return ROSEN_ERROR_OK;
     }
 
-    device_ = HdiDevice::GetInstance();
+    if (device_ == nullptr) {
+        device_ = HdiDevice::GetInstance();
+    }
     if (device_ == nullptr) {
         HLOGE("Get HdiDevice failed");
         return ROSEN_ERROR_NOT_INIT;
@@ -337,6 +396,7 @@ RosenError HdiBackend::InitDevice()
         HLOGE("RegHotPlugCallback failed, ret is %{public}d", ret);
         return ROSEN_ERROR_API_FAILED;
     }
+    hotPlugRegistered_ = true;
 
     HLOGI("Init device succeed");
 
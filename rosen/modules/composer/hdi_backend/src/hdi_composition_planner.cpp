@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hdi_composition_planner.h"
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+// cost per pixel of a client layer: an RGB layer is sampled once, a YUV one is converted as well
+constexpr int64_t RGB_PIXEL_COST = 2;
+constexpr int64_t YUV_PIXEL_COST = 3;
+// a new buffer is imported as a new texture, a static one is sampled from its cached EGL image
+constexpr int64_t NEW_BUFFER_PIXEL_COST = 1;
+// a new assignment must cost less than HYSTERESIS_NUM / HYSTERESIS_DEN of keeping the last one
+constexpr int64_t HYSTERESIS_NUM = 4;
+constexpr int64_t HYSTERESIS_DEN = 5;
+// frames a demotion by the device is remembered, as long as the layer keeps its format and area
+constexpr uint64_t REJECTION_FRAMES = 60;
+
+inline bool IsYuvFormat(int32_t format)
+{
+    return format >= PIXEL_FMT_YUV_422_I && format <= PIXEL_FMT_VYUY_422_PKG;
+}
+}
+
+void HdiCompositionPlanner::SetPlaneCount(uint32_t planeCount)
+{
+    planeCount_ = planeCount;
+}
+
+uint32_t HdiCompositionPlanner::GetPlaneCount() const
+{
+    return planeCount_;
+}
+
+int64_t HdiCompositionPlanner::GetClientCost(const HdiPlannerLayer &layer)
+{
+    int64_t pixelCost = IsYuvFormat(layer.format) ? YUV_PIXEL_COST : RGB_PIXEL_COST;
+    pixelCost += layer.bufferChanged ? NEW_BUFFER_PIXEL_COST : 0;
+    return std::max<int64_t>(layer.area, 0) * pixelCost;
+}
+
+void HdiCompositionPlanner::Plan(std::vector<HdiPlannerLayer> &layers)
+{
+    frame_++;
+    PruneRejections(layers);
+    if (planeCount_ == 0) {
+        for (auto &layer : layers) {
+            layer.compositionType = layer.clientOnly ? CompositionType::COMPOSITION_CLIENT :
+                                                       CompositionType::COMPOSITION_DEVICE;
+        }
+        lastClientLayers_.clear();
+        return;
+    }
+
+    // positions in the z-order, bottom first
+    size_t layerNum = layers.size();
+    std::vector<size_t> order(layerNum);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&layers](size_t a, size_t b) { return layers[a].zorder < layers[b].zorder; });
+
+    std::vector<int64_t> costSums(layerNum + 1, 0);
+    size_t forcedLo = layerNum;
+    size_t forcedHi = 0;
+    for (size_t pos = 0; pos < layerNum; pos++) {
+        const HdiPlannerLayer &layer = layers[order[pos]];
+        costSums[pos + 1] = costSums[pos] + GetClientCost(layer);
+        if (layer.clientOnly || IsRejected(layer)) {
+            forcedLo = std::min(forcedLo, pos);
+            forcedHi = std::max(forcedHi, pos + 1);
+        }
+    }
+    bool anyForced = forcedLo < layerNum;
+
+    // client layers take [lo, hi) of the z-order, the client target takes a plane once the range is not empty
+    size_t lo = 0;
+    size_t hi = 0;
+    if (anyForced || layerNum > planeCount_) {
+        size_t minClientNum = layerNum + 1 > planeCount_ ? layerNum + 1 - planeCount_ : 1;
+        int64_t bestCost = LLONG_MAX;
+        for (size_t start = 0; start + minClientNum <= layerNum && (!anyForced || start <= forcedLo); start++) {
+            size_t end = std::max(start + minClientNum, anyForced ? forcedHi : 0);
+            if (end > layerNum) {
+                break;
+            }
+            int64_t cost = costSums[end] - costSums[start];
+            if (cost < bestCost) {
+                bestCost = cost;
+                lo = start;
+                hi = end;
+            }
+        }
+
+        // keep the last range unless the best one is clearly cheaper
+        size_t lastLo = layerNum;
+        size_t lastHi = 0;
+        size_t lastNum = 0;
+        for (size_t pos = 0; pos < layerNum; pos++) {
+            if (lastClientLayers_.count(layers[order[pos]].layerId) > 0) {
+                lastLo = std::min(lastLo, pos);
+                lastHi = std::max(lastHi, pos + 1);
+                lastNum++;
+            }
+        }
+        bool lastFeasible = lastNum > 0 && lastHi - lastLo == lastNum && lastNum >= minClientNum &&
+            (!anyForced || (lastLo <= forcedLo && lastHi >= forcedHi));
+        if (lastFeasible) {
+            int64_t lastCost = costSums[lastHi] - costSums[lastLo];
+            if (bestCost * HYSTERESIS_DEN >= lastCost * HYSTERESIS_NUM) {
+                lo = lastLo;
+                hi = lastHi;
+            }
+        }
+    }
+
+    lastClientLayers_.clear();
+    for (size_t pos = 0; pos < layerNum; pos++) {
+        HdiPlannerLayer &layer = layers[order[pos]];
+        bool client = pos >= lo && pos < hi;
+        layer.compositionType = client ? CompositionType::COMPOSITION_CLIENT : CompositionType::COMPOSITION_DEVICE;
+        if (client) {
+            lastClientLayers_.insert(layer.layerId);
+        }
+    }
+}
+
+void HdiCompositionPlanner::OnDeviceReject(const HdiPlannerLayer &layer)
+{
+    rejections_[layer.layerId] = { layer.format, layer.area, frame_ };
+}
+
+bool HdiCompositionPlanner::IsRejected(const HdiPlannerLayer &layer) const
+{
+    auto iter = rejections_.find(layer.layerId);
+    if (iter == rejections_.end()) {
+        return false;
+    }
+    const Rejection &rejection = iter->second;
+    return rejection.format == layer.format && rejection.area == layer.area &&
+           frame_ - rejection.frame <= REJECTION_FRAMES;
+}
+
+void HdiCompositionPlanner::PruneRejections(const std::vector<HdiPlannerLayer> &layers)
+{
+    if (rejections_.empty()) {
+        return;
+    }
+    std::unordered_set<uint32_t> layerIds;
+    for (auto &layer : layers) {
+        layerIds.insert(layer.layerId);
+    }
+    for (auto iter = rejections_.begin(); iter != rejections_.end();) {
+        if (layerIds.count(iter->first) == 0 || frame_ - iter->second.frame > REJECTION_FRAMES) {
+            iter = rejections_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
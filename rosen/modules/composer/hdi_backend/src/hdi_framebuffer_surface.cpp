@@ -118,17 +118,52 @@ std::unique_ptr<FrameBufferEntry> HdiFramebufferSurface::GetFramebuffer()
 int32_t HdiFramebufferSurface::ReleaseFramebuffer(
     sptr<SurfaceBuffer> &buffer, const sptr<SyncFence>& releaseFence)
 {
+    // the result of the releases deferred by the previous calls
+    int32_t deferredRet = deferredReleaseRet_.exchange(SURFACE_ERROR_OK);
     if (buffer == nullptr) {
         HLOGI("HdiFramebufferSurface::ReleaseFramebuffer: buffer is null, no need to release.");
-        return 0;
+        return deferredRet;
     }
 
-    // [PLANNING]: we should not wait fence at here, this is just a work-around.
-    // mali driver maybe not use this fence.
-    if (releaseFence != nullptr) {
-        releaseFence->Wait(3000); // timeout: 3000ms
+    // [PLANNING]: mali driver maybe not use this fence, so the buffer is only released once it signals.
+    // the composer thread does not wait for it, the FenceWatcher releases the buffer.
+    if (releaseFence != nullptr && releaseFence->IsValid()) {
+        wptr<HdiFramebufferSurface> weakThis = this;
+        FenceWatcher::GetInstance().Watch(releaseFence, [weakThis, buffer, releaseFence](FenceStatus status) mutable {
+            auto fbSurface = weakThis.promote();
+            if (fbSurface != nullptr) {
+                fbSurface->OnReleaseFenceDone(buffer, releaseFence, status);
+            }
+        }, RELEASE_FENCE_TIMEOUT_MS);
+        return deferredRet;
     }
 
+    int32_t ret = ReleaseFramebufferNow(buffer, releaseFence);
+    return ret != SURFACE_ERROR_OK ? ret : deferredRet;
+}
+
+void HdiFramebufferSurface::OnReleaseFenceDone(
+    sptr<SurfaceBuffer> &buffer, const sptr<SyncFence>& releaseFence, FenceStatus status)
+{
+    // the buffer is released with its fence in any case, the producer waits for the fence before drawing into it,
+    // holding the buffer back would starve the framebuffer queue.
+    int32_t ret = ReleaseFramebufferNow(buffer, releaseFence);
+    if (status != FenceStatus::SIGNALED) {
+        HLOGE("release fence is %{public}s, the framebuffer is released with the fence pending",
+            status == FenceStatus::ACTIVE ? "not signaled in time" : "not watchable");
+        if (ret == SURFACE_ERROR_OK) {
+            ret = SURFACE_ERROR_ERROR;
+        }
+    }
+    if (ret != SURFACE_ERROR_OK) {
+        int32_t expected = SURFACE_ERROR_OK;
+        deferredReleaseRet_.compare_exchange_strong(expected, ret);
+    }
+}
+
+int32_t HdiFramebufferSurface::ReleaseFramebufferNow(
+    sptr<SurfaceBuffer> &buffer, const sptr<SyncFence>& releaseFence)
+{
     SurfaceError ret = consumerSurface_->ReleaseBuffer(buffer, releaseFence);
     if (ret != SURFACE_ERROR_OK) {
         HLOGE("ReleaseBuffer failed ret is %{public}d", ret);
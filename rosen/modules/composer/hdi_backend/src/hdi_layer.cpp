@@ -20,6 +20,18 @@
 
 namespace OHOS {
 namespace Rosen {
+namespace {
+inline bool IsSameRect(const IRect &rect1, const IRect &rect2)
+{
+    return rect1.x == rect2.x && rect1.y == rect2.y && rect1.w == rect2.w && rect1.h == rect2.h;
+}
+
+inline bool IsSameAlpha(const LayerAlpha &alpha1, const LayerAlpha &alpha2)
+{
+    return alpha1.enGlobalAlpha == alpha2.enGlobalAlpha && alpha1.enPixelAlpha == alpha2.enPixelAlpha &&
+           alpha1.alpha0 == alpha2.alpha0 && alpha1.alpha1 == alpha2.alpha1 && alpha1.gAlpha == alpha2.gAlpha;
+}
+}
 
 /* rs create layer and set layer info begin */
 std::shared_ptr<HdiLayer> HdiLayer::CreateHdiLayer(uint32_t screenId)
@@ -66,8 +78,16 @@ int32_t HdiLayer::CreateLayer(const LayerInfoPtr &layerInfo)
         .pixFormat = PIXEL_FMT_RGBA_8888,
     };
 
+    if (device_ == nullptr) {
+        device_ = HdiDevice::GetInstance();
+    }
+    if (device_ == nullptr) {
+        HLOGE("Create hwc layer failed, HdiDevice is null");
+        return DISPLAY_NULL_PTR;
+    }
+
     uint32_t layerId = 0;
-    int32_t ret = HdiDevice::GetInstance()->CreateLayer(screenId_, hdiLayerInfo, layerId);
+    int32_t ret = device_->CreateLayer(screenId_, hdiLayerInfo, layerId);
     if (ret != DISPLAY_SUCCESS) {
         HLOGE("Create hwc layer failed, ret is %{public}d", ret);
         return ret;
@@ -82,12 +102,12 @@ int32_t HdiLayer::CreateLayer(const LayerInfoPtr &layerInfo)
 
 void HdiLayer::CloseLayer()
 {
-    if (layerId_ == INT_MAX) {
+    if (layerId_ == INT_MAX || device_ == nullptr) {
         HLOGI("this layer has not been created");
         return;
     }
 
-    int32_t ret = HdiDevice::GetInstance()->CloseLayer(screenId_, layerId_);
+    int32_t ret = device_->CloseLayer(screenId_, layerId_);
     if (ret != DISPLAY_SUCCESS) {
         HLOGE("Close hwc layer[%{public}u] failed, ret is %{public}d", layerId_, ret);
     }
@@ -97,102 +117,190 @@ void HdiLayer::CloseLayer()
 
 void HdiLayer::SetHdiLayerInfo()
 {
-    /*
-        Some hardware platforms may not support all layer settings.
-        If the current function is not supported, continue other layer settings.
-     */
-
-    HdiDevice *device = HdiDevice::GetInstance();
-    if (device == nullptr || layerInfo_ == nullptr) {
+    rejectedByDevice_ = false;
+    if (device_ == nullptr || layerInfo_ == nullptr) {
         return;
     }
 
-    int32_t ret = device->SetLayerAlpha(screenId_, layerId_, layerInfo_->GetAlpha());
-    CheckRet(ret, "SetLayerAlpha");
-
-    ret = device->SetLayerSize(screenId_, layerId_, layerInfo_->GetLayerSize());
-    CheckRet(ret, "SetLayerSize");
+    sptr<SurfaceBuffer> buffer = layerInfo_->GetBuffer();
+    HdiLayerState state = {
+        .alpha = layerInfo_->GetAlpha(),
+        .layerSize = layerInfo_->GetLayerSize(),
+        .transform = layerInfo_->GetTransformType(),
+        .visibleNum = layerInfo_->GetVisibleNum(),
+        .visibleRegion = layerInfo_->GetVisibleRegion(),
+        .dirtyRegion = layerInfo_->GetDirtyRegion(),
+        .buffer = buffer == nullptr ? nullptr : buffer->GetBufferHandle(),
+        .acquireFence = layerInfo_->GetAcquireFence(),
+        .compositionType = layerInfo_->GetCompositionType(),
+        .blendType = layerInfo_->GetBlendType(),
+        .crop = layerInfo_->GetCropRect(),
+        .zorder = layerInfo_->GetZorder(),
+        .preMulti = layerInfo_->IsPreMulti(),
+    };
 
-    if (layerInfo_->GetTransformType() != TransformType::ROTATE_BUTT) {
-        ret = device->SetTransformMode(screenId_, layerId_, layerInfo_->GetTransformType());
-        CheckRet(ret, "SetTransformMode");
+    /* the device layer keeps its state between frames, most frames only change the buffer */
+    uint32_t fields = GetChangedFields(state);
+    if (fields == 0) {
+        return;
     }
 
-    ret = device->SetLayerVisibleRegion(screenId_, layerId_, layerInfo_->GetVisibleNum(),
-                                         layerInfo_->GetVisibleRegion());
-    CheckRet(ret, "SetLayerVisibleRegion");
-
-    ret = device->SetLayerDirtyRegion(screenId_, layerId_, layerInfo_->GetDirtyRegion());
-    CheckRet(ret, "SetLayerDirtyRegion");
-
-    ret = device->SetLayerBuffer(screenId_, layerId_, layerInfo_->GetBuffer()->GetBufferHandle(),
-                                  layerInfo_->GetAcquireFence());
-    CheckRet(ret, "SetLayerBuffer");
-
-    ret = device->SetLayerCompositionType(screenId_, layerId_, layerInfo_->GetCompositionType());
-    CheckRet(ret, "SetLayerCompositionType");
+    uint32_t setFields = fields;
+    int32_t ret = device_->SetLayerState(screenId_, layerId_, state, fields);
+    if (ret == DISPLAY_NOT_SUPPORT) {
+        setFields = SetLayerFields(state, fields);
+    } else if (ret != DISPLAY_SUCCESS) {
+        CheckRet(ret, "SetLayerState");
+        setFields = 0;
+    }
 
-    ret = device->SetLayerBlendType(screenId_, layerId_, layerInfo_->GetBlendType());
-    CheckRet(ret, "SetLayerBlendType");
+    /* fields left unchanged hold the same values, failed ones are sent again next frame */
+    sentState_ = state;
+    sentFields_ = (sentFields_ | setFields) & ~(fields & ~setFields);
+}
 
-    ret = device->SetLayerCrop(screenId_, layerId_, layerInfo_->GetCropRect());
-    CheckRet(ret, "SetLayerCrop");
+uint32_t HdiLayer::GetChangedFields(const HdiLayerState &state) const
+{
+    const HdiLayerState &sent = sentState_;
+    uint32_t changed = 0;
+    changed |= IsSameAlpha(state.alpha, sent.alpha) ? 0 : LAYER_STATE_ALPHA;
+    changed |= IsSameRect(state.layerSize, sent.layerSize) ? 0 : LAYER_STATE_SIZE;
+    if (state.transform != TransformType::ROTATE_BUTT) {
+        changed |= state.transform == sent.transform ? 0 : LAYER_STATE_TRANSFORM;
+    }
+    changed |= (state.visibleNum == sent.visibleNum && IsSameRect(state.visibleRegion, sent.visibleRegion)) ?
+        0 : LAYER_STATE_VISIBLE_REGION;
+    bool bufferChanged =
+        state.buffer != sent.buffer || state.acquireFence.GetRefPtr() != sent.acquireFence.GetRefPtr();
+    changed |= bufferChanged ? LAYER_STATE_BUFFER : 0;
+    /* the dirty region describes the damage of a buffer, it goes with every new one even when it is the same rect */
+    changed |= (!bufferChanged && IsSameRect(state.dirtyRegion, sent.dirtyRegion)) ? 0 : LAYER_STATE_DIRTY_REGION;
+    changed |= state.compositionType == sent.compositionType ? 0 : LAYER_STATE_COMPOSITION_TYPE;
+    changed |= state.blendType == sent.blendType ? 0 : LAYER_STATE_BLEND_TYPE;
+    changed |= IsSameRect(state.crop, sent.crop) ? 0 : LAYER_STATE_CROP;
+    changed |= state.zorder == sent.zorder ? 0 : LAYER_STATE_ZORDER;
+    changed |= state.preMulti == sent.preMulti ? 0 : LAYER_STATE_PREMULTI;
+
+    /* fields never set successfully are sent again, except a transform left to the device */
+    uint32_t unknown = LAYER_STATE_ALL & ~sentFields_;
+    if (state.transform == TransformType::ROTATE_BUTT) {
+        unknown &= ~LAYER_STATE_TRANSFORM;
+    }
+    return changed | unknown;
+}
 
-    ret = device->SetLayerZorder(screenId_, layerId_, layerInfo_->GetZorder());
-    CheckRet(ret, "SetLayerZorder");
+uint32_t HdiLayer::SetLayerFields(HdiLayerState &state, uint32_t fields)
+{
+    /*
+        Some hardware platforms may not support all layer settings.
+        If the current function is not supported, continue other layer settings.
+     */
+    uint32_t setFields = 0;
+    auto check = [this, &setFields](int32_t ret, uint32_t field, const char* func) {
+        CheckRet(ret, func);
+        setFields |= ret == DISPLAY_SUCCESS ? field : 0;
+    };
 
-    ret = device->SetLayerPreMulti(screenId_, layerId_, layerInfo_->IsPreMulti());
-    CheckRet(ret, "SetLayerPreMulti");
+    if (fields & LAYER_STATE_ALPHA) {
+        check(device_->SetLayerAlpha(screenId_, layerId_, state.alpha), LAYER_STATE_ALPHA, "SetLayerAlpha");
+    }
+    if (fields & LAYER_STATE_SIZE) {
+        check(device_->SetLayerSize(screenId_, layerId_, state.layerSize), LAYER_STATE_SIZE, "SetLayerSize");
+    }
+    if (fields & LAYER_STATE_TRANSFORM) {
+        check(device_->SetTransformMode(screenId_, layerId_, state.transform), LAYER_STATE_TRANSFORM,
+              "SetTransformMode");
+    }
+    if (fields & LAYER_STATE_VISIBLE_REGION) {
+        check(device_->SetLayerVisibleRegion(screenId_, layerId_, state.visibleNum, state.visibleRegion),
+              LAYER_STATE_VISIBLE_REGION, "SetLayerVisibleRegion");
+    }
+    if (fields & LAYER_STATE_DIRTY_REGION) {
+        check(device_->SetLayerDirtyRegion(screenId_, layerId_, state.dirtyRegion), LAYER_STATE_DIRTY_REGION,
+              "SetLayerDirtyRegion");
+    }
+    if (fields & LAYER_STATE_BUFFER) {
+        check(device_->SetLayerBuffer(screenId_, layerId_, state.buffer, state.acquireFence), LAYER_STATE_BUFFER,
+              "SetLayerBuffer");
+    }
+    if (fields & LAYER_STATE_COMPOSITION_TYPE) {
+        check(device_->SetLayerCompositionType(screenId_, layerId_, state.compositionType),
+              LAYER_STATE_COMPOSITION_TYPE, "SetLayerCompositionType");
+    }
+    if (fields & LAYER_STATE_BLEND_TYPE) {
+        check(device_->SetLayerBlendType(screenId_, layerId_, state.blendType), LAYER_STATE_BLEND_TYPE,
+              "SetLayerBlendType");
+    }
+    if (fields & LAYER_STATE_CROP) {
+        check(device_->SetLayerCrop(screenId_, layerId_, state.crop), LAYER_STATE_CROP, "SetLayerCrop");
+    }
+    if (fields & LAYER_STATE_ZORDER) {
+        check(device_->SetLayerZorder(screenId_, layerId_, state.zorder), LAYER_STATE_ZORDER, "SetLayerZorder");
+    }
+    if (fields & LAYER_STATE_PREMULTI) {
+        check(device_->SetLayerPreMulti(screenId_, layerId_, state.preMulti), LAYER_STATE_PREMULTI,
+              "SetLayerPreMulti");
+    }
+    return setFields;
 }
 
 int32_t HdiLayer::SetLayerColorTransform(const float *matrix) const
 {
-    HdiDevice *device = HdiDevice::GetInstance();
-    if (device == nullptr || matrix == nullptr) {
+    if (device_ == nullptr || matrix == nullptr) {
         return DISPLAY_NULL_PTR;
     }
 
-    return device->SetLayerColorTransform(screenId_, layerId_, matrix);
+    return device_->SetLayerColorTransform(screenId_, layerId_, matrix);
 }
 
 int32_t HdiLayer::SetLayerColorDataSpace(ColorDataSpace colorSpace) const
 {
-    HdiDevice *device = HdiDevice::GetInstance();
-    if (device == nullptr) {
+    if (device_ == nullptr) {
         return DISPLAY_NULL_PTR;
     }
 
-    return device->SetLayerColorDataSpace(screenId_, layerId_, colorSpace);
+    return device_->SetLayerColorDataSpace(screenId_, layerId_, colorSpace);
 }
 
 int32_t HdiLayer::GetLayerColorDataSpace(ColorDataSpace &colorSpace) const
 {
-    HdiDevice *device = HdiDevice::GetInstance();
-    if (device == nullptr) {
+    if (device_ == nullptr) {
         return DISPLAY_NULL_PTR;
     }
 
-    return device->GetLayerColorDataSpace(screenId_, layerId_, colorSpace);
+    return device_->GetLayerColorDataSpace(screenId_, layerId_, colorSpace);
 }
 
 int32_t HdiLayer::SetLayerMetaData(const std::vector<HDRMetaData> &metaData) const
 {
-    HdiDevice *device = HdiDevice::GetInstance();
-    if (device == nullptr) {
+    if (device_ == nullptr) {
         return DISPLAY_NULL_PTR;
     }
 
-    return device->SetLayerMetaData(screenId_, layerId_, metaData);
+    return device_->SetLayerMetaData(screenId_, layerId_, metaData);
 }
 
 int32_t HdiLayer::SetLayerMetaDataSet(HDRMetadataKey key, const std::vector<uint8_t> &metaData) const
 {
-    HdiDevice *device = HdiDevice::GetInstance();
-    if (device == nullptr) {
+    if (device_ == nullptr) {
         return DISPLAY_NULL_PTR;
     }
 
-    return device->SetLayerMetaDataSet(screenId_, layerId_, key, metaData);
+    return device_->SetLayerMetaDataSet(screenId_, layerId_, key, metaData);
+}
+
+void HdiLayer::SetHdiDevice(Base::HdiDevice* device)
+{
+    if (device == nullptr) {
+        HLOGE("Input HdiDevice is null");
+        return;
+    }
+
+    if (device_ != nullptr) {
+        HLOGW("HdiDevice has been changed");
+        return;
+    }
+    device_ = device;
 }
 
 uint32_t HdiLayer::GetLayerId() const
@@ -200,6 +308,16 @@ uint32_t HdiLayer::GetLayerId() const
     return layerId_;
 }
 
+bool HdiLayer::IsBufferChanged() const
+{
+    return currSbuffer_ == nullptr || prevSbuffer_ == nullptr || currSbuffer_->sbuffer_ != prevSbuffer_->sbuffer_;
+}
+
+bool HdiLayer::IsRejectedByDevice() const
+{
+    return rejectedByDevice_;
+}
+
 const LayerInfoPtr& HdiLayer::GetLayerInfo()
 {
     return layerInfo_;
@@ -304,7 +422,11 @@ void HdiLayer::UpdateCompositionType(CompositionType type)
         return;
     }
 
+    rejectedByDevice_ = type == CompositionType::COMPOSITION_CLIENT &&
+        sentState_.compositionType == CompositionType::COMPOSITION_DEVICE;
     layerInfo_->SetCompositionType(type);
+    /* the device decided the type, the one requested is sent again next frame */
+    sentFields_ &= ~LAYER_STATE_COMPOSITION_TYPE;
 }
 /* backend get layer info end */
 
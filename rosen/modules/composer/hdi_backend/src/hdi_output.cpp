@@ -105,6 +105,9 @@ void HdiOutput::ResetLayerStatus()
 int32_t HdiOutput::CreateLayer(uint64_t surfaceId, const LayerInfoPtr &layerInfo)
 {
     LayerPtr layer = HdiLayer::CreateHdiLayer(screenId_);
+    if (device_ != nullptr) {
+        layer->SetHdiDevice(device_);
+    }
     if (!layer->Init(layerInfo)) {
         HLOGE("Init hdiLayer failed");
         return DISPLAY_FAILURE;
@@ -118,6 +121,16 @@ int32_t HdiOutput::CreateLayer(uint64_t surfaceId, const LayerInfoPtr &layerInfo
     return DISPLAY_SUCCESS;
 }
 
+void HdiOutput::SetHdiDevice(Base::HdiDevice* device)
+{
+    if (device == nullptr) {
+        HLOGE("Input HdiDevice is null");
+        return;
+    }
+
+    device_ = device;
+}
+
 void HdiOutput::SetOutputDamage(uint32_t num, const IRect &outputDamage)
 {
     outputDamageNum_ = num;
@@ -189,6 +202,48 @@ void HdiOutput::RecordCompositionTime(int64_t timeStamp)
     compTimeRcdIndex_ = (compTimeRcdIndex_ + 1) % COMPOSITION_RECORDS_NUM;
 }
 
+void HdiOutput::SetPlaneCount(uint32_t planeCount)
+{
+    planner_.SetPlaneCount(planeCount);
+}
+
+void HdiOutput::PlanComposition()
+{
+    if (planner_.GetPlaneCount() == 0) {
+        return;
+    }
+
+    std::vector<HdiPlannerLayer> plannerLayers;
+    plannerLayers.reserve(layerIdMap_.size());
+    for (auto iter = layerIdMap_.begin(); iter != layerIdMap_.end(); ++iter) {
+        const LayerPtr &layer = iter->second;
+        const LayerInfoPtr &info = layer->GetLayerInfo();
+        if (info == nullptr) {
+            continue;
+        }
+        const sptr<SurfaceBuffer> &buffer = info->GetBuffer();
+        HdiPlannerLayer plannerLayer = {
+            .layerId = layer->GetLayerId(),
+            .zorder = info->GetZorder(),
+            .area = static_cast<int64_t>(info->GetLayerSize().w) * info->GetLayerSize().h,
+            .format = buffer == nullptr ? PIXEL_FMT_RGBA_8888 : buffer->GetFormat(),
+            .bufferChanged = layer->IsBufferChanged(),
+            .clientOnly = info->GetCompositionType() == CompositionType::COMPOSITION_CLIENT,
+        };
+        if (layer->IsRejectedByDevice()) {
+            planner_.OnDeviceReject(plannerLayer);
+        }
+        plannerLayers.emplace_back(plannerLayer);
+    }
+
+    planner_.Plan(plannerLayers);
+    for (const HdiPlannerLayer &plannerLayer : plannerLayers) {
+        if (plannerLayer.compositionType == CompositionType::COMPOSITION_CLIENT) {
+            layerIdMap_[plannerLayer.layerId]->GetLayerInfo()->SetCompositionType(plannerLayer.compositionType);
+        }
+    }
+}
+
 void HdiOutput::Dump(std::string &result) const
 {
     std::vector<LayerDumpInfo> dumpLayerInfos;
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "hdi_backend.h"
+#include "fake/fake_hdi_device.h"
+#include "fake/fake_layer_surface.h"
+
+using namespace OHOS;
+using namespace OHOS::Rosen;
+
+namespace {
+constexpr int DEFAULT_FRAMES = 300;
+constexpr int WARMUP_FRAMES = 10;
+constexpr uint32_t LAYER_COUNTS[] = { 4, 8, 16, 32, 64 };
+// every UNSUPPORTED_LAYER_STRIDE-th layer from the top has a format the planes can not show
+constexpr uint32_t UNSUPPORTED_LAYER_STRIDE = 5;
+constexpr int32_t LAYER_STEP = 16;
+constexpr int32_t LAYER_MIN_SIZE = 64;
+constexpr double NS_PER_US = 1000.0;
+constexpr double P99 = 0.99;
+
+using Clock = std::chrono::steady_clock;
+
+Fake::HdiDeviceConfig g_config;
+OutputPtr g_output = nullptr;
+
+void OnScreenHotplug(OutputPtr &output, bool connected, void* data)
+{
+    if (connected && g_output == nullptr) {
+        g_output = output;
+    }
+}
+
+void OnPrepareComplete(sptr<Surface> &surface, const struct PrepareCompleteParam &param, void* data)
+{
+    if (param.needFlushFramebuffer) {
+        Fake::FlushClientTarget(surface, g_config.width, g_config.height);
+    }
+}
+
+double Percentile(std::vector<double> values, double percentile)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(percentile * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+bool Run(HdiBackend *backend, Fake::HdiDevice &device, uint32_t layerCount, int frames)
+{
+    std::vector<std::unique_ptr<Fake::LayerSurface>> layers;
+    for (uint32_t i = 0; i < layerCount; i++) {
+        int32_t offset = static_cast<int32_t>(i % LAYER_STEP) * LAYER_STEP;
+        int32_t size = LAYER_MIN_SIZE + offset;
+        IRect rect = { offset, offset, size, size };
+        bool unsupported = (layerCount - 1 - i) % UNSUPPORTED_LAYER_STRIDE == UNSUPPORTED_LAYER_STRIDE - 1;
+        layers.push_back(std::make_unique<Fake::LayerSurface>(rect, IRect { 0, 0, size, size },
+            static_cast<int32_t>(i), unsupported ? PIXEL_FMT_YCBCR_420_SP : PIXEL_FMT_RGBA_8888));
+    }
+
+    std::vector<double> repaintUs;
+    std::vector<OutputPtr> outputs = { g_output };
+    for (int frame = 0; frame < WARMUP_FRAMES + frames; frame++) {
+        std::vector<LayerInfoPtr> layerInfos;
+        for (auto &layer : layers) {
+            if (!layer->Update()) {
+                return false;
+            }
+            layerInfos.push_back(layer->GetLayerInfo());
+        }
+        g_output->SetLayerInfo(layerInfos);
+        if (frame == WARMUP_FRAMES) {
+            device.ClearCommitRecords();
+            device.ClearCallCounts();
+        }
+        auto start = Clock::now();
+        backend->Repaint(outputs);
+        if (frame >= WARMUP_FRAMES) {
+            repaintUs.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / NS_PER_US);
+        }
+    }
+
+    double deviceLayers = 0;
+    double clientLayers = 0;
+    std::vector<Fake::CommitRecord> records = device.GetCommitRecords();
+    for (auto &record : records) {
+        deviceLayers += record.deviceLayers;
+        clientLayers += record.clientLayers;
+    }
+    double commits = records.empty() ? 1 : static_cast<double>(records.size());
+    std::cout << "  " << layerCount << " layers: median " << Percentile(repaintUs, 0.5) << " us, p99 " <<
+        Percentile(repaintUs, P99) << " us, " << deviceLayers / commits << " device / " << clientLayers / commits <<
+        " client layers, " << static_cast<double>(device.GetLayerCallCount()) / frames << " layer calls per frame" <<
+        std::endl;
+    return true;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    // the present fences signal at commit, so Repaint never waits for a vblank and only the composer is measured
+    g_config.vsyncPeriod = 0;
+    Fake::HdiDevice device(g_config);
+    HdiBackend *backend = HdiBackend::GetInstance();
+    backend->SetHdiDevice(&device);
+    backend->RegScreenHotplug(OnScreenHotplug, nullptr);
+    backend->RegPrepareComplete(OnPrepareComplete, nullptr);
+    if (g_output == nullptr) {
+        std::cout << "no output connected" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "HdiBackend::Repaint on a fake display of " << g_config.overlay.planeCount << " planes: " <<
+        frames << " frames" << std::endl;
+    for (uint32_t layerCount : LAYER_COUNTS) {
+        if (!Run(backend, device, layerCount, frames)) {
+            std::cout << "  " << layerCount << " layers: buffer queue failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
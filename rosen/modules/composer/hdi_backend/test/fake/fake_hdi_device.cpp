@@ -0,0 +1,724 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fake/fake_hdi_device.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace OHOS {
+namespace Rosen {
+namespace Fake {
+namespace {
+constexpr size_t MAX_VSYNC_RECORDS = 4096;
+constexpr size_t MAX_COMMIT_RECORDS = 4096;
+constexpr int64_t NS_PER_SECOND = 1000000000;
+constexpr uint32_t DEFAULT_REFRESH_RATE = 60;
+
+bool IsClient(CompositionType type)
+{
+    return type == CompositionType::COMPOSITION_CLIENT || type == CompositionType::COMPOSITION_CLIENT_CLEAR;
+}
+}
+
+HdiDevice::HdiDevice(const HdiDeviceConfig &config) : config_(config), jitterRandom_(config.jitterSeed)
+{
+    for (uint32_t screenId : config_.screenIds) {
+        screens_[screenId] = Screen();
+    }
+    timeline_ = new SyncTimeline();
+    if (!timeline_->IsValid()) {
+        HLOGE("Fake HdiDevice: create present timeline failed");
+        timeline_ = nullptr;
+    }
+    if (config_.vsyncPeriod > 0) {
+        vsyncThread_ = std::thread(&HdiDevice::VsyncThreadMain, this);
+    }
+}
+
+HdiDevice::~HdiDevice()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    vsyncCond_.notify_all();
+    if (vsyncThread_.joinable()) {
+        vsyncThread_.join();
+    }
+}
+
+int64_t HdiDevice::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::vector<CommitRecord> HdiDevice::GetCommitRecords() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commitRecords_;
+}
+
+void HdiDevice::ClearCommitRecords()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    commitRecords_.clear();
+}
+
+std::vector<int64_t> HdiDevice::GetVsyncTimestamps() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return vsyncTimestamps_;
+}
+
+std::map<std::string, uint64_t> HdiDevice::GetCallCounts() const
+{
+    std::lock_guard<std::mutex> lock(callMutex_);
+    return callCounts_;
+}
+
+uint64_t HdiDevice::GetLayerCallCount() const
+{
+    std::lock_guard<std::mutex> lock(callMutex_);
+    uint64_t count = 0;
+    for (auto &[func, calls] : callCounts_) {
+        if (func.compare(0, strlen("SetLayer"), "SetLayer") == 0 || func == "SetTransformMode") {
+            count += calls;
+        }
+    }
+    return count;
+}
+
+void HdiDevice::ClearCallCounts()
+{
+    std::lock_guard<std::mutex> lock(callMutex_);
+    callCounts_.clear();
+}
+
+void HdiDevice::CountCall(const char *func)
+{
+    std::lock_guard<std::mutex> lock(callMutex_);
+    callCounts_[func]++;
+}
+
+void HdiDevice::VsyncThreadMain()
+{
+    std::uniform_int_distribution<int64_t> jitter(-config_.vsyncJitter, config_.vsyncJitter);
+    int64_t start = Now();
+    uint32_t sequence = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        sequence++;
+        int64_t timestamp = start + static_cast<int64_t>(sequence) * config_.vsyncPeriod + jitter(jitterRandom_);
+        auto deadline = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(timestamp));
+        if (vsyncCond_.wait_until(lock, deadline, [this]() { return !running_; })) {
+            break;
+        }
+
+        // everything committed before this vblank is on screen now
+        uint32_t step = committedPoint_ - signaledPoint_;
+        signaledPoint_ = committedPoint_;
+        if (vsyncTimestamps_.size() < MAX_VSYNC_RECORDS) {
+            vsyncTimestamps_.push_back(timestamp);
+        }
+        std::vector<std::pair<VBlankCallback, void *>> callbacks;
+        for (auto &[screenId, screen] : screens_) {
+            if (screen.vsyncEnabled && screen.vblankCallback != nullptr) {
+                callbacks.emplace_back(screen.vblankCallback, screen.vblankData);
+            }
+        }
+
+        lock.unlock();
+        if (step > 0 && timeline_ != nullptr) {
+            timeline_->IncreaseSyncPoint(step);
+        }
+        for (auto &[callback, data] : callbacks) {
+            callback(sequence, static_cast<uint64_t>(timestamp), data);
+        }
+        lock.lock();
+    }
+}
+
+HdiDevice::Screen *HdiDevice::GetScreen(uint32_t screenId)
+{
+    auto iter = screens_.find(screenId);
+    return iter == screens_.end() ? nullptr : &iter->second;
+}
+
+HdiDevice::Layer *HdiDevice::GetLayer(uint32_t screenId, uint32_t layerId)
+{
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return nullptr;
+    }
+    auto iter = screen->layers.find(layerId);
+    return iter == screen->layers.end() ? nullptr : &iter->second;
+}
+
+bool HdiDevice::IsOverlayCapable(const Layer &layer) const
+{
+    const OverlayRules &rules = config_.overlay;
+    if (std::find(rules.formats.begin(), rules.formats.end(), layer.format) == rules.formats.end()) {
+        return false;
+    }
+    if (!rules.transform && layer.transform != TransformType::ROTATE_NONE &&
+        layer.transform != TransformType::ROTATE_BUTT) {
+        return false;
+    }
+    if (layer.size.w <= 0 || layer.size.h <= 0 || layer.crop.w <= 0 || layer.crop.h <= 0) {
+        return layer.size.w == layer.crop.w && layer.size.h == layer.crop.h;
+    }
+    if (layer.size.w == layer.crop.w && layer.size.h == layer.crop.h) {
+        return true;
+    }
+    if (!rules.scaling) {
+        return false;
+    }
+    float scaleX = static_cast<float>(layer.crop.w) / layer.size.w;
+    float scaleY = static_cast<float>(layer.crop.h) / layer.size.h;
+    float minScale = 1.0f / rules.maxUpscale;
+    return scaleX <= rules.maxDownscale && scaleY <= rules.maxDownscale && scaleX >= minScale && scaleY >= minScale;
+}
+
+void HdiDevice::AssignPlanes(Screen &screen)
+{
+    std::vector<std::pair<uint32_t, Layer *>> layers;
+    for (auto &[layerId, layer] : screen.layers) {
+        layers.emplace_back(layerId, &layer);
+    }
+    // top down: layers take planes until one can not, it and all layers below it are composed by the client so
+    // that no plane is sandwiched between client layers
+    std::stable_sort(layers.begin(), layers.end(),
+        [](const auto &a, const auto &b) { return a.second->zorder > b.second->zorder; });
+    uint32_t planeCount = config_.overlay.planeCount;
+    uint32_t deviceCount = 0;
+    bool fallback = false;
+    Layer *lowestDevice = nullptr;
+    for (auto &[layerId, layer] : layers) {
+        if (!fallback && !IsClient(layer->requested) && deviceCount < planeCount && IsOverlayCapable(*layer)) {
+            layer->assigned = layer->requested;
+            lowestDevice = layer;
+            deviceCount++;
+        } else {
+            fallback = true;
+            layer->assigned = CompositionType::COMPOSITION_CLIENT;
+        }
+    }
+    // the client target needs a plane of its own
+    if (fallback && deviceCount >= planeCount && lowestDevice != nullptr) {
+        lowestDevice->assigned = CompositionType::COMPOSITION_CLIENT;
+        deviceCount--;
+    }
+
+    CommitRecord &record = screen.pending;
+    record = CommitRecord();
+    record.prepareTime = Now();
+    screen.changedLayers.clear();
+    for (auto &[layerId, layer] : layers) {
+        if (layer->assigned != layer->requested) {
+            screen.changedLayers.push_back(layerId);
+        }
+        bool client = IsClient(layer->assigned);
+        record.clientLayers += client ? 1 : 0;
+        record.deviceLayers += client ? 0 : 1;
+        record.layers.push_back({ layerId, layer->zorder, layer->requested, layer->assigned });
+    }
+}
+
+/* set & get device screen info begin */
+int32_t HdiDevice::RegHotPlugCallback(HotPlugCallback callback, void *data)
+{
+    CountCall(__func__);
+    if (callback == nullptr) {
+        return DISPLAY_NULL_PTR;
+    }
+    // the screens are there from the start, report them right away like the display HDI does on registration
+    for (uint32_t screenId : config_.screenIds) {
+        callback(screenId, true, data);
+    }
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::RegScreenVBlankCallback(uint32_t screenId, VBlankCallback callback, void *data)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    screen->vblankCallback = callback;
+    screen->vblankData = data;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenCapability(uint32_t screenId, DisplayCapability &info)
+{
+    CountCall(__func__);
+    if (screens_.find(screenId) == screens_.end()) {
+        return DISPLAY_PARAM_ERR;
+    }
+    info = {};
+    info.type = InterfaceType::DISP_INTF_BT1120;
+    info.phyWidth = static_cast<uint32_t>(config_.width);
+    info.phyHeight = static_cast<uint32_t>(config_.height);
+    info.supportLayers = config_.overlay.planeCount;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenSupportedModes(uint32_t screenId, std::vector<DisplayModeInfo> &modes)
+{
+    CountCall(__func__);
+    if (screens_.find(screenId) == screens_.end()) {
+        return DISPLAY_PARAM_ERR;
+    }
+    uint32_t refreshRate = config_.vsyncPeriod > 0 ?
+        static_cast<uint32_t>((NS_PER_SECOND + config_.vsyncPeriod / 2) / config_.vsyncPeriod) : DEFAULT_REFRESH_RATE;
+    modes = { { .width = config_.width, .height = config_.height, .freshRate = refreshRate, .id = 0 } };
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenMode(uint32_t screenId, uint32_t &modeId)
+{
+    CountCall(__func__);
+    modeId = 0;
+    return screens_.find(screenId) == screens_.end() ? DISPLAY_PARAM_ERR : DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenMode(uint32_t screenId, uint32_t modeId)
+{
+    CountCall(__func__);
+    return modeId == 0 && screens_.find(screenId) != screens_.end() ? DISPLAY_SUCCESS : DISPLAY_PARAM_ERR;
+}
+
+int32_t HdiDevice::GetScreenPowerStatus(uint32_t screenId, DispPowerStatus &status)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    status = screen->powerStatus;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenPowerStatus(uint32_t screenId, DispPowerStatus status)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    screen->powerStatus = status;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenBacklight(uint32_t screenId, uint32_t &level)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    level = screen->backlight;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenBacklight(uint32_t screenId, uint32_t level)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    screen->backlight = level;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::PrepareScreenLayers(uint32_t screenId, bool &needFlushFb)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    AssignPlanes(*screen);
+    needFlushFb = screen->pending.clientLayers > 0;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenCompChange(uint32_t screenId, std::vector<uint32_t> &layersId,
+                                       std::vector<int32_t> &types)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layersId = screen->changedLayers;
+    types.clear();
+    for (uint32_t layerId : layersId) {
+        types.push_back(static_cast<int32_t>(screen->layers[layerId].assigned));
+    }
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenClientBuffer(uint32_t screenId, const BufferHandle *buffer,
+                                         const sptr<SyncFence> &fence)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr || buffer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    screen->pending.clientBufferSet = true;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenClientDamage(uint32_t screenId, uint32_t num, IRect &damageRect)
+{
+    CountCall(__func__);
+    return screens_.find(screenId) == screens_.end() ? DISPLAY_PARAM_ERR : DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenVsyncEnabled(uint32_t screenId, bool enabled)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    screen->vsyncEnabled = enabled;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenReleaseFence(uint32_t screenId, std::vector<uint32_t> &layersId,
+                                         std::vector<sptr<SyncFence>> &fences)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    // the previous buffers of all layers are released once the frame just committed is presented
+    layersId.clear();
+    fences.clear();
+    for (auto &[layerId, layer] : screen->layers) {
+        layersId.push_back(layerId);
+        fences.push_back(screen->lastPresentFence);
+    }
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenSupportedColorGamuts(uint32_t screenId, std::vector<ColorGamut> &gamuts)
+{
+    CountCall(__func__);
+    gamuts = { ColorGamut::COLOR_GAMUT_SRGB };
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenColorGamut(uint32_t screenId, ColorGamut gamut)
+{
+    CountCall(__func__);
+    return gamut == ColorGamut::COLOR_GAMUT_SRGB ? DISPLAY_SUCCESS : DISPLAY_NOT_SUPPORT;
+}
+
+int32_t HdiDevice::GetScreenColorGamut(uint32_t screenId, ColorGamut &gamut)
+{
+    CountCall(__func__);
+    gamut = ColorGamut::COLOR_GAMUT_SRGB;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenGamutMap(uint32_t screenId, GamutMap gamutMap)
+{
+    CountCall(__func__);
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetScreenGamutMap(uint32_t screenId, GamutMap &gamutMap)
+{
+    CountCall(__func__);
+    gamutMap = GamutMap::GAMUT_MAP_CONSTANT;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetScreenColorTransform(uint32_t screenId, const float *matrix)
+{
+    CountCall(__func__);
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetHDRCapabilityInfos(uint32_t screenId, HDRCapability &info)
+{
+    CountCall(__func__);
+    info.formatCount = 0;
+    info.formats = nullptr;
+    info.maxLum = 0;
+    info.maxAverageLum = 0;
+    info.minLum = 0;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::GetSupportedMetaDataKey(uint32_t screenId, std::vector<HDRMetadataKey> &keys)
+{
+    CountCall(__func__);
+    keys.clear();
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::Commit(uint32_t screenId, sptr<SyncFence> &fence)
+{
+    CountCall(__func__);
+    std::unique_lock<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    CommitRecord &record = screen->pending;
+    record.screenId = screenId;
+    record.frame = frameCount_++;
+    record.commitTime = Now();
+    if (commitRecords_.size() < MAX_COMMIT_RECORDS) {
+        commitRecords_.push_back(record);
+    }
+    record = CommitRecord();
+
+    fence = SyncFence::INVALID_FENCE;
+    if (timeline_ != nullptr) {
+        uint32_t point = ++committedPoint_;
+        fence = new SyncFence(timeline_->GenerateFence("FakePresentFence", point));
+    }
+    screen->lastPresentFence = fence;
+    if (config_.vsyncPeriod <= 0 && timeline_ != nullptr) {
+        signaledPoint_ = committedPoint_;
+        lock.unlock();
+        timeline_->IncreaseSyncPoint();
+    }
+    return DISPLAY_SUCCESS;
+}
+/* set & get device screen info end */
+
+/* set & get device layer info begin */
+int32_t HdiDevice::SetLayerAlpha(uint32_t screenId, uint32_t layerId, LayerAlpha &alpha)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetLayer(screenId, layerId) == nullptr ? DISPLAY_PARAM_ERR : DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerSize(uint32_t screenId, uint32_t layerId, IRect &layerRect)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Layer *layer = GetLayer(screenId, layerId);
+    if (layer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layer->size = layerRect;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetTransformMode(uint32_t screenId, uint32_t layerId, TransformType type)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Layer *layer = GetLayer(screenId, layerId);
+    if (layer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layer->transform = type;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerVisibleRegion(uint32_t screenId, uint32_t layerId, uint32_t num, IRect &visible)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetLayer(screenId, layerId) == nullptr ? DISPLAY_PARAM_ERR : DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerDirtyRegion(uint32_t screenId, uint32_t layerId, IRect &dirty)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetLayer(screenId, layerId) == nullptr ? DISPLAY_PARAM_ERR : DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerBuffer(uint32_t screenId, uint32_t layerId, const BufferHandle *handle,
+                                  const sptr<SyncFence> &acquireFence)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Layer *layer = GetLayer(screenId, layerId);
+    if (layer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layer->format = handle != nullptr ? handle->format : PIXEL_FMT_BUTT;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerCompositionType(uint32_t screenId, uint32_t layerId, CompositionType type)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Layer *layer = GetLayer(screenId, layerId);
+    if (layer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layer->requested = type;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerBlendType(uint32_t screenId, uint32_t layerId, BlendType type)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetLayer(screenId, layerId) == nullptr ? DISPLAY_PARAM_ERR : DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerCrop(uint32_t screenId, uint32_t layerId, IRect &crop)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Layer *layer = GetLayer(screenId, layerId);
+    if (layer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layer->crop = crop;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerZorder(uint32_t screenId, uint32_t layerId, uint32_t zorder)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Layer *layer = GetLayer(screenId, layerId);
+    if (layer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layer->zorder = zorder;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerPreMulti(uint32_t screenId, uint32_t layerId, bool isPreMulti)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetLayer(screenId, layerId) == nullptr ? DISPLAY_PARAM_ERR : DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::SetLayerColorTransform(uint32_t screenId, uint32_t layerId, const float *matrix)
+{
+    CountCall(__func__);
+    return DISPLAY_NOT_SUPPORT;
+}
+
+int32_t HdiDevice::SetLayerColorDataSpace(uint32_t screenId, uint32_t layerId, ColorDataSpace colorSpace)
+{
+    CountCall(__func__);
+    return DISPLAY_NOT_SUPPORT;
+}
+
+int32_t HdiDevice::GetLayerColorDataSpace(uint32_t screenId, uint32_t layerId, ColorDataSpace &colorSpace)
+{
+    CountCall(__func__);
+    return DISPLAY_NOT_SUPPORT;
+}
+
+int32_t HdiDevice::SetLayerMetaData(uint32_t screenId, uint32_t layerId, const std::vector<HDRMetaData> &metaData)
+{
+    CountCall(__func__);
+    return DISPLAY_NOT_SUPPORT;
+}
+
+int32_t HdiDevice::SetLayerMetaDataSet(uint32_t screenId, uint32_t layerId, HDRMetadataKey key,
+                                       const std::vector<uint8_t> &metaData)
+{
+    CountCall(__func__);
+    return DISPLAY_NOT_SUPPORT;
+}
+int32_t HdiDevice::SetLayerState(uint32_t screenId, uint32_t layerId, const HdiLayerState &state, uint32_t fields)
+{
+    CountCall(__func__);
+    if (!config_.layerStateCall) {
+        return DISPLAY_NOT_SUPPORT;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Layer *layer = GetLayer(screenId, layerId);
+    if (layer == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    if (fields & LAYER_STATE_SIZE) {
+        layer->size = state.layerSize;
+    }
+    if (fields & LAYER_STATE_TRANSFORM) {
+        layer->transform = state.transform;
+    }
+    if (fields & LAYER_STATE_BUFFER) {
+        layer->format = state.buffer != nullptr ? state.buffer->format : PIXEL_FMT_BUTT;
+    }
+    if (fields & LAYER_STATE_COMPOSITION_TYPE) {
+        layer->requested = state.compositionType;
+    }
+    if (fields & LAYER_STATE_CROP) {
+        layer->crop = state.crop;
+    }
+    if (fields & LAYER_STATE_ZORDER) {
+        layer->zorder = state.zorder;
+    }
+    return DISPLAY_SUCCESS;
+}
+/* set & get device layer info end */
+
+int32_t HdiDevice::CreateLayer(uint32_t screenId, const LayerInfo &layerInfo, uint32_t &layerId)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr) {
+        return DISPLAY_PARAM_ERR;
+    }
+    layerId = nextLayerId_++;
+    Layer &layer = screen->layers[layerId];
+    layer.size = { 0, 0, layerInfo.width, layerInfo.height };
+    layer.crop = layer.size;
+    return DISPLAY_SUCCESS;
+}
+
+int32_t HdiDevice::CloseLayer(uint32_t screenId, uint32_t layerId)
+{
+    CountCall(__func__);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Screen *screen = GetScreen(screenId);
+    if (screen == nullptr || screen->layers.erase(layerId) == 0) {
+        return DISPLAY_PARAM_ERR;
+    }
+    return DISPLAY_SUCCESS;
+}
+} // namespace Fake
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_STANDARD_COMPOSER_HDIDEVICE_FAKE_H
+#define GRAPHIC_STANDARD_COMPOSER_HDIDEVICE_FAKE_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "hdi_device.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Fake {
+// what the planes of the fake display can show, layers breaking a rule are composed by the client
+struct OverlayRules {
+    // planes of the display, the client target takes one of them once any layer is composed by the client
+    uint32_t planeCount = 4;
+    std::vector<int32_t> formats = {
+        PIXEL_FMT_RGBA_8888, PIXEL_FMT_RGBX_8888, PIXEL_FMT_BGRA_8888, PIXEL_FMT_BGRX_8888,
+    };
+    bool scaling = true;
+    // crop size / layer size
+    float maxDownscale = 4.0f;
+    float maxUpscale = 8.0f;
+    bool transform = false;
+};
+
+struct HdiDeviceConfig {
+    std::vector<uint32_t> screenIds = { 0 };
+    int32_t width = 1080;
+    int32_t height = 2340;
+    // ns; 0 runs no vsync and signals the present fence of a commit right away, as a display of infinite refresh
+    int64_t vsyncPeriod = 16666667;
+    // ns; every vsync lands uniformly within [-vsyncJitter, vsyncJitter] around its ideal time
+    int64_t vsyncJitter = 0;
+    uint32_t jitterSeed = 1;
+    // false answers SetLayerState with DISPLAY_NOT_SUPPORT, as a display HDI without a batched layer call
+    bool layerStateCall = true;
+    OverlayRules overlay;
+};
+
+struct LayerDecision {
+    uint32_t layerId;
+    uint32_t zorder;
+    CompositionType requested;
+    CompositionType assigned;
+};
+
+// composition of one commit, the times are CLOCK_MONOTONIC ns
+struct CommitRecord {
+    uint32_t screenId = 0;
+    uint64_t frame = 0;
+    int64_t prepareTime = 0;
+    int64_t commitTime = 0;
+    uint32_t deviceLayers = 0;
+    uint32_t clientLayers = 0;
+    bool clientBufferSet = false;
+    std::vector<LayerDecision> layers;
+};
+
+// Display HDI stand-in for composer tests and benchmarks without a display: it assigns layers to a configurable
+// set of overlay planes, emits vblanks at a configurable rate and jitter, and signals the present fence of a commit
+// on a SyncTimeline at the next vblank. Composition decisions and their timing are recorded per commit. Plug it in
+// with HdiBackend::SetHdiDevice before RegScreenHotplug, the screens of the config are reported connected then.
+class HdiDevice : public Base::HdiDevice {
+public:
+    explicit HdiDevice(const HdiDeviceConfig &config = {});
+    ~HdiDevice() override;
+
+    std::vector<CommitRecord> GetCommitRecords() const;
+    void ClearCommitRecords();
+    // ideal vblank times with jitter applied, as reported to the vblank callbacks
+    std::vector<int64_t> GetVsyncTimestamps() const;
+    // calls of every HdiDevice function by name, SetLayerState counts once whatever the fields it carries
+    std::map<std::string, uint64_t> GetCallCounts() const;
+    // calls setting layer state, SetLayerState and the single field calls
+    uint64_t GetLayerCallCount() const;
+    void ClearCallCounts();
+    const HdiDeviceConfig &GetConfig() const
+    {
+        return config_;
+    }
+
+    /* set & get device screen info begin */
+    int32_t RegHotPlugCallback(HotPlugCallback callback, void *data) override;
+    int32_t RegScreenVBlankCallback(uint32_t screenId, VBlankCallback callback, void *data) override;
+    int32_t GetScreenCapability(uint32_t screenId, DisplayCapability &info) override;
+    int32_t GetScreenSupportedModes(uint32_t screenId, std::vector<DisplayModeInfo> &modes) override;
+    int32_t GetScreenMode(uint32_t screenId, uint32_t &modeId) override;
+    int32_t SetScreenMode(uint32_t screenId, uint32_t modeId) override;
+    int32_t GetScreenPowerStatus(uint32_t screenId, DispPowerStatus &status) override;
+    int32_t SetScreenPowerStatus(uint32_t screenId, DispPowerStatus status) override;
+    int32_t GetScreenBacklight(uint32_t screenId, uint32_t &level) override;
+    int32_t SetScreenBacklight(uint32_t screenId, uint32_t level) override;
+    int32_t PrepareScreenLayers(uint32_t screenId, bool &needFlushFb) override;
+    int32_t GetScreenCompChange(uint32_t screenId, std::vector<uint32_t> &layersId,
+                                std::vector<int32_t> &types) override;
+    int32_t SetScreenClientBuffer(uint32_t screenId, const BufferHandle *buffer,
+                                  const sptr<SyncFence> &fence) override;
+    int32_t SetScreenClientDamage(uint32_t screenId, uint32_t num, IRect &damageRect) override;
+    int32_t SetScreenVsyncEnabled(uint32_t screenId, bool enabled) override;
+    int32_t GetScreenReleaseFence(uint32_t screenId, std::vector<uint32_t> &layersId,
+                                  std::vector<sptr<SyncFence>> &fences) override;
+    int32_t GetScreenSupportedColorGamuts(uint32_t screenId, std::vector<ColorGamut> &gamuts) override;
+    int32_t SetScreenColorGamut(uint32_t screenId, ColorGamut gamut) override;
+    int32_t GetScreenColorGamut(uint32_t screenId, ColorGamut &gamut) override;
+    int32_t SetScreenGamutMap(uint32_t screenId, GamutMap gamutMap) override;
+    int32_t GetScreenGamutMap(uint32_t screenId, GamutMap &gamutMap) override;
+    int32_t SetScreenColorTransform(uint32_t screenId, const float *matrix) override;
+    int32_t GetHDRCapabilityInfos(uint32_t screenId, HDRCapability &info) override;
+    int32_t GetSupportedMetaDataKey(uint32_t screenId, std::vector<HDRMetadataKey> &keys) override;
+    int32_t Commit(uint32_t screenId, sptr<SyncFence> &fence) override;
+    /* set & get device screen info end */
+
+    /* set & get device layer info begin */
+    int32_t SetLayerAlpha(uint32_t screenId, uint32_t layerId, LayerAlpha &alpha) override;
+    int32_t SetLayerSize(uint32_t screenId, uint32_t layerId, IRect &layerRect) override;
+    int32_t SetTransformMode(uint32_t screenId, uint32_t layerId, TransformType type) override;
+    int32_t SetLayerVisibleRegion(uint32_t screenId, uint32_t layerId, uint32_t num, IRect &visible) override;
+    int32_t SetLayerDirtyRegion(uint32_t screenId, uint32_t layerId, IRect &dirty) override;
+    int32_t SetLayerBuffer(uint32_t screenId, uint32_t layerId, const BufferHandle *handle,
+                           const sptr<SyncFence> &acquireFence) override;
+    int32_t SetLayerCompositionType(uint32_t screenId, uint32_t layerId, CompositionType type) override;
+    int32_t SetLayerBlendType(uint32_t screenId, uint32_t layerId, BlendType type) override;
+    int32_t SetLayerCrop(uint32_t screenId, uint32_t layerId, IRect &crop) override;
+    int32_t SetLayerZorder(uint32_t screenId, uint32_t layerId, uint32_t zorder) override;
+    int32_t SetLayerPreMulti(uint32_t screenId, uint32_t layerId, bool isPreMulti) override;
+    int32_t SetLayerColorTransform(uint32_t screenId, uint32_t layerId, const float *matrix) override;
+    int32_t SetLayerColorDataSpace(uint32_t screenId, uint32_t layerId, ColorDataSpace colorSpace) override;
+    int32_t GetLayerColorDataSpace(uint32_t screenId, uint32_t layerId, ColorDataSpace &colorSpace) override;
+    int32_t SetLayerMetaData(uint32_t screenId, uint32_t layerId, const std::vector<HDRMetaData> &metaData) override;
+    int32_t SetLayerMetaDataSet(uint32_t screenId, uint32_t layerId, HDRMetadataKey key,
+                                const std::vector<uint8_t> &metaData) override;
+    int32_t SetLayerState(uint32_t screenId, uint32_t layerId, const HdiLayerState &state, uint32_t fields) override;
+    /* set & get device layer info end */
+
+    int32_t CreateLayer(uint32_t screenId, const LayerInfo &layerInfo, uint32_t &layerId) override;
+    int32_t CloseLayer(uint32_t screenId, uint32_t layerId) override;
+
+private:
+    struct Layer {
+        IRect size = {};
+        IRect crop = {};
+        uint32_t zorder = 0;
+        TransformType transform = TransformType::ROTATE_NONE;
+        int32_t format = PIXEL_FMT_BUTT;
+        CompositionType requested = CompositionType::COMPOSITION_DEVICE;
+        CompositionType assigned = CompositionType::COMPOSITION_DEVICE;
+    };
+
+    struct Screen {
+        std::map<uint32_t, Layer> layers;
+        std::vector<uint32_t> changedLayers;
+        bool vsyncEnabled = false;
+        VBlankCallback vblankCallback = nullptr;
+        void *vblankData = nullptr;
+        DispPowerStatus powerStatus = DispPowerStatus::POWER_STATUS_ON;
+        uint32_t backlight = 0;
+        CommitRecord pending;
+        sptr<SyncFence> lastPresentFence = SyncFence::INVALID_FENCE;
+    };
+
+    Screen *GetScreen(uint32_t screenId);
+    Layer *GetLayer(uint32_t screenId, uint32_t layerId);
+    bool IsOverlayCapable(const Layer &layer) const;
+    void AssignPlanes(Screen &screen);
+    void VsyncThreadMain();
+    void CountCall(const char *func);
+    static int64_t Now();
+
+    HdiDeviceConfig config_;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint32_t, Screen> screens_;
+    uint32_t nextLayerId_ = 0;
+    uint64_t frameCount_ = 0;
+    std::vector<CommitRecord> commitRecords_;
+    std::vector<int64_t> vsyncTimestamps_;
+    mutable std::mutex callMutex_;
+    std::map<std::string, uint64_t> callCounts_;
+
+    sptr<SyncTimeline> timeline_ = nullptr;
+    uint32_t committedPoint_ = 0;
+    uint32_t signaledPoint_ = 0;
+
+    std::mt19937 jitterRandom_;
+    std::condition_variable vsyncCond_;
+    bool running_ = true;
+    std::thread vsyncThread_;
+};
+} // namespace Fake
+} // namespace Rosen
+} // namespace OHOS
+#endif // GRAPHIC_STANDARD_COMPOSER_HDIDEVICE_FAKE_H
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fake/fake_layer_surface.h"
+
+#include "hdi_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Fake {
+namespace {
+constexpr int32_t STRIDE_ALIGNMENT = 0x8;
+constexpr uint32_t FENCE_TIMEOUT = 100; // ms
+}
+
+LayerSurface::LayerSurface(const IRect &dst, const IRect &src, int32_t zorder, int32_t format)
+    : dst_(dst), src_(src), zorder_(zorder), format_(format)
+{
+    cSurface_ = Surface::CreateSurfaceAsConsumer("FakeLayer" + std::to_string(zorder));
+    cSurface_->SetDefaultWidthAndHeight(src.w, src.h);
+    cSurface_->SetDefaultUsage(HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA);
+    cSurface_->RegisterConsumerListener(this);
+    sptr<IBufferProducer> producer = cSurface_->GetProducer();
+    pSurface_ = Surface::CreateSurfaceAsProducer(producer);
+    layerInfo_ = HdiLayerInfo::CreateHdiLayerInfo();
+}
+
+LayerSurface::~LayerSurface()
+{
+    layerInfo_ = nullptr;
+    prevBuffer_ = nullptr;
+    pSurface_ = nullptr;
+    cSurface_ = nullptr;
+}
+
+bool LayerSurface::Update()
+{
+    sptr<SurfaceBuffer> buffer = nullptr;
+    sptr<SyncFence> releaseFence = SyncFence::INVALID_FENCE;
+    BufferRequestConfig requestConfig = {
+        .width = src_.w,
+        .height = src_.h,
+        .strideAlignment = STRIDE_ALIGNMENT,
+        .format = format_,
+        .usage = pSurface_->GetDefaultUsage(),
+        .timeout = 0,
+    };
+    if (pSurface_->RequestBuffer(buffer, releaseFence, requestConfig) != SURFACE_ERROR_OK || buffer == nullptr) {
+        HLOGE("Fake LayerSurface: RequestBuffer failed");
+        return false;
+    }
+    releaseFence->Wait(FENCE_TIMEOUT);
+    BufferFlushConfig flushConfig = {
+        .damage = { .w = src_.w, .h = src_.h },
+    };
+    if (pSurface_->FlushBuffer(buffer, SyncFence::INVALID_FENCE, flushConfig) != SURFACE_ERROR_OK) {
+        HLOGE("Fake LayerSurface: FlushBuffer failed");
+        return false;
+    }
+
+    sptr<SyncFence> acquireFence = SyncFence::INVALID_FENCE;
+    int64_t timestamp = 0;
+    Rect damage = {};
+    if (cSurface_->AcquireBuffer(buffer, acquireFence, timestamp, damage) != SURFACE_ERROR_OK) {
+        HLOGE("Fake LayerSurface: AcquireBuffer failed");
+        return false;
+    }
+
+    LayerAlpha alpha = { .enPixelAlpha = true };
+    layerInfo_->SetSurface(cSurface_);
+    layerInfo_->SetBuffer(buffer, acquireFence, prevBuffer_, prevFence_);
+    layerInfo_->SetZorder(zorder_);
+    layerInfo_->SetAlpha(alpha);
+    layerInfo_->SetCompositionType(CompositionType::COMPOSITION_DEVICE);
+    layerInfo_->SetVisibleRegion(1, dst_);
+    layerInfo_->SetDirtyRegion(src_);
+    layerInfo_->SetLayerSize(dst_);
+    layerInfo_->SetBlendType(BlendType::BLEND_SRCOVER);
+    layerInfo_->SetCropRect(src_);
+    layerInfo_->SetPreMulti(false);
+    prevBuffer_ = buffer;
+    prevFence_ = acquireFence;
+    return true;
+}
+
+bool FlushClientTarget(sptr<Surface> &fbSurface, int32_t width, int32_t height)
+{
+    if (fbSurface == nullptr) {
+        return false;
+    }
+    sptr<SurfaceBuffer> buffer = nullptr;
+    sptr<SyncFence> releaseFence = SyncFence::INVALID_FENCE;
+    BufferRequestConfig requestConfig = {
+        .width = width,
+        .height = height,
+        .strideAlignment = STRIDE_ALIGNMENT,
+        .format = PIXEL_FMT_RGBA_8888,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    if (fbSurface->RequestBuffer(buffer, releaseFence, requestConfig) != SURFACE_ERROR_OK || buffer == nullptr) {
+        HLOGE("Fake FlushClientTarget: RequestBuffer failed");
+        return false;
+    }
+    releaseFence->Wait(FENCE_TIMEOUT);
+    BufferFlushConfig flushConfig = {
+        .damage = { .w = width, .h = height },
+    };
+    return fbSurface->FlushBuffer(buffer, SyncFence::INVALID_FENCE, flushConfig) == SURFACE_ERROR_OK;
+}
+} // namespace Fake
+} // namespace Rosen
+} // namespace OHOS
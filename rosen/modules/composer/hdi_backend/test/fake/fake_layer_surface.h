@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_STANDARD_COMPOSER_LAYER_SURFACE_FAKE_H
+#define GRAPHIC_STANDARD_COMPOSER_LAYER_SURFACE_FAKE_H
+
+#include <surface.h>
+
+#include "hdi_layer.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace Fake {
+// A surface and the layer info showing it, standing in for a window of RS. Every Update queues a buffer and latches
+// it into the layer info, the buffer it replaces is released by the HdiLayer once composed.
+class LayerSurface : public IBufferConsumerListenerClazz {
+public:
+    LayerSurface(const IRect &dst, const IRect &src, int32_t zorder, int32_t format = PIXEL_FMT_RGBA_8888);
+    ~LayerSurface() override;
+
+    bool Update();
+    const LayerInfoPtr &GetLayerInfo() const
+    {
+        return layerInfo_;
+    }
+    void OnBufferAvailable() override {}
+
+private:
+    IRect dst_;
+    IRect src_;
+    int32_t zorder_;
+    int32_t format_;
+    sptr<Surface> cSurface_ = nullptr;
+    sptr<Surface> pSurface_ = nullptr;
+    LayerInfoPtr layerInfo_ = nullptr;
+    sptr<SurfaceBuffer> prevBuffer_ = nullptr;
+    sptr<SyncFence> prevFence_ = SyncFence::INVALID_FENCE;
+};
+
+// what RS does in its prepare complete callback when layers are composed by the client: queue a frame buffer
+bool FlushClientTarget(sptr<Surface> &fbSurface, int32_t width, int32_t height);
+} // namespace Fake
+} // namespace Rosen
+} // namespace OHOS
+#endif // GRAPHIC_STANDARD_COMPOSER_LAYER_SURFACE_FAKE_H
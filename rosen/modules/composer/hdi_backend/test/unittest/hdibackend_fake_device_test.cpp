@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hdi_backend.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <unistd.h>
+
+#include "fake/fake_hdi_device.h"
+#include "fake/fake_layer_surface.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+class HdiBackendFakeDeviceTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void TearDown() override;
+
+    static void OnScreenHotplug(OutputPtr &output, bool connected, void* data);
+    static void OnPrepareComplete(sptr<Surface> &surface, const struct PrepareCompleteParam &param, void* data);
+    static void CreateLayers(uint32_t count, std::vector<std::unique_ptr<Fake::LayerSurface>> &layers);
+    static bool RepaintFrame(std::vector<std::unique_ptr<Fake::LayerSurface>> &layers);
+    static uint32_t GetCompositionTimeCount(const OutputPtr &output);
+
+    static inline Fake::HdiDeviceConfig config_;
+    static inline Fake::HdiDevice* device_ = nullptr;
+    static inline HdiBackend* hdiBackend_ = nullptr;
+    static inline OutputPtr output_ = nullptr;
+    // the second screen, external
+    static inline OutputPtr externalOutput_ = nullptr;
+};
+
+void HdiBackendFakeDeviceTest::SetUpTestCase()
+{
+    config_.width = 720;  // 720: screen width
+    config_.height = 1280; // 1280: screen height
+    config_.vsyncPeriod = 0;
+    config_.screenIds = { 0, 1 };
+    device_ = new Fake::HdiDevice(config_);
+    hdiBackend_ = HdiBackend::GetInstance();
+    hdiBackend_->SetHdiDevice(device_);
+    hdiBackend_->RegScreenHotplug(HdiBackendFakeDeviceTest::OnScreenHotplug, nullptr);
+    hdiBackend_->RegPrepareComplete(HdiBackendFakeDeviceTest::OnPrepareComplete, nullptr);
+}
+
+void HdiBackendFakeDeviceTest::TearDownTestCase()
+{
+    // the backend is a singleton keeping the device, so the device is never deleted
+    output_ = nullptr;
+    externalOutput_ = nullptr;
+}
+
+void HdiBackendFakeDeviceTest::TearDown()
+{
+    device_->ClearCommitRecords();
+}
+
+void HdiBackendFakeDeviceTest::OnScreenHotplug(OutputPtr &output, bool connected, void* data)
+{
+    if (connected) {
+        (output->GetScreenId() == 0 ? output_ : externalOutput_) = output;
+    }
+}
+
+void HdiBackendFakeDeviceTest::OnPrepareComplete(sptr<Surface> &surface, const struct PrepareCompleteParam &param,
+                                                 void* data)
+{
+    if (param.needFlushFramebuffer) {
+        Fake::FlushClientTarget(surface, config_.width, config_.height);
+    }
+}
+
+void HdiBackendFakeDeviceTest::CreateLayers(uint32_t count, std::vector<std::unique_ptr<Fake::LayerSurface>> &layers)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t size = 64 + static_cast<int32_t>(i) * 16; // 64, 16: cascading window sizes
+        IRect rect = { static_cast<int32_t>(i) * 16, static_cast<int32_t>(i) * 16, size, size };
+        IRect crop = { 0, 0, size, size };
+        layers.push_back(std::make_unique<Fake::LayerSurface>(rect, crop, static_cast<int32_t>(i)));
+    }
+}
+
+bool HdiBackendFakeDeviceTest::RepaintFrame(std::vector<std::unique_ptr<Fake::LayerSurface>> &layers)
+{
+    std::vector<LayerInfoPtr> layerInfos;
+    for (auto &layer : layers) {
+        if (!layer->Update()) {
+            return false;
+        }
+        layerInfos.push_back(layer->GetLayerInfo());
+    }
+    output_->SetLayerInfo(layerInfos);
+    std::vector<OutputPtr> outputs = { output_ };
+    hdiBackend_->Repaint(outputs);
+    return true;
+}
+
+uint32_t HdiBackendFakeDeviceTest::GetCompositionTimeCount(const OutputPtr &output)
+{
+    std::string dump;
+    output->DumpFps(dump, "composer");
+    std::istringstream lines(dump.substr(dump.find(":\n") + 2)); // 2: past the header
+    std::string line;
+    uint32_t count = 0;
+    while (std::getline(lines, line)) {
+        count += (!line.empty() && line != "0") ? 1 : 0;
+    }
+    return count;
+}
+
+namespace {
+/**
+ * @tc.name: Hotplug001
+ * @tc.desc: Verify the screen of the fake device is reported connected
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, Hotplug001, Function | MediumTest| Level3)
+{
+    ASSERT_NE(HdiBackendFakeDeviceTest::output_, nullptr);
+    ASSERT_EQ(HdiBackendFakeDeviceTest::output_->GetScreenId(), 0u);
+}
+
+/**
+ * @tc.name: Repaint001
+ * @tc.desc: Verify the top layers take the overlay planes and the rest, with the client target, the last plane
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, Repaint001, Function | MediumTest| Level3)
+{
+    ASSERT_NE(HdiBackendFakeDeviceTest::output_, nullptr);
+    std::vector<std::unique_ptr<Fake::LayerSurface>> layers;
+    HdiBackendFakeDeviceTest::CreateLayers(8, layers); // 8: twice the planes
+    ASSERT_TRUE(HdiBackendFakeDeviceTest::RepaintFrame(layers));
+
+    std::vector<Fake::CommitRecord> records = HdiBackendFakeDeviceTest::device_->GetCommitRecords();
+    ASSERT_EQ(records.size(), 1u);
+    ASSERT_EQ(records[0].deviceLayers, 3u);
+    ASSERT_EQ(records[0].clientLayers, 5u);
+    ASSERT_TRUE(records[0].clientBufferSet);
+    ASSERT_LE(records[0].prepareTime, records[0].commitTime);
+    for (auto &decision : records[0].layers) {
+        bool onPlane = decision.zorder >= 5; // 5: the three top layers
+        ASSERT_EQ(decision.assigned, onPlane ? CompositionType::COMPOSITION_DEVICE :
+                                               CompositionType::COMPOSITION_CLIENT);
+    }
+}
+
+/**
+ * @tc.name: Repaint002
+ * @tc.desc: Verify all layers are on planes, and no client target is set, when they fit the planes
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, Repaint002, Function | MediumTest| Level3)
+{
+    ASSERT_NE(HdiBackendFakeDeviceTest::output_, nullptr);
+    std::vector<std::unique_ptr<Fake::LayerSurface>> layers;
+    HdiBackendFakeDeviceTest::CreateLayers(4, layers); // 4: the planes
+    for (int i = 0; i < 3; i++) { // 3: frames, the buffers of the previous frame are released
+        ASSERT_TRUE(HdiBackendFakeDeviceTest::RepaintFrame(layers));
+    }
+
+    std::vector<Fake::CommitRecord> records = HdiBackendFakeDeviceTest::device_->GetCommitRecords();
+    ASSERT_EQ(records.size(), 3u);
+    for (auto &record : records) {
+        ASSERT_EQ(record.deviceLayers, 4u);
+        ASSERT_EQ(record.clientLayers, 0u);
+        ASSERT_FALSE(record.clientBufferSet);
+    }
+}
+
+/**
+ * @tc.name: Repaint003
+ * @tc.desc: Verify a layer of a format the planes can not show is composed by the client with all layers below it
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, Repaint003, Function | MediumTest| Level3)
+{
+    ASSERT_NE(HdiBackendFakeDeviceTest::output_, nullptr);
+    std::vector<std::unique_ptr<Fake::LayerSurface>> layers;
+    IRect rect = { 0, 0, 64, 64 };
+    for (int32_t i = 0; i < 3; i++) { // 3: layers
+        int32_t format = i == 1 ? PIXEL_FMT_YCBCR_420_SP : PIXEL_FMT_RGBA_8888;
+        layers.push_back(std::make_unique<Fake::LayerSurface>(rect, rect, i, format));
+    }
+    ASSERT_TRUE(HdiBackendFakeDeviceTest::RepaintFrame(layers));
+
+    std::vector<Fake::CommitRecord> records = HdiBackendFakeDeviceTest::device_->GetCommitRecords();
+    ASSERT_EQ(records.size(), 1u);
+    ASSERT_EQ(records[0].deviceLayers, 1u);
+    ASSERT_EQ(records[0].clientLayers, 2u);
+    ASSERT_TRUE(records[0].clientBufferSet);
+}
+
+/**
+ * @tc.name: Repaint004
+ * @tc.desc: Verify the primary screen set by the screen manager is committed first, and every screen records one
+ *           composition time per frame
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, Repaint004, Function | MediumTest| Level3)
+{
+    OutputPtr &output = HdiBackendFakeDeviceTest::output_;
+    OutputPtr &externalOutput = HdiBackendFakeDeviceTest::externalOutput_;
+    ASSERT_NE(output, nullptr);
+    ASSERT_NE(externalOutput, nullptr);
+    std::vector<std::unique_ptr<Fake::LayerSurface>> layers;
+    std::vector<std::unique_ptr<Fake::LayerSurface>> externalLayers;
+    HdiBackendFakeDeviceTest::CreateLayers(4, layers); // 4: layers
+    HdiBackendFakeDeviceTest::CreateLayers(4, externalLayers); // 4: layers
+    uint32_t timeCount = HdiBackendFakeDeviceTest::GetCompositionTimeCount(output);
+    uint32_t externalTimeCount = HdiBackendFakeDeviceTest::GetCompositionTimeCount(externalOutput);
+    HdiBackendFakeDeviceTest::hdiBackend_->SetPrimaryScreen(output->GetScreenId());
+    constexpr uint32_t frames = 3;
+    for (uint32_t i = 0; i < frames; i++) {
+        std::vector<LayerInfoPtr> layerInfos;
+        std::vector<LayerInfoPtr> externalLayerInfos;
+        for (uint32_t j = 0; j < layers.size(); j++) {
+            ASSERT_TRUE(layers[j]->Update());
+            ASSERT_TRUE(externalLayers[j]->Update());
+            layerInfos.push_back(layers[j]->GetLayerInfo());
+            externalLayerInfos.push_back(externalLayers[j]->GetLayerInfo());
+        }
+        output->SetLayerInfo(layerInfos);
+        externalOutput->SetLayerInfo(externalLayerInfos);
+        std::vector<OutputPtr> outputs = { externalOutput, output };
+        HdiBackendFakeDeviceTest::hdiBackend_->Repaint(outputs);
+    }
+
+    std::vector<Fake::CommitRecord> records = HdiBackendFakeDeviceTest::device_->GetCommitRecords();
+    ASSERT_EQ(records.size(), frames * 2);
+    for (uint32_t i = 0; i < records.size(); i++) {
+        ASSERT_EQ(records[i].screenId, i % 2); // the primary screen, in front of the external one
+    }
+
+    // one per frame once the present fence of the previous frame is known, not one per layer
+    timeCount = HdiBackendFakeDeviceTest::GetCompositionTimeCount(output) - timeCount;
+    externalTimeCount = HdiBackendFakeDeviceTest::GetCompositionTimeCount(externalOutput) - externalTimeCount;
+    ASSERT_GE(timeCount, frames - 1);
+    ASSERT_LE(timeCount, frames);
+    ASSERT_GE(externalTimeCount, frames - 1);
+    ASSERT_LE(externalTimeCount, frames);
+
+    // the default screen switched to the external one
+    HdiBackendFakeDeviceTest::device_->ClearCommitRecords();
+    HdiBackendFakeDeviceTest::hdiBackend_->SetPrimaryScreen(externalOutput->GetScreenId());
+    std::vector<OutputPtr> outputs = { output, externalOutput };
+    HdiBackendFakeDeviceTest::hdiBackend_->Repaint(outputs);
+    records = HdiBackendFakeDeviceTest::device_->GetCommitRecords();
+    ASSERT_EQ(records.size(), 2u);
+    ASSERT_EQ(records[0].screenId, externalOutput->GetScreenId());
+    ASSERT_EQ(records[1].screenId, output->GetScreenId());
+    HdiBackendFakeDeviceTest::hdiBackend_->SetPrimaryScreen(output->GetScreenId());
+}
+
+/**
+ * @tc.name: LayerState001
+ * @tc.desc: Verify a layer is programmed by a call per field the first time, then only for the fields changed and
+ *           the dirty region of a new buffer
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, LayerState001, Function | MediumTest| Level3)
+{
+    Fake::HdiDeviceConfig config;
+    config.vsyncPeriod = 0;
+    config.layerStateCall = false;
+    Fake::HdiDevice device(config);
+    IRect rect = { 0, 0, 64, 64 };
+    Fake::LayerSurface surface(rect, rect, 0);
+    ASSERT_TRUE(surface.Update());
+    HdiLayer layer(0);
+    layer.SetHdiDevice(&device);
+    ASSERT_TRUE(layer.Init(surface.GetLayerInfo()));
+
+    layer.UpdateLayerInfo(surface.GetLayerInfo());
+    layer.SetHdiLayerInfo();
+    std::map<std::string, uint64_t> counts = device.GetCallCounts();
+    ASSERT_EQ(counts["SetLayerState"], 1u);
+    ASSERT_EQ(counts["SetLayerBuffer"], 1u);
+    ASSERT_EQ(counts["SetLayerZorder"], 1u);
+    ASSERT_EQ(counts.count("SetTransformMode"), 0u); // the transform is left to the device
+    ASSERT_EQ(device.GetLayerCallCount(), 11u); // 11: SetLayerState and ten fields
+
+    device.ClearCallCounts();
+    layer.SetHdiLayerInfo();
+    ASSERT_EQ(device.GetLayerCallCount(), 0u);
+
+    ASSERT_TRUE(surface.Update());
+    layer.UpdateLayerInfo(surface.GetLayerInfo());
+    layer.SetHdiLayerInfo();
+    counts = device.GetCallCounts();
+    ASSERT_EQ(counts["SetLayerState"], 1u);
+    ASSERT_EQ(counts["SetLayerBuffer"], 1u);
+    ASSERT_EQ(counts["SetLayerDirtyRegion"], 1u); // the damage of the new buffer, even if unchanged
+    ASSERT_EQ(device.GetLayerCallCount(), 3u);
+
+    device.ClearCallCounts();
+    layer.UpdateCompositionType(CompositionType::COMPOSITION_CLIENT);
+    surface.GetLayerInfo()->SetCompositionType(CompositionType::COMPOSITION_DEVICE);
+    layer.SetHdiLayerInfo();
+    ASSERT_EQ(device.GetCallCounts()["SetLayerCompositionType"], 1u);
+}
+
+/**
+ * @tc.name: LayerState002
+ * @tc.desc: Verify a device with SetLayerState gets one call per changed layer
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, LayerState002, Function | MediumTest| Level3)
+{
+    ASSERT_NE(HdiBackendFakeDeviceTest::output_, nullptr);
+    std::vector<std::unique_ptr<Fake::LayerSurface>> layers;
+    HdiBackendFakeDeviceTest::CreateLayers(4, layers); // 4: the planes
+    ASSERT_TRUE(HdiBackendFakeDeviceTest::RepaintFrame(layers));
+
+    HdiBackendFakeDeviceTest::device_->ClearCallCounts();
+    ASSERT_TRUE(HdiBackendFakeDeviceTest::RepaintFrame(layers));
+    std::map<std::string, uint64_t> counts = HdiBackendFakeDeviceTest::device_->GetCallCounts();
+    ASSERT_EQ(counts["SetLayerState"], 4u);
+    ASSERT_EQ(HdiBackendFakeDeviceTest::device_->GetLayerCallCount(), 4u);
+}
+
+/**
+ * @tc.name: Vsync001
+ * @tc.desc: Verify vblanks come at the configured period within the jitter, and present fences signal at a vblank
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiBackendFakeDeviceTest, Vsync001, Function | MediumTest| Level3)
+{
+    Fake::HdiDeviceConfig config;
+    config.vsyncPeriod = 2000000;  // 2000000: 2ms
+    config.vsyncJitter = 200000;   // 200000: 0.2ms
+    Fake::HdiDevice device(config);
+
+    static std::atomic<uint32_t> vblankCount { 0 };
+    auto onVblank = [](unsigned int sequence, uint64_t ns, void *data) { vblankCount++; };
+    ASSERT_EQ(device.RegScreenVBlankCallback(0, onVblank, nullptr), DISPLAY_SUCCESS);
+    ASSERT_EQ(device.SetScreenVsyncEnabled(0, true), DISPLAY_SUCCESS);
+
+    sptr<SyncFence> presentFence = SyncFence::INVALID_FENCE;
+    ASSERT_EQ(device.Commit(0, presentFence), DISPLAY_SUCCESS);
+    ASSERT_TRUE(presentFence->IsValid());
+    ASSERT_GE(presentFence->Wait(100), 0); // 100: ms, many periods
+    ASSERT_NE(presentFence->SyncFileReadTimestamp(), SyncFence::FENCE_PENDING_TIMESTAMP);
+
+    usleep(50000); // 50000: 50ms, about 25 periods
+    ASSERT_EQ(device.SetScreenVsyncEnabled(0, false), DISPLAY_SUCCESS);
+    ASSERT_GT(vblankCount.load(), 10u); // 10: well below the 25 expected
+
+    std::vector<int64_t> timestamps = device.GetVsyncTimestamps();
+    ASSERT_GT(timestamps.size(), 1u);
+    for (size_t i = 1; i < timestamps.size(); i++) {
+        int64_t delta = timestamps[i] - timestamps[i - 1];
+        ASSERT_GE(delta, config.vsyncPeriod - 2 * config.vsyncJitter);
+        ASSERT_LE(delta, config.vsyncPeriod + 2 * config.vsyncJitter);
+    }
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
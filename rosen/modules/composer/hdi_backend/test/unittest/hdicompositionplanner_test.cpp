@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hdi_composition_planner.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+class HdiCompositionPlannerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+
+    // layers with zorder 0..n-1 of the given areas
+    static std::vector<HdiPlannerLayer> CreateLayers(const std::vector<int64_t> &areas);
+    static std::vector<CompositionType> GetTypes(const std::vector<HdiPlannerLayer> &layers);
+};
+
+void HdiCompositionPlannerTest::SetUpTestCase() {}
+void HdiCompositionPlannerTest::TearDownTestCase() {}
+
+std::vector<HdiPlannerLayer> HdiCompositionPlannerTest::CreateLayers(const std::vector<int64_t> &areas)
+{
+    std::vector<HdiPlannerLayer> layers;
+    for (uint32_t i = 0; i < areas.size(); i++) {
+        HdiPlannerLayer layer;
+        layer.layerId = i + 100; // 100: ids unrelated to the zorder
+        layer.zorder = i;
+        layer.area = areas[i];
+        layers.push_back(layer);
+    }
+    return layers;
+}
+
+std::vector<CompositionType> HdiCompositionPlannerTest::GetTypes(const std::vector<HdiPlannerLayer> &layers)
+{
+    std::vector<CompositionType> types;
+    for (auto &layer : layers) {
+        types.push_back(layer.compositionType);
+    }
+    return types;
+}
+
+namespace {
+constexpr CompositionType DEVICE = CompositionType::COMPOSITION_DEVICE;
+constexpr CompositionType CLIENT = CompositionType::COMPOSITION_CLIENT;
+
+/**
+ * @tc.name: Plan001
+ * @tc.desc: Verify all layers take a plane when there are enough, and the types requested are kept without planes
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiCompositionPlannerTest, Plan001, Function | MediumTest| Level3)
+{
+    HdiCompositionPlanner planner;
+    std::vector<HdiPlannerLayer> layers = HdiCompositionPlannerTest::CreateLayers({ 100, 100, 100 });
+    layers[1].clientOnly = true;
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ DEVICE, CLIENT, DEVICE }));
+
+    planner.SetPlaneCount(4); // 4: planes
+    layers[1].clientOnly = false;
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ DEVICE, DEVICE, DEVICE }));
+}
+
+/**
+ * @tc.name: Plan002
+ * @tc.desc: Verify the client layers form one range of the z-order covering the layers requested as client
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiCompositionPlannerTest, Plan002, Function | MediumTest| Level3)
+{
+    HdiCompositionPlanner planner;
+    planner.SetPlaneCount(4); // 4: planes
+    std::vector<HdiPlannerLayer> layers = HdiCompositionPlannerTest::CreateLayers({ 100, 100, 100, 100 });
+    layers[2].clientOnly = true;
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers),
+              std::vector<CompositionType>({ DEVICE, DEVICE, CLIENT, DEVICE }));
+
+    layers[1].clientOnly = true;
+    layers[2].clientOnly = false;
+    layers[3].clientOnly = true;
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers),
+              std::vector<CompositionType>({ DEVICE, CLIENT, CLIENT, CLIENT }));
+}
+
+/**
+ * @tc.name: Plan003
+ * @tc.desc: Verify the cheapest layers are composed by the client when there are more layers than planes
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiCompositionPlannerTest, Plan003, Function | MediumTest| Level3)
+{
+    HdiCompositionPlanner planner;
+    planner.SetPlaneCount(3); // 3: planes, two for layers and one for the client target
+    std::vector<HdiPlannerLayer> layers = HdiCompositionPlannerTest::CreateLayers({ 1000, 10, 20, 30, 1000 });
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers),
+              std::vector<CompositionType>({ DEVICE, CLIENT, CLIENT, CLIENT, DEVICE }));
+
+    // a YUV layer costs more than an RGB one of the same area, a static buffer less than a new one
+    HdiPlannerLayer layer;
+    layer.area = 100;
+    int64_t rgbCost = HdiCompositionPlanner::GetClientCost(layer);
+    layer.format = PIXEL_FMT_YCBCR_420_SP;
+    ASSERT_GT(HdiCompositionPlanner::GetClientCost(layer), rgbCost);
+    layer.format = PIXEL_FMT_RGBA_8888;
+    layer.bufferChanged = false;
+    ASSERT_LT(HdiCompositionPlanner::GetClientCost(layer), rgbCost);
+}
+
+/**
+ * @tc.name: Plan004
+ * @tc.desc: Verify the assignment of the last frame is kept until another one is clearly cheaper
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiCompositionPlannerTest, Plan004, Function | MediumTest| Level3)
+{
+    HdiCompositionPlanner planner;
+    planner.SetPlaneCount(2); // 2: one plane for a layer and one for the client target
+    std::vector<HdiPlannerLayer> layers = HdiCompositionPlannerTest::CreateLayers({ 100, 100, 110 });
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ CLIENT, CLIENT, DEVICE }));
+
+    layers[2].area = 95; // 95: slightly cheaper to compose the top layers
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ CLIENT, CLIENT, DEVICE }));
+
+    layers[2].area = 50; // 50: clearly cheaper to compose the top layers
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ DEVICE, CLIENT, CLIENT }));
+}
+
+/**
+ * @tc.name: OnDeviceReject001
+ * @tc.desc: Verify a layer demoted by the device is planned on the client until its format or size changes
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiCompositionPlannerTest, OnDeviceReject001, Function | MediumTest| Level3)
+{
+    HdiCompositionPlanner planner;
+    planner.SetPlaneCount(4); // 4: planes
+    std::vector<HdiPlannerLayer> layers = HdiCompositionPlannerTest::CreateLayers({ 100, 100 });
+    layers[1].format = PIXEL_FMT_YCBCR_420_SP;
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ DEVICE, DEVICE }));
+
+    planner.OnDeviceReject(layers[1]);
+    for (int32_t i = 0; i < 3; i++) { // 3: frames
+        planner.Plan(layers);
+        ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ DEVICE, CLIENT }));
+    }
+
+    layers[1].format = PIXEL_FMT_RGBA_8888;
+    planner.Plan(layers);
+    ASSERT_EQ(HdiCompositionPlannerTest::GetTypes(layers), std::vector<CompositionType>({ DEVICE, DEVICE }));
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include "fence_watcher.h"
+
 using namespace testing;
 using namespace testing::ext;
 
@@ -26,6 +28,7 @@ class HdiFramebufferSurfaceTest : public testing::Test {
 public:
     static void SetUpTestCase();
     static void TearDownTestCase();
+    static std::unique_ptr<FrameBufferEntry> QueueFramebuffer();
 
     static inline sptr<HdiFramebufferSurface> hdiFramebufferSurface_ = nullptr;
 };
@@ -36,5 +39,87 @@ void HdiFramebufferSurfaceTest::SetUpTestCase()
 }
 
 void HdiFramebufferSurfaceTest::TearDownTestCase() {}
+
+std::unique_ptr<FrameBufferEntry> HdiFramebufferSurfaceTest::QueueFramebuffer()
+{
+    sptr<Surface> producer = hdiFramebufferSurface_->GetSurface();
+    sptr<SurfaceBuffer> buffer = nullptr;
+    sptr<SyncFence> releaseFence = SyncFence::INVALID_FENCE;
+    BufferRequestConfig requestConfig = {
+        .width = 64, // 64: buffer width
+        .height = 64, // 64: buffer height
+        .strideAlignment = 8, // 8: stride alignment
+        .format = PIXEL_FMT_RGBA_8888,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    if (producer->RequestBuffer(buffer, releaseFence, requestConfig) != SURFACE_ERROR_OK || buffer == nullptr) {
+        return nullptr;
+    }
+    BufferFlushConfig flushConfig = {
+        .damage = { .w = 64, .h = 64 }, // 64: damage size
+    };
+    if (producer->FlushBuffer(buffer, SyncFence::INVALID_FENCE, flushConfig) != SURFACE_ERROR_OK) {
+        return nullptr;
+    }
+    return hdiFramebufferSurface_->GetFramebuffer();
+}
+
+namespace {
+/**
+ * @tc.name: ReleaseFramebuffer001
+ * @tc.desc: Verify a release deferred to its release fence reports its failure through the next call
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiFramebufferSurfaceTest, ReleaseFramebuffer001, Function | MediumTest| Level3)
+{
+    ASSERT_NE(HdiFramebufferSurfaceTest::hdiFramebufferSurface_, nullptr);
+    auto fbEntry = HdiFramebufferSurfaceTest::QueueFramebuffer();
+    ASSERT_NE(fbEntry, nullptr);
+    sptr<SyncTimeline> timeline = new SyncTimeline();
+    ASSERT_TRUE(timeline->IsValid());
+    sptr<SyncFence> releaseFence = new SyncFence(timeline->GenerateFence("fb release", 1));
+
+    auto &fbSurface = HdiFramebufferSurfaceTest::hdiFramebufferSurface_;
+    ASSERT_EQ(fbSurface->ReleaseFramebuffer(fbEntry->buffer, releaseFence), SURFACE_ERROR_OK);
+    // released again before the fence signals, so the deferred release fails
+    ASSERT_EQ(fbSurface->ReleaseFramebuffer(fbEntry->buffer, SyncFence::INVALID_FENCE), SURFACE_ERROR_OK);
+    ASSERT_EQ(timeline->IncreaseSyncPoint(1), 0);
+    FenceWatcher::GetInstance().Flush();
+
+    sptr<SurfaceBuffer> noBuffer = nullptr;
+    ASSERT_NE(fbSurface->ReleaseFramebuffer(noBuffer, SyncFence::INVALID_FENCE), SURFACE_ERROR_OK);
+    ASSERT_EQ(fbSurface->ReleaseFramebuffer(noBuffer, SyncFence::INVALID_FENCE), SURFACE_ERROR_OK);
+}
+
+/**
+ * @tc.name: ReleaseFramebuffer002
+ * @tc.desc: Verify a release fence timing out releases the framebuffer and is reported through the next call
+ * @tc.type:FUNC
+ * @tc.require:AR000GGP0P
+ * @tc.author:
+ */
+HWTEST_F(HdiFramebufferSurfaceTest, ReleaseFramebuffer002, Function | MediumTest| Level3)
+{
+    ASSERT_NE(HdiFramebufferSurfaceTest::hdiFramebufferSurface_, nullptr);
+    auto fbEntry = HdiFramebufferSurfaceTest::QueueFramebuffer();
+    ASSERT_NE(fbEntry, nullptr);
+    sptr<SyncTimeline> timeline = new SyncTimeline();
+    ASSERT_TRUE(timeline->IsValid());
+    sptr<SyncFence> releaseFence = new SyncFence(timeline->GenerateFence("fb release", 1));
+
+    // what the FenceWatcher calls once RELEASE_FENCE_TIMEOUT_MS passed
+    auto &fbSurface = HdiFramebufferSurfaceTest::hdiFramebufferSurface_;
+    fbSurface->OnReleaseFenceDone(fbEntry->buffer, releaseFence, FenceStatus::ACTIVE);
+    // the buffer is back in the queue, so it can not be released again
+    ASSERT_NE(fbSurface->ReleaseFramebufferNow(fbEntry->buffer, SyncFence::INVALID_FENCE), SURFACE_ERROR_OK);
+
+    sptr<SurfaceBuffer> noBuffer = nullptr;
+    ASSERT_EQ(fbSurface->ReleaseFramebuffer(noBuffer, SyncFence::INVALID_FENCE), SURFACE_ERROR_ERROR);
+    ASSERT_EQ(timeline->IncreaseSyncPoint(1), 0);
+}
+} // namespace
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
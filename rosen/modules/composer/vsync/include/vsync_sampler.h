@@ -34,6 +34,8 @@ public:
     virtual int64_t GetPeriod() const = 0;
     virtual int64_t GetPhase() const = 0;
     virtual int64_t GetRefrenceTime() const = 0;
+    // 0 to 1, how well the period and phase fit the hardware vsync samples
+    virtual double GetConfidence() const = 0;
     virtual bool AddPresentFenceTime(int64_t timestamp) = 0;
     virtual void SetHardwareVSyncStatus(bool enabled) = 0;
     virtual bool GetHardwareVSyncStatus() const = 0;
@@ -55,6 +57,7 @@ public:
     virtual int64_t GetPeriod() const override;
     virtual int64_t GetPhase() const override;
     virtual int64_t GetRefrenceTime() const override;
+    virtual double GetConfidence() const override;
     virtual bool AddPresentFenceTime(int64_t timestamp) override;
     virtual void SetHardwareVSyncStatus(bool enabled) override;
     virtual bool GetHardwareVSyncStatus() const override;
@@ -63,6 +66,8 @@ private:
     friend class OHOS::Rosen::VSyncSampler;
     enum { MAX_SAMPLES = 32 };
     enum { MIN_SAMPLES_FOR_UPDATE = 6 };
+    // consecutive samples agreeing on a new period which restart the window, also the fewest samples fitted
+    enum { RATE_CHANGE_SAMPLES = 4 };
     enum { MAX_SAMPLES_WITHOUT_PRESENT = 4 };
     enum { NUM_PRESENT = 8 };
 
@@ -70,6 +75,7 @@ private:
     ~VSyncSampler() noexcept override;
 
     void UpdateModeLocked();
+    bool DetectRateChangeLocked();
     void UpdateErrorLocked();
     void ResetErrorLocked();
 
@@ -77,6 +83,7 @@ private:
     int64_t phase_;
     int64_t referenceTime_;
     int64_t error_;
+    double confidence_ = 0;
     int64_t samples_[MAX_SAMPLES];
     int64_t presentFenceTime_[NUM_PRESENT] = {-1};
     uint32_t firstSampleIndex_;
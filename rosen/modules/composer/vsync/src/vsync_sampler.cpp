@@ -14,6 +14,7 @@
  */
 
 #include "vsync_sampler.h"
+#include <algorithm>
 #include <cmath>
 #include "vsync_generator.h"
 
@@ -24,10 +25,67 @@ std::once_flag VSyncSampler::createFlag_;
 sptr<OHOS::Rosen::VSyncSampler> VSyncSampler::instance_ = nullptr;
 
 namespace {
-constexpr double PI = 3.1415926;
 constexpr int64_t g_errorThreshold = 40000000000; // 200 usec squared
 constexpr int32_t INVAILD_TIMESTAMP = -1;
-constexpr int32_t MINES_SAMPLE_NUMS = 3;
+// a sample is an outlier beyond 3 robust standard deviations of the residuals, and beyond 1/20 of the period
+constexpr double OUTLIER_SIGMAS = 3.0;
+constexpr double MIN_OUTLIER_RATIO = 0.05;
+// scale of the median absolute deviation to the standard deviation of normally distributed residuals
+constexpr double MAD_TO_SIGMA = 1.4826;
+// the confidence drops to 0 as the rms residual reaches 1/20 of the period
+constexpr double CONFIDENCE_JITTER_RATIO = 0.05;
+// hardware vsync may be turned off from this confidence on
+constexpr double MIN_CONFIDENCE = 0.8;
+// intervals off the period by more than 1/10 of it, agreeing with each other within 1/20, are a new refresh rate
+constexpr int64_t RATE_CHANGE_DIVISOR = 10;
+constexpr int64_t RATE_CHANGE_SPREAD_DIVISOR = 20;
+constexpr double HALF = 0.5;
+
+template<typename T>
+T Median(T* values, uint32_t count)
+{
+    std::nth_element(values, values + count / 2, values + count);
+    return values[count / 2];
+}
+
+struct LineFit {
+    double intercept = 0;
+    double slope = 0;
+};
+
+// least squares fit of y = intercept + slope * x over the samples selected by mask
+bool FitLine(const double* x, const double* y, const bool* mask, uint32_t count, LineFit& fit)
+{
+    double sumX = 0;
+    double sumY = 0;
+    uint32_t num = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (mask[i]) {
+            sumX += x[i];
+            sumY += y[i];
+            num++;
+        }
+    }
+    if (num < 2) { // 2: a line needs two points
+        return false;
+    }
+    double meanX = sumX / num;
+    double meanY = sumY / num;
+    double covXY = 0;
+    double varX = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (mask[i]) {
+            covXY += (x[i] - meanX) * (y[i] - meanY);
+            varX += (x[i] - meanX) * (x[i] - meanX);
+        }
+    }
+    if (varX <= 0) {
+        return false;
+    }
+    fit.slope = covXY / varX;
+    fit.intercept = meanY - fit.slope * meanX;
+    return fit.slope > 0;
+}
 }
 sptr<OHOS::Rosen::VSyncSampler> VSyncSampler::GetInstance() noexcept
 {
@@ -53,6 +111,7 @@ void VSyncSampler::Reset()
     phase_ = 0;
     referenceTime_ = 0;
     error_ = 0;
+    confidence_ = 0;
     firstSampleIndex_ = 0;
     numSamples_ = 0;
     modeUpdated_ = false;
@@ -73,6 +132,7 @@ void VSyncSampler::BeginSample()
     std::lock_guard<std::mutex> lock(mutex_);
     numSamples_ = 0;
     modeUpdated_ = false;
+    confidence_ = 0;
     hardwareVSyncStatus_ = true;
 }
 
@@ -106,6 +166,7 @@ bool VSyncSampler::AddSample(int64_t timeStamp)
     uint32_t index = (firstSampleIndex_ + numSamples_ - 1) % MAX_SAMPLES;
     samples_[index] = timeStamp;
 
+    DetectRateChangeLocked();
     UpdateModeLocked();
 
     if (numResyncSamplesSincePresent_++ > MAX_SAMPLES_WITHOUT_PRESENT) {
@@ -113,47 +174,111 @@ bool VSyncSampler::AddSample(int64_t timeStamp)
     }
 
     // 1/2 just a empirical value
-    bool ret = modeUpdated_ & (error_ < g_errorThreshold / 2);
+    bool ret = modeUpdated_ && (error_ < g_errorThreshold / 2) && confidence_ >= MIN_CONFIDENCE;
     return !ret;
 }
 
 
-void VSyncSampler::UpdateModeLocked()
+bool VSyncSampler::DetectRateChangeLocked()
 {
-    if (numSamples_ >= MIN_SAMPLES_FOR_UPDATE) {
-        int64_t sum = 0;
-        int64_t min = INT64_MAX;
-        int64_t max = 0;
-        for (uint32_t i = 1; i < numSamples_; i++) {
-            int64_t prevSample = samples_[(firstSampleIndex_ + i - 1 + MAX_SAMPLES) % MAX_SAMPLES];
-            int64_t currentSample = samples_[(firstSampleIndex_ + i) % MAX_SAMPLES];
-            int64_t diff = currentSample - prevSample;
-            min = min < diff ? min : diff;
-            max = max > diff ? max : diff;
-            sum += diff;
-        }
-        sum -= min;
-        sum -= max;
-
-        period_ = sum / (numSamples_ - MINES_SAMPLE_NUMS);
-
-        double scale = 2.0 * PI / period_;
-        double deltaAvgX = 0;
-        double deltaAvgY = 0;
-        for (uint32_t i = 1; i < numSamples_; i++) {
-            double delta = (samples_[(firstSampleIndex_ + i) % MAX_SAMPLES] - referenceTime_) % period_ * scale;
-            deltaAvgX += cos(delta);
-            deltaAvgY += sin(delta);
+    if (!modeUpdated_ || numSamples_ <= RATE_CHANGE_SAMPLES) {
+        return false;
+    }
+
+    int64_t minDiff = INT64_MAX;
+    int64_t maxDiff = 0;
+    for (uint32_t i = numSamples_ - RATE_CHANGE_SAMPLES + 1; i < numSamples_; i++) {
+        int64_t diff = samples_[(firstSampleIndex_ + i) % MAX_SAMPLES] -
+            samples_[(firstSampleIndex_ + i - 1) % MAX_SAMPLES];
+        if (std::abs(diff - period_) * RATE_CHANGE_DIVISOR <= period_) {
+            return false;
         }
+        minDiff = std::min(minDiff, diff);
+        maxDiff = std::max(maxDiff, diff);
+    }
+    if (minDiff <= 0 || (maxDiff - minDiff) * RATE_CHANGE_SPREAD_DIVISOR > minDiff) {
+        return false;
+    }
+
+    // the older samples belong to the former refresh rate
+    firstSampleIndex_ = (firstSampleIndex_ + numSamples_ - RATE_CHANGE_SAMPLES) % MAX_SAMPLES;
+    numSamples_ = RATE_CHANGE_SAMPLES;
+    return true;
+}
+
+void VSyncSampler::UpdateModeLocked()
+{
+    if (numSamples_ < RATE_CHANGE_SAMPLES) {
+        return;
+    }
 
-        deltaAvgX /= double(numSamples_ - 1);
-        deltaAvgY /= double(numSamples_ - 1);
+    // the median interval tells the vsync count between two samples, even across a missed or a late sample
+    int64_t diffs[MAX_SAMPLES];
+    int64_t firstSample = samples_[firstSampleIndex_];
+    for (uint32_t i = 1; i < numSamples_; i++) {
+        diffs[i - 1] = samples_[(firstSampleIndex_ + i) % MAX_SAMPLES] -
+            samples_[(firstSampleIndex_ + i - 1) % MAX_SAMPLES];
+    }
+    int64_t periodGuess = Median(diffs, numSamples_ - 1);
+    if (periodGuess <= 0) {
+        return;
+    }
 
-        phase_ = int64_t(::atan2(deltaAvgY, deltaAvgX) / scale);
+    double vsyncCount[MAX_SAMPLES];
+    double time[MAX_SAMPLES];
+    bool inlier[MAX_SAMPLES];
+    vsyncCount[0] = 0;
+    time[0] = 0;
+    inlier[0] = true;
+    for (uint32_t i = 1; i < numSamples_; i++) {
+        int64_t sample = samples_[(firstSampleIndex_ + i) % MAX_SAMPLES];
+        int64_t diff = sample - samples_[(firstSampleIndex_ + i - 1) % MAX_SAMPLES];
+        vsyncCount[i] = vsyncCount[i - 1] + std::max<int64_t>(1, std::llround(double(diff) / periodGuess));
+        time[i] = double(sample - firstSample);
+        inlier[i] = true;
+    }
 
-        modeUpdated_ = true;
-        CreateVSyncGenerator()->UpdateMode(period_, phase_, referenceTime_);
+    // fit all samples, reject the outliers by their residual and fit the others again
+    LineFit fit;
+    if (!FitLine(vsyncCount, time, inlier, numSamples_, fit)) {
+        return;
+    }
+    double residuals[MAX_SAMPLES];
+    double absResiduals[MAX_SAMPLES];
+    for (uint32_t i = 0; i < numSamples_; i++) {
+        residuals[i] = time[i] - (fit.intercept + fit.slope * vsyncCount[i]);
+        absResiduals[i] = std::abs(residuals[i]);
     }
+    double sigma = MAD_TO_SIGMA * Median(absResiduals, numSamples_);
+    double threshold = std::max(OUTLIER_SIGMAS * sigma, MIN_OUTLIER_RATIO * fit.slope);
+    uint32_t numInliers = 0;
+    for (uint32_t i = 0; i < numSamples_; i++) {
+        inlier[i] = std::abs(residuals[i]) <= threshold;
+        numInliers += inlier[i] ? 1 : 0;
+    }
+    if (numInliers < numSamples_ && !FitLine(vsyncCount, time, inlier, numSamples_, fit)) {
+        return;
+    }
+
+    double squareSum = 0;
+    for (uint32_t i = 0; i < numSamples_; i++) {
+        if (inlier[i]) {
+            double residual = time[i] - (fit.intercept + fit.slope * vsyncCount[i]);
+            squareSum += residual * residual;
+        }
+    }
+    double rms = std::sqrt(squareSum / numInliers);
+    confidence_ = double(numInliers) / numSamples_ *
+        std::min(1.0, double(numInliers) / MIN_SAMPLES_FOR_UPDATE) *
+        std::max(0.0, 1.0 - rms / (CONFIDENCE_JITTER_RATIO * fit.slope));
+
+    // the phase is the offset of the fitted vsyncs to the reference time, within half a period
+    period_ = std::llround(fit.slope);
+    double offset = double(firstSample - referenceTime_) + fit.intercept;
+    phase_ = std::llround(offset - std::floor(offset / fit.slope + HALF) * fit.slope);
+
+    modeUpdated_ = true;
+    CreateVSyncGenerator()->UpdateMode(period_, phase_, referenceTime_);
 }
 
 void VSyncSampler::UpdateErrorLocked()
@@ -162,8 +287,8 @@ void VSyncSampler::UpdateErrorLocked()
         return;
     }
 
-    int numErrSamples = 0;
-    int64_t sqErrSum = 0;
+    uint32_t numErrSamples = 0;
+    int64_t sqErrs[NUM_PRESENT];
 
     for (uint32_t i = 0; i < NUM_PRESENT; i++) {
         int64_t t = presentFenceTime_[i];
@@ -181,12 +306,12 @@ void VSyncSampler::UpdateErrorLocked()
         if (sampleErr > period_ / 2) {
             sampleErr -= period_;
         }
-        sqErrSum += sampleErr * sampleErr;
-        numErrSamples++;
+        sqErrs[numErrSamples++] = sampleErr * sampleErr;
     }
 
+    // the median, a single late fence does not force a resync
     if (numErrSamples > 0) {
-        error_ = sqErrSum / numErrSamples;
+        error_ = Median(sqErrs, numErrSamples);
     } else {
         error_ = 0;
     }
@@ -222,6 +347,12 @@ int64_t VSyncSampler::GetRefrenceTime() const
     return referenceTime_;
 }
 
+double VSyncSampler::GetConfidence() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return confidence_;
+}
+
 VSyncSampler::~VSyncSampler()
 {
 }
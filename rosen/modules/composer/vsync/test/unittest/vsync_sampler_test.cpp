@@ -15,6 +15,9 @@
 
 #include "vsync_sampler.h"
 
+#include <cstdlib>
+#include <random>
+
 #include <gtest/gtest.h>
 
 using namespace testing;
@@ -24,6 +27,25 @@ namespace OHOS {
 namespace Rosen {
 namespace {
 constexpr int32_t SAMPLER_NUMBER = 6;
+constexpr int64_t PERIOD_60HZ = 16666667;
+constexpr int64_t PERIOD_90HZ = 11111111;
+constexpr int64_t START_TIME = 1000000000;
+constexpr double JITTER_STDDEV = 50000; // 50 usec
+constexpr int64_t PERIOD_TOLERANCE = 20000;
+constexpr int64_t PHASE_TOLERANCE = 100000;
+
+// feeds count jittered hardware vsync timestamps from time on, returns the last result of AddSample
+bool AddJitteredSamples(const sptr<VSyncSampler>& sampler, int64_t& time, int64_t period, int count,
+    std::mt19937& random)
+{
+    std::normal_distribution<double> jitter(0, JITTER_STDDEV);
+    bool ret = true;
+    for (int i = 0; i < count; i++) {
+        ret = sampler->AddSample(time + static_cast<int64_t>(jitter(random)));
+        time += period;
+    }
+    return ret;
+}
 }
 class VSyncSamplerTest : public testing::Test {
 public:
@@ -212,6 +234,103 @@ HWTEST_F(VSyncSamplerTest, AddPresentFenceTime002, Function | MediumTest| Level3
     ASSERT_EQ(VSyncSamplerTest::vsyncSampler->AddPresentFenceTime(SAMPLER_NUMBER + 1), false);
     VSyncSamplerTest::vsyncSampler->Reset();
 }
+
+/*
+* Function: JitteredSamples001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. add 60Hz samples with gaussian jitter, a missed vsync and late outliers
+*                  2. check the period, the phase and the confidence, hardware vsync may be turned off
+ */
+HWTEST_F(VSyncSamplerTest, JitteredSamples001, Function | MediumTest| Level3)
+{
+    std::mt19937 random(1);
+    int64_t time = START_TIME;
+    AddJitteredSamples(VSyncSamplerTest::vsyncSampler, time, PERIOD_60HZ, 10, random);
+    time += PERIOD_60HZ; // missed vsync
+    AddJitteredSamples(VSyncSamplerTest::vsyncSampler, time, PERIOD_60HZ, 10, random);
+    VSyncSamplerTest::vsyncSampler->AddSample(time + PERIOD_60HZ / 4); // late by a quarter period
+    time += PERIOD_60HZ;
+    bool ret = AddJitteredSamples(VSyncSamplerTest::vsyncSampler, time, PERIOD_60HZ, 10, random);
+
+    ASSERT_EQ(ret, false);
+    ASSERT_LT(std::abs(VSyncSamplerTest::vsyncSampler->GetPeriod() - PERIOD_60HZ), PERIOD_TOLERANCE);
+    ASSERT_LT(std::abs(VSyncSamplerTest::vsyncSampler->GetPhase()), PHASE_TOLERANCE);
+    ASSERT_GT(VSyncSamplerTest::vsyncSampler->GetConfidence(), 0.8);
+    VSyncSamplerTest::vsyncSampler->Reset();
+}
+
+/*
+* Function: JitteredSamples002
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. add samples with a jitter of a fifth of the period
+*                  2. check the confidence keeps hardware vsync on
+ */
+HWTEST_F(VSyncSamplerTest, JitteredSamples002, Function | MediumTest| Level3)
+{
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int64_t> jitter(-PERIOD_60HZ / 5, PERIOD_60HZ / 5);
+    bool ret = false;
+    for (int i = 0; i < 20; i++) {
+        ret = VSyncSamplerTest::vsyncSampler->AddSample(START_TIME + i * PERIOD_60HZ + jitter(random));
+    }
+    ASSERT_EQ(ret, true);
+    ASSERT_LT(VSyncSamplerTest::vsyncSampler->GetConfidence(), 0.8);
+    VSyncSamplerTest::vsyncSampler->Reset();
+}
+
+/*
+* Function: RefreshRateChange001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. add 60Hz samples, then 90Hz samples
+*                  2. check the period follows within a few samples and hardware vsync stays on meanwhile
+ */
+HWTEST_F(VSyncSamplerTest, RefreshRateChange001, Function | MediumTest| Level3)
+{
+    std::mt19937 random(1);
+    int64_t time = START_TIME;
+    ASSERT_EQ(AddJitteredSamples(VSyncSamplerTest::vsyncSampler, time, PERIOD_60HZ, 20, random), false);
+    ASSERT_LT(std::abs(VSyncSamplerTest::vsyncSampler->GetPeriod() - PERIOD_60HZ), PERIOD_TOLERANCE);
+
+    time = time - PERIOD_60HZ + PERIOD_90HZ;
+    ASSERT_EQ(AddJitteredSamples(VSyncSamplerTest::vsyncSampler, time, PERIOD_90HZ, 4, random), true);
+    ASSERT_LT(std::abs(VSyncSamplerTest::vsyncSampler->GetPeriod() - PERIOD_90HZ), PERIOD_TOLERANCE * 3);
+    ASSERT_EQ(AddJitteredSamples(VSyncSamplerTest::vsyncSampler, time, PERIOD_90HZ, 4, random), false);
+    ASSERT_LT(std::abs(VSyncSamplerTest::vsyncSampler->GetPeriod() - PERIOD_90HZ), PERIOD_TOLERANCE);
+    VSyncSamplerTest::vsyncSampler->Reset();
+}
+
+/*
+* Function: AddPresentFenceTime003
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. add 60Hz samples and present fences on the vsyncs but one late by a third period
+*                  2. check no resync is requested
+ */
+HWTEST_F(VSyncSamplerTest, AddPresentFenceTime003, Function | MediumTest| Level3)
+{
+    std::mt19937 random(1);
+    int64_t time = START_TIME;
+    ASSERT_EQ(AddJitteredSamples(VSyncSamplerTest::vsyncSampler, time, PERIOD_60HZ, 10, random), false);
+    bool ret = false;
+    for (int i = 0; i < 8; i++) {
+        int64_t fenceTime = time + i * PERIOD_60HZ + (i == 3 ? PERIOD_60HZ / 3 : 0);
+        ret = ret || VSyncSamplerTest::vsyncSampler->AddPresentFenceTime(fenceTime);
+    }
+    ASSERT_EQ(ret, false);
+    ASSERT_EQ(VSyncSamplerTest::vsyncSampler->AddPresentFenceTime(time + PERIOD_60HZ / 2), false);
+    for (int i = 0; i < 4; i++) {
+        ret = VSyncSamplerTest::vsyncSampler->AddPresentFenceTime(time + i * PERIOD_60HZ + PERIOD_60HZ / 3);
+    }
+    ASSERT_EQ(ret, true);
+    VSyncSamplerTest::vsyncSampler->Reset();
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "animation/rs_animation_log.h"
+
+namespace {
+constexpr int RET_INVALID_ARGS = 2;
+constexpr int RET_DECODE_FAILED = 1;
+constexpr int ARG_COUNT_OUTPUT_FILE = 3;
+
+void PrintUsage()
+{
+    printf("usage: rs_animation_log_decoder log_file [text_file]\n"
+           "  decodes a binary animation log (/etc/rosen/Animation*.bin) to text, on stdout without text_file\n");
+}
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < ARG_COUNT_OUTPUT_FILE - 1 || argc > ARG_COUNT_OUTPUT_FILE) {
+        PrintUsage();
+        return RET_INVALID_ARGS;
+    }
+
+    std::ofstream textFile;
+    if (argc == ARG_COUNT_OUTPUT_FILE) {
+        textFile.open(argv[ARG_COUNT_OUTPUT_FILE - 1]);
+        if (!textFile.is_open()) {
+            printf("can't write %s\n", argv[ARG_COUNT_OUTPUT_FILE - 1]);
+            return RET_INVALID_ARGS;
+        }
+    }
+    std::ostream& out = textFile.is_open() ? textFile : std::cout;
+    if (!OHOS::Rosen::RSAnimationLog::DecodeLogFile(argv[1], out)) {
+        printf("can't decode %s\n", argv[1]);
+        return RET_DECODE_FAILED;
+    }
+    return 0;
+}
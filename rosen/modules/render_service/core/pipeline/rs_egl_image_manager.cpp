@@ -242,7 +242,7 @@ void RSEglImageManager::WaitAcquireFence(const sptr<SyncFence>& acquireFence)
     acquireFence->Wait(3000); // 3000ms
 }
 
-GLuint RSEglImageManager::CreateImageCacheFromBuffer(const sptr<OHOS::SurfaceBuffer>& buffer)
+GLuint RSEglImageManager::CreateImageCacheFromBuffer(const sptr<OHOS::SurfaceBuffer>& buffer, pid_t pid)
 {
     auto bufferId = buffer->GetSeqNum();
     auto imageCache = ImageCacheSeq::Create(eglDisplay_, EGL_NO_CONTEXT, buffer);
@@ -252,44 +252,97 @@ GLuint RSEglImageManager::CreateImageCacheFromBuffer(const sptr<OHOS::SurfaceBuf
         return 0; // return texture id 0.
     }
     auto textureId = imageCache->TextureId();
-    imageCacheSeqs_[bufferId] = std::move(imageCache);
-    cacheQueue_.push(bufferId);
+    lruList_.push_front(bufferId);
+    imageCacheSeqs_[bufferId] = { std::move(imageCache), pid, frameCount_, lruList_.begin() };
+    processCacheSizes_[pid]++;
     return textureId;
 }
 
 GLuint RSEglImageManager::MapEglImageFromSurfaceBuffer(const sptr<OHOS::SurfaceBuffer>& buffer,
-    const sptr<SyncFence>& acquireFence)
+    const sptr<SyncFence>& acquireFence, pid_t pid)
 {
     WaitAcquireFence(acquireFence);
     std::lock_guard<std::mutex> lock(opMutex_);
     auto bufferId = buffer->GetSeqNum();
-    if (imageCacheSeqs_.count(bufferId) == 0) {
+    auto iter = imageCacheSeqs_.find(bufferId);
+    if (iter == imageCacheSeqs_.end()) {
         // cache not found, create it.
-        return CreateImageCacheFromBuffer(buffer);
-    } else {
-        return imageCacheSeqs_[bufferId]->TextureId();
+        return CreateImageCacheFromBuffer(buffer, pid);
     }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.lruPos);
+    iter->second.lastUsedFrame = frameCount_;
+    return iter->second.imageCache->TextureId();
+}
+
+bool RSEglImageManager::IsRecentlyUsed(const ImageCacheEntry& entry) const
+{
+    return frameCount_ - entry.lastUsedFrame < RECENT_USE_FRAMES;
 }
 
 void RSEglImageManager::ShrinkCachesIfNeeded()
 {
-    while (cacheQueue_.size() > MAX_CACHE_SIZE) {
-        const int32_t id = cacheQueue_.front();
-        UnMapEglImageFromSurfaceBuffer(id);
-        cacheQueue_.pop();
+    std::lock_guard<std::mutex> lock(opMutex_);
+    // least recently used first: images of processes over their quota, then any images over the total limit.
+    // the list is ordered by use, so the walk stops at the first image that is still in use.
+    for (auto iter = lruList_.end(); iter != lruList_.begin();) {
+        --iter;
+        const auto& entry = imageCacheSeqs_[*iter];
+        if (IsRecentlyUsed(entry)) {
+            break;
+        }
+        if (entry.pid == 0 || processCacheSizes_[entry.pid] <= MAX_CACHE_SIZE_PER_PROCESS) {
+            continue;
+        }
+        auto next = std::next(iter);
+        EraseImageCache(*iter);
+        iter = next;
+    }
+    while (lruList_.size() > MAX_CACHE_SIZE && !IsRecentlyUsed(imageCacheSeqs_[lruList_.back()])) {
+        EraseImageCache(lruList_.back());
+    }
+    frameCount_++;
+}
+
+bool RSEglImageManager::IsImageCached(int32_t seqNum) const
+{
+    std::lock_guard<std::mutex> lock(opMutex_);
+    return imageCacheSeqs_.find(seqNum) != imageCacheSeqs_.end();
+}
+
+size_t RSEglImageManager::GetImageCacheCount() const
+{
+    std::lock_guard<std::mutex> lock(opMutex_);
+    return imageCacheSeqs_.size();
+}
+
+void RSEglImageManager::EraseImageCache(int32_t seqNum)
+{
+    auto iter = imageCacheSeqs_.find(seqNum);
+    if (iter == imageCacheSeqs_.end()) {
+        return;
     }
+    lruList_.erase(iter->second.lruPos);
+    auto sizeIter = processCacheSizes_.find(iter->second.pid);
+    if (sizeIter != processCacheSizes_.end() && --sizeIter->second == 0) {
+        processCacheSizes_.erase(sizeIter);
+    }
+    imageCacheSeqs_.erase(iter);
 }
 
 void RSEglImageManager::UnMapEglImageFromSurfaceBuffer(int32_t seqNum)
 {
+    // the buffer queue calls it from its own thread, the texture must be deleted on the main thread.
     auto mainThread = RSMainThread::Instance();
     mainThread->PostTask([this, seqNum]() {
-        if (imageCacheSeqs_.count(seqNum) == 0) {
-            return;
-        }
-        (void)imageCacheSeqs_.erase(seqNum);
-        RS_LOGD("RSEglImageManager::UnMapEglImageFromSurfaceBuffer");
+        ReleaseImageCache(seqNum);
     });
 }
+
+void RSEglImageManager::ReleaseImageCache(int32_t seqNum)
+{
+    std::lock_guard<std::mutex> lock(opMutex_);
+    EraseImageCache(seqNum);
+    RS_LOGD("RSEglImageManager::ReleaseImageCache");
+}
 } // namespace Rosen
 } // namespace OHOS
@@ -16,9 +16,9 @@
 #ifndef RS_EGL_IMAGE_MANAGER_H
 #define RS_EGL_IMAGE_MANAGER_H
 
+#include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <unordered_map>
 
 #include <surface.h>
@@ -65,18 +65,44 @@ public:
     explicit RSEglImageManager(EGLDisplay display);
     ~RSEglImageManager() noexcept = default;
 
+    // pid is the process owning the buffer, its images count against MAX_CACHE_SIZE_PER_PROCESS.
     GLuint MapEglImageFromSurfaceBuffer(const sptr<OHOS::SurfaceBuffer>& buffer,
-        const sptr<SyncFence>& acquireFence);
+        const sptr<SyncFence>& acquireFence, pid_t pid = 0);
+    // called once the buffer queue deleted the buffer.
     void UnMapEglImageFromSurfaceBuffer(int32_t seqNum);
+    // drops the image of a deleted buffer, must run on the main thread since it deletes the texture.
+    void ReleaseImageCache(int32_t seqNum);
+    // evicts the least recently used images over the limits, call it once after the frame is flushed since the
+    // textures of evicted images are deleted. Images used in the last RECENT_USE_FRAMES frames are never evicted.
     void ShrinkCachesIfNeeded();
+
+    bool IsImageCached(int32_t seqNum) const;
+    size_t GetImageCacheCount() const;
+
+    static constexpr size_t MAX_CACHE_SIZE = 64;
+    // so that one process churning buffers does not evict the images of all others.
+    static constexpr size_t MAX_CACHE_SIZE_PER_PROCESS = 24;
+    // a triple buffered producer running at a quarter of the refresh rate still reuses each buffer within it,
+    // so a process whose live buffers exceed its quota keeps them instead of recreating them every frame.
+    static constexpr uint64_t RECENT_USE_FRAMES = 16;
 private:
+    struct ImageCacheEntry {
+        std::unique_ptr<ImageCacheSeq> imageCache;
+        pid_t pid = 0;
+        uint64_t lastUsedFrame = 0;
+        std::list<int32_t>::iterator lruPos;
+    };
+
     void WaitAcquireFence(const sptr<SyncFence>& acquireFence);
-    GLuint CreateImageCacheFromBuffer(const sptr<OHOS::SurfaceBuffer>& buffer);
+    GLuint CreateImageCacheFromBuffer(const sptr<OHOS::SurfaceBuffer>& buffer, pid_t pid);
+    void EraseImageCache(int32_t seqNum);
+    bool IsRecentlyUsed(const ImageCacheEntry& entry) const;
 
     mutable std::mutex opMutex_;
-    static constexpr size_t MAX_CACHE_SIZE = 64;
-    std::queue<int32_t> cacheQueue_; // fifo, size restricted by MAX_CACHE_SIZE
-    std::unordered_map<int32_t, std::unique_ptr<ImageCacheSeq>> imageCacheSeqs_; // guarded by opMutex_.
+    uint64_t frameCount_ = 0; // advanced by ShrinkCachesIfNeeded, guarded by opMutex_.
+    std::list<int32_t> lruList_; // most recently used first, guarded by opMutex_.
+    std::unordered_map<int32_t, ImageCacheEntry> imageCacheSeqs_; // guarded by opMutex_.
+    std::unordered_map<pid_t, size_t> processCacheSizes_; // guarded by opMutex_.
     EGLDisplay eglDisplay_ = EGL_NO_DISPLAY;
 };
 } // namespace Rosen
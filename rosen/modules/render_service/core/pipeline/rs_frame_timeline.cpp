@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_frame_timeline.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr double NS_PER_MS = 1000000.0;
+constexpr double PERCENTILES[] = { 50.0, 90.0, 99.0 };
+constexpr const char* STAGE_NAMES[] = { "ProcessCommand", "Animate", "Render", "SendCommands", "Total" };
+
+struct ExportHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t recordCount;
+};
+}
+
+RSFrameTimeline& RSFrameTimeline::Instance()
+{
+    static RSFrameTimeline instance;
+    return instance;
+}
+
+uint64_t RSFrameTimeline::Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void RSFrameTimeline::BeginFrame(uint64_t vsyncTimestamp)
+{
+    current_ = RSFrameRecord();
+    current_.vsyncTimestamp = vsyncTimestamp;
+    current_.startTime = Now();
+    inFrame_ = true;
+}
+
+void RSFrameTimeline::EndFrame()
+{
+    if (!inFrame_) {
+        return;
+    }
+    inFrame_ = false;
+    current_.totalDuration = Now() - current_.startTime;
+    for (size_t i = 0; i < current_.stageDurations.size(); i++) {
+        AddToHistogram(histograms_[i], current_.stageDurations[i]);
+    }
+    AddToHistogram(histograms_[static_cast<size_t>(RSFrameStage::STAGE_COUNT)], current_.totalDuration);
+    histogramFrames_++;
+
+    ring_[next_] = current_;
+    next_ = (next_ + 1) % RING_SIZE;
+    if (count_ < RING_SIZE) {
+        count_++;
+    }
+}
+
+void RSFrameTimeline::BeginStage(RSFrameStage stage)
+{
+    if (stage >= RSFrameStage::STAGE_COUNT) {
+        return;
+    }
+    stageStart_[static_cast<size_t>(stage)] = Now();
+}
+
+void RSFrameTimeline::EndStage(RSFrameStage stage)
+{
+    if (!inFrame_ || stage >= RSFrameStage::STAGE_COUNT) {
+        return;
+    }
+    auto index = static_cast<size_t>(stage);
+    current_.stageDurations[index] += Now() - stageStart_[index];
+}
+
+void RSFrameTimeline::AddCommandCount(uint32_t count)
+{
+    current_.commandCount += count;
+}
+
+void RSFrameTimeline::AddVisitedNodeCount(uint32_t count)
+{
+    current_.visitedNodeCount += count;
+}
+
+void RSFrameTimeline::AddDirtyArea(uint64_t area)
+{
+    current_.dirtyArea += area;
+}
+
+void RSFrameTimeline::AddComposedLayerCount(uint32_t count)
+{
+    current_.composedLayerCount += count;
+}
+
+void RSFrameTimeline::AddOccludedSurfaces(uint32_t count, uint64_t area)
+{
+    current_.occludedSurfaceCount += count;
+    current_.occludedArea += area;
+}
+
+size_t RSFrameTimeline::GetRecordCount() const
+{
+    return count_;
+}
+
+const RSFrameRecord& RSFrameTimeline::GetRecord(size_t index) const
+{
+    size_t oldest = (next_ + RING_SIZE - count_) % RING_SIZE;
+    return ring_[(oldest + index) % RING_SIZE];
+}
+
+void RSFrameTimeline::AddToHistogram(Histogram& histogram, uint64_t duration)
+{
+    size_t bucket = static_cast<size_t>(duration / HISTOGRAM_BUCKET_NS);
+    if (bucket >= HISTOGRAM_BUCKET_COUNT) {
+        bucket = HISTOGRAM_BUCKET_COUNT - 1;
+    }
+    histogram[bucket]++;
+}
+
+uint64_t RSFrameTimeline::GetPercentile(RSFrameStage stage, double percentile) const
+{
+    if (histogramFrames_ == 0 || stage > RSFrameStage::STAGE_COUNT) {
+        return 0;
+    }
+    const auto& histogram = histograms_[static_cast<size_t>(stage)];
+    uint64_t target = static_cast<uint64_t>(histogramFrames_ * percentile / 100.0); // 100.0 for percent
+    if (target >= histogramFrames_) {
+        target = histogramFrames_ - 1;
+    }
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKET_COUNT; i++) {
+        accumulated += histogram[i];
+        if (accumulated > target) {
+            // report the upper bound of the bucket.
+            return (i + 1) * HISTOGRAM_BUCKET_NS;
+        }
+    }
+    return HISTOGRAM_BUCKET_COUNT * HISTOGRAM_BUCKET_NS;
+}
+
+void RSFrameTimeline::Dump(std::string& dumpString) const
+{
+    dumpString.append("\n");
+    dumpString.append("-- FrameTimeline: ");
+    dumpString.append(std::to_string(histogramFrames_) + " frames\n");
+    char buffer[256];
+    for (size_t i = 0; i < HISTOGRAM_COUNT; i++) {
+        auto stage = static_cast<RSFrameStage>(i);
+        int ret = snprintf(buffer, sizeof(buffer), "  %-16s p50 %.2fms  p90 %.2fms  p99 %.2fms\n", STAGE_NAMES[i],
+            GetPercentile(stage, PERCENTILES[0]) / NS_PER_MS, GetPercentile(stage, PERCENTILES[1]) / NS_PER_MS,
+            GetPercentile(stage, PERCENTILES[2]) / NS_PER_MS);
+        if (ret > 0) {
+            dumpString.append(buffer);
+        }
+    }
+    dumpString.append("  last frames (vsync, total, stages, commands, nodes, dirty area, layers, occluded):\n");
+    constexpr size_t lastFrameCount = 8;
+    size_t first = count_ > lastFrameCount ? count_ - lastFrameCount : 0;
+    for (size_t i = first; i < count_; i++) {
+        const auto& record = GetRecord(i);
+        int ret = snprintf(buffer, sizeof(buffer),
+            "  %" PRIu64 " %.2fms [%.2f %.2f %.2f %.2f] %u %u %" PRIu64 " %u %u/%" PRIu64 "\n", record.vsyncTimestamp,
+            record.totalDuration / NS_PER_MS,
+            record.stageDurations[static_cast<size_t>(RSFrameStage::PROCESS_COMMAND)] / NS_PER_MS,
+            record.stageDurations[static_cast<size_t>(RSFrameStage::ANIMATE)] / NS_PER_MS,
+            record.stageDurations[static_cast<size_t>(RSFrameStage::RENDER)] / NS_PER_MS,
+            record.stageDurations[static_cast<size_t>(RSFrameStage::SEND_COMMANDS)] / NS_PER_MS,
+            record.commandCount, record.visitedNodeCount, record.dirtyArea, record.composedLayerCount,
+            record.occludedSurfaceCount, record.occludedArea);
+        if (ret > 0) {
+            dumpString.append(buffer);
+        }
+    }
+}
+
+bool RSFrameTimeline::ExportToFile(const std::string& path) const
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        RS_LOGE("RSFrameTimeline::ExportToFile: open %s failed", path.c_str());
+        return false;
+    }
+    ExportHeader header = {
+        .magic = EXPORT_MAGIC,
+        .version = EXPORT_VERSION,
+        .recordSize = sizeof(RSFrameRecord),
+        .recordCount = static_cast<uint32_t>(count_),
+    };
+    bool ret = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; ret && i < count_; i++) {
+        ret = fwrite(&GetRecord(i), sizeof(RSFrameRecord), 1, file) == 1;
+    }
+    if (fclose(file) != 0) {
+        ret = false;
+    }
+    if (!ret) {
+        RS_LOGE("RSFrameTimeline::ExportToFile: write %s failed", path.c_str());
+    }
+    return ret;
+}
+
+void RSFrameTimeline::Reset()
+{
+    next_ = 0;
+    count_ = 0;
+    inFrame_ = false;
+    histograms_ = {};
+    histogramFrames_ = 0;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_FRAME_TIMELINE_H
+#define RS_FRAME_TIMELINE_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace Rosen {
+enum class RSFrameStage : uint32_t {
+    PROCESS_COMMAND = 0,
+    ANIMATE,
+    RENDER,
+    SEND_COMMANDS,
+    STAGE_COUNT,
+};
+
+struct RSFrameRecord {
+    uint64_t vsyncTimestamp = 0; // ns
+    uint64_t startTime = 0;      // ns, steady clock
+    std::array<uint64_t, static_cast<size_t>(RSFrameStage::STAGE_COUNT)> stageDurations = {}; // ns
+    uint64_t totalDuration = 0;  // ns
+    uint64_t dirtyArea = 0;      // pixels
+    uint32_t commandCount = 0;
+    uint32_t visitedNodeCount = 0;
+    uint32_t composedLayerCount = 0;
+    uint32_t occludedSurfaceCount = 0;
+    uint64_t occludedArea = 0;   // pixels
+};
+
+// Always-on record of the last frames of RSMainThread. Written and read on the main thread only, so no locking
+// is involved; the cost per frame is a handful of clock reads and counter updates.
+class RSFrameTimeline {
+public:
+    static RSFrameTimeline& Instance();
+
+    RSFrameTimeline() = default;
+    ~RSFrameTimeline() = default;
+
+    void BeginFrame(uint64_t vsyncTimestamp);
+    void EndFrame();
+    void BeginStage(RSFrameStage stage);
+    void EndStage(RSFrameStage stage);
+
+    void AddCommandCount(uint32_t count);
+    void AddVisitedNodeCount(uint32_t count);
+    void AddDirtyArea(uint64_t area);
+    void AddComposedLayerCount(uint32_t count);
+    void AddOccludedSurfaces(uint32_t count, uint64_t area);
+
+    // frames recorded in the ring, at most RING_SIZE.
+    size_t GetRecordCount() const;
+    // index 0 is the oldest frame still in the ring.
+    const RSFrameRecord& GetRecord(size_t index) const;
+    // percentile in [0, 100] of a stage duration (or of the total when stage is STAGE_COUNT) over all frames
+    // since the last Reset(), in ns, with the histogram bucket resolution.
+    uint64_t GetPercentile(RSFrameStage stage, double percentile) const;
+
+    void Dump(std::string& dumpString) const;
+    bool ExportToFile(const std::string& path) const;
+    void Reset();
+
+    static constexpr size_t RING_SIZE = 512;
+    static constexpr uint32_t EXPORT_MAGIC = 0x54465352; // "RSFT"
+    static constexpr uint32_t EXPORT_VERSION = 2;
+
+private:
+    static constexpr size_t HISTOGRAM_BUCKET_COUNT = 256;
+    static constexpr uint64_t HISTOGRAM_BUCKET_NS = 250000; // 0.25ms per bucket, the last bucket holds overflow
+    static constexpr size_t HISTOGRAM_COUNT = static_cast<size_t>(RSFrameStage::STAGE_COUNT) + 1;
+    using Histogram = std::array<uint32_t, HISTOGRAM_BUCKET_COUNT>;
+
+    static uint64_t Now();
+    static void AddToHistogram(Histogram& histogram, uint64_t duration);
+
+    std::array<RSFrameRecord, RING_SIZE> ring_ = {};
+    size_t next_ = 0;
+    size_t count_ = 0;
+    bool inFrame_ = false;
+    RSFrameRecord current_;
+    std::array<uint64_t, static_cast<size_t>(RSFrameStage::STAGE_COUNT)> stageStart_ = {};
+    std::array<Histogram, HISTOGRAM_COUNT> histograms_ = {};
+    uint64_t histogramFrames_ = 0;
+};
+
+// record the duration of a RSMainThread stage of the current frame.
+class RSFrameStageScope {
+public:
+    explicit RSFrameStageScope(RSFrameStage stage) : stage_(stage)
+    {
+        RSFrameTimeline::Instance().BeginStage(stage_);
+    }
+    ~RSFrameStageScope()
+    {
+        RSFrameTimeline::Instance().EndStage(stage_);
+    }
+
+private:
+    RSFrameStage stage_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RS_FRAME_TIMELINE_H
@@ -31,6 +31,7 @@
 #include "sync_fence.h"
 #include "common/rs_vector4.h"
 #include "pipeline/rs_draw_cmd_list.h"
+#include "pipeline/rs_frame_timeline.h"
 #include "pipeline/rs_main_thread.h"
 #include "pipeline/rs_paint_filter_canvas.h"
 #include "pipeline/rs_render_service_util.h"
@@ -94,6 +95,7 @@ void RSHardwareProcessor::PostProcess()
     CropLayers();
     ScaleDownLayers();
     output_->SetLayerInfo(layers_);
+    RSFrameTimeline::Instance().AddComposedLayerCount(layers_.size());
     std::vector<std::shared_ptr<HdiOutput>> outputs{output_};
     if (backend_) {
         backend_->Repaint(outputs);
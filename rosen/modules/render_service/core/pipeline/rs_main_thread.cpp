@@ -16,8 +16,10 @@
 
 #include "command/rs_message_processor.h"
 #include "pipeline/rs_base_render_node.h"
+#include "pipeline/rs_frame_timeline.h"
 #include "pipeline/rs_render_service_util.h"
 #include "pipeline/rs_render_service_visitor.h"
+#include "pipeline/rs_subtree_cache_manager.h"
 #include "pipeline/rs_uni_render_visitor.h"
 #include "platform/common/rs_log.h"
 #include "platform/common/rs_system_properties.h"
@@ -47,10 +49,16 @@ void RSMainThread::Init()
     mainLoop_ = [&]() {
         RS_LOGI("RsDebug mainLoop start");
         ROSEN_TRACE_BEGIN(HITRACE_TAG_GRAPHIC_AGP, "RSMainThread::DoComposition");
+        auto& frameTimeline = RSFrameTimeline::Instance();
+        frameTimeline.BeginFrame(timestamp_);
+        if (transactionTrace_ != nullptr) {
+            transactionTrace_->WriteVsync(timestamp_);
+        }
         ProcessCommand();
         Animate(timestamp_);
         Render();
         SendCommands();
+        frameTimeline.EndFrame();
         ROSEN_TRACE_END(HITRACE_TAG_GRAPHIC_AGP);
         RS_LOGI("RsDebug mainLoop end");
     };
@@ -80,22 +88,22 @@ void RSMainThread::Start()
 
 void RSMainThread::ProcessCommand()
 {
-    {
-        std::lock_guard<std::mutex> lock(transitionDataMutex_);
-        std::swap(cacheCommandQueue_, effectCommandQueue_);
-    }
-    while (!effectCommandQueue_.empty())
-    {
-        auto rsTransaction = std::move(effectCommandQueue_.front());
-        effectCommandQueue_.pop();
-        if (rsTransaction) {
-            rsTransaction->Process(context_);
+    RSFrameStageScope stageScope(RSFrameStage::PROCESS_COMMAND);
+    transactionQueue_.Collect();
+    int processedCommands = 0;
+    while (auto rsTransaction = transactionQueue_.Pop()) {
+        processedCommands += rsTransaction->GetCommandCount();
+        if (transactionTrace_ != nullptr) {
+            transactionTrace_->WriteTransaction(*rsTransaction);
         }
+        rsTransaction->Process(context_);
     }
+    RSFrameTimeline::Instance().AddCommandCount(processedCommands);
 }
 
 void RSMainThread::Render()
 {
+    RSFrameStageScope stageScope(RSFrameStage::RENDER);
     const std::shared_ptr<RSBaseRenderNode> rootNode = context_.GetGlobalRootRenderNode();
     if (rootNode == nullptr) {
         RS_LOGE("RSMainThread::Draw GetGlobalRootRenderNode fail");
@@ -145,6 +153,7 @@ void RSMainThread::OnVsync(uint64_t timestamp, void *data)
 void RSMainThread::Animate(uint64_t timestamp)
 {
     RS_TRACE_FUNC();
+    RSFrameStageScope stageScope(RSFrameStage::ANIMATE);
 
     if (context_.animatingNodeList_.empty()) {
         return;
@@ -167,13 +176,12 @@ void RSMainThread::Animate(uint64_t timestamp)
     RequestNextVSync();
 }
 
-void RSMainThread::RecvRSTransactionData(std::unique_ptr<RSTransactionData>& rsTransactionData)
+void RSMainThread::RecvRSTransactionData(std::unique_ptr<RSTransactionData>& rsTransactionData, pid_t pid)
 {
-    {
-        std::lock_guard<std::mutex> lock(transitionDataMutex_);
-        cacheCommandQueue_.push(std::move(rsTransactionData));
+    // only the first transaction after a frame has to ask for vsync.
+    if (transactionQueue_.Push(pid, std::move(rsTransactionData))) {
+        RequestNextVSync();
     }
-    RequestNextVSync();
 }
 
 void RSMainThread::PostTask(RSTaskMessage::RSTask task)
@@ -183,6 +191,14 @@ void RSMainThread::PostTask(RSTaskMessage::RSTask task)
     }
 }
 
+void RSMainThread::PostIdleTask(RSTaskMessage::RSTask task, const std::string& name, int64_t delayTime)
+{
+    if (handler_) {
+        handler_->RemoveTask(name);
+        handler_->PostTask(task, name, delayTime, AppExecFwk::EventQueue::Priority::IDLE);
+    }
+}
+
 void RSMainThread::RegisterApplicationRenderThread(uint32_t pid, sptr<IApplicationRenderThread> app)
 {
     applicationRenderThreadMap_.emplace(pid, app);
@@ -196,6 +212,7 @@ void RSMainThread::UnregisterApplicationRenderThread(sptr<IApplicationRenderThre
 void RSMainThread::SendCommands()
 {
     RS_TRACE_FUNC();
+    RSFrameStageScope stageScope(RSFrameStage::SEND_COMMANDS);
     if (!RSMessageProcessor::Instance().HasTransaction()) {
         return;
     }
@@ -229,5 +246,56 @@ void RSMainThread::RenderServiceTreeDump(std::string& dumpString)
     }
     rootNode->DumpTree(dumpString);
 }
+
+void RSMainThread::FrameTimelineDump(std::string& dumpString)
+{
+    RSFrameTimeline::Instance().Dump(dumpString);
+}
+
+void RSMainThread::FrameTimelineExport(std::string& dumpString)
+{
+    dumpString.append("\n");
+    if (RSFrameTimeline::Instance().ExportToFile(FRAME_TIMELINE_EXPORT_PATH)) {
+        dumpString.append("-- FrameTimeline exported to " + std::string(FRAME_TIMELINE_EXPORT_PATH) + "\n");
+    } else {
+        dumpString.append("-- FrameTimeline export failed\n");
+    }
+}
+
+void RSMainThread::SubtreeCacheDump(std::string& dumpString)
+{
+    RSSubtreeCacheManager::Instance().Dump(dumpString);
+}
+
+void RSMainThread::TransactionTraceStart(std::string& dumpString)
+{
+    dumpString.append("\n");
+    if (transactionTrace_ != nullptr) {
+        dumpString.append("-- TransactionTrace already recording to " + std::string(TRANSACTION_TRACE_PATH) + "\n");
+        return;
+    }
+    auto transactionTrace = std::make_unique<RSTransactionTraceWriter>();
+    if (!transactionTrace->Open(TRANSACTION_TRACE_PATH)) {
+        dumpString.append("-- TransactionTrace start failed\n");
+        return;
+    }
+    transactionTrace_ = std::move(transactionTrace);
+    dumpString.append("-- TransactionTrace recording to " + std::string(TRANSACTION_TRACE_PATH) +
+        ", start the applications to record now, the nodes they created before are not in the trace\n");
+}
+
+void RSMainThread::TransactionTraceStop(std::string& dumpString)
+{
+    dumpString.append("\n");
+    if (transactionTrace_ == nullptr) {
+        dumpString.append("-- TransactionTrace is not recording\n");
+        return;
+    }
+    size_t recordCount = transactionTrace_->GetRecordCount();
+    bool ret = transactionTrace_->Close();
+    transactionTrace_ = nullptr;
+    dumpString.append("-- TransactionTrace " + std::to_string(recordCount) + " records " +
+        (ret ? "saved to " + std::string(TRANSACTION_TRACE_PATH) : std::string("failed to save")) + "\n");
+}
 } // namespace Rosen
 } // namespace OHOS
@@ -17,6 +17,7 @@
 #define RS_MAIN_THREAD
 
 #include <future>
+#include <string>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -26,6 +27,8 @@
 #include "common/rs_thread_looper.h"
 #include "ipc_callbacks/iapplication_render_thread.h"
 #include "pipeline/rs_context.h"
+#include "pipeline/rs_transaction_queue.h"
+#include "transaction/rs_transaction_trace.h"
 #include "platform/drawing/rs_vsync_client.h"
 #include "refbase.h"
 #include "vsync_receiver.h"
@@ -71,10 +74,18 @@ public:
 
     void Init();
     void Start();
-    void RecvRSTransactionData(std::unique_ptr<RSTransactionData>& rsTransactionData);
+    void RecvRSTransactionData(std::unique_ptr<RSTransactionData>& rsTransactionData, pid_t pid = 0);
     void RequestNextVSync();
     void PostTask(RSTaskMessage::RSTask task);
+    // runs task once the thread is idle and delayTime ms have passed, replacing a pending task of the same name.
+    void PostIdleTask(RSTaskMessage::RSTask task, const std::string& name, int64_t delayTime);
     void RenderServiceTreeDump(std::string& dumpString);
+    void FrameTimelineDump(std::string& dumpString);
+    void FrameTimelineExport(std::string& dumpString);
+    void SubtreeCacheDump(std::string& dumpString);
+    // record the transactions processed from now on and the vsyncs they are processed in, for render_service_replay
+    void TransactionTraceStart(std::string& dumpString);
+    void TransactionTraceStop(std::string& dumpString);
 
     template<typename Task, typename Return = std::invoke_result_t<Task>>
     std::future<Return> ScheduleTask(Task&& task)
@@ -121,18 +132,19 @@ private:
     void Render();
     void SendCommands();
 
-    std::mutex transitionDataMutex_;
+    static constexpr const char* FRAME_TIMELINE_EXPORT_PATH = "/data/rs_frame_timeline.bin";
+    static constexpr const char* TRANSACTION_TRACE_PATH = "/data/rs_transaction_trace.bin";
     std::shared_ptr<AppExecFwk::EventRunner> runner_ = nullptr;
     std::shared_ptr<AppExecFwk::EventHandler> handler_ = nullptr;
     RSTaskMessage::RSTask mainLoop_;
     std::unique_ptr<RSVsyncClient> vsyncClient_ = nullptr;
-    std::queue<std::unique_ptr<RSTransactionData>> cacheCommandQueue_;
-    std::queue<std::unique_ptr<RSTransactionData>> effectCommandQueue_;
+    RSTransactionQueue transactionQueue_;
 
     uint64_t timestamp_ = 0;
     std::unordered_map<uint32_t, sptr<IApplicationRenderThread>> applicationRenderThreadMap_;
 
     RSContext context_;
+    std::unique_ptr<RSTransactionTraceWriter> transactionTrace_;
     std::thread::id mainThreadId_;
     std::shared_ptr<VSyncReceiver> receiver_ = nullptr;
 
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_occlusion_culling.h"
+
+#include <climits>
+
+#include "common/rs_obj_abs_geometry.h"
+#include "display_type.h"
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+// split the parts of rect outside of hole into at most 4 rects.
+void SubtractRect(const RectI& rect, const RectI& hole, std::vector<RectI>& out)
+{
+    RectI inter = rect.IntersectRect(hole);
+    if (inter.IsEmpty()) {
+        out.push_back(rect);
+        return;
+    }
+    if (inter.top_ > rect.top_) {
+        out.emplace_back(rect.left_, rect.top_, rect.width_, inter.top_ - rect.top_);
+    }
+    if (inter.GetBottom() < rect.GetBottom()) {
+        out.emplace_back(rect.left_, inter.GetBottom(), rect.width_, rect.GetBottom() - inter.GetBottom());
+    }
+    if (inter.left_ > rect.left_) {
+        out.emplace_back(rect.left_, inter.top_, inter.left_ - rect.left_, inter.height_);
+    }
+    if (inter.GetRight() < rect.GetRight()) {
+        out.emplace_back(inter.GetRight(), inter.top_, rect.GetRight() - inter.GetRight(), inter.height_);
+    }
+}
+
+std::shared_ptr<RSObjAbsGeometry> GetAbsGeometry(RSSurfaceRenderNode& node)
+{
+    return std::static_pointer_cast<RSObjAbsGeometry>(node.GetRenderProperties().GetBoundsGeometry());
+}
+
+// the area an opaque surface really paints, following RSSurfaceRenderNode::CalculateClipRegion: the bounds moved by
+// the window offset and cut by the clip region. A transition transforms the surface when it is drawn, so its abs rect
+// says nothing about where it ends up and it must not occlude anything.
+RectI GetOpaqueRect(RSSurfaceRenderNode& node, const RectI& absRect)
+{
+    if (node.HasTransition(false)) {
+        return RectI();
+    }
+    RectI dstRect(absRect.left_ - node.GetOffSetX(), absRect.top_ - node.GetOffSetY(), absRect.width_,
+        absRect.height_);
+    const Vector4f& clip = node.GetClipRegion();
+    RectI clipRect(clip.x_, clip.y_, clip.z_, clip.w_);
+    return clipRect.IsEmpty() ? dstRect : dstRect.IntersectRect(clipRect);
+}
+
+// a surface composed from its buffer is opaque if the buffer has no alpha or is not blended.
+bool IsBufferOpaque(RSSurfaceRenderNode& node)
+{
+    const auto& buffer = node.GetBuffer();
+    if (buffer == nullptr) {
+        return false;
+    }
+    if (node.GetBlendType() == BlendType::BLEND_NONE || node.GetBlendType() == BlendType::BLEND_SRC) {
+        return true;
+    }
+    switch (buffer->GetFormat()) {
+        case PIXEL_FMT_RGBX_8888:
+        case PIXEL_FMT_BGRX_8888:
+        case PIXEL_FMT_RGB_888:
+        case PIXEL_FMT_YCBCR_420_SP:
+        case PIXEL_FMT_YCRCB_420_SP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// a surface drawn by uni render paints its render nodes, not its buffer. Only an opaque background color is known
+// to cover its bounds, and filters need the content below it.
+bool IsContentOpaque(const RSProperties& property)
+{
+    return property.GetBackgroundColor().GetAlpha() == UCHAR_MAX && property.GetBackgroundFilter() == nullptr &&
+        property.GetFilter() == nullptr && property.GetMask() == nullptr;
+}
+}
+
+void RSOcclusionRegion::Add(const RectI& rect)
+{
+    if (rect.IsEmpty()) {
+        return;
+    }
+    for (const auto& existing : rects_) {
+        if (existing.IntersectRect(rect) == rect) {
+            return;
+        }
+    }
+    rects_.push_back(rect);
+}
+
+bool RSOcclusionRegion::Covers(const RectI& rect) const
+{
+    if (rect.IsEmpty() || rects_.empty()) {
+        return false;
+    }
+    std::vector<RectI> remaining = { rect };
+    std::vector<RectI> next;
+    for (const auto& occluder : rects_) {
+        next.clear();
+        for (const auto& piece : remaining) {
+            SubtractRect(piece, occluder, next);
+        }
+        std::swap(remaining, next);
+        if (remaining.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+RSOcclusionStats RSOcclusionCulling::CalcOcclusion(std::vector<RSOcclusionLayer>& layers)
+{
+    RSOcclusionStats stats;
+    stats.layerCount = layers.size();
+    RSOcclusionRegion covered;
+    for (auto iter = layers.rbegin(); iter != layers.rend(); ++iter) {
+        iter->isOccluded = covered.Covers(iter->rect);
+        if (iter->isOccluded) {
+            stats.occludedCount++;
+            stats.occludedArea += static_cast<uint64_t>(iter->rect.width_) * static_cast<uint64_t>(iter->rect.height_);
+            continue;
+        }
+        covered.Add(iter->opaqueRect);
+    }
+    return stats;
+}
+
+bool RSOcclusionCulling::IsOpaque(RSSurfaceRenderNode& node, bool isUniRender)
+{
+    const auto& property = node.GetRenderProperties();
+    if (!property.GetVisible() || node.GetSecurityLayer()) {
+        // security layers are not drawn on every display, they must not hide anything.
+        return false;
+    }
+    if (!ROSEN_EQ(node.GetGlobalAlhpa(), 1.0f) || !ROSEN_EQ(node.GetAlpha(), 1.0f) ||
+        !ROSEN_EQ(property.GetAlpha(), 1.0f) || !property.GetCornerRadius().IsZero()) {
+        return false;
+    }
+    auto geoPtr = GetAbsGeometry(node);
+    if (geoPtr == nullptr || !geoPtr->GetAbsMatrix().rectStaysRect()) {
+        return false;
+    }
+    return isUniRender ? IsContentOpaque(property) : IsBufferOpaque(node);
+}
+
+void RSOcclusionCulling::ReleaseOccludedBuffers(RSSurfaceRenderNode& node)
+{
+    if (node.GetConsumer() != nullptr && node.GetAvailableBufferCount() > 0) {
+        RsRenderServiceUtil::ConsumeAndUpdateBuffer(node, true);
+    }
+    for (auto& child : node.GetSortedChildren()) {
+        auto childSurface = child ? child->ReinterpretCastTo<RSSurfaceRenderNode>() : nullptr;
+        if (childSurface != nullptr) {
+            ReleaseOccludedBuffers(*childSurface);
+        }
+    }
+    // clear SortedChildren, it will be generated again in next frame
+    node.ResetSortedChildren();
+}
+
+RSOcclusionStats RSOcclusionCulling::Apply(RSBaseRenderNode& displayNode, const UniRenderPredicate& isUniRender)
+{
+    std::vector<std::shared_ptr<RSSurfaceRenderNode>> surfaces;
+    std::vector<RSOcclusionLayer> layers;
+    for (auto& child : displayNode.GetSortedChildren()) {
+        auto surface = child ? child->ReinterpretCastTo<RSSurfaceRenderNode>() : nullptr;
+        if (surface == nullptr) {
+            continue;
+        }
+        surface->SetOccluded(false);
+        auto geoPtr = GetAbsGeometry(*surface);
+        if (geoPtr == nullptr) {
+            continue;
+        }
+        RSOcclusionLayer layer;
+        layer.rect = geoPtr->GetAbsRect();
+        // child surfaces (e.g. video) are drawn with their parent, hide the parent only if they are hidden as well.
+        for (auto& grandChild : surface->GetSortedChildren()) {
+            auto childSurface = grandChild ? grandChild->ReinterpretCastTo<RSSurfaceRenderNode>() : nullptr;
+            if (childSurface == nullptr) {
+                continue;
+            }
+            childSurface->SetOccluded(false);
+            auto childGeoPtr = GetAbsGeometry(*childSurface);
+            if (childGeoPtr != nullptr) {
+                layer.rect = layer.rect.JoinRect(childGeoPtr->GetAbsRect());
+            }
+        }
+        if (IsOpaque(*surface, isUniRender && isUniRender(*surface))) {
+            layer.opaqueRect = GetOpaqueRect(*surface, geoPtr->GetAbsRect());
+        }
+        surfaces.push_back(surface);
+        layers.push_back(layer);
+    }
+    auto stats = CalcOcclusion(layers);
+    for (size_t i = 0; i < surfaces.size(); i++) {
+        surfaces[i]->SetOccluded(layers[i].isOccluded);
+        if (layers[i].isOccluded) {
+            RS_LOGD("RSOcclusionCulling::Apply node %llu is occluded", surfaces[i]->GetId());
+        }
+    }
+    return stats;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_OCCLUSION_CULLING_H
+#define RS_OCCLUSION_CULLING_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "common/rs_rect.h"
+#include "pipeline/rs_base_render_node.h"
+#include "pipeline/rs_render_service_util.h"
+#include "pipeline/rs_surface_render_node.h"
+
+namespace OHOS {
+namespace Rosen {
+struct RSOcclusionLayer {
+    RectI rect;       // area the layer may draw to, in screen coordinates.
+    RectI opaqueRect; // area the layer fully paints with opaque pixels, empty if none.
+    bool isOccluded = false;
+};
+
+struct RSOcclusionStats {
+    uint32_t layerCount = 0;
+    uint32_t occludedCount = 0;
+    uint64_t occludedArea = 0;
+};
+
+// Union of opaque rects, used to test whether a rect is completely hidden.
+class RSOcclusionRegion {
+public:
+    void Add(const RectI& rect);
+    bool Covers(const RectI& rect) const;
+    bool IsEmpty() const
+    {
+        return rects_.empty();
+    }
+
+private:
+    std::vector<RectI> rects_;
+};
+
+// Front-to-back occlusion pass over the surfaces of one display, run after Prepare.
+class RSOcclusionCulling {
+public:
+    using UniRenderPredicate = std::function<bool(const RSSurfaceRenderNode&)>;
+
+    // layers are ordered back to front, isOccluded is written for every layer.
+    static RSOcclusionStats CalcOcclusion(std::vector<RSOcclusionLayer>& layers);
+    // marks the surface children of displayNode (sorted back to front) which need not be drawn this frame.
+    // isUniRender tells which surfaces are drawn from their render nodes instead of composed from their buffers.
+    static RSOcclusionStats Apply(RSBaseRenderNode& displayNode, const UniRenderPredicate& isUniRender = nullptr);
+    // the opacity of a uni rendered surface comes from its properties, that of other surfaces from their buffers.
+    static bool IsOpaque(RSSurfaceRenderNode& node, bool isUniRender = false);
+    // an occluded surface is not drawn, but its queued buffers still have to go back to the producer. Call it
+    // once per frame, from the display the occlusion was computed for.
+    static void ReleaseOccludedBuffers(RSSurfaceRenderNode& node);
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RS_OCCLUSION_CULLING_H
@@ -127,6 +127,11 @@ void RSRenderService::DoDump(std::unordered_set<std::u16string>& argSets, std::s
     std::u16string arg4(u"nodeNotOnTree");
     std::u16string arg5(u"allSurfacesMem");
     std::u16string arg6(u"renderServiceTree");
+    std::u16string arg7(u"frameTimeline");
+    std::u16string arg8(u"frameTimelineExport");
+    std::u16string arg9(u"subtreeCache");
+    std::u16string arg10(u"transactionTraceStart");
+    std::u16string arg11(u"transactionTraceStop");
 
     if (argSets.size() == 0 || argSets.count(arg1) != 0) {
         mainThread_->ScheduleTask([this, &dumpString]() {
@@ -153,6 +158,31 @@ void RSRenderService::DoDump(std::unordered_set<std::u16string>& argSets, std::s
             mainThread_->RenderServiceTreeDump(dumpString);
         }).wait();
     }
+    if (argSets.size() == 0 || argSets.count(arg7) != 0) {
+        mainThread_->ScheduleTask([this, &dumpString]() {
+            mainThread_->FrameTimelineDump(dumpString);
+        }).wait();
+    }
+    if (argSets.count(arg8) != 0) {
+        mainThread_->ScheduleTask([this, &dumpString]() {
+            mainThread_->FrameTimelineExport(dumpString);
+        }).wait();
+    }
+    if (argSets.size() == 0 || argSets.count(arg9) != 0) {
+        mainThread_->ScheduleTask([this, &dumpString]() {
+            mainThread_->SubtreeCacheDump(dumpString);
+        }).wait();
+    }
+    if (argSets.count(arg10) != 0) {
+        mainThread_->ScheduleTask([this, &dumpString]() {
+            mainThread_->TransactionTraceStart(dumpString);
+        }).wait();
+    }
+    if (argSets.count(arg11) != 0) {
+        mainThread_->ScheduleTask([this, &dumpString]() {
+            mainThread_->TransactionTraceStop(dumpString);
+        }).wait();
+    }
     auto iter = argSets.find(arg3);
     if (iter != argSets.end()) {
         std::string layerArg;
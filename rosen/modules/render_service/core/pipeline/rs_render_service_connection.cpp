@@ -165,7 +165,7 @@ void RSRenderServiceConnection::RSApplicationRenderThreadDeathRecipient::OnRemot
 
 void RSRenderServiceConnection::CommitTransaction(std::unique_ptr<RSTransactionData>& transactionData)
 {
-    mainThread_->RecvRSTransactionData(transactionData);
+    mainThread_->RecvRSTransactionData(transactionData, remotePid_);
 }
 
 void RSRenderServiceConnection::ExecuteSynchronousTask(const std::shared_ptr<RSSyncTask>& task)
@@ -310,8 +310,14 @@ void RSRenderServiceConnection::TakeSurfaceCapture(NodeId id, sptr<RSISurfaceCap
         RS_LOGD("RSRenderService::TakeSurfaceCapture callback->OnSurfaceCapture nodeId:[%llu]", id);
         ROSEN_TRACE_BEGIN(HITRACE_TAG_GRAPHIC_AGP, "RSRenderService::TakeSurfaceCapture");
         RSSurfaceCaptureTask task(id, scaleX, scaleY);
-        std::unique_ptr<Media::PixelMap> pixelmap = task.Run();
+        auto& pool = RSSurfaceCapturePool::Instance();
+        std::unique_ptr<Media::PixelMap> pixelmap = task.Run(pool);
         callback->OnSurfaceCapture(id, pixelmap.get());
+        // the pixelmap has been marshalled into the callback parcel, its pixels can be reused.
+        pool.Recycle(std::move(pixelmap));
+        // nothing stays pooled once the periodic captures stop.
+        RSMainThread::Instance()->PostIdleTask([]() { RSSurfaceCapturePool::Instance().Trim(0); },
+            "RSSurfaceCapturePoolTrim", RSSurfaceCapturePool::IDLE_TRIM_DELAY_MS);
         ROSEN_TRACE_END(HITRACE_TAG_GRAPHIC_AGP);
     };
     mainThread_->PostTask(captureTask);
@@ -14,6 +14,7 @@
  */
 #include "rs_render_service_util.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "display_type.h"
@@ -26,6 +27,7 @@
 #include "property/rs_properties_painter.h"
 #include "render/rs_blur_filter.h"
 #include "rs_trace.h"
+#include "screen_manager/rs_screen_manager.h"
 #ifdef RS_ENABLE_GL
 #include "include/gpu/gl/GrGLTypes.h"
 #include "include/gpu/GrBackendSurface.h"
@@ -652,6 +654,24 @@ bool RsRenderServiceUtil::ConsumeAndUpdateBuffer(RSSurfaceHandler& node, bool to
     return true;
 }
 
+std::vector<std::shared_ptr<RSBaseRenderNode>> RsRenderServiceUtil::GetDisplaysInCommitOrder(
+    RSBaseRenderNode& rootNode)
+{
+    const auto& children = rootNode.GetSortedChildren();
+    std::vector<std::shared_ptr<RSBaseRenderNode>> displays(children.begin(), children.end());
+    sptr<RSScreenManager> screenManager = CreateOrGetScreenManager();
+    if (screenManager == nullptr) {
+        return displays;
+    }
+    ScreenId defaultScreenId = screenManager->GetDefaultScreenId();
+    auto isDefaultDisplay = [defaultScreenId](const std::shared_ptr<RSBaseRenderNode>& child) {
+        auto display = child ? child->ReinterpretCastTo<RSDisplayRenderNode>() : nullptr;
+        return display != nullptr && display->GetScreenId() == defaultScreenId;
+    };
+    std::stable_partition(displays.begin(), displays.end(), isDefaultDisplay);
+    return displays;
+}
+
 bool RsRenderServiceUtil::IsNeedClient(RSSurfaceRenderNode* node)
 {
     if (enableClient) {
@@ -871,6 +891,7 @@ BufferDrawParam RsRenderServiceUtil::CreateBufferDrawParam(RSSurfaceRenderNode&
     paint.setAlphaf(alpha);
 
     params.buffer = buffer;
+    params.pid = static_cast<pid_t>(node.GetId() >> 32); // higher 32 bits of node id
     params.matrix = GetCanvasTransform(node, canvasMatrix, rotation, dstRect);
     params.acquireFence = node.GetFence();
 
@@ -969,7 +990,8 @@ void RsRenderServiceUtil::DrawImage(std::shared_ptr<RSEglImageManager> eglImageM
         return;
     }
     sk_sp<SkImage> image;
-    auto eglTextureId = eglImageManager->MapEglImageFromSurfaceBuffer(buffer, bufferDrawParam.acquireFence);
+    auto eglTextureId = eglImageManager->MapEglImageFromSurfaceBuffer(buffer, bufferDrawParam.acquireFence,
+        bufferDrawParam.pid);
     if (eglTextureId == 0) {
         RS_LOGE("RsRenderServiceUtil::MapEglImageFromSurfaceBuffer return invalid EGL texture ID");
         return;
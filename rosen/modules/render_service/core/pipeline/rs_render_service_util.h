@@ -49,6 +49,7 @@ struct BufferDrawParam {
     bool isNeedClip = true;
     SkPaint paint;
     ColorGamut targetColorGamut = ColorGamut::COLOR_GAMUT_SRGB;
+    pid_t pid = 0; // the process drawing into the buffer
 };
 
 struct ComposeInfo {
@@ -87,6 +88,9 @@ public:
 
     static void DropFrameProcess(RSSurfaceHandler& node);
     static bool ConsumeAndUpdateBuffer(RSSurfaceHandler& node, bool toReleaseBuffer = false);
+    // the display children of rootNode in the order their screens are committed, the default screen first so that
+    // a slow external or virtual screen does not delay the frame of the primary panel.
+    static std::vector<std::shared_ptr<RSBaseRenderNode>> GetDisplaysInCommitOrder(RSBaseRenderNode& rootNode);
 
 private:
     static SkMatrix GetCanvasTransform(const RSSurfaceRenderNode& node, const SkMatrix& canvasMatrix,
@@ -27,8 +27,11 @@
 #include "include/core/SkRect.h"
 #include "pipeline/rs_base_render_node.h"
 #include "pipeline/rs_display_render_node.h"
+#include "pipeline/rs_frame_timeline.h"
+#include "pipeline/rs_occlusion_culling.h"
 #include "pipeline/rs_processor.h"
 #include "pipeline/rs_processor_factory.h"
+#include "pipeline/rs_render_service_util.h"
 #include "pipeline/rs_surface_render_node.h"
 #include "platform/common/rs_log.h"
 #include "platform/drawing/rs_surface.h"
@@ -51,8 +54,16 @@ void RSRenderServiceVisitor::PrepareBaseRenderNode(RSBaseRenderNode& node)
 
 void RSRenderServiceVisitor::ProcessBaseRenderNode(RSBaseRenderNode& node)
 {
-    for (auto& child : node.GetSortedChildren()) {
-        child->Process(shared_from_this());
+    RSFrameTimeline::Instance().AddVisitedNodeCount(node.GetSortedChildren().size());
+    if (node.GetType() == RSRenderNodeType::BASE_NODE) {
+        // the children of the global root are the displays, HdiBackend commits them in the order they are processed.
+        for (auto& display : RsRenderServiceUtil::GetDisplaysInCommitOrder(node)) {
+            display->Process(shared_from_this());
+        }
+    } else {
+        for (auto& child : node.GetSortedChildren()) {
+            child->Process(shared_from_this());
+        }
     }
     // clear SortedChildren, it will be generated again in next frame
     node.ResetSortedChildren();
@@ -72,12 +83,15 @@ void RSRenderServiceVisitor::PrepareDisplayRenderNode(RSDisplayRenderNode& node)
     } else {
         UpdateGeometry(node);
         PrepareBaseRenderNode(node);
+        auto stats = RSOcclusionCulling::Apply(node);
+        RSFrameTimeline::Instance().AddOccludedSurfaces(stats.occludedCount, stats.occludedArea);
     }
 }
 
 void RSRenderServiceVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
 {
     isSecurityDisplay_ = node.GetSecurityDisplay();
+    isMirrorDisplay_ = node.IsMirrorDisplay();
     RS_LOGD("RsDebug RSRenderServiceVisitor::ProcessDisplayRenderNode: nodeid:[%llu] screenid:[%llu] \
         isSecurityDisplay:[%s] child size:[%d] total size:[%d]", node.GetId(), node.GetScreenId(),
         isSecurityDisplay_ ? "true" : "false", node.GetChildrenCount(), node.GetSortedChildren().size());
@@ -187,6 +201,14 @@ void RSRenderServiceVisitor::ProcessSurfaceRenderNode(RSSurfaceRenderNode& node)
         RS_LOGI("RSRenderServiceVisitor::ProcessSurfaceRenderNode node : %llu is invisible", node.GetId());
         return;
     }
+    if (node.IsOccluded()) {
+        RS_LOGD("RSRenderServiceVisitor::ProcessSurfaceRenderNode node : %llu is occluded", node.GetId());
+        // a mirror display shows the surfaces of its source, which releases their buffers once per frame.
+        if (!isMirrorDisplay_) {
+            RSOcclusionCulling::ReleaseOccludedBuffers(node);
+        }
+        return;
+    }
     canvas_->save();
     node.SetOffset(offsetX_, offsetY_);
     node.ProcessRenderBeforeChildren(*canvas_);
@@ -52,6 +52,7 @@ private:
     int32_t offsetX_ = 0;
     int32_t offsetY_ = 0;
     bool isSecurityDisplay_ = false;
+    bool isMirrorDisplay_ = false;
     std::shared_ptr<RSProcessor> processor_ = nullptr;
 };
 } // namespace Rosen
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_surface_capture_pool.h"
+
+#include <securec.h>
+
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+RSSurfaceCapturePool& RSSurfaceCapturePool::Instance()
+{
+    static RSSurfaceCapturePool instance;
+    return instance;
+}
+
+RSSurfaceCapturePool::RSSurfaceCapturePool(size_t maxPooledPixelMaps, size_t maxPooledBytes)
+    : maxPooledPixelMaps_(maxPooledPixelMaps), maxPooledBytes_(maxPooledBytes)
+{
+}
+
+size_t RSSurfaceCapturePool::GetByteCount(const Media::PixelMap& pixelmap)
+{
+    return static_cast<size_t>(pixelmap.GetRowBytes()) * static_cast<size_t>(pixelmap.GetHeight());
+}
+
+std::unique_ptr<Media::PixelMap> RSSurfaceCapturePool::Acquire(int32_t width, int32_t height, bool keepContent)
+{
+    if (width <= 0 || height <= 0) {
+        RS_LOGE("RSSurfaceCapturePool::Acquire: invalid size [%d, %d]", width, height);
+        return nullptr;
+    }
+    std::unique_ptr<Media::PixelMap> pixelmap;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto iter = pixelMaps_.begin(); iter != pixelMaps_.end(); ++iter) {
+            if ((*iter)->GetWidth() == width && (*iter)->GetHeight() == height) {
+                pixelmap = std::move(*iter);
+                pixelMaps_.erase(iter);
+                pooledBytes_ -= GetByteCount(*pixelmap);
+                ++reuseCount_;
+                break;
+            }
+        }
+        if (pixelmap == nullptr) {
+            ++allocCount_;
+        }
+    }
+    if (pixelmap == nullptr) {
+        Media::InitializationOptions opts;
+        opts.size.width = width;
+        opts.size.height = height;
+        pixelmap = Media::PixelMap::Create(opts);
+        if (pixelmap == nullptr) {
+            // low on memory, give back the pixels the pool holds and try once more.
+            RS_LOGW("RSSurfaceCapturePool::Acquire: failed to create pixelmap, trim the pool");
+            Trim(0);
+            pixelmap = Media::PixelMap::Create(opts);
+        }
+        return pixelmap;
+    }
+    if (!keepContent) {
+        auto address = const_cast<uint32_t*>(pixelmap->GetPixel32(0, 0));
+        size_t size = GetByteCount(*pixelmap);
+        if (address == nullptr || memset_s(address, size, 0, size) != EOK) {
+            RS_LOGE("RSSurfaceCapturePool::Acquire: failed to clear reused pixelmap");
+            return nullptr;
+        }
+    }
+    return pixelmap;
+}
+
+void RSSurfaceCapturePool::Recycle(std::unique_ptr<Media::PixelMap> pixelmap)
+{
+    if (pixelmap == nullptr) {
+        return;
+    }
+    size_t byteCount = GetByteCount(*pixelmap);
+    if (byteCount > maxPooledBytes_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    pixelMaps_.push_front(std::move(pixelmap));
+    pooledBytes_ += byteCount;
+    TrimLocked(maxPooledPixelMaps_, maxPooledBytes_);
+}
+
+void RSSurfaceCapturePool::Trim(size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimLocked(maxPooledPixelMaps_, maxBytes);
+}
+
+void RSSurfaceCapturePool::TrimLocked(size_t maxCount, size_t maxBytes)
+{
+    // drop the least recently recycled ones, their size is most likely not requested any more.
+    while (!pixelMaps_.empty() && (pixelMaps_.size() > maxCount || pooledBytes_ > maxBytes)) {
+        pooledBytes_ -= GetByteCount(*pixelMaps_.back());
+        pixelMaps_.pop_back();
+    }
+}
+
+bool RSSurfaceCapturePool::IsBufferUnchanged(NodeId id, int32_t bufferSeqNum) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = capturedBufferSeqNums_.find(id);
+    return iter != capturedBufferSeqNums_.end() && iter->second == bufferSeqNum;
+}
+
+void RSSurfaceCapturePool::UpdateCapturedBuffer(NodeId id, int32_t bufferSeqNum)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capturedBufferSeqNums_.size() >= MAX_CAPTURED_BUFFER_RECORDS && capturedBufferSeqNums_.count(id) == 0) {
+        // records of destroyed nodes are never looked up again, start over instead of growing forever.
+        capturedBufferSeqNums_.clear();
+    }
+    capturedBufferSeqNums_[id] = bufferSeqNum;
+}
+
+void RSSurfaceCapturePool::RemoveCapturedBuffer(NodeId id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capturedBufferSeqNums_.erase(id);
+}
+
+void RSSurfaceCapturePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pixelMaps_.clear();
+    pooledBytes_ = 0;
+    capturedBufferSeqNums_.clear();
+}
+
+size_t RSSurfaceCapturePool::GetPooledCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pixelMaps_.size();
+}
+
+size_t RSSurfaceCapturePool::GetPooledBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pooledBytes_;
+}
+} // namespace Rosen
+} // namespace OHOS
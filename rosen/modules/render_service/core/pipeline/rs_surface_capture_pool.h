@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_SURFACE_CAPTURE_POOL_H
+#define RS_SURFACE_CAPTURE_POOL_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/rs_common_def.h"
+#include "pixel_map.h"
+
+namespace OHOS {
+namespace Rosen {
+// Keeps the destination pixelmaps of finished captures so that periodic captures (thumbnails, screen
+// recording fallbacks) do not allocate a new pixel buffer every time, and remembers which surface buffer
+// was captured last for each node so unchanged surfaces can take the fast blit path.
+// The pool is bounded by both a count and a byte budget, and is emptied once captures stop for
+// IDLE_TRIM_DELAY_MS or an allocation fails.
+class RSSurfaceCapturePool {
+public:
+    static constexpr size_t DEFAULT_MAX_POOLED_PIXELMAPS = 16;
+    static constexpr size_t DEFAULT_MAX_POOLED_BYTES = 32 * 1024 * 1024; // two full screen captures
+    static constexpr int64_t IDLE_TRIM_DELAY_MS = 3000;
+
+    static RSSurfaceCapturePool& Instance();
+
+    explicit RSSurfaceCapturePool(size_t maxPooledPixelMaps = DEFAULT_MAX_POOLED_PIXELMAPS,
+        size_t maxPooledBytes = DEFAULT_MAX_POOLED_BYTES);
+    ~RSSurfaceCapturePool() = default;
+
+    // returns a pixelmap of exactly width x height, reused from the pool if possible.
+    // the content of a reused pixelmap is cleared unless keepContent is true.
+    std::unique_ptr<Media::PixelMap> Acquire(int32_t width, int32_t height, bool keepContent = false);
+    // give the pixelmap back after the capture result has been delivered (marshalled) to the client.
+    void Recycle(std::unique_ptr<Media::PixelMap> pixelmap);
+
+    bool IsBufferUnchanged(NodeId id, int32_t bufferSeqNum) const;
+    void UpdateCapturedBuffer(NodeId id, int32_t bufferSeqNum);
+    void RemoveCapturedBuffer(NodeId id);
+
+    // drop the least recently recycled pixelmaps until at most maxBytes are pooled, 0 drops all of them.
+    void Trim(size_t maxBytes);
+    void Clear();
+    size_t GetPooledCount() const;
+    size_t GetPooledBytes() const;
+    uint64_t GetReuseCount() const
+    {
+        return reuseCount_.load();
+    }
+    uint64_t GetAllocCount() const
+    {
+        return allocCount_.load();
+    }
+
+private:
+    static constexpr size_t MAX_CAPTURED_BUFFER_RECORDS = 256;
+
+    static size_t GetByteCount(const Media::PixelMap& pixelmap);
+    void TrimLocked(size_t maxCount, size_t maxBytes);
+
+    mutable std::mutex mutex_;
+    size_t maxPooledPixelMaps_;
+    size_t maxPooledBytes_;
+    std::list<std::unique_ptr<Media::PixelMap>> pixelMaps_; // guarded by mutex_, most recently recycled first.
+    size_t pooledBytes_ = 0; // guarded by mutex_.
+    std::unordered_map<NodeId, int32_t> capturedBufferSeqNums_; // guarded by mutex_.
+    std::atomic<uint64_t> reuseCount_ { 0 };
+    std::atomic<uint64_t> allocCount_ { 0 };
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RS_SURFACE_CAPTURE_POOL_H
@@ -17,8 +17,11 @@
 
 #include <memory>
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "pipeline/rs_base_render_node.h"
 #include "pipeline/rs_display_render_node.h"
@@ -28,11 +31,20 @@
 #include "pipeline/rs_surface_render_node.h"
 #include "platform/common/rs_log.h"
 #include "platform/drawing/rs_surface.h"
+#include "rs_trace.h"
 #include "screen_manager/rs_screen_manager.h"
 #include "screen_manager/rs_screen_mode_info.h"
 
 namespace OHOS {
 namespace Rosen {
+std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::Run(RSSurfaceCapturePool& pool)
+{
+    pool_ = &pool;
+    auto pixelmap = Run();
+    pool_ = nullptr;
+    return pixelmap;
+}
+
 std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::Run()
 {
     if (ROSEN_EQ(scaleX_, 0.f) || ROSEN_EQ(scaleY_, 0.f) || scaleX_ < 0.f || scaleY_ < 0.f) {
@@ -42,12 +54,21 @@ std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::Run()
     auto node = RSMainThread::Instance()->GetContext().GetNodeMap().GetRenderNode(nodeId_);
     if (node == nullptr) {
         RS_LOGE("RSSurfaceCaptureTask::Run: node is nullptr");
+        if (pool_ != nullptr) {
+            pool_->RemoveCapturedBuffer(nodeId_);
+        }
         return nullptr;
     }
     std::unique_ptr<Media::PixelMap> pixelmap;
     std::shared_ptr<RSSurfaceCaptureVisitor> visitor = std::make_shared<RSSurfaceCaptureVisitor>();
     if (auto surfaceNode = node->ReinterpretCastTo<RSSurfaceRenderNode>()) {
         RS_LOGI("RSSurfaceCaptureTask::Run: Into SURFACE_NODE SurfaceRenderNodeId:[%llu]", node->GetId());
+        if (CanCaptureByBlit(*surfaceNode)) {
+            return CaptureByBlit(*surfaceNode);
+        }
+        if (pool_ != nullptr && surfaceNode->GetBuffer() != nullptr) {
+            pool_->UpdateCapturedBuffer(nodeId_, surfaceNode->GetBuffer()->GetSeqNum());
+        }
         pixelmap = CreatePixelMapBySurfaceNode(surfaceNode);
         visitor->IsDisplayNode(false);
     } else if (auto displayNode = node->ReinterpretCastTo<RSDisplayRenderNode>()) {
@@ -92,7 +113,7 @@ std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CreatePixelMapBySurfaceNo
     RS_LOGD("RSSurfaceCaptureTask::CreatePixelMapBySurfaceNode: origin pixelmap width is [%u], height is [%u], "\
         "created pixelmap width is [%u], height is [%u], the scale is scaleY:[%f], scaleY:[%f]",
         pixmapWidth, pixmapHeight, opts.size.width, opts.size.height, scaleX_, scaleY_);
-    return Media::PixelMap::Create(opts);
+    return CreatePixelMap(opts.size.width, opts.size.height);
 }
 
 std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CreatePixelMapByDisplayNode(
@@ -122,9 +143,111 @@ std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CreatePixelMapByDisplayNo
     RS_LOGD("RSSurfaceCaptureTask::CreatePixelMapByDisplayNode: origin pixelmap width is [%u], height is [%u], "\
         "created pixelmap width is [%u], height is [%u], the scale is scaleY:[%f], scaleY:[%f]",
         pixmapWidth, pixmapHeight, opts.size.width, opts.size.height, scaleX_, scaleY_);
+    return CreatePixelMap(opts.size.width, opts.size.height);
+}
+
+std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CreatePixelMap(int32_t width, int32_t height)
+{
+    if (pool_ != nullptr) {
+        return pool_->Acquire(width, height);
+    }
+    Media::InitializationOptions opts;
+    opts.size.width = width;
+    opts.size.height = height;
     return Media::PixelMap::Create(opts);
 }
 
+bool RSSurfaceCaptureTask::CanCaptureByBlit(RSSurfaceRenderNode& node) const
+{
+    auto buffer = node.GetBuffer();
+    if (pool_ == nullptr || buffer == nullptr || buffer->GetVirAddr() == nullptr) {
+        return false;
+    }
+    // the first capture after the buffer changed always goes through the visitor,
+    // so the blit path only ever reproduces content the full path has already produced.
+    if (!pool_->IsBufferUnchanged(node.GetId(), buffer->GetSeqNum())) {
+        return false;
+    }
+    if (node.GetSecurityLayer() || node.GetChildrenCount() != 0 || node.GetDstRect().IsEmpty()) {
+        return false;
+    }
+    auto existedParent = node.GetParent().lock();
+    if (existedParent && existedParent->IsInstanceOf<RSSurfaceRenderNode>()) {
+        return false;
+    }
+    sptr<Surface> surface = node.GetConsumer();
+    if (surface == nullptr || surface->GetTransform() != TransformType::ROTATE_NONE) {
+        return false;
+    }
+    const auto& property = node.GetRenderProperties();
+    if (!ROSEN_EQ(node.GetGlobalAlhpa(), 1.0f) || !property.GetCornerRadius().IsZero()) {
+        return false;
+    }
+    if (static_cast<ColorGamut>(buffer->GetSurfaceBufferColorGamut()) != ColorGamut::COLOR_GAMUT_SRGB) {
+        return false;
+    }
+    auto format = buffer->GetFormat();
+    return format == PIXEL_FMT_RGBA_8888 || format == PIXEL_FMT_RGBX_8888 || format == PIXEL_FMT_BGRA_8888;
+}
+
+std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CaptureByBlit(RSSurfaceRenderNode& node)
+{
+    ROSEN_TRACE_BEGIN(HITRACE_TAG_GRAPHIC_AGP, "RSSurfaceCaptureTask::CaptureByBlit");
+    auto buffer = node.GetBuffer();
+    const auto& property = node.GetRenderProperties();
+    int32_t width = ceil(property.GetBoundsWidth() * scaleX_);
+    int32_t height = ceil(property.GetBoundsHeight() * scaleY_);
+    // like the visitor, a node clipping to its frame shows its dst rect only, taken in pixels of the capture.
+    SkIRect crop = SkIRect::MakeWH(width, height);
+    bool cropped = property.GetClipToFrame() &&
+        crop.intersect(SkIRect::MakeWH(node.GetDstRect().width_, node.GetDstRect().height_)) &&
+        crop != SkIRect::MakeWH(width, height);
+    // every pixel is overwritten by an uncropped blit, no need to clear the reused pixelmap then.
+    auto pixelmap = pool_->Acquire(width, height, !cropped);
+    if (pixelmap == nullptr) {
+        RS_LOGE("RSSurfaceCaptureTask::CaptureByBlit: pixelmap is nullptr");
+        ROSEN_TRACE_END(HITRACE_TAG_GRAPHIC_AGP);
+        return nullptr;
+    }
+    SkColorType srcColorType = kRGBA_8888_SkColorType;
+    SkAlphaType srcAlphaType = kPremul_SkAlphaType;
+    if (buffer->GetFormat() == PIXEL_FMT_BGRA_8888) {
+        srcColorType = kBGRA_8888_SkColorType;
+    } else if (buffer->GetFormat() == PIXEL_FMT_RGBX_8888) {
+        // the fourth byte is undefined, not alpha
+        srcColorType = kRGB_888x_SkColorType;
+        srcAlphaType = kOpaque_SkAlphaType;
+    }
+    SkImageInfo srcInfo = SkImageInfo::Make(buffer->GetSurfaceBufferWidth(), buffer->GetSurfaceBufferHeight(),
+        srcColorType, srcAlphaType);
+    SkPixmap src(srcInfo, buffer->GetVirAddr(), buffer->GetStride());
+    SkImageInfo dstInfo = SkImageInfo::Make(pixelmap->GetWidth(), pixelmap->GetHeight(),
+        kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    SkPixmap dst(dstInfo, const_cast<uint32_t*>(pixelmap->GetPixel32(0, 0)), pixelmap->GetRowBytes());
+    bool blitted = false;
+    if (dst.addr() != nullptr && !cropped) {
+        blitted = src.scalePixels(dst, kLow_SkFilterQuality);
+    } else if (dst.addr() != nullptr) {
+        SkBitmap bitmap;
+        auto canvas = SkCanvas::MakeRasterDirect(dstInfo, dst.writable_addr(), dst.rowBytes());
+        blitted = canvas != nullptr && bitmap.installPixels(src);
+        if (blitted) {
+            SkPaint paint;
+            paint.setFilterQuality(kLow_SkFilterQuality);
+            canvas->clipRect(SkRect::Make(crop));
+            canvas->drawBitmapRect(bitmap, SkRect::MakeIWH(width, height), &paint);
+        }
+    }
+    if (!blitted) {
+        RS_LOGE("RSSurfaceCaptureTask::CaptureByBlit: blit failed");
+        pool_->Recycle(std::move(pixelmap));
+        ROSEN_TRACE_END(HITRACE_TAG_GRAPHIC_AGP);
+        return nullptr;
+    }
+    ROSEN_TRACE_END(HITRACE_TAG_GRAPHIC_AGP);
+    return pixelmap;
+}
+
 std::unique_ptr<SkCanvas> RSSurfaceCaptureTask::CreateCanvas(const std::unique_ptr<Media::PixelMap>& pixelmap)
 {
     if (pixelmap == nullptr) {
@@ -19,6 +19,7 @@
 #include "common/rs_common_def.h"
 #include "include/core/SkCanvas.h"
 #include "pipeline/rs_display_render_node.h"
+#include "pipeline/rs_surface_capture_pool.h"
 #include "pipeline/rs_surface_render_node.h"
 #include "pixel_map.h"
 #include "visitor/rs_node_visitor.h"
@@ -32,6 +33,10 @@ public:
     ~RSSurfaceCaptureTask() = default;
 
     std::unique_ptr<Media::PixelMap> Run();
+    // capture into a pixelmap taken from pool, the caller should recycle it into the same pool once the
+    // result is delivered. Surface nodes whose buffer is unchanged since their last capture are blitted
+    // from the buffer directly instead of being replayed.
+    std::unique_ptr<Media::PixelMap> Run(RSSurfaceCapturePool& pool);
 
 private:
     class RSSurfaceCaptureVisitor : public RSNodeVisitor {
@@ -70,6 +75,12 @@ private:
 
     std::unique_ptr<SkCanvas> CreateCanvas(const std::unique_ptr<Media::PixelMap>& pixelmap);
 
+    std::unique_ptr<Media::PixelMap> CreatePixelMap(int32_t width, int32_t height);
+
+    bool CanCaptureByBlit(RSSurfaceRenderNode& node) const;
+
+    std::unique_ptr<Media::PixelMap> CaptureByBlit(RSSurfaceRenderNode& node);
+
     std::unique_ptr<Media::PixelMap> CreatePixelMapBySurfaceNode(std::shared_ptr<RSSurfaceRenderNode> node);
 
     std::unique_ptr<Media::PixelMap> CreatePixelMapByDisplayNode(std::shared_ptr<RSDisplayRenderNode> node);
@@ -79,6 +90,8 @@ private:
     float scaleX_;
 
     float scaleY_;
+
+    RSSurfaceCapturePool* pool_ = nullptr;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_transaction_queue.h"
+
+namespace OHOS {
+namespace Rosen {
+RSTransactionQueue::RSTransactionQueue() : head_(&stub_), tail_(&stub_)
+{
+}
+
+RSTransactionQueue::~RSTransactionQueue() noexcept
+{
+    Collect();
+}
+
+bool RSTransactionQueue::Push(pid_t pid, std::unique_ptr<RSTransactionData> transactionData)
+{
+    Node* node = new Node();
+    node->pid = pid;
+    node->data = std::move(transactionData);
+    PushNode(node);
+    // only after the node is linked, so a consumer woken by this push will always find it.
+    return !wakeupPending_.exchange(true);
+}
+
+void RSTransactionQueue::PushNode(Node* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    // between the exchange and this store the node is not reachable by the consumer yet.
+    prev->next.store(node, std::memory_order_release);
+}
+
+RSTransactionQueue::Node* RSTransactionQueue::PopNode()
+{
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+        // a producer is between its exchange and its link, its node will be collected next time.
+        return nullptr;
+    }
+    // tail is the last node, put the stub behind it so that tail can be detached.
+    PushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void RSTransactionQueue::Collect()
+{
+    // re-arm before draining: a transaction pushed after this point either gets drained below
+    // or wakes the consumer up again by itself.
+    wakeupPending_.store(false);
+    while (Node* node = PopNode()) {
+        auto& pending = pendingByPid_[node->pid];
+        if (pending.empty()) {
+            pidOrder_.push_back(node->pid);
+        }
+        pending.push(std::move(node->data));
+        delete node;
+    }
+}
+
+std::unique_ptr<RSTransactionData> RSTransactionQueue::Pop()
+{
+    if (pidOrder_.empty()) {
+        return nullptr;
+    }
+    pid_t pid = pidOrder_.front();
+    pidOrder_.pop_front();
+    auto iter = pendingByPid_.find(pid);
+    if (iter == pendingByPid_.end() || iter->second.empty()) {
+        return nullptr;
+    }
+    auto transactionData = std::move(iter->second.front());
+    iter->second.pop();
+    if (iter->second.empty()) {
+        pendingByPid_.erase(iter);
+    } else {
+        pidOrder_.push_back(pid);
+    }
+    return transactionData;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_TRANSACTION_QUEUE_H
+#define RS_TRANSACTION_QUEUE_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <queue>
+#include <sys/types.h>
+#include <unordered_map>
+
+#include "transaction/rs_transaction_data.h"
+
+namespace OHOS {
+namespace Rosen {
+// Transactions from the IPC threads to RSMainThread.
+// Push() is lock-free and may be called from any number of threads; every other method belongs to the single
+// consumer. Transactions of one producer are consumed in the order they were pushed, transactions of different
+// pids are consumed round-robin so one busy application cannot delay the others.
+class RSTransactionQueue {
+public:
+    RSTransactionQueue();
+    ~RSTransactionQueue() noexcept;
+
+    // returns true if this is the first transaction since the consumer last called Collect(),
+    // only then the producer has to wake up the consumer.
+    bool Push(pid_t pid, std::unique_ptr<RSTransactionData> transactionData);
+
+    // move everything pushed so far into the per-pid queues and re-arm the wakeup of Push().
+    void Collect();
+    // next transaction in round-robin order over pids, nullptr if nothing is pending.
+    std::unique_ptr<RSTransactionData> Pop();
+    bool HasPending() const
+    {
+        return !pidOrder_.empty();
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next { nullptr };
+        pid_t pid = 0;
+        std::unique_ptr<RSTransactionData> data;
+    };
+
+    RSTransactionQueue(const RSTransactionQueue&) = delete;
+    RSTransactionQueue& operator=(const RSTransactionQueue&) = delete;
+
+    void PushNode(Node* node);
+    Node* PopNode();
+
+    // intrusive mpsc list, producers exchange head_, the consumer follows next pointers from tail_.
+    std::atomic<Node*> head_;
+    Node* tail_;
+    Node stub_;
+    std::atomic<bool> wakeupPending_ { false };
+
+    std::unordered_map<pid_t, std::queue<std::unique_ptr<RSTransactionData>>> pendingByPid_;
+    std::deque<pid_t> pidOrder_; // pids which have pending transactions, in round-robin order.
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RS_TRANSACTION_QUEUE_H
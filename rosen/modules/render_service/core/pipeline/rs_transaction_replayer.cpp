@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_transaction_replayer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+#include "include/core/SkPixmap.h"
+#include "pipeline/rs_base_render_node.h"
+#include "pipeline/rs_paint_filter_canvas.h"
+#include "pipeline/rs_uni_render_visitor.h"
+#include "platform/common/rs_log.h"
+#include "transaction/rs_transaction_trace.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr const char* STAGE_NAMES[] = { "ProcessCommand", "Animate", "Prepare", "Process", "Total" };
+constexpr double PERCENTILES[] = { 50.0, 90.0, 99.0 };
+constexpr double NS_PER_MS = 1000000.0;
+constexpr double PERCENT = 100.0;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+}
+
+RSTransactionReplayer::RSTransactionReplayer(int32_t screenWidth, int32_t screenHeight)
+    : screen_(SkSurface::MakeRasterN32Premul(screenWidth, screenHeight))
+{
+    if (screen_ == nullptr) {
+        RS_LOGE("RSTransactionReplayer: create %dx%d screen failed", screenWidth, screenHeight);
+    }
+}
+
+uint64_t RSTransactionReplayer::Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t RSTransactionReplayer::GetAllocationCount() const
+{
+    return allocationCounter_ ? allocationCounter_() : 0;
+}
+
+bool RSTransactionReplayer::Replay(const std::string& tracePath)
+{
+    RSTransactionTraceReader reader;
+    if (!reader.Open(tracePath)) {
+        return false;
+    }
+    RSTransactionTraceRecord record;
+    bool inFrame = false;
+    uint64_t vsyncTimestamp = 0;
+    std::vector<std::unique_ptr<RSTransactionData>> transactions;
+    while (reader.Next(record)) {
+        if (record.type == RSTransactionTraceRecordType::VSYNC) {
+            if (inFrame) {
+                ReplayFrame(vsyncTimestamp, transactions);
+                transactions.clear();
+            }
+            inFrame = true;
+            vsyncTimestamp = record.timestamp;
+            continue;
+        }
+        // unmarshalled up front, the render service does it on the binder threads
+        auto transaction = RSTransactionTraceReader::Unmarshalling(record);
+        if (transaction == nullptr) {
+            RS_LOGE("RSTransactionReplayer::Replay: transaction of frame %zu dropped", frames_.size());
+            continue;
+        }
+        inFrame = true;
+        vsyncTimestamp = record.timestamp;
+        transactions.push_back(std::move(transaction));
+    }
+    if (inFrame) {
+        ReplayFrame(vsyncTimestamp, transactions);
+    }
+    return true;
+}
+
+void RSTransactionReplayer::ReplayFrame(uint64_t vsyncTimestamp,
+    std::vector<std::unique_ptr<RSTransactionData>>& transactions)
+{
+    RSReplayFrame frame;
+    frame.vsyncTimestamp = vsyncTimestamp;
+    auto measure = [this, &frame](RSReplayStage stage, const std::function<void()>& work) {
+        uint64_t allocations = GetAllocationCount();
+        uint64_t start = Now();
+        work();
+        frame.stageDurations[static_cast<size_t>(stage)] = Now() - start;
+        frame.stageAllocations[static_cast<size_t>(stage)] = GetAllocationCount() - allocations;
+    };
+
+    measure(RSReplayStage::PROCESS_COMMAND, [this, &transactions, &frame]() {
+        for (auto& transaction : transactions) {
+            frame.commandCount += static_cast<uint32_t>(transaction->GetCommandCount());
+            transaction->Process(context_);
+        }
+    });
+    measure(RSReplayStage::ANIMATE, [this, vsyncTimestamp]() { Animate(vsyncTimestamp); });
+
+    const auto& rootNode = context_.GetGlobalRootRenderNode();
+    std::unique_ptr<RSPaintFilterCanvas> canvas;
+    if (screen_ != nullptr) {
+        canvas = std::make_unique<RSPaintFilterCanvas>(screen_->getCanvas());
+        canvas->clear(SK_ColorTRANSPARENT);
+    }
+    // the real unified renderer, drawing into the raster screen instead of composing the displays
+    auto visitor = std::make_shared<RSUniRenderVisitor>(canvas.get());
+    measure(RSReplayStage::PREPARE, [&rootNode, &visitor]() { rootNode->Prepare(visitor); });
+    if (canvas != nullptr) {
+        measure(RSReplayStage::PROCESS, [&rootNode, &visitor]() { rootNode->Process(visitor); });
+        frame.checksum = ComputeChecksum();
+    }
+    frames_.push_back(frame);
+}
+
+void RSTransactionReplayer::Animate(uint64_t timestamp)
+{
+    // same as RSMainThread::Animate, without asking for the next vsync
+    std::__libcpp_erase_if_container(context_.animatingNodeList_, [timestamp](const auto& iter) -> bool {
+        auto node = iter.second.lock();
+        return node == nullptr || !node->Animate(timestamp);
+    });
+}
+
+uint64_t RSTransactionReplayer::ComputeChecksum() const
+{
+    SkPixmap pixmap;
+    if (!screen_->peekPixels(&pixmap)) {
+        return 0;
+    }
+    // FNV-1a over the visible bytes of every row
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t rowBytes = pixmap.info().minRowBytes();
+    for (int y = 0; y < pixmap.height(); y++) {
+        const uint8_t* row = static_cast<const uint8_t*>(pixmap.addr(0, y));
+        for (size_t i = 0; i < rowBytes; i++) {
+            hash = (hash ^ row[i]) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+uint64_t RSTransactionReplayer::GetPercentile(RSReplayStage stage, double percentile) const
+{
+    if (frames_.empty() || stage > RSReplayStage::STAGE_COUNT) {
+        return 0;
+    }
+    std::vector<uint64_t> durations;
+    durations.reserve(frames_.size());
+    for (const auto& frame : frames_) {
+        if (stage == RSReplayStage::STAGE_COUNT) {
+            uint64_t total = 0;
+            for (auto duration : frame.stageDurations) {
+                total += duration;
+            }
+            durations.push_back(total);
+        } else {
+            durations.push_back(frame.stageDurations[static_cast<size_t>(stage)]);
+        }
+    }
+    size_t index = std::min(static_cast<size_t>(durations.size() * percentile / PERCENT), durations.size() - 1);
+    std::nth_element(durations.begin(), durations.begin() + index, durations.end());
+    return durations[index];
+}
+
+void RSTransactionReplayer::Dump(std::string& dumpString) const
+{
+    dumpString.append("-- TransactionReplay: " + std::to_string(frames_.size()) + " frames\n");
+    std::array<uint64_t, static_cast<size_t>(RSReplayStage::STAGE_COUNT) + 1> allocations = {};
+    uint64_t commandCount = 0;
+    for (const auto& frame : frames_) {
+        for (size_t i = 0; i < frame.stageAllocations.size(); i++) {
+            allocations[i] += frame.stageAllocations[i];
+            allocations.back() += frame.stageAllocations[i];
+        }
+        commandCount += frame.commandCount;
+    }
+    char buffer[256];
+    for (size_t i = 0; i < allocations.size(); i++) {
+        auto stage = static_cast<RSReplayStage>(i);
+        int ret = snprintf(buffer, sizeof(buffer), "  %-16s p50 %.3fms  p90 %.3fms  p99 %.3fms  allocations %" PRIu64
+            "\n", STAGE_NAMES[i], GetPercentile(stage, PERCENTILES[0]) / NS_PER_MS,
+            GetPercentile(stage, PERCENTILES[1]) / NS_PER_MS, GetPercentile(stage, PERCENTILES[2]) / NS_PER_MS,
+            allocations[i]);
+        if (ret > 0) {
+            dumpString.append(buffer);
+        }
+    }
+    int ret = snprintf(buffer, sizeof(buffer), "  commands %" PRIu64 ", last frame checksum %016" PRIx64 "\n",
+        commandCount, frames_.empty() ? 0 : frames_.back().checksum);
+    if (ret > 0) {
+        dumpString.append(buffer);
+    }
+}
+
+const char* RSTransactionReplayer::GetStageName(RSReplayStage stage)
+{
+    return stage <= RSReplayStage::STAGE_COUNT ? STAGE_NAMES[static_cast<size_t>(stage)] : "";
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_TRANSACTION_REPLAYER_H
+#define RS_TRANSACTION_REPLAYER_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/core/SkSurface.h"
+#include "pipeline/rs_context.h"
+#include "transaction/rs_transaction_data.h"
+
+namespace OHOS {
+namespace Rosen {
+enum class RSReplayStage : uint32_t {
+    PROCESS_COMMAND = 0,
+    ANIMATE,
+    PREPARE,
+    PROCESS,
+    STAGE_COUNT,
+};
+
+struct RSReplayFrame {
+    uint64_t vsyncTimestamp = 0; // ns
+    std::array<uint64_t, static_cast<size_t>(RSReplayStage::STAGE_COUNT)> stageDurations = {}; // ns
+    std::array<uint64_t, static_cast<size_t>(RSReplayStage::STAGE_COUNT)> stageAllocations = {};
+    uint32_t commandCount = 0;
+    uint64_t checksum = 0; // of the screen pixels after the frame
+};
+
+// Replays a trace recorded by RSMainThread::TransactionTraceStart headless: the transactions are processed in the
+// frames they were recorded in, with their vsync timestamps, and RSUniRenderVisitor draws the tree into a raster
+// fake screen instead of the displays, without screens, buffers or GPU. Every stage of every frame is timed, its
+// allocations counted and the screen checksummed, so pipeline changes can be gated on timing and pixels.
+class RSTransactionReplayer {
+public:
+    // allocations made by the process so far, e.g. counted by a global operator new of the replay tool
+    using AllocationCounter = std::function<uint64_t()>;
+
+    RSTransactionReplayer(int32_t screenWidth, int32_t screenHeight);
+    ~RSTransactionReplayer() = default;
+
+    void SetAllocationCounter(AllocationCounter allocationCounter)
+    {
+        allocationCounter_ = std::move(allocationCounter);
+    }
+    bool Replay(const std::string& tracePath);
+    // one frame: process the transactions, animate, prepare and process the tree
+    void ReplayFrame(uint64_t vsyncTimestamp, std::vector<std::unique_ptr<RSTransactionData>>& transactions);
+
+    RSContext& GetContext()
+    {
+        return context_;
+    }
+    const std::vector<RSReplayFrame>& GetFrames() const
+    {
+        return frames_;
+    }
+    // percentile in [0, 100] of a stage duration (or of the frame total when stage is STAGE_COUNT), in ns
+    uint64_t GetPercentile(RSReplayStage stage, double percentile) const;
+    void Dump(std::string& dumpString) const;
+
+    static const char* GetStageName(RSReplayStage stage);
+
+    RSTransactionReplayer(const RSTransactionReplayer&) = delete;
+    RSTransactionReplayer& operator=(const RSTransactionReplayer&) = delete;
+
+private:
+    static uint64_t Now();
+    uint64_t GetAllocationCount() const;
+    void Animate(uint64_t timestamp);
+    uint64_t ComputeChecksum() const;
+
+    RSContext context_;
+    sk_sp<SkSurface> screen_;
+    AllocationCounter allocationCounter_;
+    std::vector<RSReplayFrame> frames_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RS_TRANSACTION_REPLAYER_H
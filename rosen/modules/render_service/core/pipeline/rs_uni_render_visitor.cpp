@@ -18,6 +18,8 @@
 #include "common/rs_obj_abs_geometry.h"
 #include "display_type.h"
 #include "pipeline/rs_display_render_node.h"
+#include "pipeline/rs_frame_timeline.h"
+#include "pipeline/rs_occlusion_culling.h"
 #include "pipeline/rs_main_thread.h"
 #include "pipeline/rs_processor_factory.h"
 #include "pipeline/rs_render_service_util.h"
@@ -35,6 +37,8 @@ namespace OHOS {
 namespace Rosen {
 RSUniRenderVisitor::RSUniRenderVisitor() {}
 
+RSUniRenderVisitor::RSUniRenderVisitor(RSPaintFilterCanvas* offscreenCanvas) : offscreenCanvas_(offscreenCanvas) {}
+
 RSUniRenderVisitor::~RSUniRenderVisitor() {}
 
 void RSUniRenderVisitor::PrepareBaseRenderNode(RSBaseRenderNode& node)
@@ -46,13 +50,17 @@ void RSUniRenderVisitor::PrepareBaseRenderNode(RSBaseRenderNode& node)
 
 void RSUniRenderVisitor::PrepareDisplayRenderNode(RSDisplayRenderNode& node)
 {
-    isUniRenderForAll_ =
+    isUniRenderForAll_ = offscreenCanvas_ != nullptr ||
         RSSystemProperties::GetUniRenderEnabledType() == UniRenderEnabledType::UNI_RENDER_ENABLED_FOR_ALL;
     if (!isUniRenderForAll_) {
         RS_LOGI("RSUniRenderVisitor::PrepareDisplayRenderNode isUniRenderForAll_ false");
         uniRenderList_ = RSSystemProperties::GetUniRenderEnabledList();
     }
     PrepareBaseRenderNode(node);
+    auto stats = RSOcclusionCulling::Apply(node, [this](const RSSurfaceRenderNode& surface) {
+        return isUniRenderForAll_ || uniRenderList_.find(surface.GetName()) != uniRenderList_.end();
+    });
+    RSFrameTimeline::Instance().AddOccludedSurfaces(stats.occludedCount, stats.occludedArea);
 }
 
 void RSUniRenderVisitor::PrepareSurfaceRenderNode(RSSurfaceRenderNode& node)
@@ -93,13 +101,22 @@ void RSUniRenderVisitor::PrepareCanvasRenderNode(RSCanvasRenderNode &node)
     bool dirtyFlag = dirtyFlag_;
     dirtyFlag_ = node.Update(dirtyManager_, parent_ ? &(parent_->GetRenderProperties()) : nullptr, dirtyFlag_);
     PrepareBaseRenderNode(node);
+    node.UpdateSubtreeCacheState();
     dirtyFlag_ = dirtyFlag;
 }
 
 void RSUniRenderVisitor::ProcessBaseRenderNode(RSBaseRenderNode& node)
 {
-    for (auto& child : node.GetSortedChildren()) {
-        child->Process(shared_from_this());
+    RSFrameTimeline::Instance().AddVisitedNodeCount(node.GetSortedChildren().size());
+    if (node.GetType() == RSRenderNodeType::BASE_NODE) {
+        // the children of the global root are the displays, HdiBackend commits them in the order they are processed.
+        for (auto& display : RsRenderServiceUtil::GetDisplaysInCommitOrder(node)) {
+            display->Process(shared_from_this());
+        }
+    } else {
+        for (auto& child : node.GetSortedChildren()) {
+            child->Process(shared_from_this());
+        }
     }
     // clear SortedChildren, it will be generated again in next frame
     node.ResetSortedChildren();
@@ -110,6 +127,13 @@ void RSUniRenderVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
     RS_LOGD("RSUniRenderVisitor::ProcessDisplayRenderNode node: %llu, child size:%u", node.GetChildrenCount(),
         node.GetId());
     globalZOrder_ = 0.0f;
+    if (offscreenCanvas_ != nullptr) {
+        // nothing is composed, every surface is uni rendered into the offscreen canvas.
+        canvas_ = offscreenCanvas_;
+        ProcessBaseRenderNode(node);
+        canvas_ = nullptr;
+        return;
+    }
     sptr<RSScreenManager> screenManager = CreateOrGetScreenManager();
     if (!screenManager) {
         RS_LOGE("RSUniRenderVisitor::ProcessDisplayRenderNode ScreenManager is nullptr");
@@ -174,6 +198,9 @@ void RSUniRenderVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
         RS_TRACE_BEGIN("RSUniRender:FlushFrame");
         rsSurface->FlushFrame(surfaceFrame);
         RS_TRACE_END();
+        const auto& dirtyRegion = dirtyManager_.GetDirtyRegion();
+        RSFrameTimeline::Instance().AddDirtyArea(
+            static_cast<uint64_t>(dirtyRegion.width_) * static_cast<uint64_t>(dirtyRegion.height_));
         delete canvas_;
         canvas_ = nullptr;
 
@@ -192,6 +219,11 @@ void RSUniRenderVisitor::ProcessSurfaceRenderNode(RSSurfaceRenderNode& node)
 {
     RS_LOGD("RSUniRenderVisitor::ProcessSurfaceRenderNode node: %llu, child size:%u %s", node.GetId(),
         node.GetChildrenCount(), node.GetName().c_str());
+    if (node.IsOccluded() && IsChildOfDisplayNode(node)) {
+        RS_LOGD("RSUniRenderVisitor::ProcessSurfaceRenderNode node: %llu occluded", node.GetId());
+        RSOcclusionCulling::ReleaseOccludedBuffers(node);
+        return;
+    }
     if (isUniRenderForAll_ || uniRenderList_.find(node.GetName()) != uniRenderList_.end()) {
         isUniRender_ = true;
     }
@@ -280,6 +312,9 @@ void RSUniRenderVisitor::ProcessCanvasRenderNode(RSCanvasRenderNode& node)
         RS_LOGE("RSUniRenderVisitor::ProcessCanvasRenderNode, canvas is nullptr");
         return;
     }
+    if (node.ProcessCachedSubtree(*canvas_)) {
+        return;
+    }
     node.ProcessRenderBeforeChildren(*canvas_);
     ProcessBaseRenderNode(node);
     node.ProcessRenderAfterChildren(*canvas_);
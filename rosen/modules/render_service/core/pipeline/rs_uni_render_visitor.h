@@ -29,6 +29,8 @@ namespace Rosen {
 class RSUniRenderVisitor : public RSNodeVisitor {
 public:
     RSUniRenderVisitor();
+    // draw every surface into offscreenCanvas instead of composing the screens, e.g. to replay a transaction trace.
+    explicit RSUniRenderVisitor(RSPaintFilterCanvas* offscreenCanvas);
     ~RSUniRenderVisitor() override;
 
     void PrepareBaseRenderNode(RSBaseRenderNode& node) override;
@@ -53,6 +55,7 @@ private:
     RSRenderNode* parent_ = nullptr;
     bool dirtyFlag_ { false };
     RSPaintFilterCanvas* canvas_ = nullptr;
+    RSPaintFilterCanvas* offscreenCanvas_ = nullptr;
 
     float globalZOrder_ { 0.0f };
     float uniZOrder_ { 0.0f };
@@ -111,6 +111,7 @@ void RSScreenManager::ProcessScreenHotPlugEvents()
             ProcessScreenDisConnectedLocked(event.output);
         }
     }
+    UpdatePrimaryScreenLocked();
     for (auto id : connectedIds_) {
         for (auto &cb : screenChangeCallbacks_) {
             cb->OnScreenChanged(id, ScreenEvent::CONNECTED);
@@ -196,10 +197,22 @@ void RSScreenManager::HandleDefaultScreenDisConnectedLocked()
     }
 }
 
+// The composer commits the default screen first and samples vsync from it, so it always follows the default screen.
+void RSScreenManager::UpdatePrimaryScreenLocked()
+{
+    if (composer_ == nullptr) {
+        return;
+    }
+    auto iter = screens_.find(defaultScreenId_);
+    bool isPhysical = iter != screens_.end() && iter->second != nullptr && !iter->second->IsVirtual();
+    composer_->SetPrimaryScreen(isPhysical ? ToScreenPhysicalId(defaultScreenId_) : UINT32_MAX);
+}
+
 void RSScreenManager::SetDefaultScreenId(ScreenId id)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     defaultScreenId_ = id;
+    UpdatePrimaryScreenLocked();
 }
 
 void RSScreenManager::SetScreenMirror(ScreenId id, ScreenId toMirror)
@@ -254,6 +254,7 @@ private:
     void ProcessScreenConnectedLocked(std::shared_ptr<HdiOutput> &output);
     void ProcessScreenDisConnectedLocked(std::shared_ptr<HdiOutput> &output);
     void HandleDefaultScreenDisConnectedLocked();
+    void UpdatePrimaryScreenLocked();
     std::vector<ScreenHotPlugEvent> pendingHotPlugEvents_;
 
     void GetVirtualScreenResolutionLocked(ScreenId id, RSVirtualScreenResolution& virtualScreenResolution) const;
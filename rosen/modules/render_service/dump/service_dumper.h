@@ -99,6 +99,13 @@ public:
             std::cout << "fps:               Show the fps info." << std::endl;
             std::cout << "nodeNotOnTree:     Show the surfaces info which are not on the tree." << std::endl;
             std::cout << "allSurfacesMem:    Show the memory size of all surfaces buffer." << std::endl;
+            std::cout << "frameTimeline:     Show the stage percentiles and the last frames of the render service."
+                      << std::endl;
+            std::cout << "frameTimelineExport: Export the recorded frames to /data/rs_frame_timeline.bin." << std::endl;
+            std::cout << "subtreeCache:      Show the usage and hit rate of the static subtree cache." << std::endl;
+            std::cout << "transactionTraceStart: Record the transactions and vsyncs to /data/rs_transaction_trace.bin "
+                      << "for render_service_replay." << std::endl;
+            std::cout << "transactionTraceStop: Stop recording and save the transaction trace." << std::endl;
             std::cout << "NULL:              Show all of the information above." << std::endl;
             retCode = 1;
         }
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <unistd.h>
+
+#include "pipeline/rs_transaction_replayer.h"
+
+namespace {
+constexpr int32_t DEFAULT_SCREEN_WIDTH = 1344;
+constexpr int32_t DEFAULT_SCREEN_HEIGHT = 2772;
+constexpr int RET_CHECKSUM_MISMATCH = 1;
+constexpr int RET_INVALID_ARGS = 2;
+
+std::atomic<uint64_t> g_allocationCount { 0 };
+
+void PrintUsage()
+{
+    printf("usage: render_service_replay [-w width] [-h height] [-c checksum_file] trace_file\n"
+           "  replays a trace of 'render_service_dump transactionTraceStart' headless and prints the stage timing.\n"
+           "  -c: writes the checksums of all frames to checksum_file, or compares them when it exists already\n");
+}
+
+int CheckChecksums(const std::vector<OHOS::Rosen::RSReplayFrame>& frames, const std::string& checksumPath)
+{
+    std::ifstream expected(checksumPath);
+    if (!expected.is_open()) {
+        std::ofstream out(checksumPath);
+        for (const auto& frame : frames) {
+            out << std::hex << frame.checksum << "\n";
+        }
+        printf("checksums of %zu frames written to %s\n", frames.size(), checksumPath.c_str());
+        return 0;
+    }
+    size_t index = 0;
+    uint64_t checksum = 0;
+    while (expected >> std::hex >> checksum) {
+        if (index >= frames.size() || frames[index].checksum != checksum) {
+            printf("checksum mismatch at frame %zu\n", index);
+            return RET_CHECKSUM_MISMATCH;
+        }
+        index++;
+    }
+    if (index != frames.size()) {
+        printf("frame count mismatch: %zu replayed, %zu expected\n", frames.size(), index);
+        return RET_CHECKSUM_MISMATCH;
+    }
+    printf("checksums of %zu frames match\n", frames.size());
+    return 0;
+}
+}
+
+// counts every allocation of the process, the replayer reads the counter around each stage
+void* operator new(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    size = (size == 0) ? 1 : size;
+    void* ptr = malloc(size);
+    // built without exceptions: give the new handler a chance to free memory, abort if there is none
+    while (ptr == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            abort();
+        }
+        handler();
+        ptr = malloc(size);
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    free(ptr);
+}
+
+int main(int argc, char *argv[])
+{
+    int32_t width = DEFAULT_SCREEN_WIDTH;
+    int32_t height = DEFAULT_SCREEN_HEIGHT;
+    std::string checksumPath;
+    int opt;
+    while ((opt = getopt(argc, argv, "w:h:c:")) != -1) {
+        switch (opt) {
+            case 'w':
+                width = atoi(optarg);
+                break;
+            case 'h':
+                height = atoi(optarg);
+                break;
+            case 'c':
+                checksumPath = optarg;
+                break;
+            default:
+                PrintUsage();
+                return RET_INVALID_ARGS;
+        }
+    }
+    if (optind >= argc || width <= 0 || height <= 0) {
+        PrintUsage();
+        return RET_INVALID_ARGS;
+    }
+
+    OHOS::Rosen::RSTransactionReplayer replayer(width, height);
+    replayer.SetAllocationCounter([]() { return g_allocationCount.load(std::memory_order_relaxed); });
+    if (!replayer.Replay(argv[optind])) {
+        printf("can't read trace %s\n", argv[optind]);
+        return RET_INVALID_ARGS;
+    }
+    std::string dumpString;
+    replayer.Dump(dumpString);
+    printf("%s", dumpString.c_str());
+    return checksumPath.empty() ? 0 : CheckChecksums(replayer.GetFrames(), checksumPath);
+}
@@ -16,9 +16,11 @@
 #ifndef RENDER_SERVICE_BASE_ANIMATION_RS_ANIMATION_LOG_H
 #define RENDER_SERVICE_BASE_ANIMATION_RS_ANIMATION_LOG_H
 
-#include <fstream>
-#include <set>
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
 
 #include "animation/rs_animatable_property.h"
 #include "platform/common/rs_log.h"
@@ -26,11 +28,77 @@
 
 namespace OHOS {
 namespace Rosen {
+enum class RSAnimationLogRecordKind : uint8_t {
+    VALUE = 0,
+    INFO,
+    // id is the count of records dropped since the last one as the ring of a thread was full
+    DROPPED,
+    // first record of a log file, repeated when processes create the file at the same time
+    FILE_HEADER = 0xFF,
+};
+
+enum class RSAnimationLogValueType : uint8_t {
+    INT = 0,
+    FLOAT,
+    COLOR,
+    MATRIX3F,
+    VECTOR2F,
+    VECTOR4F,
+    QUATERNION,
+    FILTER,
+    VECTOR4_COLOR,
+};
+
+// One record of the binary animation log. Records have a fixed size, the rings and the log file need no framing.
+struct RSAnimationLogRecord {
+    static constexpr size_t MAX_VALUES = 32;
+
+    RSAnimationLogRecordKind kind { RSAnimationLogRecordKind::VALUE };
+    RSAnimationLogValueType valueType { RSAnimationLogValueType::FLOAT };
+    // floats per value, an info record holds the start value followed by the end value; 0 for a null filter
+    uint8_t valueCount { 0 };
+    uint8_t reserved { 0 };
+    uint32_t reserved2 { 0 };
+    int64_t time { 0 };
+    // node id of a value record, animation id of an info record
+    uint64_t id { 0 };
+    uint64_t property { 0 };
+    float values[MAX_VALUES] = {};
+};
+
+// Single producer single consumer ring of records. The animating thread pushes without locking and drops the record
+// when the ring is full, the log writer thread drains it.
+class RSAnimationLogRing {
+public:
+    static constexpr uint32_t CAPACITY = 512;
+
+    RSAnimationLogRing() = default;
+    ~RSAnimationLogRing() = default;
+
+    bool Push(const RSAnimationLogRecord& record);
+    // appends the records pushed so far to records, returns their count
+    size_t Drain(std::vector<RSAnimationLogRecord>& records);
+    uint64_t GetDroppedCount() const
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<RSAnimationLogRecord, CAPACITY> records_;
+    alignas(64) std::atomic<uint32_t> head_ { 0 };
+    alignas(64) std::atomic<uint32_t> tail_ { 0 };
+    std::atomic<uint64_t> dropped_ { 0 };
+};
+
+// Traces the values of animated properties for the nodes and properties selected in ANIMATION_LOG_PATH/property.config.
+// A write only encodes a record into the ring of the calling thread; a background thread appends the rings to a binary
+// log file, which DecodeLogFile or the rs_animation_log_decoder tool turn into text.
 class RSAnimationLog {
 public:
     RSAnimationLog();
     ~RSAnimationLog();
 
+    // reloads the process wide selection of nodes and properties
     void InitNodeAndPropertyInfo();
 
     void ClearNodeAndPropertyInfo();
@@ -44,22 +112,12 @@ public:
     void WriteAnimationInfoToLog(const RSAnimatableProperty& property, const AnimationId& id,
         const T& startValue, const T& endValue);
 
-private:
-    void PreProcessLogFile(const std::string& logFilePath);
-
-    void DealConfigInputInfo(const std::string& info);
+    // writes the records of a binary log file as the lines of the former text log
+    static bool DecodeLogFile(const std::string& logFilePath, std::ostream& out);
+    static std::string DecodeRecord(const RSAnimationLogRecord& record);
 
-    int64_t GetNowTime();
-
-    void WriteString(const std::string& log);
-
-    int WriteLog(const char* format, ...);
-
-    bool needWriteAllNode_ {false};
-    bool needWriteAllProperty_ {false};
-    std::ofstream logFile_;
-    std::set<NodeId> nodeIdSet_;
-    std::set<RSAnimatableProperty> propertySet_;
+private:
+    static void WriteRecord(const RSAnimationLogRecord& record);
 };
 } // namespace Rosen
 } // namespace OHOS
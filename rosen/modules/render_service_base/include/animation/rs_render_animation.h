@@ -49,6 +49,8 @@ public:
     void Resume();
     void SetFraction(float fraction);
     void SetReversed(bool isReversed);
+    // finishes the part of the animation animating property, all of it if property is all it animates
+    void FinishProperty(RSAnimatableProperty property);
 #ifdef ROSEN_OHOS
     virtual bool Marshalling(Parcel& parcel) const override;
 #endif
@@ -153,6 +155,8 @@ protected:
 
     virtual void OnRemoveOnCompletion() {}
 
+    virtual void OnFinishProperty(RSAnimatableProperty property) {}
+
 private:
     void ProcessFillModeOnStart(float startFraction);
 
@@ -163,6 +167,8 @@ private:
     AnimationState state_ { AnimationState::INITIALIZED };
     bool firstToRunning_ { false };
     RSRenderNode* target_ { nullptr };
+
+    friend class RSRenderGroupCurveAnimation;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_RENDER_GROUP_CURVE_ANIMATION_H
+#define RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_RENDER_GROUP_CURVE_ANIMATION_H
+
+#include <vector>
+
+#include "animation/rs_render_animation.h"
+#include "animation/rs_render_curve_animation.h"
+
+namespace OHOS {
+namespace Rosen {
+// Curve animations of several properties of one node under one animation id. The group owns the timing, every frame
+// its fraction is handed to all the animations, which interpolate with their own curve.
+class RSRenderGroupCurveAnimation : public RSRenderAnimation {
+public:
+    explicit RSRenderGroupCurveAnimation(AnimationId id);
+    ~RSRenderGroupCurveAnimation() = default;
+
+    template<typename T>
+    void AddAnimation(const std::shared_ptr<RSRenderCurveAnimation<T>>& animation)
+    {
+        if (animation == nullptr) {
+            ROSEN_LOGE("RSRenderGroupCurveAnimation::AddAnimation, animation is null!");
+            return;
+        }
+        animations_.emplace_back(GetValueType(static_cast<const T*>(nullptr)), animation);
+    }
+
+    size_t GetAnimationCount() const
+    {
+        return animations_.size();
+    }
+
+    RSAnimatableProperty GetProperty() const override;
+
+#ifdef ROSEN_OHOS
+    bool Marshalling(Parcel& parcel) const override;
+    static RSRenderGroupCurveAnimation* Unmarshalling(Parcel& parcel);
+#endif
+
+protected:
+    void OnSetFraction(float fraction) override;
+    void OnAttach() override;
+    void OnDetach() override;
+    void OnAnimate(float fraction) override;
+    void OnRemoveOnCompletion() override;
+    void OnFinishProperty(RSAnimatableProperty property) override;
+
+private:
+    // value type of an animation, written ahead of it to unmarshal it as the right RSRenderCurveAnimation
+    enum ValueType : uint16_t {
+        INT,
+        FLOAT,
+        COLOR,
+        MATRIX3F,
+        VEC2F,
+        VEC4F,
+        QUATERNION,
+        FILTER,
+        VEC4_COLOR,
+    };
+
+    static constexpr uint16_t GetValueType(const int*)
+    {
+        return INT;
+    }
+    static constexpr uint16_t GetValueType(const float*)
+    {
+        return FLOAT;
+    }
+    static constexpr uint16_t GetValueType(const Color*)
+    {
+        return COLOR;
+    }
+    static constexpr uint16_t GetValueType(const Matrix3f*)
+    {
+        return MATRIX3F;
+    }
+    static constexpr uint16_t GetValueType(const Vector2f*)
+    {
+        return VEC2F;
+    }
+    static constexpr uint16_t GetValueType(const Vector4f*)
+    {
+        return VEC4F;
+    }
+    static constexpr uint16_t GetValueType(const Quaternion*)
+    {
+        return QUATERNION;
+    }
+    static constexpr uint16_t GetValueType(const std::shared_ptr<RSFilter>*)
+    {
+        return FILTER;
+    }
+    static constexpr uint16_t GetValueType(const Vector4<Color>*)
+    {
+        return VEC4_COLOR;
+    }
+
+#ifdef ROSEN_OHOS
+    bool ParseParam(Parcel& parcel) override;
+#endif
+    RSRenderGroupCurveAnimation() = default;
+
+    std::vector<std::pair<uint16_t, std::shared_ptr<RSRenderAnimation>>> animations_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_RENDER_GROUP_CURVE_ANIMATION_H
@@ -18,6 +18,7 @@
 
 #include "animation/rs_render_animation.h"
 #include "animation/rs_render_curve_animation.h"
+#include "animation/rs_render_group_curve_animation.h"
 #include "animation/rs_render_keyframe_animation.h"
 #include "animation/rs_render_path_animation.h"
 #include "animation/rs_render_transition.h"
@@ -52,6 +53,8 @@ enum RSAnimationCommandType : uint16_t {
     ANIMATION_CREATE_PATH,
     // transition animation
     ANIMATION_CREATE_TRANSITION,
+    // group curve animation
+    ANIMATION_CREATE_GROUP_CURVE,
 
     // operations
     ANIMATION_START,
@@ -60,6 +63,7 @@ enum RSAnimationCommandType : uint16_t {
     ANIMATION_FINISH,
     ANIMATION_REVERSE,
     ANIMATION_SET_FRACTION,
+    ANIMATION_FINISH_PROPERTY,
 
     // UI operation
     ANIMATION_FINISH_CALLBACK,
@@ -142,6 +146,10 @@ ADD_COMMAND(RSAnimationReverse,
 ADD_COMMAND(RSAnimationSetFraction,
     ARG(ANIMATION, ANIMATION_SET_FRACTION, AnimationCommandHelper::AnimOp<float, &RSRenderAnimation::SetFraction>,
         NodeId, AnimationId, float))
+ADD_COMMAND(RSAnimationFinishProperty,
+    ARG(ANIMATION, ANIMATION_FINISH_PROPERTY,
+        AnimationCommandHelper::AnimOp<RSAnimatableProperty, &RSRenderAnimation::FinishProperty>, NodeId, AnimationId,
+        RSAnimatableProperty))
 
 ADD_COMMAND(RSAnimationFinishCallback,
     ARG(ANIMATION, ANIMATION_FINISH_CALLBACK, AnimationCommandHelper::AnimationFinishCallback, NodeId, AnimationId))
@@ -213,6 +221,11 @@ ADD_COMMAND(
     RSAnimationCreateTransition, ARG(ANIMATION, ANIMATION_CREATE_TRANSITION, AnimationCommandHelper::CreateAnimation,
                                      NodeId, std::shared_ptr<RSRenderTransition>))
 
+// create group curve animation
+ADD_COMMAND(RSAnimationCreateGroupCurve, ARG(ANIMATION, ANIMATION_CREATE_GROUP_CURVE,
+                                             AnimationCommandHelper::CreateAnimation, NodeId,
+                                             std::shared_ptr<RSRenderGroupCurveAnimation>))
+
 } // namespace Rosen
 } // namespace OHOS
 
@@ -43,6 +43,15 @@ class RSUIDirector;
 template<uint16_t commandType, uint16_t commandSubType, auto processFunc, typename... Ts>
 class RSCommandTemplate;
 
+// subtype of a command alias, e.g. RSCommandSubType<RSNodeSetAlphaDelta>::value
+template<typename Command>
+struct RSCommandSubType;
+
+template<uint16_t commandType, uint16_t commandSubType, auto processFunc, typename... Ts>
+struct RSCommandSubType<RSCommandTemplate<commandType, commandSubType, processFunc, Ts...>> {
+    static constexpr uint16_t value = commandSubType;
+};
+
 template<uint16_t commandType, uint16_t commandSubType, auto processFunc>
 class RSCommandTemplate<commandType, commandSubType, processFunc> : public RSCommand {
 public:
@@ -17,6 +17,7 @@
 #define ROSEN_RENDER_SERVICE_BASE_COMMAND_RS_NODE_COMMAND_H
 
 #include "command/rs_command_templates.h"
+#include "command/rs_node_delta_bundle.h"
 #include "pipeline/rs_render_node.h"
 #include "property/rs_properties.h"
 
@@ -135,6 +136,8 @@ enum RSNodeCommandType : uint16_t {
     SET_SHADOW_ALPHA_DELTA,
     SET_SHADOW_ELEVATION_DELTA,
     SET_SHADOW_RADIUS_DELTA,
+
+    APPLY_DELTA_BUNDLE,
 };
 
 class RSRenderNodeCommandHelper {
@@ -156,6 +159,9 @@ public:
             (node->GetMutableRenderProperties().*setter)(newValue);
         }
     }
+
+    static void ApplyDeltaBundle(
+        RSContext& context, NodeId nodeId, const std::shared_ptr<RSNodeDeltaBundle>& bundle);
 };
 
 // declare commands like RSPropertyRenderNodeAlphaChanged and RSPropertyRenderNodeAlphaDelta
@@ -173,6 +179,10 @@ public:
 #undef DECLARE_SET_COMMAND
 #undef DECLARE_DELTA_COMMAND
 
+// the deltas of a node set one after another, see RSTransactionProxy::AddPropertyDelta
+ADD_COMMAND(RSNodeApplyDeltaBundle, ARG(RS_NODE, APPLY_DELTA_BUNDLE, RSRenderNodeCommandHelper::ApplyDeltaBundle,
+                                        NodeId, std::shared_ptr<RSNodeDeltaBundle>))
+
 } // namespace Rosen
 } // namespace OHOS
 
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSEN_RENDER_SERVICE_BASE_COMMAND_RS_NODE_DELTA_BUNDLE_H
+#define ROSEN_RENDER_SERVICE_BASE_COMMAND_RS_NODE_DELTA_BUNDLE_H
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef ROSEN_OHOS
+#include <parcel.h>
+#endif
+
+#include "common/rs_color.h"
+#include "common/rs_matrix3.h"
+#include "common/rs_vector2.h"
+#include "common/rs_vector4.h"
+
+namespace OHOS {
+namespace Rosen {
+// Property deltas a node sets one after another while its properties animate, each the subtype of the RSNodeSetXxxDelta
+// command it replaces and its value. The bundle travels as one RSNodeApplyDeltaBundle command, see
+// RSTransactionProxy::AddPropertyDelta. Deltas of one value type keep their order, which is all the order that matters
+// as a property has a single value type.
+#ifdef ROSEN_OHOS
+class RSNodeDeltaBundle : public Parcelable {
+#else
+class RSNodeDeltaBundle {
+#endif
+public:
+    RSNodeDeltaBundle() = default;
+    ~RSNodeDeltaBundle() = default;
+
+    // value types of the deltas a bundle carries, the others are sent as commands of their own
+    template<typename T>
+    static constexpr bool IsSupported()
+    {
+        return std::is_same_v<T, float> || std::is_same_v<T, Vector2f> || std::is_same_v<T, Vector4f> ||
+            std::is_same_v<T, Quaternion> || std::is_same_v<T, Color> || std::is_same_v<T, Vector4<Color>> ||
+            std::is_same_v<T, Matrix3f>;
+    }
+
+    template<typename T>
+    void AddDelta(uint16_t type, const T& delta)
+    {
+        std::get<Deltas<T>>(deltas_).emplace_back(type, delta);
+    }
+
+    // calls visitor(type, delta) for every delta
+    template<typename Visitor>
+    void ForEachDelta(Visitor&& visitor) const
+    {
+        std::apply([&visitor](const auto&... deltas) { (VisitDeltas(deltas, visitor), ...); }, deltas_);
+    }
+
+    size_t GetDeltaCount() const;
+
+#ifdef ROSEN_OHOS
+    bool Marshalling(Parcel& parcel) const override;
+    static RSNodeDeltaBundle* Unmarshalling(Parcel& parcel);
+#endif
+
+private:
+    template<typename T>
+    using Deltas = std::vector<std::pair<uint16_t, T>>;
+
+    template<typename T, typename Visitor>
+    static void VisitDeltas(const Deltas<T>& deltas, Visitor& visitor)
+    {
+        for (const auto& [type, delta] : deltas) {
+            visitor(type, delta);
+        }
+    }
+
+    std::tuple<Deltas<float>, Deltas<Vector2f>, Deltas<Vector4f>, Deltas<Quaternion>, Deltas<Color>,
+        Deltas<Vector4<Color>>, Deltas<Matrix3f>> deltas_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // ROSEN_RENDER_SERVICE_BASE_COMMAND_RS_NODE_DELTA_BUNDLE_H
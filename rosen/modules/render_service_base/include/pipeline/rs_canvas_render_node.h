@@ -17,6 +17,10 @@
 
 #include <memory>
 
+#ifdef ROSEN_OHOS
+#include "include/core/SkImage.h"
+#endif
+
 #include "pipeline/rs_render_node.h"
 
 namespace OHOS {
@@ -42,15 +46,53 @@ public:
     void Prepare(const std::shared_ptr<RSNodeVisitor>& visitor) override;
     void Process(const std::shared_ptr<RSNodeVisitor>& visitor) override;
 
+    // Subtree cache: visitors call UpdateSubtreeCacheState() once the children are prepared, and
+    // ProcessCachedSubtree() in place of the regular processing. When it returns true the whole subtree has been
+    // drawn from an offscreen image and the children must not be processed.
+    void UpdateSubtreeCacheState();
+    bool ProcessCachedSubtree(RSPaintFilterCanvas& canvas);
+
+    bool IsSubtreeChanged() const
+    {
+        return subtreeChanged_;
+    }
+    int GetSubtreeCost() const
+    {
+        return subtreeCost_;
+    }
+    uint32_t GetStableFrameCount() const
+    {
+        return stableFrames_;
+    }
+
     RSRenderNodeType GetType() const override
     {
         return RSRenderNodeType::CANVAS_NODE;
     }
 
 private:
+    void DrawContentsBeforeChildren(RSPaintFilterCanvas& canvas);
+    void DrawContentsAfterChildren(RSPaintFilterCanvas& canvas);
+#ifdef ROSEN_OHOS
+    sk_sp<SkImage> CreateSubtreeCache(RSPaintFilterCanvas& canvas, float scale);
+    void DrawSubtreeContents(RSPaintFilterCanvas& canvas);
+#endif
+    bool IsSubtreeCacheEligible() const;
+    void ReleaseSubtreeCache();
+    static void FinishSkippedChildren(RSBaseRenderNode& node);
+
     std::shared_ptr<DrawCmdList> drawCmdList_ { nullptr };
     bool drawContentLast_ = false;
 
+    bool subtreeChanged_ = true;
+    bool subtreeCacheable_ = false;
+    bool subtreeInsideBounds_ = false;
+    bool cacheRejected_ = false;
+    int subtreeCost_ = 0;
+    uint32_t stableFrames_ = 0;
+    float cacheScale_ = 0.f;
+    float lastDrawScale_ = 0.f;
+
     friend class RSRenderTransition;
 };
 } // namespace Rosen
@@ -59,6 +59,7 @@ private:
 
     friend class RSRenderThread;
     friend class RSMainThread;
+    friend class RSTransactionReplayer;
 };
 
 } // namespace Rosen
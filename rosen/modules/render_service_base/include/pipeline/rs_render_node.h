@@ -62,6 +62,16 @@ public:
         return animationManager_.HasTransition() || RSBaseRenderNode::HasTransition(recursive);
     }
 
+    // whether the last Update() found this node changed, and whether anything but its transform and alpha changed
+    bool IsLastFrameDirty() const
+    {
+        return isLastFrameDirty_;
+    }
+    bool IsLastFrameContentDirty() const
+    {
+        return isLastFrameContentDirty_;
+    }
+
 protected:
     explicit RSRenderNode(NodeId id, std::weak_ptr<RSContext> context = {});
     void UpdateDirtyRegion(RSDirtyRegionManager& dirtyManager);
@@ -70,6 +80,9 @@ protected:
 private:
     void FallbackAnimationsToRoot();
     int32_t saveCount_ = 0;
+    bool wasVisible_ = true;
+    bool isLastFrameDirty_ = true;
+    bool isLastFrameContentDirty_ = true;
     RectI oldDirty_;
     RSProperties renderProperties_;
     RSAnimationManager animationManager_;
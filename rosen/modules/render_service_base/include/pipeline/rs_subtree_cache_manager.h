@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_PIPELINE_RS_SUBTREE_CACHE_MANAGER_H
+#define RENDER_SERVICE_CLIENT_CORE_PIPELINE_RS_SUBTREE_CACHE_MANAGER_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "include/core/SkImage.h"
+
+#include "common/rs_common_def.h"
+
+namespace OHOS {
+namespace Rosen {
+struct RSSubtreeCacheStats {
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint64_t createCount = 0;
+    uint64_t invalidateCount = 0;
+    uint64_t evictCount = 0;
+    uint64_t rejectCount = 0;
+    size_t cachedCount = 0;
+    size_t memoryUsage = 0;
+    size_t memoryBudget = 0;
+};
+
+// Owns the offscreen images of static canvas subtrees (see RSCanvasRenderNode::ProcessCachedSubtree) and keeps
+// them under a memory budget, evicting the least recently drawn ones first.
+class RSSubtreeCacheManager final {
+public:
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 32 * 1024 * 1024;
+    static constexpr uint32_t DEFAULT_STABLE_FRAMES = 3;
+    static constexpr int DEFAULT_COST_THRESHOLD = 32;
+
+    static RSSubtreeCacheManager& Instance();
+
+    explicit RSSubtreeCacheManager(size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+    ~RSSubtreeCacheManager() = default;
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+    // a subtree is cached once its content is unchanged for this many frames ...
+    void SetStableFrameThreshold(uint32_t frames);
+    uint32_t GetStableFrameThreshold() const;
+    // ... and replaying it costs at least this many draw ops
+    void SetCostThreshold(int cost);
+    int GetCostThreshold() const;
+    void SetMemoryBudget(size_t bytes);
+    size_t GetMemoryBudget() const;
+
+    bool ShouldCache(uint32_t stableFrames, int cost) const;
+    bool CanFit(size_t bytes) const;
+
+    // returns the cached image of the node and marks it most recently used, nullptr if there is none
+    sk_sp<SkImage> Get(NodeId id);
+    // stores the image of the node, evicting the least recently used images to stay under the budget
+    bool Put(NodeId id, sk_sp<SkImage> image);
+    // drops the image because the subtree changed
+    void Invalidate(NodeId id);
+    // drops the image because the node is gone or no longer drawn through its cache
+    void Remove(NodeId id);
+    bool Contains(NodeId id) const;
+    void Clear();
+
+    void RecordReject();
+    RSSubtreeCacheStats GetStats() const;
+    void ResetStats();
+    void Dump(std::string& dumpString) const;
+
+private:
+    struct CacheEntry {
+        sk_sp<SkImage> image;
+        size_t bytes = 0;
+        std::list<NodeId>::iterator lruIter;
+    };
+
+    void EraseLocked(std::unordered_map<NodeId, CacheEntry>::iterator iter);
+    void EvictLocked(size_t budget);
+
+    mutable std::mutex mutex_;
+    bool enabled_ = true;
+    uint32_t stableFrameThreshold_ = DEFAULT_STABLE_FRAMES;
+    int costThreshold_ = DEFAULT_COST_THRESHOLD;
+    size_t memoryBudget_;
+    size_t memoryUsage_ = 0;
+    std::unordered_map<NodeId, CacheEntry> entries_;
+    // most recently used first
+    std::list<NodeId> lruList_;
+    RSSubtreeCacheStats stats_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_PIPELINE_RS_SUBTREE_CACHE_MANAGER_H
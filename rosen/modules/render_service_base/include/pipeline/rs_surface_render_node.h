@@ -105,6 +105,16 @@ public:
     void SetSecurityLayer(bool isSecurityLayer);
     bool GetSecurityLayer() const;
 
+    // set by the occlusion pass of the render service when opaque surfaces above fully cover this node.
+    void SetOccluded(bool isOccluded)
+    {
+        isOccluded_ = isOccluded;
+    }
+    bool IsOccluded() const
+    {
+        return isOccluded_;
+    }
+
     const Vector4f& GetClipRegion() const
     {
         return clipRect_;
@@ -181,6 +191,7 @@ private:
     SkMatrix matrix_;
     float alpha_ = 1.0f;
     bool isSecurityLayer_ = false;
+    bool isOccluded_ = false;
     NodeId parentId_ = 0;
     RectI dstRect_;
     int32_t offsetX_ = 0;
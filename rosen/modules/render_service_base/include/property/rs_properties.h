@@ -188,8 +188,11 @@ public:
 
 private:
     void SetDirty();
+    // marks a change of position, rotation, scale or pivot only, which moves the node without changing its content
+    void SetTransformDirty();
     void ResetDirty();
     bool IsDirty() const;
+    bool IsContentDirty() const;
     void ResetBounds();
 
     RectF GetBoundsRect() const;
@@ -207,6 +210,7 @@ private:
     bool clipToFrame_ = false;
     bool isDirty_ = false;
     bool geoDirty_ = false;
+    bool contentDirty_ = false;
 
     bool hasBounds_ = false;
 
@@ -43,12 +43,14 @@ class DrawCmdList;
 class RSFilter;
 class RSImage;
 class RSMask;
+class RSNodeDeltaBundle;
 class RSPath;
 class RSShader;
 template<typename T>
 class RSRenderCurveAnimation;
 template<typename T>
 class RSRenderKeyframeAnimation;
+class RSRenderGroupCurveAnimation;
 class RSRenderPathAnimation;
 class RSRenderTransition;
 class RSRenderTransitionEffect;
@@ -57,6 +59,9 @@ class RSMarshallingHelper {
 public:
     static bool WriteToParcel(Parcel &parcel, const void* data, size_t size);
     static const void* ReadFromParcel(Parcel& parcel, size_t size);
+    // while set on the calling thread, data of any size is kept in the parcel itself instead of shared memory,
+    // for parcels which are persisted rather than sent (see RSTransactionTraceWriter)
+    static void SetInlineData(bool inlineData);
 
     // default marshalling and unmarshalling method for POD types
     // [PLANNING]: implement marshalling & unmarshalling methods for other types (e.g. RSImage, drawCMDList)
@@ -126,7 +131,9 @@ public:
     DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<RSMask>)
     DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<RSImage>)
     DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<DrawCmdList>)
+    DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<RSNodeDeltaBundle>)
     // animation
+    DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<RSRenderGroupCurveAnimation>)
     DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<RSRenderPathAnimation>)
     DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<RSRenderTransition>)
     DECLARE_FUNCTION_OVERLOAD(std::shared_ptr<RSRenderTransitionEffect>)
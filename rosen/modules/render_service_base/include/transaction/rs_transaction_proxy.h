@@ -20,6 +20,7 @@
 #include <mutex>
 
 #include "command/rs_command.h"
+#include "command/rs_node_delta_bundle.h"
 #include "common/rs_singleton.h"
 #include "transaction/rs_irender_client.h"
 #include "transaction/rs_transaction_data.h"
@@ -37,6 +38,18 @@ public:
     void AddCommand(std::unique_ptr<RSCommand>& command, bool isRenderServiceCommand = false);
     void AddCommandFromRT(std::unique_ptr<RSCommand>& command);
 
+    // Adds the delta of a property of a node, deltaType being the subtype of its RSNodeSetXxxDelta command. The
+    // deltas a node adds one after another travel as one RSNodeApplyDeltaBundle command per destination, any other
+    // command ends the bundle so the order of the commands is kept.
+    template<typename T>
+    void AddPropertyDelta(NodeId nodeId, uint16_t deltaType, const T& delta, bool isRenderServiceCommand = false)
+    {
+        std::unique_lock<std::mutex> cmdLock(mutex_);
+        if (auto bundle = GetDeltaBundle(nodeId, isRenderServiceCommand)) {
+            bundle->AddDelta(deltaType, delta);
+        }
+    }
+
     void FlushImplicitTransaction();
     void FlushImplicitTransactionFromRT();
 
@@ -54,11 +67,15 @@ private:
 
     void AddCommonCommand(std::unique_ptr<RSCommand>& command);
     void AddRemoteCommand(std::unique_ptr<RSCommand>& command);
+    std::shared_ptr<RSNodeDeltaBundle> GetDeltaBundle(NodeId nodeId, bool isRenderServiceCommand);
 
     // Command Transaction Triggered by UI Thread.
     std::mutex mutex_;
     std::unique_ptr<RSTransactionData> implicitCommonTransactionData_{std::make_unique<RSTransactionData>()};
     std::unique_ptr<RSTransactionData> implicitRemoteTransactionData_{std::make_unique<RSTransactionData>()};
+    // bundles of the last commands added, open for more deltas of their node
+    std::pair<NodeId, std::shared_ptr<RSNodeDeltaBundle>> commonDeltaBundle_;
+    std::pair<NodeId, std::shared_ptr<RSNodeDeltaBundle>> remoteDeltaBundle_;
 
     // Command Transaction Triggered by Render Thread which is definitely send to Render Service.
     std::mutex mutexForRT_;
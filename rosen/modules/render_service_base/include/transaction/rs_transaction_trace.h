@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSEN_RENDER_SERVICE_BASE_RS_TRANSACTION_TRACE_H
+#define ROSEN_RENDER_SERVICE_BASE_RS_TRANSACTION_TRACE_H
+
+#ifdef ROSEN_OHOS
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "transaction/rs_transaction_data.h"
+
+namespace OHOS {
+namespace Rosen {
+enum class RSTransactionTraceRecordType : uint32_t {
+    // starts a frame, the transactions recorded after it were processed in that frame
+    VSYNC = 1,
+    TRANSACTION = 2,
+};
+
+struct RSTransactionTraceRecord {
+    RSTransactionTraceRecordType type = RSTransactionTraceRecordType::VSYNC;
+    uint64_t timestamp = 0; // ns, the vsync timestamp of the frame
+    std::vector<uint8_t> data; // marshalled RSTransactionData of a TRANSACTION record
+};
+
+// Trace of the transactions RSMainThread processed and the vsyncs it processed them in, replayed by
+// RSTransactionReplayer. The file is a header followed by records, each a type, data size and timestamp followed by
+// the data; transactions are marshalled with their data inline so the file is self-contained.
+class RSTransactionTraceWriter {
+public:
+    RSTransactionTraceWriter() = default;
+    ~RSTransactionTraceWriter();
+
+    bool Open(const std::string& path);
+    bool Close();
+    bool IsOpen() const
+    {
+        return file_ != nullptr;
+    }
+    bool WriteVsync(uint64_t timestamp);
+    bool WriteTransaction(const RSTransactionData& transactionData);
+    size_t GetRecordCount() const
+    {
+        return recordCount_;
+    }
+
+    RSTransactionTraceWriter(const RSTransactionTraceWriter&) = delete;
+    RSTransactionTraceWriter& operator=(const RSTransactionTraceWriter&) = delete;
+
+private:
+    bool WriteRecord(RSTransactionTraceRecordType type, const void* data, uint32_t size);
+
+    FILE* file_ = nullptr;
+    uint64_t timestamp_ = 0;
+    size_t recordCount_ = 0;
+    bool failed_ = false;
+};
+
+class RSTransactionTraceReader {
+public:
+    RSTransactionTraceReader() = default;
+    ~RSTransactionTraceReader();
+
+    bool Open(const std::string& path);
+    // false at the end of the trace or on a damaged record
+    bool Next(RSTransactionTraceRecord& record);
+    static std::unique_ptr<RSTransactionData> Unmarshalling(const RSTransactionTraceRecord& record);
+
+    RSTransactionTraceReader(const RSTransactionTraceReader&) = delete;
+    RSTransactionTraceReader& operator=(const RSTransactionTraceReader&) = delete;
+
+    static constexpr uint32_t MAGIC = 0x54525352; // "RSRT"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t MAX_RECORD_SIZE = 256 * 1024 * 1024; // 256M
+
+private:
+    FILE* file_ = nullptr;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // ROSEN_OHOS
+#endif // ROSEN_RENDER_SERVICE_BASE_RS_TRANSACTION_TRACE_H
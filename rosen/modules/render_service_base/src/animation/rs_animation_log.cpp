@@ -15,10 +15,21 @@
 
 #include "animation/rs_animation_log.h"
 
-#include <cstdarg>
-#include <regex>
-#include <securec.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <sys/stat.h>
 #include <sys/time.h>
+#include <thread>
+#include <unistd.h>
 
 #include "render/rs_blur_filter.h"
 #include "common/rs_color.h"
@@ -28,411 +39,545 @@
 
 namespace OHOS {
 namespace Rosen {
+namespace {
 const std::string ANIMATION_LOG_PATH = "/etc/rosen/";
 const std::string ANIMATION_LOG_FILE_NAME = "Animation";
-const std::string ANIMATION_LOG_FILE_TYPE = ".log";
+const std::string ANIMATION_LOG_FILE_TYPE = ".bin";
 const std::string CONFIG_FILE_NAME = "property.config";
-const std::string COLON_SEPARATOR = ":";
-const std::string COMMA_SEPARATOR = ",";
-const std::string SEMICOLON_SEPARATOR = ";";
 const std::string PROPERTY_TAG = "PROPERTY";
 const std::string NODE_ID_TAG = "ID";
 const std::string ALL_NEED_TAG = "all";
-static constexpr int MIN_INFO_SIZE = 2;
-static constexpr int DATA_INDEX_ZERO = 0;
-static constexpr int DATA_INDEX_ONE = 1;
-static constexpr int DATA_INDEX_TWO = 2;
-static constexpr int DATA_INDEX_THREE = 3;
-static constexpr int DATA_INDEX_FOUR = 4;
-static constexpr int DATA_INDEX_FIVE = 5;
-static constexpr int DATA_INDEX_SIX = 6;
-static constexpr int DATA_INDEX_SEVEN = 7;
-static constexpr int DATA_INDEX_EIGHT = 8;
-static constexpr int MAX_LOG_LENGTH = 2048;
-static constexpr size_t LOG_FILE_MAX_SIZE = 10485760;
-
-std::vector<std::string> SplitStringBySeparator(const std::string& str,
-    const std::string& separator)
+constexpr char COLON_SEPARATOR = ':';
+constexpr char COMMA_SEPARATOR = ',';
+constexpr char SEMICOLON_SEPARATOR = ';';
+constexpr int MIN_INFO_SIZE = 2;
+constexpr int DATA_INDEX_ZERO = 0;
+constexpr int DATA_INDEX_ONE = 1;
+constexpr int DATA_INDEX_TWO = 2;
+constexpr int DATA_INDEX_THREE = 3;
+constexpr int MATRIX3_DATA_SIZE = 9;
+constexpr int VALUE_PRECISION = 6;
+constexpr size_t LOG_FILE_MAX_SIZE = 10485760;
+constexpr uint64_t LOG_FILE_MAGIC = 0x4C415352; // "RSAL"
+constexpr uint64_t LOG_FILE_VERSION = 1;
+// a ring holds CAPACITY records, so a thread may log CAPACITY records per interval without drops
+constexpr std::chrono::milliseconds DRAIN_INTERVAL(50);
+
+std::vector<std::string> SplitStringBySeparator(const std::string& str, char separator)
 {
-    std::regex re(separator);
-    std::sregex_token_iterator pos(str.begin(), str.end(), re, -1);
-    std::sregex_token_iterator endPos;
     std::vector<std::string> result;
-    while (pos != endPos) {
-        result.emplace_back(*pos++);
+    size_t begin = 0;
+    while (true) {
+        size_t end = str.find(separator, begin);
+        result.emplace_back(str.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+        if (end == std::string::npos) {
+            break;
+        }
+        begin = end + 1;
     }
     return result;
 }
 
-RSAnimationLog::RSAnimationLog()
+int64_t GetNowTime()
 {
-    std::string logFilePath = ANIMATION_LOG_PATH + ANIMATION_LOG_FILE_NAME + ANIMATION_LOG_FILE_TYPE;
-    PreProcessLogFile(logFilePath);
-    logFile_ = std::ofstream(logFilePath, std::ios::app);
-    if (!logFile_.is_open()) {
-        ROSEN_LOGI("Open file error:[%s]", logFilePath.c_str());
-        logFile_.close();
-        return;
+    struct timeval start = {};
+    gettimeofday(&start, nullptr);
+    constexpr uint32_t secToUsec = 1000 * 1000;
+    return static_cast<uint64_t>(start.tv_sec) * secToUsec + start.tv_usec;
+}
+
+// nodes and properties selected in the config file, read once per process
+class RSAnimationLogConfig {
+public:
+    static RSAnimationLogConfig& GetInstance()
+    {
+        static RSAnimationLogConfig instance;
+        return instance;
     }
 
-    InitNodeAndPropertyInfo();
-}
+    void Load()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        LoadLocked();
+    }
 
-RSAnimationLog::~RSAnimationLog()
-{
-    logFile_.close();
-}
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loaded_ = true;
+        needWriteAllNode_ = false;
+        needWriteAllProperty_ = false;
+        propertySet_.clear();
+        nodeIdSet_.clear();
+    }
 
-void RSAnimationLog::PreProcessLogFile(const std::string& logFilePath)
-{
-    std::ifstream logFile = std::ifstream(logFilePath.c_str(), std::ios::binary);
-    if (!logFile) {
-        ROSEN_LOGI("Open file err:[%s]", logFilePath.c_str());
-        logFile.close();
-        return;
+    bool IsSelected(const RSAnimatableProperty& property, const NodeId& id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!loaded_) {
+            LoadLocked();
+        }
+        if (propertySet_.find(property) == propertySet_.end() && !needWriteAllProperty_) {
+            return false;
+        }
+        return nodeIdSet_.find(id) != nodeIdSet_.end() || needWriteAllNode_;
     }
 
-    logFile.seekg(0, logFile.end);
-    size_t logFileSize = logFile.tellg();
-    if (logFileSize >= LOG_FILE_MAX_SIZE) {
-        std::string timestampPath = ANIMATION_LOG_PATH + ANIMATION_LOG_FILE_NAME + std::to_string(GetNowTime())
-            + ANIMATION_LOG_FILE_TYPE;
-        std::rename(logFilePath.c_str(), timestampPath.c_str());
+private:
+    RSAnimationLogConfig() = default;
+    ~RSAnimationLogConfig() = default;
+
+    void LoadLocked()
+    {
+        loaded_ = true;
+        std::string configFilePath = ANIMATION_LOG_PATH + CONFIG_FILE_NAME;
+        std::ifstream configFile(configFilePath.c_str());
+        if (!configFile.is_open()) {
+            return;
+        }
+
+        std::string info;
+        while (std::getline(configFile, info)) {
+            DealConfigInputInfo(SplitStringBySeparator(info, SEMICOLON_SEPARATOR).front());
+        }
+        configFile.close();
     }
-    logFile.close();
-}
 
-void RSAnimationLog::InitNodeAndPropertyInfo()
-{
-    std::string configFilePath = ANIMATION_LOG_PATH + CONFIG_FILE_NAME;
-    std::ifstream configFile(configFilePath.c_str());
-    if (!configFile.is_open()) {
-        return;
+    void DealConfigInputInfo(const std::string& info)
+    {
+        std::vector<std::string> splitResult = SplitStringBySeparator(info, COLON_SEPARATOR);
+        if (splitResult.size() != MIN_INFO_SIZE) {
+            return;
+        }
+
+        std::string tag = splitResult.front();
+        if (tag == PROPERTY_TAG) {
+            for (const std::string& prop : SplitStringBySeparator(splitResult.back(), COMMA_SEPARATOR)) {
+                if (prop == ALL_NEED_TAG) {
+                    needWriteAllProperty_ = true;
+                    return;
+                }
+                propertySet_.insert(static_cast<RSAnimatableProperty>(strtoull(prop.c_str(), NULL, 10)));
+            }
+        }
+
+        if (tag == NODE_ID_TAG) {
+            for (const std::string& nodeId : SplitStringBySeparator(splitResult.back(), COMMA_SEPARATOR)) {
+                if (nodeId == ALL_NEED_TAG) {
+                    needWriteAllNode_ = true;
+                    return;
+                }
+                nodeIdSet_.insert(atoll(nodeId.c_str()));
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    bool loaded_ { false };
+    bool needWriteAllNode_ { false };
+    bool needWriteAllProperty_ { false };
+    std::set<NodeId> nodeIdSet_;
+    std::set<RSAnimatableProperty> propertySet_;
+};
+
+// Owns the rings of the threads writing animation logs and the thread appending them to the log file. The log file
+// is written with one append per batch, processes logging to it at the same time don't split each other's records.
+class RSAnimationLogWriter {
+public:
+    static RSAnimationLogWriter& GetInstance()
+    {
+        static RSAnimationLogWriter instance;
+        return instance;
     }
 
-    std::string info;
-    while (std::getline(configFile, info)) {
-        std::vector<std::string> infos = SplitStringBySeparator(info, SEMICOLON_SEPARATOR);
-        if (infos.empty()) {
-            continue;
+    RSAnimationLogRing& GetThreadRing()
+    {
+        // the writer keeps the ring until drained once the thread exited
+        thread_local std::shared_ptr<RSAnimationLogRing> ring;
+        if (ring == nullptr) {
+            ring = std::make_shared<RSAnimationLogRing>();
+            std::lock_guard<std::mutex> lock(mutex_);
+            rings_.push_back({ ring, 0 });
+            if (!thread_.joinable() && !stop_) {
+                thread_ = std::thread(&RSAnimationLogWriter::Run, this);
+            }
         }
-        DealConfigInputInfo(infos.front());
+        return *ring;
     }
-    configFile.close();
-}
 
-void RSAnimationLog::DealConfigInputInfo(const std::string& info)
-{
-    std::vector<std::string> splitResult = SplitStringBySeparator(info, COLON_SEPARATOR);
-    if (splitResult.size() != MIN_INFO_SIZE) {
-        return;
+private:
+    struct RingEntry {
+        std::shared_ptr<RSAnimationLogRing> ring;
+        uint64_t reportedDroppedCount;
+    };
+
+    RSAnimationLogWriter() = default;
+    ~RSAnimationLogWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
     }
 
-    std::string tag = splitResult.front();
-    if (tag == PROPERTY_TAG) {
-        std::vector<std::string> props =
-            SplitStringBySeparator(splitResult.back(), COMMA_SEPARATOR);
-        for (std::string prop: props) {
-            if (prop == ALL_NEED_TAG) {
-                needWriteAllProperty_ = true;
-                return;
+    void Run()
+    {
+        std::vector<RSAnimationLogRecord> records;
+        bool stop = false;
+        while (!stop) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait_for(lock, DRAIN_INTERVAL, [this] { return stop_; });
+                stop = stop_;
+                DrainRings(records);
             }
-            RSAnimatableProperty property =
-                static_cast<RSAnimatableProperty>(strtoull(prop.c_str(), NULL, 10));
-            propertySet_.insert(property);
+            WriteRecords(records);
+            records.clear();
+        }
+        if (logFd_ >= 0) {
+            close(logFd_);
+            logFd_ = -1;
         }
     }
 
-    if (tag == NODE_ID_TAG) {
-        std::vector<std::string> nodeIds =
-            SplitStringBySeparator(splitResult.back(), COMMA_SEPARATOR);
-        for (std::string nodeId : nodeIds) {
-            if (nodeId == ALL_NEED_TAG) {
-                needWriteAllNode_ = true;
-                return;
+    void DrainRings(std::vector<RSAnimationLogRecord>& records)
+    {
+        for (auto it = rings_.begin(); it != rings_.end();) {
+            // the thread is gone when the writer holds the last reference, nothing can be pushed after this drain
+            bool threadExited = it->ring.use_count() == 1;
+            it->ring->Drain(records);
+            uint64_t droppedCount = it->ring->GetDroppedCount();
+            if (droppedCount != it->reportedDroppedCount) {
+                RSAnimationLogRecord record;
+                record.kind = RSAnimationLogRecordKind::DROPPED;
+                record.time = GetNowTime();
+                record.id = droppedCount - it->reportedDroppedCount;
+                records.push_back(record);
+                it->reportedDroppedCount = droppedCount;
             }
-            auto id = atoll(nodeId.c_str());
-            nodeIdSet_.insert(id);
+            it = threadExited ? rings_.erase(it) : it + 1;
         }
     }
-}
 
-void RSAnimationLog::ClearNodeAndPropertyInfo()
-{
-    propertySet_.clear();
-    nodeIdSet_.clear();
-}
+    bool OpenLogFile()
+    {
+        std::string logFilePath = ANIMATION_LOG_PATH + ANIMATION_LOG_FILE_NAME + ANIMATION_LOG_FILE_TYPE;
+        struct stat fileStat = {};
+        if (stat(logFilePath.c_str(), &fileStat) == 0 && static_cast<size_t>(fileStat.st_size) >= LOG_FILE_MAX_SIZE) {
+            std::string timestampPath = ANIMATION_LOG_PATH + ANIMATION_LOG_FILE_NAME + std::to_string(GetNowTime()) +
+                ANIMATION_LOG_FILE_TYPE;
+            std::rename(logFilePath.c_str(), timestampPath.c_str());
+        }
 
-bool RSAnimationLog::IsNeedWriteLog(const RSAnimatableProperty& property, const NodeId& id)
-{
-    auto itrp = propertySet_.find(property);
-    if (itrp == propertySet_.end() && !needWriteAllProperty_) {
-        return false;
+        logFd_ = open(logFilePath.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP);
+        if (logFd_ < 0) {
+            ROSEN_LOGI("Open file error:[%s]", logFilePath.c_str());
+            return false;
+        }
+        if (fstat(logFd_, &fileStat) == 0 && fileStat.st_size == 0) {
+            RSAnimationLogRecord header;
+            header.kind = RSAnimationLogRecordKind::FILE_HEADER;
+            header.id = LOG_FILE_MAGIC;
+            header.property = LOG_FILE_VERSION;
+            header.reserved2 = sizeof(RSAnimationLogRecord);
+            header.time = GetNowTime();
+            write(logFd_, &header, sizeof(header));
+        }
+        return true;
     }
 
-    auto itrn = nodeIdSet_.find(id);
-    if (itrn == nodeIdSet_.end() && !needWriteAllNode_) {
-        return false;
+    void WriteRecords(const std::vector<RSAnimationLogRecord>& records)
+    {
+        if (records.empty()) {
+            return;
+        }
+        if (logFd_ < 0) {
+            if (openFailed_ || !OpenLogFile()) {
+                openFailed_ = true;
+                return;
+            }
+        }
+
+        size_t size = records.size() * sizeof(RSAnimationLogRecord);
+        if (write(logFd_, records.data(), size) != static_cast<ssize_t>(size)) {
+            ROSEN_LOGE("RSAnimationLogWriter::WriteRecords, write %zu records failed", records.size());
+        }
+        struct stat fileStat = {};
+        if (fstat(logFd_, &fileStat) == 0 && static_cast<size_t>(fileStat.st_size) >= LOG_FILE_MAX_SIZE) {
+            // the next batch rotates the file
+            close(logFd_);
+            logFd_ = -1;
+        }
     }
 
-    return true;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool stop_ { false };
+    std::thread thread_;
+    std::vector<RingEntry> rings_;
+    // used by the writer thread only
+    int logFd_ { -1 };
+    bool openFailed_ { false };
+};
+
+RSAnimationLogValueType EncodeValue(const int& value, float* data, uint8_t& count)
+{
+    // bit copy, a float would round large ints
+    std::memcpy(data, &value, sizeof(value));
+    count = 1;
+    return RSAnimationLogValueType::INT;
 }
 
-int64_t RSAnimationLog::GetNowTime()
+RSAnimationLogValueType EncodeValue(const float& value, float* data, uint8_t& count)
 {
-    struct timeval start = {};
-    gettimeofday(&start, nullptr);
-    constexpr uint32_t secToUsec = 1000 * 1000;
-    return static_cast<uint64_t>(start.tv_sec) * secToUsec + start.tv_usec;
+    data[0] = value;
+    count = 1;
+    return RSAnimationLogValueType::FLOAT;
 }
 
-void RSAnimationLog::WriteString(const std::string& log)
+void EncodeColor(const Color& value, float* data)
 {
-    if (logFile_.is_open()) {
-        logFile_.write(log.c_str(), log.size());
-        logFile_.flush();
-    }
+    data[DATA_INDEX_ZERO] = value.GetRed();
+    data[DATA_INDEX_ONE] = value.GetGreen();
+    data[DATA_INDEX_TWO] = value.GetBlue();
+    data[DATA_INDEX_THREE] = value.GetAlpha();
 }
 
-int RSAnimationLog::WriteLog(const char* format, ...)
+RSAnimationLogValueType EncodeValue(const Color& value, float* data, uint8_t& count)
 {
-    char logStr[MAX_LOG_LENGTH] = {0};
-    va_list args;
-    va_start(args, format);
-    int ret = vsprintf_s(logStr, MAX_LOG_LENGTH, format, args);
-    if (ret == -1) {
-        va_end(args);
-        return -1;
-    }
-
-    WriteString(logStr);
-    va_end(args);
-    return 0;
+    EncodeColor(value, data);
+    count = DATA_INDEX_THREE + 1;
+    return RSAnimationLogValueType::COLOR;
 }
 
-#define WRITE_LOG(format, ...)                \
-    do {                                      \
-        WriteLog(format, ##__VA_ARGS__);      \
-    } while (0)
-
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const int& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+RSAnimationLogValueType EncodeValue(const Matrix3f& value, float* data, uint8_t& count)
 {
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} value:{%d}\n",
-        id, GetNowTime(), property, value);
+    std::memcpy(data, value.GetConstData(), MATRIX3_DATA_SIZE * sizeof(float));
+    count = MATRIX3_DATA_SIZE;
+    return RSAnimationLogValueType::MATRIX3F;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const int& startValue, const int& endValue)
+RSAnimationLogValueType EncodeValue(const Vector2f& value, float* data, uint8_t& count)
 {
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%d} endValue:{%d}\n", id, GetNowTime(), property, startValue, endValue);
+    data[DATA_INDEX_ZERO] = value.x_;
+    data[DATA_INDEX_ONE] = value.y_;
+    count = DATA_INDEX_ONE + 1;
+    return RSAnimationLogValueType::VECTOR2F;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const float& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+RSAnimationLogValueType EncodeValue(const Vector4f& value, float* data, uint8_t& count)
 {
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} value:{%f}\n",
-        id, GetNowTime(), property, value);
+    for (int i = 0; i <= DATA_INDEX_THREE; i++) {
+        data[i] = value[i];
+    }
+    count = DATA_INDEX_THREE + 1;
+    return RSAnimationLogValueType::VECTOR4F;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const float& startValue, const float& endValue)
+RSAnimationLogValueType EncodeValue(const Quaternion& value, float* data, uint8_t& count)
 {
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%f} endValue:{%f}\n", id, GetNowTime(), property, startValue, endValue);
+    for (int i = 0; i <= DATA_INDEX_THREE; i++) {
+        data[i] = value[i];
+    }
+    count = DATA_INDEX_THREE + 1;
+    return RSAnimationLogValueType::QUATERNION;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const Color& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+RSAnimationLogValueType EncodeValue(const std::shared_ptr<RSFilter>& value, float* data, uint8_t& count)
 {
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-        "value:{%d %d %d %d}\n", id, GetNowTime(), property, value.GetRed(),
-        value.GetGreen(), value.GetBlue(), value.GetAlpha());
+    auto filter = std::static_pointer_cast<RSBlurFilter>(value);
+    count = 0;
+    if (filter != nullptr) {
+        data[DATA_INDEX_ZERO] = filter->GetBlurRadiusX();
+        data[DATA_INDEX_ONE] = filter->GetBlurRadiusY();
+        count = DATA_INDEX_ONE + 1;
+    }
+    return RSAnimationLogValueType::FILTER;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const Color& startValue, const Color& endValue)
+RSAnimationLogValueType EncodeValue(const Vector4<Color>& value, float* data, uint8_t& count)
 {
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%d %d %d %d} endValue:{%d %d %d %d}\n", id, GetNowTime(), property,
-        startValue.GetRed(), startValue.GetGreen(), startValue.GetBlue(),
-        startValue.GetAlpha(), endValue.GetRed(), endValue.GetGreen(), endValue.GetBlue(),
-        endValue.GetAlpha());
+    constexpr int colorSize = DATA_INDEX_THREE + 1;
+    for (int i = 0; i < colorSize; i++) {
+        EncodeColor(value[i], data + i * colorSize);
+    }
+    count = colorSize * colorSize;
+    return RSAnimationLogValueType::VECTOR4_COLOR;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const Matrix3f& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+void DecodeValue(std::ostringstream& out, const RSAnimationLogRecord& record, size_t offset)
 {
-    auto data = value.GetConstData();
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-        "value:{%d %d %d %d %d %d %d %d %d}\n", id, GetNowTime(), property,
-        data[DATA_INDEX_ZERO], data[DATA_INDEX_ONE], data[DATA_INDEX_TWO],
-        data[DATA_INDEX_THREE], data[DATA_INDEX_FOUR], data[DATA_INDEX_FIVE],
-        data[DATA_INDEX_SIX], data[DATA_INDEX_SEVEN], data[DATA_INDEX_EIGHT]);
+    out << "{";
+    if (record.valueCount == 0) {
+        out << "nullptr";
+    }
+    for (size_t i = offset; i < offset + record.valueCount; i++) {
+        out << (i == offset ? "" : " ");
+        switch (record.valueType) {
+            case RSAnimationLogValueType::INT: {
+                int value = 0;
+                std::memcpy(&value, &record.values[i], sizeof(value));
+                out << value;
+                break;
+            }
+            case RSAnimationLogValueType::COLOR:
+            case RSAnimationLogValueType::VECTOR4_COLOR:
+                out << static_cast<int>(record.values[i]);
+                break;
+            default:
+                out << record.values[i];
+                break;
+        }
+    }
+    out << "}";
 }
+} // namespace
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const Matrix3f& startValue, const Matrix3f& endValue)
+bool RSAnimationLogRing::Push(const RSAnimationLogRecord& record)
 {
-    auto startData = startValue.GetConstData();
-    auto endData = endValue.GetConstData();
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%d %d %d %d %d %d %d %d %d} endValue:{%d %d %d %d %d %d %d %d %d}\n",
-        id, GetNowTime(), property, startData[DATA_INDEX_ZERO], startData[DATA_INDEX_ONE],
-        startData[DATA_INDEX_TWO], startData[DATA_INDEX_THREE], startData[DATA_INDEX_FOUR],
-        startData[DATA_INDEX_FIVE], startData[DATA_INDEX_SIX], startData[DATA_INDEX_SEVEN],
-        startData[DATA_INDEX_EIGHT], endData[DATA_INDEX_ZERO], endData[DATA_INDEX_ONE],
-        endData[DATA_INDEX_TWO], endData[DATA_INDEX_THREE], endData[DATA_INDEX_FOUR],
-        endData[DATA_INDEX_FIVE], endData[DATA_INDEX_SIX], endData[DATA_INDEX_SEVEN],
-        endData[DATA_INDEX_EIGHT]);
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= CAPACITY) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    records_[tail % CAPACITY] = record;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const Vector2f& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+size_t RSAnimationLogRing::Drain(std::vector<RSAnimationLogRecord>& records)
 {
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-        "value:{%f %f}\n", id, GetNowTime(), property, value.x_, value.y_);
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t tail = tail_.load(std::memory_order_acquire);
+    for (uint32_t i = head; i != tail; i++) {
+        records.push_back(records_[i % CAPACITY]);
+    }
+    head_.store(tail, std::memory_order_release);
+    return tail - head;
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const Vector2f& startValue, const Vector2f& endValue)
+RSAnimationLog::RSAnimationLog() = default;
+
+RSAnimationLog::~RSAnimationLog() = default;
+
+void RSAnimationLog::InitNodeAndPropertyInfo()
 {
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%f %f} endValue:{%f %f}\n", id, GetNowTime(), property,
-        startValue.x_, startValue.y_, endValue.x_, endValue.y_);
+    RSAnimationLogConfig::GetInstance().Load();
 }
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const Vector4f& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+void RSAnimationLog::ClearNodeAndPropertyInfo()
 {
-    auto data = value;
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-        "value:{%f %f %f %f}\n", id, GetNowTime(), property, data[DATA_INDEX_ZERO],
-        data[DATA_INDEX_ONE], data[DATA_INDEX_TWO], data[DATA_INDEX_THREE]);
+    RSAnimationLogConfig::GetInstance().Clear();
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const Vector4f& startValue, const Vector4f& endValue)
+bool RSAnimationLog::IsNeedWriteLog(const RSAnimatableProperty& property, const NodeId& id)
 {
-    auto startData = startValue;
-    auto endData = endValue;
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%f %f %f %f} endValue:{%f %f %f %f}\n", id, GetNowTime(), property,
-        startData[DATA_INDEX_ZERO], startData[DATA_INDEX_ONE], startData[DATA_INDEX_TWO],
-        startData[DATA_INDEX_THREE], endData[DATA_INDEX_ZERO], endData[DATA_INDEX_ONE],
-        endData[DATA_INDEX_TWO], endData[DATA_INDEX_THREE]);
+    return RSAnimationLogConfig::GetInstance().IsSelected(property, id);
 }
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const Quaternion& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+void RSAnimationLog::WriteRecord(const RSAnimationLogRecord& record)
 {
-    auto data = value;
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-        "value:{%f %f %f %f}\n", id, GetNowTime(), property, data[DATA_INDEX_ZERO],
-        data[DATA_INDEX_ONE], data[DATA_INDEX_TWO], data[DATA_INDEX_THREE]);
+    RSAnimationLogWriter::GetInstance().GetThreadRing().Push(record);
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const Quaternion& startValue, const Quaternion& endValue)
+template<typename T>
+void RSAnimationLog::WriteAnimationValueToLog(const T& value, const RSAnimatableProperty& property, const NodeId& id)
 {
-    auto startData = startValue;
-    auto endData = endValue;
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%f %f %f %f} endValue:{%f %f %f %f}\n", id, GetNowTime(), property,
-        startData[DATA_INDEX_ZERO], startData[DATA_INDEX_ONE], startData[DATA_INDEX_TWO],
-        startData[DATA_INDEX_THREE], endData[DATA_INDEX_ZERO], endData[DATA_INDEX_ONE],
-        endData[DATA_INDEX_TWO], endData[DATA_INDEX_THREE]);
+    RSAnimationLogRecord record;
+    record.kind = RSAnimationLogRecordKind::VALUE;
+    record.time = GetNowTime();
+    record.id = id;
+    record.property = static_cast<uint64_t>(property);
+    record.valueType = EncodeValue(value, record.values, record.valueCount);
+    WriteRecord(record);
 }
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const std::shared_ptr<RSFilter>& value,
-    const RSAnimatableProperty& property, const NodeId& id)
+template<typename T>
+void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property, const AnimationId& id,
+    const T& startValue, const T& endValue)
 {
-    auto filter = std::static_pointer_cast<RSBlurFilter>(value);
-    if (filter == nullptr) {
-        WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-            "value:{nullptr}\n", id, GetNowTime(), property);
-        return;
-    }
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} value:{%f %f}\n",
-        id, GetNowTime(), property, filter->GetBlurRadiusX(), filter->GetBlurRadiusY());
+    RSAnimationLogRecord record;
+    record.kind = RSAnimationLogRecordKind::INFO;
+    record.time = GetNowTime();
+    record.id = id;
+    record.property = static_cast<uint64_t>(property);
+    uint8_t startCount = 0;
+    uint8_t endCount = 0;
+    record.valueType = EncodeValue(startValue, record.values, startCount);
+    EncodeValue(endValue, record.values + startCount, endCount);
+    // a null filter on either side logs both as null
+    record.valueCount = startCount == endCount ? startCount : 0;
+    WriteRecord(record);
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const std::shared_ptr<RSFilter>& startValue,
-    const std::shared_ptr<RSFilter>& endValue)
+#define INSTANTIATE_ANIMATION_LOG(T)                                                                \
+    template void RSAnimationLog::WriteAnimationValueToLog(const T& value,                          \
+        const RSAnimatableProperty& property, const NodeId& id);                                    \
+    template void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,     \
+        const AnimationId& id, const T& startValue, const T& endValue)
+
+INSTANTIATE_ANIMATION_LOG(int);
+INSTANTIATE_ANIMATION_LOG(float);
+INSTANTIATE_ANIMATION_LOG(Color);
+INSTANTIATE_ANIMATION_LOG(Matrix3f);
+INSTANTIATE_ANIMATION_LOG(Vector2f);
+INSTANTIATE_ANIMATION_LOG(Vector4f);
+INSTANTIATE_ANIMATION_LOG(Quaternion);
+INSTANTIATE_ANIMATION_LOG(std::shared_ptr<RSFilter>);
+INSTANTIATE_ANIMATION_LOG(Vector4<Color>);
+
+std::string RSAnimationLog::DecodeRecord(const RSAnimationLogRecord& record)
 {
-    auto startFilter = std::static_pointer_cast<RSBlurFilter>(startValue);
-    auto endFilter = std::static_pointer_cast<RSBlurFilter>(endValue);
-    if (startFilter == nullptr || endFilter == nullptr) {
-        WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-            "startValue:{nullptr} endValue:{nullptr}\n", id, GetNowTime(), property);
-        return;
+    size_t valueSlots = record.kind == RSAnimationLogRecordKind::INFO ? 2 * record.valueCount : record.valueCount;
+    if (valueSlots > RSAnimationLogRecord::MAX_VALUES) {
+        return "";
     }
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%f %f} endValue:{%f %f}\n", id, GetNowTime(), property,
-        startFilter->GetBlurRadiusX(), startFilter->GetBlurRadiusY(),
-        endFilter->GetBlurRadiusX(), endFilter->GetBlurRadiusY());
-}
 
-template<>
-void RSAnimationLog::WriteAnimationValueToLog(const Vector4<Color>& value,
-    const RSAnimatableProperty& property, const NodeId& id)
-{
-    auto data = value;
-    WRITE_LOG("RSAnimationValueLog NodeId:{%llu} time:{%lld} property:{%llu} " \
-        "value:{%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d}\n", id, GetNowTime(),
-        property, data[DATA_INDEX_ZERO].GetRed(), data[DATA_INDEX_ZERO].GetGreen(),
-        data[DATA_INDEX_ZERO].GetBlue(), data[DATA_INDEX_ZERO].GetAlpha(),
-        data[DATA_INDEX_ONE].GetRed(), data[DATA_INDEX_ONE].GetGreen(),
-        data[DATA_INDEX_ONE].GetBlue(), data[DATA_INDEX_ONE].GetAlpha(),
-        data[DATA_INDEX_TWO].GetRed(), data[DATA_INDEX_TWO].GetGreen(),
-        data[DATA_INDEX_TWO].GetBlue(), data[DATA_INDEX_TWO].GetAlpha(),
-        data[DATA_INDEX_THREE].GetRed(), data[DATA_INDEX_THREE].GetGreen(),
-        data[DATA_INDEX_THREE].GetBlue(), data[DATA_INDEX_THREE].GetAlpha());
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(VALUE_PRECISION);
+    switch (record.kind) {
+        case RSAnimationLogRecordKind::VALUE:
+            out << "RSAnimationValueLog NodeId:{" << record.id << "} time:{" << record.time << "} property:{" <<
+                record.property << "} value:";
+            DecodeValue(out, record, 0);
+            break;
+        case RSAnimationLogRecordKind::INFO:
+            out << "RSAnimationInfoLog AnimationId:{" << record.id << "} time:{" << record.time << "} property:{" <<
+                record.property << "} startValue:";
+            DecodeValue(out, record, 0);
+            out << " endValue:";
+            DecodeValue(out, record, record.valueCount);
+            break;
+        case RSAnimationLogRecordKind::DROPPED:
+            out << "RSAnimationLogDropped time:{" << record.time << "} count:{" << record.id << "}";
+            break;
+        default:
+            return "";
+    }
+    out << "\n";
+    return out.str();
 }
 
-template<>
-void RSAnimationLog::WriteAnimationInfoToLog(const RSAnimatableProperty& property,
-    const AnimationId& id, const Vector4<Color>& startValue, const Vector4<Color>& endValue)
+bool RSAnimationLog::DecodeLogFile(const std::string& logFilePath, std::ostream& out)
 {
-    auto startData = startValue;
-    auto endData = endValue;
-    WRITE_LOG("RSAnimationInfoLog AnimationId:{%llu} time:{%lld} property:{%llu} " \
-        "startValue:{%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d} " \
-        "endValue:{%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d}\n", id, GetNowTime(), property,
-        startData[DATA_INDEX_ZERO].GetRed(), startData[DATA_INDEX_ZERO].GetGreen(),
-        startData[DATA_INDEX_ZERO].GetBlue(), startData[DATA_INDEX_ZERO].GetAlpha(),
-        startData[DATA_INDEX_ONE].GetRed(), startData[DATA_INDEX_ONE].GetGreen(),
-        startData[DATA_INDEX_ONE].GetBlue(), startData[DATA_INDEX_ONE].GetAlpha(),
-        startData[DATA_INDEX_TWO].GetRed(), startData[DATA_INDEX_TWO].GetGreen(),
-        startData[DATA_INDEX_TWO].GetBlue(), startData[DATA_INDEX_TWO].GetAlpha(),
-        startData[DATA_INDEX_THREE].GetRed(), startData[DATA_INDEX_THREE].GetGreen(),
-        startData[DATA_INDEX_THREE].GetBlue(), startData[DATA_INDEX_THREE].GetAlpha(),
-        endData[DATA_INDEX_ZERO].GetRed(), endData[DATA_INDEX_ZERO].GetGreen(),
-        endData[DATA_INDEX_ZERO].GetBlue(), endData[DATA_INDEX_ZERO].GetAlpha(),
-        endData[DATA_INDEX_ONE].GetRed(), endData[DATA_INDEX_ONE].GetGreen(),
-        endData[DATA_INDEX_ONE].GetBlue(), endData[DATA_INDEX_ONE].GetAlpha(),
-        endData[DATA_INDEX_TWO].GetRed(), endData[DATA_INDEX_TWO].GetGreen(),
-        endData[DATA_INDEX_TWO].GetBlue(), endData[DATA_INDEX_TWO].GetAlpha(),
-        endData[DATA_INDEX_THREE].GetRed(), endData[DATA_INDEX_THREE].GetGreen(),
-        endData[DATA_INDEX_THREE].GetBlue(), endData[DATA_INDEX_THREE].GetAlpha());
+    std::ifstream logFile(logFilePath, std::ios::binary);
+    RSAnimationLogRecord record;
+    if (!logFile.read(reinterpret_cast<char*>(&record), sizeof(record)) ||
+        record.kind != RSAnimationLogRecordKind::FILE_HEADER || record.id != LOG_FILE_MAGIC ||
+        record.property != LOG_FILE_VERSION || record.reserved2 != sizeof(RSAnimationLogRecord)) {
+        ROSEN_LOGE("RSAnimationLog::DecodeLogFile, %s is no animation log", logFilePath.c_str());
+        return false;
+    }
+    while (logFile.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        if (record.kind != RSAnimationLogRecordKind::FILE_HEADER) {
+            out << DecodeRecord(record);
+        }
+    }
+    return true;
 }
 } // namespace Rosen
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -133,6 +133,21 @@ void RSRenderAnimation::Finish()
     ProcessFillModeOnFinish(animationFraction_.GetEndFraction());
 }
 
+void RSRenderAnimation::FinishProperty(RSAnimatableProperty property)
+{
+    if (GetProperty() == property) {
+        Finish();
+        return;
+    }
+
+    if (!IsPaused() && !IsRunning()) {
+        ROSEN_LOGE("Failed to finish animation property, animation is not running!");
+        return;
+    }
+
+    OnFinishProperty(property);
+}
+
 void RSRenderAnimation::Pause()
 {
     if (!IsRunning()) {
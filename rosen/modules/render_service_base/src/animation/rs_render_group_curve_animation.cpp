@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "animation/rs_render_group_curve_animation.h"
+
+#include "platform/common/rs_log.h"
+#include "transaction/rs_marshalling_helper.h"
+
+namespace OHOS {
+namespace Rosen {
+#ifdef ROSEN_OHOS
+namespace {
+template<typename T>
+bool MarshallingAnimation(Parcel& parcel, const std::shared_ptr<RSRenderAnimation>& animation)
+{
+    return RSMarshallingHelper::Marshalling(parcel, std::static_pointer_cast<RSRenderCurveAnimation<T>>(animation));
+}
+
+template<typename T>
+std::shared_ptr<RSRenderAnimation> UnmarshallingAnimation(Parcel& parcel)
+{
+    std::shared_ptr<RSRenderCurveAnimation<T>> animation;
+    if (!RSMarshallingHelper::Unmarshalling(parcel, animation)) {
+        return nullptr;
+    }
+    return animation;
+}
+} // namespace
+#endif
+
+RSRenderGroupCurveAnimation::RSRenderGroupCurveAnimation(AnimationId id) : RSRenderAnimation(id) {}
+
+RSAnimatableProperty RSRenderGroupCurveAnimation::GetProperty() const
+{
+    unsigned long long property = 0;
+    for (const auto& [type, animation] : animations_) {
+        property |= static_cast<unsigned long long>(animation->GetProperty());
+    }
+    return static_cast<RSAnimatableProperty>(property);
+}
+
+#ifdef ROSEN_OHOS
+bool RSRenderGroupCurveAnimation::Marshalling(Parcel& parcel) const
+{
+    if (!RSRenderAnimation::Marshalling(parcel)) {
+        ROSEN_LOGE("RSRenderGroupCurveAnimation::Marshalling, RenderAnimation failed");
+        return false;
+    }
+    if (!parcel.WriteUint32(animations_.size())) {
+        ROSEN_LOGE("RSRenderGroupCurveAnimation::Marshalling, write size failed");
+        return false;
+    }
+    for (const auto& [type, animation] : animations_) {
+        bool success = parcel.WriteUint16(type);
+        switch (type) {
+            case INT:
+                success = success && MarshallingAnimation<int>(parcel, animation);
+                break;
+            case FLOAT:
+                success = success && MarshallingAnimation<float>(parcel, animation);
+                break;
+            case COLOR:
+                success = success && MarshallingAnimation<Color>(parcel, animation);
+                break;
+            case MATRIX3F:
+                success = success && MarshallingAnimation<Matrix3f>(parcel, animation);
+                break;
+            case VEC2F:
+                success = success && MarshallingAnimation<Vector2f>(parcel, animation);
+                break;
+            case VEC4F:
+                success = success && MarshallingAnimation<Vector4f>(parcel, animation);
+                break;
+            case QUATERNION:
+                success = success && MarshallingAnimation<Quaternion>(parcel, animation);
+                break;
+            case FILTER:
+                success = success && MarshallingAnimation<std::shared_ptr<RSFilter>>(parcel, animation);
+                break;
+            case VEC4_COLOR:
+                success = success && MarshallingAnimation<Vector4<Color>>(parcel, animation);
+                break;
+            default:
+                success = false;
+                break;
+        }
+        if (!success) {
+            ROSEN_LOGE("RSRenderGroupCurveAnimation::Marshalling, write animation failed");
+            return false;
+        }
+    }
+    return true;
+}
+
+RSRenderGroupCurveAnimation* RSRenderGroupCurveAnimation::Unmarshalling(Parcel& parcel)
+{
+    RSRenderGroupCurveAnimation* renderGroupCurveAnimation = new RSRenderGroupCurveAnimation();
+    if (!renderGroupCurveAnimation->ParseParam(parcel)) {
+        ROSEN_LOGE("RSRenderGroupCurveAnimation::Unmarshalling, ParseParam Failed");
+        delete renderGroupCurveAnimation;
+        return nullptr;
+    }
+    return renderGroupCurveAnimation;
+}
+
+bool RSRenderGroupCurveAnimation::ParseParam(Parcel& parcel)
+{
+    if (!RSRenderAnimation::ParseParam(parcel)) {
+        ROSEN_LOGE("RSRenderGroupCurveAnimation::ParseParam, RenderAnimation failed");
+        return false;
+    }
+    uint32_t size = 0;
+    if (!parcel.ReadUint32(size)) {
+        ROSEN_LOGE("RSRenderGroupCurveAnimation::ParseParam, read size failed");
+        return false;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        uint16_t type = 0;
+        if (!parcel.ReadUint16(type)) {
+            ROSEN_LOGE("RSRenderGroupCurveAnimation::ParseParam, read type failed");
+            return false;
+        }
+        std::shared_ptr<RSRenderAnimation> animation;
+        switch (type) {
+            case INT:
+                animation = UnmarshallingAnimation<int>(parcel);
+                break;
+            case FLOAT:
+                animation = UnmarshallingAnimation<float>(parcel);
+                break;
+            case COLOR:
+                animation = UnmarshallingAnimation<Color>(parcel);
+                break;
+            case MATRIX3F:
+                animation = UnmarshallingAnimation<Matrix3f>(parcel);
+                break;
+            case VEC2F:
+                animation = UnmarshallingAnimation<Vector2f>(parcel);
+                break;
+            case VEC4F:
+                animation = UnmarshallingAnimation<Vector4f>(parcel);
+                break;
+            case QUATERNION:
+                animation = UnmarshallingAnimation<Quaternion>(parcel);
+                break;
+            case FILTER:
+                animation = UnmarshallingAnimation<std::shared_ptr<RSFilter>>(parcel);
+                break;
+            case VEC4_COLOR:
+                animation = UnmarshallingAnimation<Vector4<Color>>(parcel);
+                break;
+            default:
+                break;
+        }
+        if (animation == nullptr) {
+            ROSEN_LOGE("RSRenderGroupCurveAnimation::ParseParam, read animation failed");
+            return false;
+        }
+        animations_.emplace_back(type, animation);
+    }
+    return true;
+}
+#endif
+
+void RSRenderGroupCurveAnimation::OnSetFraction(float fraction)
+{
+    for (const auto& [type, animation] : animations_) {
+        animation->OnSetFraction(fraction);
+    }
+    SetFractionInner(fraction);
+}
+
+void RSRenderGroupCurveAnimation::OnAttach()
+{
+    for (const auto& [type, animation] : animations_) {
+        animation->Attach(GetTarget());
+    }
+}
+
+void RSRenderGroupCurveAnimation::OnDetach()
+{
+    for (const auto& [type, animation] : animations_) {
+        animation->Detach();
+    }
+}
+
+void RSRenderGroupCurveAnimation::OnAnimate(float fraction)
+{
+    for (const auto& [type, animation] : animations_) {
+        animation->OnAnimate(fraction);
+    }
+}
+
+void RSRenderGroupCurveAnimation::OnRemoveOnCompletion()
+{
+    for (const auto& [type, animation] : animations_) {
+        animation->OnRemoveOnCompletion();
+    }
+}
+
+void RSRenderGroupCurveAnimation::OnFinishProperty(RSAnimatableProperty property)
+{
+    // the animations of the other properties keep running with the group
+    auto iter = animations_.begin();
+    while (iter != animations_.end()) {
+        auto& animation = iter->second;
+        if (animation->GetProperty() != property) {
+            ++iter;
+            continue;
+        }
+        animation->ProcessFillModeOnFinish(animationFraction_.GetEndFraction());
+        animation->Detach();
+        iter = animations_.erase(iter);
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -15,8 +15,44 @@
 
 #include "command/rs_node_command.h"
 
+#include "platform/common/rs_log.h"
+
 namespace OHOS {
 namespace Rosen {
+namespace {
+template<typename T>
+void ApplyDelta(RSProperties& properties, uint16_t type, const T& delta)
+{
+    // the setter and getter of every delta command, as the command would apply the delta
+    switch (type) {
+#define DECLARE_SET_COMMAND(COMMAND_NAME, SUBCOMMAND, TYPE, SETTER)
+#define DECLARE_DELTA_COMMAND(COMMAND_NAME, SUBCOMMAND, TYPE, SETTER, GETTER) \
+        case SUBCOMMAND:                                                      \
+            if constexpr (std::is_same_v<T, TYPE>) {                          \
+                properties.SETTER(properties.GETTER() + delta);               \
+            }                                                                 \
+            break;
+
+#include "command/rs_node_command.in"
+
+#undef DECLARE_SET_COMMAND
+#undef DECLARE_DELTA_COMMAND
+        default:
+            ROSEN_LOGE("ApplyDelta, unknown delta type %d", type);
+            break;
+    }
+}
+} // namespace
 
+void RSRenderNodeCommandHelper::ApplyDeltaBundle(
+    RSContext& context, NodeId nodeId, const std::shared_ptr<RSNodeDeltaBundle>& bundle)
+{
+    auto node = context.GetNodeMap().GetRenderNode<RSRenderNode>(nodeId);
+    if (node == nullptr || bundle == nullptr) {
+        return;
+    }
+    auto& properties = node->GetMutableRenderProperties();
+    bundle->ForEachDelta([&properties](uint16_t type, const auto& delta) { ApplyDelta(properties, type, delta); });
+}
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "command/rs_node_delta_bundle.h"
+
+#include "platform/common/rs_log.h"
+#include "transaction/rs_marshalling_helper.h"
+
+namespace OHOS {
+namespace Rosen {
+size_t RSNodeDeltaBundle::GetDeltaCount() const
+{
+    return std::apply([](const auto&... deltas) { return (deltas.size() + ...); }, deltas_);
+}
+
+#ifdef ROSEN_OHOS
+bool RSNodeDeltaBundle::Marshalling(Parcel& parcel) const
+{
+    auto marshallingDeltas = [&parcel](const auto& deltas) {
+        bool success = parcel.WriteUint32(deltas.size());
+        for (const auto& [type, delta] : deltas) {
+            success = success && RSMarshallingHelper::Marshalling(parcel, type) &&
+                RSMarshallingHelper::Marshalling(parcel, delta);
+        }
+        return success;
+    };
+    if (!std::apply([&marshallingDeltas](const auto&... deltas) { return (marshallingDeltas(deltas) && ...); },
+        deltas_)) {
+        ROSEN_LOGE("RSNodeDeltaBundle::Marshalling, write deltas failed");
+        return false;
+    }
+    return true;
+}
+
+RSNodeDeltaBundle* RSNodeDeltaBundle::Unmarshalling(Parcel& parcel)
+{
+    auto unmarshallingDeltas = [&parcel](auto& deltas) {
+        uint32_t size = 0;
+        if (!parcel.ReadUint32(size)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < size; i++) {
+            typename std::remove_reference_t<decltype(deltas)>::value_type item;
+            if (!(RSMarshallingHelper::Unmarshalling(parcel, item.first) &&
+                RSMarshallingHelper::Unmarshalling(parcel, item.second))) {
+                return false;
+            }
+            deltas.emplace_back(std::move(item));
+        }
+        return true;
+    };
+    RSNodeDeltaBundle* bundle = new RSNodeDeltaBundle();
+    if (!std::apply([&unmarshallingDeltas](auto&... deltas) { return (unmarshallingDeltas(deltas) && ...); },
+        bundle->deltas_)) {
+        ROSEN_LOGE("RSNodeDeltaBundle::Unmarshalling, read deltas failed");
+        delete bundle;
+        return nullptr;
+    }
+    return bundle;
+}
+#endif
+} // namespace Rosen
+} // namespace OHOS
@@ -16,23 +16,45 @@
 #include "pipeline/rs_canvas_render_node.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #ifdef ROSEN_OHOS
 #include "common/rs_obj_abs_geometry.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
 #include "pipeline/rs_paint_filter_canvas.h"
 #include "property/rs_properties_painter.h"
 #include "render/rs_blur_filter.h"
 #endif
+#include "pipeline/rs_draw_cmd_list.h"
+#include "pipeline/rs_subtree_cache_manager.h"
 #include "platform/common/rs_log.h"
 #include "visitor/rs_node_visitor.h"
 
 namespace OHOS {
 namespace Rosen {
+namespace {
+// every node costs a little to replay, even without recorded content (save, concat, background)
+constexpr int NODE_BASE_COST = 1;
+constexpr int BYTES_PER_PIXEL = 4;
+constexpr float CACHE_SCALE_TOLERANCE = 1.05f;
+
+#ifdef ROSEN_OHOS
+bool RectContains(const RectI& outer, const RectI& inner)
+{
+    return inner.left_ >= outer.left_ && inner.top_ >= outer.top_ && inner.GetRight() <= outer.GetRight() &&
+        inner.GetBottom() <= outer.GetBottom();
+}
+#endif
+}
 
 RSCanvasRenderNode::RSCanvasRenderNode(NodeId id, std::weak_ptr<RSContext> context) : RSRenderNode(id, context) {}
 
-RSCanvasRenderNode::~RSCanvasRenderNode() {}
+RSCanvasRenderNode::~RSCanvasRenderNode()
+{
+    ReleaseSubtreeCache();
+}
 
 void RSCanvasRenderNode::UpdateRecording(std::shared_ptr<DrawCmdList> drawCmds, bool drawContentLast)
 {
@@ -68,7 +90,21 @@ void RSCanvasRenderNode::ProcessRenderBeforeChildren(RSPaintFilterCanvas& canvas
 {
 #ifdef ROSEN_OHOS
     RSRenderNode::ProcessRenderBeforeChildren(canvas);
+    DrawContentsBeforeChildren(canvas);
+#endif
+}
 
+void RSCanvasRenderNode::ProcessRenderAfterChildren(RSPaintFilterCanvas& canvas)
+{
+#ifdef ROSEN_OHOS
+    DrawContentsAfterChildren(canvas);
+    RSRenderNode::ProcessRenderAfterChildren(canvas);
+#endif
+}
+
+void RSCanvasRenderNode::DrawContentsBeforeChildren(RSPaintFilterCanvas& canvas)
+{
+#ifdef ROSEN_OHOS
     RSPropertiesPainter::DrawBackground(GetRenderProperties(), canvas);
     auto filter = std::static_pointer_cast<RSSkiaFilter>(GetRenderProperties().GetBackgroundFilter());
     if (filter != nullptr) {
@@ -87,7 +123,7 @@ void RSCanvasRenderNode::ProcessRenderBeforeChildren(RSPaintFilterCanvas& canvas
 #endif
 }
 
-void RSCanvasRenderNode::ProcessRenderAfterChildren(RSPaintFilterCanvas& canvas)
+void RSCanvasRenderNode::DrawContentsAfterChildren(RSPaintFilterCanvas& canvas)
 {
 #ifdef ROSEN_OHOS
     if (drawContentLast_) {
@@ -101,9 +137,198 @@ void RSCanvasRenderNode::ProcessRenderAfterChildren(RSPaintFilterCanvas& canvas)
     canvas.restore();
     RSPropertiesPainter::DrawBorder(GetRenderProperties(), canvas);
     RSPropertiesPainter::DrawForegroundColor(GetRenderProperties(), canvas);
+#endif
+}
+
+void RSCanvasRenderNode::UpdateSubtreeCacheState()
+{
+    const auto& properties = GetRenderProperties();
+    bool childrenChanged = false;
+    bool childrenCacheable = true;
+    bool insideBounds = true;
+    int cost = NODE_BASE_COST + (drawCmdList_ ? drawCmdList_->GetSize() : 0);
+#ifdef ROSEN_OHOS
+    auto boundsGeo = std::static_pointer_cast<RSObjAbsGeometry>(properties.GetBoundsGeometry());
+    RectI ownRect = boundsGeo ? boundsGeo->GetAbsRect() : RectI();
+#endif
+    for (auto& child : GetSortedChildren()) {
+        auto canvasChild = RSBaseRenderNode::ReinterpretCast<RSCanvasRenderNode>(child);
+        if (canvasChild == nullptr || canvasChild->GetType() != RSRenderNodeType::CANVAS_NODE) {
+            // surfaces and nested roots are composed by their own pipeline, they can not be baked into an image
+            childrenChanged = true;
+            childrenCacheable = false;
+            continue;
+        }
+        childrenChanged = childrenChanged || canvasChild->IsLastFrameDirty() || canvasChild->subtreeChanged_;
+        childrenCacheable = childrenCacheable && canvasChild->subtreeCacheable_;
+        cost += canvasChild->subtreeCost_;
+        if (!canvasChild->GetRenderProperties().GetVisible()) {
+            continue;
+        }
+        const auto& childProperties = canvasChild->GetRenderProperties();
+        bool childHasShadow = childProperties.shadow_ != nullptr && childProperties.shadow_->IsValid();
+        insideBounds = insideBounds && canvasChild->subtreeInsideBounds_ && !childHasShadow;
+#ifdef ROSEN_OHOS
+        auto childGeo = std::static_pointer_cast<RSObjAbsGeometry>(childProperties.GetBoundsGeometry());
+        insideBounds = insideBounds && childGeo != nullptr && RectContains(ownRect, childGeo->GetAbsRect());
+#endif
+    }
+
+    // the node's own transform and alpha are applied when the image is composited, so only its content and
+    // anything below it invalidate the cache
+    subtreeChanged_ = IsLastFrameContentDirty() || childrenChanged;
+    subtreeCacheable_ =
+        childrenCacheable && properties.GetBackgroundFilter() == nullptr && properties.GetFilter() == nullptr;
+    subtreeInsideBounds_ = insideBounds;
+    subtreeCost_ = cost;
+    if (subtreeChanged_) {
+        stableFrames_ = 0;
+        cacheRejected_ = false;
+        if (cacheScale_ > 0.f) {
+            RSSubtreeCacheManager::Instance().Invalidate(GetId());
+            cacheScale_ = 0.f;
+        }
+    } else if (stableFrames_ < std::numeric_limits<uint32_t>::max()) {
+        stableFrames_++;
+    }
+}
+
+bool RSCanvasRenderNode::IsSubtreeCacheEligible() const
+{
+    const auto& properties = GetRenderProperties();
+    // the image only covers the bounds, so the subtree must be clipped to them or known to stay inside them
+    bool hasShadow = properties.shadow_ != nullptr && properties.shadow_->IsValid();
+    if (GetType() != RSRenderNodeType::CANVAS_NODE || !subtreeCacheable_ || cacheRejected_ || hasShadow ||
+        !(properties.GetClipToBounds() || subtreeInsideBounds_)) {
+        return false;
+    }
+    return RSSubtreeCacheManager::Instance().ShouldCache(stableFrames_, subtreeCost_);
+}
+
+bool RSCanvasRenderNode::ProcessCachedSubtree(RSPaintFilterCanvas& canvas)
+{
+#ifdef ROSEN_OHOS
+    if (!IsSubtreeCacheEligible()) {
+        ReleaseSubtreeCache();
+        return false;
+    }
+    auto boundsGeo = std::static_pointer_cast<RSObjAbsGeometry>(GetRenderProperties().GetBoundsGeometry());
+    if (boundsGeo == nullptr || boundsGeo->IsEmpty()) {
+        return false;
+    }
+    SkMatrix matrix = canvas.getTotalMatrix();
+    matrix.preConcat(boundsGeo->GetMatrix());
+    SkScalar scales[2] = { 0.f, 0.f };
+    if (matrix.hasPerspective() || !matrix.getMinMaxScales(scales) || scales[1] <= 0.f) {
+        return false;
+    }
+    float scale = scales[1];
+
+    auto& cacheManager = RSSubtreeCacheManager::Instance();
+    sk_sp<SkImage> image = cacheManager.Get(GetId());
+    // a magnified subtree is rasterized again at the new resolution, but only once the scale has settled
+    if (image != nullptr && scale > cacheScale_ * CACHE_SCALE_TOLERANCE && ROSEN_EQ(scale, lastDrawScale_)) {
+        cacheManager.Remove(GetId());
+        image = nullptr;
+    }
+    lastDrawScale_ = scale;
+    if (image == nullptr) {
+        image = CreateSubtreeCache(canvas, scale);
+        if (image == nullptr) {
+            return false;
+        }
+    }
+
+    RSRenderNode::ProcessRenderBeforeChildren(canvas);
+    canvas.save();
+    canvas.scale(1.f / cacheScale_, 1.f / cacheScale_);
+    SkPaint paint;
+    paint.setFilterQuality(kLow_SkFilterQuality);
+    canvas.drawImage(image, 0.f, 0.f, &paint);
+    canvas.restore();
     RSRenderNode::ProcessRenderAfterChildren(canvas);
+    FinishSkippedChildren(*this);
+    return true;
+#else
+    return false;
 #endif
 }
 
+#ifdef ROSEN_OHOS
+sk_sp<SkImage> RSCanvasRenderNode::CreateSubtreeCache(RSPaintFilterCanvas& canvas, float scale)
+{
+    auto& cacheManager = RSSubtreeCacheManager::Instance();
+    int width = static_cast<int>(std::ceil(GetRenderProperties().GetBoundsWidth() * scale));
+    int height = static_cast<int>(std::ceil(GetRenderProperties().GetBoundsHeight() * scale));
+    if (width <= 0 || height <= 0 ||
+        !cacheManager.CanFit(static_cast<size_t>(width) * static_cast<size_t>(height) * BYTES_PER_PIXEL)) {
+        cacheManager.RecordReject();
+        cacheRejected_ = true;
+        return nullptr;
+    }
+    SkImageInfo info = SkImageInfo::MakeN32Premul(width, height);
+    // keep the image on the same backend as the target, so compositing it does not need an upload
+    sk_sp<SkSurface> surface = canvas.makeSurface(info);
+    if (surface == nullptr) {
+        surface = SkSurface::MakeRaster(info);
+    }
+    if (surface == nullptr) {
+        ROSEN_LOGE("RSCanvasRenderNode::CreateSubtreeCache failed to create %d x %d surface", width, height);
+        cacheRejected_ = true;
+        return nullptr;
+    }
+    RSPaintFilterCanvas cacheCanvas(surface.get());
+    cacheCanvas.clear(SK_ColorTRANSPARENT);
+    cacheCanvas.scale(scale, scale);
+    DrawSubtreeContents(cacheCanvas);
+
+    auto image = surface->makeImageSnapshot();
+    if (!cacheManager.Put(GetId(), image)) {
+        cacheRejected_ = true;
+        return nullptr;
+    }
+    cacheScale_ = scale;
+    return image;
+}
+
+void RSCanvasRenderNode::DrawSubtreeContents(RSPaintFilterCanvas& canvas)
+{
+    // same order as the visitors, without the transform and alpha of this node
+    DrawContentsBeforeChildren(canvas);
+    for (auto& child : GetSortedChildren()) {
+        auto canvasChild = RSBaseRenderNode::ReinterpretCast<RSCanvasRenderNode>(child);
+        if (canvasChild == nullptr || !canvasChild->GetRenderProperties().GetVisible()) {
+            continue;
+        }
+        // a cached child is now part of this image
+        canvasChild->ReleaseSubtreeCache();
+        canvasChild->RSRenderNode::ProcessRenderBeforeChildren(canvas);
+        canvasChild->DrawSubtreeContents(canvas);
+        canvasChild->RSRenderNode::ProcessRenderAfterChildren(canvas);
+    }
+    DrawContentsAfterChildren(canvas);
+}
+#endif
+
+void RSCanvasRenderNode::FinishSkippedChildren(RSBaseRenderNode& node)
+{
+    // the children skipped through the cache still need the cleanup the visitor does after processing them
+    for (auto& child : node.GetSortedChildren()) {
+        if (auto renderNode = RSBaseRenderNode::ReinterpretCast<RSRenderNode>(child)) {
+            renderNode->GetMutableRenderProperties().ResetBounds();
+        }
+        FinishSkippedChildren(*child);
+    }
+    node.ResetSortedChildren();
+}
+
+void RSCanvasRenderNode::ReleaseSubtreeCache()
+{
+    if (cacheScale_ > 0.f) {
+        RSSubtreeCacheManager::Instance().Remove(GetId());
+        cacheScale_ = 0.f;
+    }
+}
+
 } // namespace Rosen
 } // namespace OHOS
@@ -71,7 +71,13 @@ bool RSRenderNode::Animate(int64_t timestamp)
 
 bool RSRenderNode::Update(RSDirtyRegionManager& dirtyManager, const RSProperties* parent, bool parentDirty)
 {
-    if (!renderProperties_.GetVisible()) {
+    // remember what changed before the flags are cleared, the subtree cache of the ancestors depends on it
+    bool visible = renderProperties_.GetVisible();
+    isLastFrameDirty_ = (visible || wasVisible_) && IsDirty();
+    isLastFrameContentDirty_ =
+        isLastFrameDirty_ && (RSBaseRenderNode::IsDirty() || renderProperties_.IsContentDirty());
+    wasVisible_ = visible;
+    if (!visible) {
         return false;
     }
     bool dirty = renderProperties_.UpdateGeometry(parent, parentDirty);
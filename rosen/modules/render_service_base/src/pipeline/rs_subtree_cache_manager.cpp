@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_subtree_cache_manager.h"
+
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr size_t BYTES_PER_KB = 1024;
+constexpr double PERCENT = 100.0;
+}
+
+RSSubtreeCacheManager& RSSubtreeCacheManager::Instance()
+{
+    static RSSubtreeCacheManager instance;
+    return instance;
+}
+
+RSSubtreeCacheManager::RSSubtreeCacheManager(size_t memoryBudget) : memoryBudget_(memoryBudget) {}
+
+void RSSubtreeCacheManager::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = enabled;
+    if (!enabled_) {
+        EvictLocked(0);
+    }
+}
+
+bool RSSubtreeCacheManager::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_;
+}
+
+void RSSubtreeCacheManager::SetStableFrameThreshold(uint32_t frames)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stableFrameThreshold_ = frames;
+}
+
+uint32_t RSSubtreeCacheManager::GetStableFrameThreshold() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stableFrameThreshold_;
+}
+
+void RSSubtreeCacheManager::SetCostThreshold(int cost)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    costThreshold_ = cost;
+}
+
+int RSSubtreeCacheManager::GetCostThreshold() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return costThreshold_;
+}
+
+void RSSubtreeCacheManager::SetMemoryBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    memoryBudget_ = bytes;
+    EvictLocked(memoryBudget_);
+}
+
+size_t RSSubtreeCacheManager::GetMemoryBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memoryBudget_;
+}
+
+bool RSSubtreeCacheManager::ShouldCache(uint32_t stableFrames, int cost) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_ && stableFrames >= stableFrameThreshold_ && cost >= costThreshold_;
+}
+
+bool RSSubtreeCacheManager::CanFit(size_t bytes) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes > 0 && bytes <= memoryBudget_;
+}
+
+sk_sp<SkImage> RSSubtreeCacheManager::Get(NodeId id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(id);
+    if (iter == entries_.end()) {
+        stats_.missCount++;
+        return nullptr;
+    }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.lruIter);
+    stats_.hitCount++;
+    return iter->second.image;
+}
+
+bool RSSubtreeCacheManager::Put(NodeId id, sk_sp<SkImage> image)
+{
+    if (image == nullptr) {
+        return false;
+    }
+    size_t bytes = image->imageInfo().computeMinByteSize();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(id);
+    if (iter != entries_.end()) {
+        EraseLocked(iter);
+    }
+    if (!enabled_ || bytes > memoryBudget_) {
+        stats_.rejectCount++;
+        return false;
+    }
+    EvictLocked(memoryBudget_ - bytes);
+    lruList_.push_front(id);
+    entries_[id] = { image, bytes, lruList_.begin() };
+    memoryUsage_ += bytes;
+    stats_.createCount++;
+    return true;
+}
+
+void RSSubtreeCacheManager::Invalidate(NodeId id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(id);
+    if (iter == entries_.end()) {
+        return;
+    }
+    EraseLocked(iter);
+    stats_.invalidateCount++;
+}
+
+void RSSubtreeCacheManager::Remove(NodeId id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(id);
+    if (iter != entries_.end()) {
+        EraseLocked(iter);
+    }
+}
+
+bool RSSubtreeCacheManager::Contains(NodeId id) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.find(id) != entries_.end();
+}
+
+void RSSubtreeCacheManager::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lruList_.clear();
+    memoryUsage_ = 0;
+}
+
+void RSSubtreeCacheManager::RecordReject()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.rejectCount++;
+}
+
+RSSubtreeCacheStats RSSubtreeCacheManager::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    RSSubtreeCacheStats stats = stats_;
+    stats.cachedCount = entries_.size();
+    stats.memoryUsage = memoryUsage_;
+    stats.memoryBudget = memoryBudget_;
+    return stats;
+}
+
+void RSSubtreeCacheManager::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = {};
+}
+
+void RSSubtreeCacheManager::Dump(std::string& dumpString) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t lookups = stats_.hitCount + stats_.missCount;
+    double hitRate = lookups == 0 ? 0.0 : PERCENT * stats_.hitCount / lookups;
+    dumpString.append("\n");
+    dumpString.append("-- SubtreeCache: " + std::string(enabled_ ? "enabled" : "disabled") +
+        ", stable frames: " + std::to_string(stableFrameThreshold_) +
+        ", cost threshold: " + std::to_string(costThreshold_) + "\n");
+    dumpString.append("   memory: " + std::to_string(memoryUsage_ / BYTES_PER_KB) + " KB / " +
+        std::to_string(memoryBudget_ / BYTES_PER_KB) + " KB, entries: " + std::to_string(entries_.size()) + "\n");
+    dumpString.append("   hit: " + std::to_string(stats_.hitCount) + ", miss: " + std::to_string(stats_.missCount) +
+        ", hit rate: " + std::to_string(hitRate) + "%\n");
+    dumpString.append("   create: " + std::to_string(stats_.createCount) +
+        ", invalidate: " + std::to_string(stats_.invalidateCount) +
+        ", evict: " + std::to_string(stats_.evictCount) + ", reject: " + std::to_string(stats_.rejectCount) + "\n");
+    for (auto id : lruList_) {
+        auto iter = entries_.find(id);
+        if (iter == entries_.end() || iter->second.image == nullptr) {
+            continue;
+        }
+        const auto& image = iter->second.image;
+        dumpString.append("   node " + std::to_string(id) + ": " + std::to_string(image->width()) + "x" +
+            std::to_string(image->height()) + ", " + std::to_string(iter->second.bytes / BYTES_PER_KB) + " KB\n");
+    }
+}
+
+void RSSubtreeCacheManager::EraseLocked(std::unordered_map<NodeId, CacheEntry>::iterator iter)
+{
+    memoryUsage_ -= iter->second.bytes;
+    lruList_.erase(iter->second.lruIter);
+    entries_.erase(iter);
+}
+
+void RSSubtreeCacheManager::EvictLocked(size_t budget)
+{
+    while (memoryUsage_ > budget && !lruList_.empty()) {
+        auto iter = entries_.find(lruList_.back());
+        if (iter == entries_.end()) {
+            lruList_.pop_back();
+            continue;
+        }
+        ROSEN_LOGD("RSSubtreeCacheManager: evict node %llu", static_cast<unsigned long long>(iter->first));
+        EraseLocked(iter);
+        stats_.evictCount++;
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
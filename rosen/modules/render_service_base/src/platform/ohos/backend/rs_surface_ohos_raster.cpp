@@ -17,6 +17,8 @@
 
 #include <sync_fence.h>
 
+#include "include/core/SkPixmap.h"
+
 #include "platform/common/rs_log.h"
 #include "rs_surface_frame_ohos_raster.h"
 
@@ -31,6 +33,45 @@ void RSSurfaceOhosRaster::SetSurfaceBufferUsage(int32_t usage)
     bufferUsage_ = usage;
 }
 
+sk_sp<SkSurface> RSSurfaceOhosRaster::GetCachedSurface(const sptr<SurfaceBuffer>& buffer)
+{
+    auto iter = bufferCache_.find(buffer->GetSeqNum());
+    if (iter == bufferCache_.end()) {
+        return nullptr;
+    }
+    CachedBuffer& cached = iter->second;
+    if (cached.buffer.promote().GetRefPtr() != buffer.GetRefPtr() || cached.addr == nullptr ||
+        cached.addr != buffer->GetVirAddr()) {
+        bufferCache_.erase(iter);
+        return nullptr;
+    }
+
+    // once a snapshot of the surface is alive, skia moves the pixels of the next draw away from the buffer
+    SkPixmap pixmap;
+    cached.skSurface->notifyContentWillChange(SkSurface::kDiscard_ContentChangeMode);
+    if (!cached.skSurface->peekPixels(&pixmap) || pixmap.addr() != cached.addr) {
+        bufferCache_.erase(iter);
+        return nullptr;
+    }
+
+    // drop the matrix and clip the last frame left behind
+    SkCanvas* canvas = cached.skSurface->getCanvas();
+    canvas->restoreToCount(1);
+    canvas->save();
+    return cached.skSurface;
+}
+
+void RSSurfaceOhosRaster::PruneBufferCache()
+{
+    for (auto iter = bufferCache_.begin(); iter != bufferCache_.end();) {
+        if (iter->second.buffer.promote() == nullptr) {
+            iter = bufferCache_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 std::unique_ptr<RSSurfaceFrame> RSSurfaceOhosRaster::RequestFrame(int32_t width, int32_t height)
 {
     if (producer_ == nullptr) {
@@ -46,10 +87,21 @@ std::unique_ptr<RSSurfaceFrame> RSSurfaceOhosRaster::RequestFrame(int32_t width,
         return nullptr;
     }
 
-    err = frame->buffer_->Map();
-    if (err != SURFACE_ERROR_OK) {
-        ROSEN_LOGE("RSSurfaceOhosRaster::Map Failed, error is : %s", SurfaceErrorStr(err).c_str());
-        return nullptr;
+    PruneBufferCache();
+    frame->skSurface_ = GetCachedSurface(frame->buffer_);
+    if (frame->skSurface_ == nullptr) {
+        err = frame->buffer_->Map();
+        if (err != SURFACE_ERROR_OK) {
+            ROSEN_LOGE("RSSurfaceOhosRaster::Map Failed, error is : %s", SurfaceErrorStr(err).c_str());
+            return nullptr;
+        }
+        frame->CreateSurface();
+        if (frame->skSurface_ != nullptr) {
+            // the clean state GetCachedSurface restores the canvas to
+            frame->skSurface_->getCanvas()->save();
+            bufferCache_[frame->buffer_->GetSeqNum()] = {
+                frame->buffer_, frame->buffer_->GetVirAddr(), frame->skSurface_ };
+        }
     }
 
 
@@ -16,6 +16,7 @@
 #ifndef RS_SURFACE_OHOS_RASTER_H
 #define RS_SURFACE_OHOS_RASTER_H
 
+#include <unordered_map>
 #include <surface.h>
 
 #include "platform/drawing/rs_surface.h"
@@ -38,6 +39,21 @@ public:
     bool FlushFrame(std::unique_ptr<RSSurfaceFrame>& frame) override;
 
     void SetSurfaceBufferUsage(int32_t usage) override;
+
+private:
+    // a buffer of the queue, mapped once, with the SkSurface drawing into it
+    struct CachedBuffer {
+        wptr<SurfaceBuffer> buffer;
+        void* addr = nullptr;
+        sk_sp<SkSurface> skSurface;
+    };
+
+    sk_sp<SkSurface> GetCachedSurface(const sptr<SurfaceBuffer>& buffer);
+    void PruneBufferCache();
+
+    // keyed by sequence number; an entry is dropped once its buffer is deleted, and replaced once the sequence
+    // number comes with another buffer, as when the queue reallocates it
+    std::unordered_map<int32_t, CachedBuffer> bufferCache_;
 };
 } // namespace Rosen
 } // namespace OHOS
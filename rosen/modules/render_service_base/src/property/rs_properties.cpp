@@ -75,22 +75,19 @@ void RSProperties::SetBoundsHeight(float height)
 void RSProperties::SetBoundsPosition(Vector2f position)
 {
     boundsGeo_->SetPosition(position.x_, position.y_);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetBoundsPositionX(float positionX)
 {
     boundsGeo_->SetX(positionX);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetBoundsPositionY(float positionY)
 {
     boundsGeo_->SetY(positionY);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 Vector4f RSProperties::GetBounds() const
@@ -263,8 +260,7 @@ void RSProperties::SetPositionZ(float positionZ)
 {
     boundsGeo_->SetZ(positionZ);
     frameGeo_->SetZ(positionZ);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 float RSProperties::GetPositionZ() const
@@ -275,22 +271,19 @@ float RSProperties::GetPositionZ() const
 void RSProperties::SetPivot(Vector2f pivot)
 {
     boundsGeo_->SetPivot(pivot.x_, pivot.y_);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetPivotX(float pivotX)
 {
     boundsGeo_->SetPivotX(pivotX);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetPivotY(float pivotY)
 {
     boundsGeo_->SetPivotY(pivotY);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 Vector2f RSProperties::GetPivot() const
@@ -325,79 +318,68 @@ Vector4f RSProperties::GetCornerRadius() const
 void RSProperties::SetQuaternion(Quaternion quaternion)
 {
     boundsGeo_->SetQuaternion(quaternion);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetRotation(float degree)
 {
     boundsGeo_->SetRotation(degree);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetRotationX(float degree)
 {
     boundsGeo_->SetRotationX(degree);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetRotationY(float degree)
 {
     boundsGeo_->SetRotationY(degree);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetScale(Vector2f scale)
 {
     boundsGeo_->SetScale(scale.x_, scale.y_);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetScaleX(float sx)
 {
     boundsGeo_->SetScaleX(sx);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetScaleY(float sy)
 {
     boundsGeo_->SetScaleY(sy);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetTranslate(Vector2f translate)
 {
     boundsGeo_->SetTranslateX(translate[0]);
     boundsGeo_->SetTranslateY(translate[1]);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetTranslateX(float translate)
 {
     boundsGeo_->SetTranslateX(translate);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetTranslateY(float translate)
 {
     boundsGeo_->SetTranslateY(translate);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 void RSProperties::SetTranslateZ(float translate)
 {
     boundsGeo_->SetTranslateZ(translate);
-    geoDirty_ = true;
-    SetDirty();
+    SetTransformDirty();
 }
 
 Quaternion RSProperties::GetQuaternion() const
@@ -458,7 +440,8 @@ float RSProperties::GetTranslateZ() const
 void RSProperties::SetAlpha(float alpha)
 {
     alpha_ = alpha;
-    SetDirty();
+    // alpha is applied when the node is composited, what the node draws does not change
+    isDirty_ = true;
 }
 
 float RSProperties::GetAlpha() const
@@ -883,12 +866,20 @@ bool RSProperties::NeedClip() const
 void RSProperties::SetDirty()
 {
     isDirty_ = true;
+    contentDirty_ = true;
+}
+
+void RSProperties::SetTransformDirty()
+{
+    isDirty_ = true;
+    geoDirty_ = true;
 }
 
 void RSProperties::ResetDirty()
 {
     isDirty_ = false;
     geoDirty_ = false;
+    contentDirty_ = false;
 }
 
 bool RSProperties::IsDirty() const
@@ -896,6 +887,11 @@ bool RSProperties::IsDirty() const
     return isDirty_;
 }
 
+bool RSProperties::IsContentDirty() const
+{
+    return contentDirty_;
+}
+
 RectI RSProperties::GetDirtyRect() const
 {
 #ifdef ROSEN_OHOS
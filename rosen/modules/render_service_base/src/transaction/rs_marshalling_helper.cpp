@@ -36,9 +36,11 @@
 #include "src/image/SkImage_Base.h"
 
 #include "animation/rs_render_curve_animation.h"
+#include "animation/rs_render_group_curve_animation.h"
 #include "animation/rs_render_keyframe_animation.h"
 #include "animation/rs_render_path_animation.h"
 #include "animation/rs_render_transition.h"
+#include "command/rs_node_delta_bundle.h"
 #include "common/rs_color.h"
 #include "common/rs_matrix3.h"
 #include "common/rs_vector4.h"
@@ -52,6 +54,9 @@
 #ifdef ROSEN_OHOS
 namespace OHOS {
 namespace Rosen {
+namespace {
+thread_local bool g_inlineData = false;
+}
 
 #define MARSHALLING_AND_UNMARSHALLING(TYPE, TYPENAME)                      \
     bool RSMarshallingHelper::Marshalling(Parcel& parcel, const TYPE& val) \
@@ -540,10 +545,12 @@ bool RSMarshallingHelper::Unmarshalling(Parcel& parcel, std::shared_ptr<RSImage>
         val.reset(parcel.ReadParcelable<TYPE>());                                           \
         return val != nullptr;                                                              \
     }
+MARSHALLING_AND_UNMARSHALLING(RSRenderGroupCurveAnimation)
 MARSHALLING_AND_UNMARSHALLING(RSRenderPathAnimation)
 MARSHALLING_AND_UNMARSHALLING(RSRenderTransition)
 MARSHALLING_AND_UNMARSHALLING(RSRenderTransitionEffect)
 MARSHALLING_AND_UNMARSHALLING(DrawCmdList)
+MARSHALLING_AND_UNMARSHALLING(RSNodeDeltaBundle)
 #undef MARSHALLING_AND_UNMARSHALLING
 
 #define MARSHALLING_AND_UNMARSHALLING(TEMPLATE)                                                    \
@@ -646,7 +653,7 @@ bool RSMarshallingHelper::WriteToParcel(Parcel& parcel, const void* data, size_t
     if (!parcel.WriteInt32(size)) {
         return false;
     }
-    if (size <= MIN_DATA_SIZE) {
+    if (size <= MIN_DATA_SIZE || g_inlineData) {
         return parcel.WriteUnpadBuffer(data, size);
     }
     static pid_t pid_ = getpid();
@@ -683,6 +690,11 @@ bool RSMarshallingHelper::WriteToParcel(Parcel& parcel, const void* data, size_t
     return true;
 }
 
+void RSMarshallingHelper::SetInlineData(bool inlineData)
+{
+    g_inlineData = inlineData;
+}
+
 const void* RSMarshallingHelper::ReadFromParcel(Parcel& parcel, size_t size)
 {
     int32_t bufferSize = parcel.ReadInt32();
@@ -694,6 +706,17 @@ const void* RSMarshallingHelper::ReadFromParcel(Parcel& parcel, size_t size)
     if (static_cast<unsigned int>(bufferSize) <= MIN_DATA_SIZE) {
         return parcel.ReadUnpadBuffer(size);
     }
+    if (g_inlineData) {
+        // owned by the caller like the copy out of shared memory below
+        const void* data = parcel.ReadUnpadBuffer(size);
+        void* base = data != nullptr ? malloc(size) : nullptr;
+        if (base == nullptr || memcpy_s(base, size, data, size) != EOK) {
+            free(base);
+            ROSEN_LOGE("RSMarshallingHelper::ReadFromParcel read inline data failed");
+            return nullptr;
+        }
+        return base;
+    }
 
     int fd = static_cast<MessageParcel*>(&parcel)->ReadFileDescriptor();
     if (fd < 0) {
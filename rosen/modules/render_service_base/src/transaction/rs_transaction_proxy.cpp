@@ -16,6 +16,8 @@
 #include "transaction/rs_transaction_proxy.h"
 #include <stdlib.h>
 
+#include "command/rs_node_command.h"
+
 namespace OHOS {
 namespace Rosen {
 std::once_flag RSTransactionProxy::flag_;
@@ -111,6 +113,8 @@ void RSTransactionProxy::ExecuteSynchronousTask(const std::shared_ptr<RSSyncTask
 void RSTransactionProxy::FlushImplicitTransaction()
 {
     std::unique_lock<std::mutex> cmdLock(mutex_);
+    commonDeltaBundle_.second.reset();
+    remoteDeltaBundle_.second.reset();
     if (renderThreadClient_ != nullptr && !implicitCommonTransactionData_->IsEmpty()) {
         renderThreadClient_->CommitTransaction(implicitCommonTransactionData_);
         implicitCommonTransactionData_ = std::make_unique<RSTransactionData>();
@@ -132,13 +136,39 @@ void RSTransactionProxy::FlushImplicitTransactionFromRT()
 
 void RSTransactionProxy::AddCommonCommand(std::unique_ptr<RSCommand> &command)
 {
+    commonDeltaBundle_.second.reset();
     implicitCommonTransactionData_->AddCommand(command);
 }
 
 void RSTransactionProxy::AddRemoteCommand(std::unique_ptr<RSCommand>& command)
 {
+    remoteDeltaBundle_.second.reset();
     implicitRemoteTransactionData_->AddCommand(command);
 }
 
+std::shared_ptr<RSNodeDeltaBundle> RSTransactionProxy::GetDeltaBundle(NodeId nodeId, bool isRenderServiceCommand)
+{
+    if (renderServiceClient_ == nullptr && renderThreadClient_ == nullptr) {
+        return nullptr;
+    }
+
+    // same destination as AddCommand
+    bool isRemote = renderThreadClient_ == nullptr || isRenderServiceCommand;
+    auto& deltaBundle = isRemote ? remoteDeltaBundle_ : commonDeltaBundle_;
+    if (deltaBundle.second != nullptr && deltaBundle.first == nodeId) {
+        return deltaBundle.second;
+    }
+
+    auto bundle = std::make_shared<RSNodeDeltaBundle>();
+    std::unique_ptr<RSCommand> command = std::make_unique<RSNodeApplyDeltaBundle>(nodeId, bundle);
+    if (isRemote) {
+        AddRemoteCommand(command);
+    } else {
+        AddCommonCommand(command);
+    }
+    deltaBundle = { nodeId, bundle };
+    return bundle;
+}
+
 } // namespace Rosen
 } // namespace OHOS
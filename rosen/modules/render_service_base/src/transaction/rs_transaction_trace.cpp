@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transaction/rs_transaction_trace.h"
+
+#ifdef ROSEN_OHOS
+#include <parcel.h>
+
+#include "platform/common/rs_log.h"
+#include "transaction/rs_marshalling_helper.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+struct TraceHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+
+struct TraceRecordHeader {
+    uint32_t type;
+    uint32_t size;
+    uint64_t timestamp;
+};
+
+class InlineDataScope {
+public:
+    InlineDataScope()
+    {
+        RSMarshallingHelper::SetInlineData(true);
+    }
+    ~InlineDataScope()
+    {
+        RSMarshallingHelper::SetInlineData(false);
+    }
+};
+}
+
+RSTransactionTraceWriter::~RSTransactionTraceWriter()
+{
+    Close();
+}
+
+bool RSTransactionTraceWriter::Open(const std::string& path)
+{
+    Close();
+    file_ = fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        ROSEN_LOGE("RSTransactionTraceWriter::Open: open %s failed", path.c_str());
+        return false;
+    }
+    TraceHeader header = { .magic = RSTransactionTraceReader::MAGIC, .version = RSTransactionTraceReader::VERSION };
+    failed_ = fwrite(&header, sizeof(header), 1, file_) != 1;
+    recordCount_ = 0;
+    timestamp_ = 0;
+    return !failed_;
+}
+
+bool RSTransactionTraceWriter::Close()
+{
+    if (file_ == nullptr) {
+        return false;
+    }
+    bool ret = fclose(file_) == 0 && !failed_;
+    file_ = nullptr;
+    if (!ret) {
+        ROSEN_LOGE("RSTransactionTraceWriter::Close: the trace is incomplete");
+    }
+    return ret;
+}
+
+bool RSTransactionTraceWriter::WriteVsync(uint64_t timestamp)
+{
+    timestamp_ = timestamp;
+    return WriteRecord(RSTransactionTraceRecordType::VSYNC, nullptr, 0);
+}
+
+bool RSTransactionTraceWriter::WriteTransaction(const RSTransactionData& transactionData)
+{
+    if (file_ == nullptr) {
+        return false;
+    }
+    Parcel parcel;
+    // data of any size is inline, the default capacity is for IPC
+    parcel.SetMaxCapacity(RSTransactionTraceReader::MAX_RECORD_SIZE);
+    bool marshalled = false;
+    {
+        InlineDataScope inlineData;
+        marshalled = transactionData.Marshalling(parcel);
+    }
+    if (!marshalled) {
+        ROSEN_LOGE("RSTransactionTraceWriter::WriteTransaction: marshalling failed, transaction skipped");
+        return false;
+    }
+    return WriteRecord(RSTransactionTraceRecordType::TRANSACTION, reinterpret_cast<const void*>(parcel.GetData()),
+        static_cast<uint32_t>(parcel.GetDataSize()));
+}
+
+bool RSTransactionTraceWriter::WriteRecord(RSTransactionTraceRecordType type, const void* data, uint32_t size)
+{
+    if (file_ == nullptr || failed_) {
+        return false;
+    }
+    TraceRecordHeader header = { .type = static_cast<uint32_t>(type), .size = size, .timestamp = timestamp_ };
+    failed_ = fwrite(&header, sizeof(header), 1, file_) != 1 || (size > 0 && fwrite(data, size, 1, file_) != 1);
+    if (failed_) {
+        ROSEN_LOGE("RSTransactionTraceWriter::WriteRecord: write failed");
+        return false;
+    }
+    recordCount_++;
+    return true;
+}
+
+RSTransactionTraceReader::~RSTransactionTraceReader()
+{
+    if (file_ != nullptr) {
+        fclose(file_);
+    }
+}
+
+bool RSTransactionTraceReader::Open(const std::string& path)
+{
+    if (file_ != nullptr) {
+        fclose(file_);
+    }
+    file_ = fopen(path.c_str(), "rb");
+    if (file_ == nullptr) {
+        ROSEN_LOGE("RSTransactionTraceReader::Open: open %s failed", path.c_str());
+        return false;
+    }
+    TraceHeader header = {};
+    if (fread(&header, sizeof(header), 1, file_) != 1 || header.magic != MAGIC || header.version != VERSION) {
+        ROSEN_LOGE("RSTransactionTraceReader::Open: %s is no transaction trace", path.c_str());
+        fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool RSTransactionTraceReader::Next(RSTransactionTraceRecord& record)
+{
+    if (file_ == nullptr) {
+        return false;
+    }
+    TraceRecordHeader header = {};
+    if (fread(&header, sizeof(header), 1, file_) != 1) {
+        return false;
+    }
+    if ((header.type != static_cast<uint32_t>(RSTransactionTraceRecordType::VSYNC) &&
+        header.type != static_cast<uint32_t>(RSTransactionTraceRecordType::TRANSACTION)) ||
+        header.size > MAX_RECORD_SIZE) {
+        ROSEN_LOGE("RSTransactionTraceReader::Next: damaged record");
+        return false;
+    }
+    record.type = static_cast<RSTransactionTraceRecordType>(header.type);
+    record.timestamp = header.timestamp;
+    record.data.resize(header.size);
+    if (header.size > 0 && fread(record.data.data(), header.size, 1, file_) != 1) {
+        ROSEN_LOGE("RSTransactionTraceReader::Next: truncated record");
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<RSTransactionData> RSTransactionTraceReader::Unmarshalling(const RSTransactionTraceRecord& record)
+{
+    if (record.type != RSTransactionTraceRecordType::TRANSACTION) {
+        return nullptr;
+    }
+    if (record.data.empty()) {
+        return std::make_unique<RSTransactionData>();
+    }
+    Parcel parcel;
+    parcel.SetMaxCapacity(MAX_RECORD_SIZE);
+    if (!parcel.WriteBuffer(record.data.data(), record.data.size())) {
+        ROSEN_LOGE("RSTransactionTraceReader::Unmarshalling: copy into parcel failed");
+        return nullptr;
+    }
+    InlineDataScope inlineData;
+    return std::unique_ptr<RSTransactionData>(RSTransactionData::Unmarshalling(parcel));
+}
+} // namespace Rosen
+} // namespace OHOS
+#endif // ROSEN_OHOS
@@ -28,6 +28,7 @@ namespace OHOS {
 namespace Rosen {
 class RSNode;
 class AnimationFinishCallback;
+class RSRenderGroupCurveAnimation;
 
 class RS_EXPORT RSAnimation : public RSAnimationTimingProtocol, public std::enable_shared_from_this<RSAnimation> {
 public:
@@ -76,6 +77,16 @@ protected:
     virtual void OnFinish();
     virtual void OnSetFraction(float fraction);
     virtual void OnUpdateStagingValue(bool isFirstStart) {};
+    // starts the animation as a part of renderGroup instead of as an animation of its own, false if it can't be
+    virtual bool OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+    {
+        return false;
+    }
+    // finishes the part of the animation animating property and keeps the rest running, false if it can't
+    virtual bool OnFinishProperty(const RSAnimatableProperty& property)
+    {
+        return false;
+    }
     virtual RSAnimatableProperty GetProperty() const;
 
     void StartInner(const std::shared_ptr<RSNode>& target);
@@ -96,6 +107,7 @@ private:
 
     friend class RSCurveImplicitAnimParam;
     friend class RSAnimationGroup;
+    friend class RSGroupCurveAnimation;
     friend class RSNode;
     friend class RSImplicitAnimator;
 };
@@ -17,6 +17,7 @@
 
 #include "animation/rs_animation_common.h"
 #include "animation/rs_render_curve_animation.h"
+#include "animation/rs_render_group_curve_animation.h"
 #include "command/rs_animation_command.h"
 #include "platform/common/rs_log.h"
 #include "transaction/rs_transaction_proxy.h"
@@ -24,13 +25,7 @@
 namespace OHOS {
 namespace Rosen {
 
-#define START_CURVE_ANIMATION(RSRenderCommand, Type)                                                               \
-    RSPropertyAnimation<Type>::OnStart();                                                                          \
-    auto target = GetTarget().lock();                                                                              \
-    if (target == nullptr) {                                                                                       \
-        ROSEN_LOGE("Failed to start curve animation, target is null!");                                            \
-        return;                                                                                                    \
-    }                                                                                                              \
+#define CREATE_RENDER_CURVE_ANIMATION(Type)                                                                        \
     auto interpolator = timingCurve_.GetInterpolator(GetDuration());                                               \
     auto animation = std::make_shared<RSRenderCurveAnimation<Type>>(GetId(), GetProperty(),                        \
         RSPropertyAnimation<Type>::originValue_, RSPropertyAnimation<Type>::startValue_,                           \
@@ -42,7 +37,16 @@ namespace Rosen {
     animation->SetSpeed(GetSpeed());                                                                               \
     animation->SetDirection(GetDirection());                                                                       \
     animation->SetFillMode(GetFillMode());                                                                         \
-    animation->SetInterpolator(interpolator);                                                                      \
+    animation->SetInterpolator(interpolator)
+
+#define START_CURVE_ANIMATION(RSRenderCommand, Type)                                                               \
+    RSPropertyAnimation<Type>::OnStart();                                                                          \
+    auto target = GetTarget().lock();                                                                              \
+    if (target == nullptr) {                                                                                       \
+        ROSEN_LOGE("Failed to start curve animation, target is null!");                                            \
+        return;                                                                                                    \
+    }                                                                                                              \
+    CREATE_RENDER_CURVE_ANIMATION(Type);                                                                           \
     std::unique_ptr<RSCommand> command = std::make_unique<RSRenderCommand>(target->GetId(), animation);            \
     auto transactionProxy = RSTransactionProxy::GetInstance();                                                     \
     if (transactionProxy != nullptr) {                                                                             \
@@ -54,58 +58,126 @@ namespace Rosen {
         }                                                                                                          \
     }
 
+#define START_CURVE_ANIMATION_IN_GROUP(Type)                                                                       \
+    RSPropertyAnimation<Type>::OnStart();                                                                          \
+    CREATE_RENDER_CURVE_ANIMATION(Type);                                                                           \
+    renderGroup.AddAnimation(animation)
+
 template<>
 void RSCurveAnimation<int>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveInt, int);
 }
 
+template<>
+bool RSCurveAnimation<int>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(int);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<float>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveFloat, float);
 }
 
+template<>
+bool RSCurveAnimation<float>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(float);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<Color>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveColor, Color);
 }
 
+template<>
+bool RSCurveAnimation<Color>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(Color);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<Matrix3f>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveMatrix3f, Matrix3f);
 }
 
+template<>
+bool RSCurveAnimation<Matrix3f>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(Matrix3f);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<Vector2f>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveVec2f, Vector2f);
 }
 
+template<>
+bool RSCurveAnimation<Vector2f>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(Vector2f);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<Vector4f>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveVec4f, Vector4f);
 }
 
+template<>
+bool RSCurveAnimation<Vector4f>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(Vector4f);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<Quaternion>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveQuaternion, Quaternion);
 }
 
+template<>
+bool RSCurveAnimation<Quaternion>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(Quaternion);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<std::shared_ptr<RSFilter>>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveFilter, std::shared_ptr<RSFilter>);
 }
 
+template<>
+bool RSCurveAnimation<std::shared_ptr<RSFilter>>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(std::shared_ptr<RSFilter>);
+    return true;
+}
+
 template<>
 void RSCurveAnimation<Vector4<Color>>::OnStart()
 {
     START_CURVE_ANIMATION(RSAnimationCreateCurveVec4Color, Vector4<Color>);
 }
+
+template<>
+bool RSCurveAnimation<Vector4<Color>>::OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup)
+{
+    START_CURVE_ANIMATION_IN_GROUP(Vector4<Color>);
+    return true;
+}
 } // namespace Rosen
 } // namespace OHOS
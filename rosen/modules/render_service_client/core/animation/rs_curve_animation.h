@@ -59,9 +59,12 @@ public:
 
 protected:
     void OnStart() override;
+    bool OnStartInGroup(RSRenderGroupCurveAnimation& renderGroup) override;
 
 private:
     RSAnimationTimingCurve timingCurve_ { RSAnimationTimingCurve::DEFAULT };
+
+    friend class RSImplicitCurveAnimationParam;
 };
 
 template class RSCurveAnimation<int>;
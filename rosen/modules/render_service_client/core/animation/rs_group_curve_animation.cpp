@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "animation/rs_group_curve_animation.h"
+
+#include <algorithm>
+
+#include "animation/rs_render_group_curve_animation.h"
+#include "command/rs_animation_command.h"
+#include "platform/common/rs_log.h"
+#include "transaction/rs_transaction_proxy.h"
+#include "ui/rs_node.h"
+
+namespace OHOS {
+namespace Rosen {
+void RSGroupCurveAnimation::AddAnimation(const std::shared_ptr<RSAnimation>& animation)
+{
+    if (animation == nullptr) {
+        ROSEN_LOGE("Failed to add animation, adding animation is null!");
+        return;
+    }
+
+    if (IsStarted()) {
+        ROSEN_LOGE("Failed to add animation, group curve animation has started!");
+        return;
+    }
+
+    if (animation->IsStarted()) {
+        ROSEN_LOGE("Failed to add animation, adding animation has started!");
+        return;
+    }
+
+    animations_.emplace_back(animation);
+}
+
+void RSGroupCurveAnimation::OnStart()
+{
+    if (animations_.empty()) {
+        ROSEN_LOGE("Failed to start group curve animation, animations is empty!");
+        return;
+    }
+
+    auto target = GetTarget().lock();
+    if (target == nullptr) {
+        ROSEN_LOGE("Failed to start group curve animation, target is null!");
+        return;
+    }
+
+    auto renderGroup = std::make_shared<RSRenderGroupCurveAnimation>(GetId());
+    renderGroup->SetDuration(GetDuration());
+    renderGroup->SetStartDelay(GetStartDelay());
+    renderGroup->SetRepeatCount(GetRepeatCount());
+    renderGroup->SetAutoReverse(GetAutoReverse());
+    renderGroup->SetSpeed(GetSpeed());
+    renderGroup->SetDirection(GetDirection());
+    renderGroup->SetFillMode(GetFillMode());
+    for (auto& animation : animations_) {
+        static_cast<RSAnimationTimingProtocol&>(*animation) = *this;
+        animation->target_ = target;
+        animation->state_ = AnimationState::RUNNING;
+        if (!animation->OnStartInGroup(*renderGroup)) {
+            ROSEN_LOGE("Failed to start animation[%llu] in group, it is not a curve animation!", animation->GetId());
+        }
+    }
+
+    std::unique_ptr<RSCommand> command = std::make_unique<RSAnimationCreateGroupCurve>(target->GetId(), renderGroup);
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    if (transactionProxy != nullptr) {
+        transactionProxy->AddCommand(command, target->IsRenderServiceNode());
+        if (target->NeedForcedSendToRemote()) {
+            std::unique_ptr<RSCommand> commandForRemote =
+                std::make_unique<RSAnimationCreateGroupCurve>(target->GetId(), renderGroup);
+            transactionProxy->AddCommand(commandForRemote, true);
+        }
+    }
+}
+
+void RSGroupCurveAnimation::OnUpdateStagingValue(bool isFirstStart)
+{
+    // in the order the values were set, so the last value set for a property is the one left
+    for (auto& animation : animations_) {
+        animation->isReversed_ = IsReversed();
+        animation->UpdateStagingValue(isFirstStart);
+    }
+}
+
+bool RSGroupCurveAnimation::OnFinishProperty(const RSAnimatableProperty& property)
+{
+    if (!IsRunning() && !IsPaused()) {
+        return false;
+    }
+
+    auto target = GetTarget().lock();
+    if (target == nullptr) {
+        ROSEN_LOGE("Failed to finish group curve animation property, target is null!");
+        return false;
+    }
+
+    auto iter = std::remove_if(animations_.begin(), animations_.end(),
+        [&property](const auto& animation) { return animation->GetProperty() == property; });
+    if (iter == animations_.begin() || iter == animations_.end()) {
+        // finishing all of the animations is finishing the group, finishing none is nothing to do
+        return false;
+    }
+    for (auto it = iter; it != animations_.end(); ++it) {
+        (*it)->state_ = AnimationState::FINISHED;
+    }
+    animations_.erase(iter, animations_.end());
+
+    std::unique_ptr<RSCommand> command =
+        std::make_unique<RSAnimationFinishProperty>(target->GetId(), GetId(), property);
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    if (transactionProxy != nullptr) {
+        transactionProxy->AddCommand(command, target->IsRenderServiceNode());
+        if (target->NeedForcedSendToRemote()) {
+            std::unique_ptr<RSCommand> commandForRemote =
+                std::make_unique<RSAnimationFinishProperty>(target->GetId(), GetId(), property);
+            transactionProxy->AddCommand(commandForRemote, true);
+        }
+    }
+    return true;
+}
+
+RSAnimatableProperty RSGroupCurveAnimation::GetProperty() const
+{
+    unsigned long long property = 0;
+    for (const auto& animation : animations_) {
+        property |= static_cast<unsigned long long>(animation->GetProperty());
+    }
+    return static_cast<RSAnimatableProperty>(property);
+}
+} // namespace Rosen
+} // namespace OHOS
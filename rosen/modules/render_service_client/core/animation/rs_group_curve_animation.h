@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_GROUP_CURVE_ANIMATION_H
+#define RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_GROUP_CURVE_ANIMATION_H
+
+#include <memory>
+#include <vector>
+
+#include "animation/rs_animatable_property.h"
+#include "animation/rs_animation.h"
+#include "common/rs_common_def.h"
+
+namespace OHOS {
+namespace Rosen {
+// Curve animations of several properties of one node started as one animation: one id, one create command, one
+// render animation for the animation manager to drive and one finish callback. The timing protocol of the group
+// replaces the one of the animations added, each keeps its own timing curve.
+class RS_EXPORT RSGroupCurveAnimation : public RSAnimation {
+public:
+    RSGroupCurveAnimation() = default;
+    ~RSGroupCurveAnimation() = default;
+
+    void AddAnimation(const std::shared_ptr<RSAnimation>& animation);
+
+    size_t GetAnimationCount() const
+    {
+        return animations_.size();
+    }
+
+protected:
+    void OnStart() override;
+    void OnUpdateStagingValue(bool isFirstStart) override;
+    RSAnimatableProperty GetProperty() const override;
+    bool OnFinishProperty(const RSAnimatableProperty& property) override;
+
+private:
+    std::vector<std::shared_ptr<RSAnimation>> animations_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_GROUP_CURVE_ANIMATION_H
@@ -64,6 +64,8 @@ public:
         const RSAnimatableProperty& property, const T& startValue, const T& endValue) const
     {
         auto curveAnimation = std::make_shared<RSCurveAnimation<T>>(property, endValue - startValue);
+        // the animation may start after the value has been changed, see RSImplicitAnimator
+        curveAnimation->SetOriginValue(startValue);
         curveAnimation->SetTimingCurve(timingCurve_);
         ApplyTimingProtocol(curveAnimation);
         return curveAnimation;
@@ -15,7 +15,10 @@
 
 #include "animation/rs_implicit_animator.h"
 
+#include <set>
+
 #include "animation/rs_animation_callback.h"
+#include "animation/rs_group_curve_animation.h"
 #include "animation/rs_path_animation.h"
 #include "pipeline/rs_node_map.h"
 
@@ -57,6 +60,7 @@ std::vector<std::shared_ptr<RSAnimation>> RSImplicitAnimator::CloseImplicitAnima
             CreateEmptyAnimation();
         }
     }
+    StartImplicitCurveAnimations(implicitAnimations_.top());
     currentAnimations = implicitAnimations_.top();
 
     for (const auto& [animationInfo, keyframeAnimation] : keyframeAnimations_.top()) {
@@ -95,6 +99,49 @@ std::vector<std::shared_ptr<RSAnimation>> RSImplicitAnimator::CloseImplicitAnima
     return resultAnimations;
 }
 
+void RSImplicitAnimator::StartImplicitCurveAnimations(
+    std::vector<std::pair<std::shared_ptr<RSAnimation>, NodeId>>& animations)
+{
+    std::vector<std::pair<std::shared_ptr<RSAnimation>, NodeId>> startedAnimations;
+    std::map<NodeId, std::vector<std::shared_ptr<RSAnimation>>> curveAnimations;
+    // keyframe animations are not started yet either, they are started on their own after the curve animations
+    std::set<std::shared_ptr<RSAnimation>> keyframeAnimations;
+    for (const auto& [animationInfo, keyframeAnimation] : keyframeAnimations_.top()) {
+        keyframeAnimations.insert(keyframeAnimation);
+    }
+    for (const auto& [animation, nodeId] : animations) {
+        if (animation == nullptr || animation->IsStarted() || keyframeAnimations.count(animation) != 0) {
+            startedAnimations.emplace_back(animation, nodeId);
+        } else {
+            curveAnimations[nodeId].emplace_back(animation);
+        }
+    }
+
+    for (const auto& [nodeId, nodeAnimations] : curveAnimations) {
+        auto target = RSNodeMap::Instance().GetNode<RSNode>(nodeId);
+        if (target == nullptr) {
+            ROSEN_LOGE("Failed to start implicit curve animations, target[%llu] is null!", nodeId);
+            continue;
+        }
+
+        if (nodeAnimations.size() == 1) {
+            target->AddAnimation(nodeAnimations.front());
+            startedAnimations.emplace_back(nodeAnimations.front(), nodeId);
+            continue;
+        }
+
+        // all the properties of the target animate with one animation, they share the timing protocol
+        auto groupAnimation = std::make_shared<RSGroupCurveAnimation>();
+        static_cast<RSAnimationTimingProtocol&>(*groupAnimation) = *nodeAnimations.front();
+        for (const auto& animation : nodeAnimations) {
+            groupAnimation->AddAnimation(animation);
+        }
+        target->AddAnimation(groupAnimation);
+        startedAnimations.emplace_back(groupAnimation, nodeId);
+    }
+    animations.swap(startedAnimations);
+}
+
 void RSImplicitAnimator::BeginImplicitKeyFrameAnimation(float fraction, const RSAnimationTimingCurve& timingCurve)
 {
     if (globalImplicitParams_.empty()) {
@@ -266,6 +313,7 @@ std::shared_ptr<RSAnimation> RSImplicitAnimator::CreateImplicitAnimation(
     switch (params->GetType()) {
         case ImplicitAnimationParamType::CURVE: {
             auto curveImplicitParam = static_cast<RSImplicitCurveAnimationParam*>(params.get());
+            SetPropertyValue(target, property, endValue);
             animation = curveImplicitParam->CreateAnimation(property, startValue, endValue);
             break;
         }
@@ -298,7 +346,9 @@ std::shared_ptr<RSAnimation> RSImplicitAnimator::CreateImplicitAnimation(
         return nullptr;
     }
 
-    if (params->GetType() != ImplicitAnimationParamType::KEYFRAME) {
+    // curve animations start when the implicit animation closes, grouped by target
+    if (params->GetType() != ImplicitAnimationParamType::KEYFRAME &&
+        params->GetType() != ImplicitAnimationParamType::CURVE) {
         target.AddAnimation(animation);
     }
 
@@ -54,6 +54,9 @@ private:
     void PushImplicitParam(const std::shared_ptr<RSImplicitAnimationParam>& implicitParam);
     void PopImplicitParam();
     void CreateEmptyAnimation();
+    // starts the curve animations not started yet, the ones of a target as one RSGroupCurveAnimation when there are
+    // several, and replaces them by the animations started
+    void StartImplicitCurveAnimations(std::vector<std::pair<std::shared_ptr<RSAnimation>, NodeId>>& animations);
 
     template<typename T>
     void SetPropertyValue(RSNode& target, const RSAnimatableProperty& property, const T& value)
@@ -25,6 +25,7 @@
 #include "rs_animation_timing_curve.h"
 #include "rs_canvas_node.h"
 #include "rs_curve_animation.h"
+#include "rs_group_curve_animation.h"
 #include "rs_implicit_animation_param.h"
 #include "rs_implicit_animator.h"
 #include "rs_keyframe_animation.h"
@@ -304,6 +305,103 @@ HWTEST_F(RSAnimationTest, AnimationGroupTest001, TestSize.Level1)
     EXPECT_TRUE(animation2->IsPaused());
 }
 
+/**
+ * @tc.name: GroupCurveAnimationTest001
+ * @tc.desc: Verify the curve animations of several properties start as one group curve animation
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSAnimationTest, GroupCurveAnimationTest001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RSAnimationTest GroupCurveAnimationTest001 start";
+    /**
+     * @tc.steps: step1. init group curve animation
+     */
+    RSCanvasNode::SharedPtr node = RSCanvasNode::Create();
+    node->SetBoundsWidth(200);
+    node->SetAlpha(1.0f);
+    std::shared_ptr<RSCurveAnimation<float>> animation1 =
+        std::make_shared<RSCurveAnimation<float>>(RSAnimatableProperty::BOUNDS_WIDTH, 200, 500);
+    animation1->SetTimingCurve(RSAnimationTimingCurve::EASE_IN_OUT);
+    std::shared_ptr<RSCurveAnimation<float>> animation2 =
+        std::make_shared<RSCurveAnimation<float>>(RSAnimatableProperty::ALPHA, 1.0f, 0.5f);
+    std::shared_ptr<RSGroupCurveAnimation> groupAnimation = std::make_shared<RSGroupCurveAnimation>();
+    groupAnimation->SetDuration(1000);
+    groupAnimation->AddAnimation(animation1);
+    groupAnimation->AddAnimation(animation2);
+    groupAnimation->AddAnimation(nullptr);
+    EXPECT_EQ(groupAnimation->GetAnimationCount(), 2u);
+    /**
+     * @tc.steps: step2. start group curve animation test
+     */
+    groupAnimation->Start(node);
+    EXPECT_TRUE(groupAnimation->IsRunning());
+    EXPECT_TRUE(animation1->IsRunning());
+    EXPECT_TRUE(animation2->IsRunning());
+    EXPECT_EQ(animation1->GetDuration(), 1000);
+    EXPECT_EQ(animation2->GetDuration(), 1000);
+    EXPECT_FLOAT_EQ(node->GetStagingProperties().GetBoundsWidth(), 500);
+    EXPECT_FLOAT_EQ(node->GetStagingProperties().GetAlpha(), 0.5f);
+    groupAnimation->AddAnimation(std::make_shared<RSCurveAnimation<float>>(RSAnimatableProperty::ALPHA, 1.0f, 0.5f));
+    EXPECT_EQ(groupAnimation->GetAnimationCount(), 2u);
+    groupAnimation->Pause();
+    EXPECT_TRUE(groupAnimation->IsPaused());
+}
+
+/**
+ * @tc.name: GroupCurveAnimationTest002
+ * @tc.desc: Verify finishing one property of a group curve animation keeps the other properties animating
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSAnimationTest, GroupCurveAnimationTest002, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RSAnimationTest GroupCurveAnimationTest002 start";
+    /**
+     * @tc.steps: step1. init group curve animation and a bounds animation
+     */
+    RSCanvasNode::SharedPtr node = RSCanvasNode::Create();
+    node->SetBoundsWidth(200);
+    node->SetAlpha(1.0f);
+    std::shared_ptr<RSCurveAnimation<float>> animation1 =
+        std::make_shared<RSCurveAnimation<float>>(RSAnimatableProperty::BOUNDS_WIDTH, 200, 500);
+    std::shared_ptr<RSCurveAnimation<float>> animation2 =
+        std::make_shared<RSCurveAnimation<float>>(RSAnimatableProperty::ALPHA, 1.0f, 0.5f);
+    std::shared_ptr<RSGroupCurveAnimation> groupAnimation = std::make_shared<RSGroupCurveAnimation>();
+    groupAnimation->SetDuration(1000);
+    groupAnimation->AddAnimation(animation1);
+    groupAnimation->AddAnimation(animation2);
+    groupAnimation->Start(node);
+    std::shared_ptr<RSCurveAnimation<Vector4f>> boundsAnimation = std::make_shared<RSCurveAnimation<Vector4f>>(
+        RSAnimatableProperty::BOUNDS, Vector4f(0, 0, 200, 200), Vector4f(0, 0, 500, 500));
+    boundsAnimation->SetDuration(1000);
+    boundsAnimation->Start(node);
+    EXPECT_TRUE(groupAnimation->IsRunning());
+    EXPECT_TRUE(boundsAnimation->IsRunning());
+    /**
+     * @tc.steps: step2. finish the bounds width animations with an animation of no duration
+     */
+    std::shared_ptr<RSCurveAnimation<float>> widthAnimation =
+        std::make_shared<RSCurveAnimation<float>>(RSAnimatableProperty::BOUNDS_WIDTH, 500, 300);
+    widthAnimation->SetDuration(0);
+    widthAnimation->Start(node);
+    EXPECT_TRUE(groupAnimation->IsRunning());
+    EXPECT_EQ(groupAnimation->GetAnimationCount(), 1u);
+    EXPECT_TRUE(animation1->IsFinished());
+    EXPECT_TRUE(animation2->IsRunning());
+    EXPECT_TRUE(boundsAnimation->IsRunning());
+    /**
+     * @tc.steps: step3. finishing the last property finishes the group
+     */
+    std::shared_ptr<RSCurveAnimation<float>> alphaAnimation =
+        std::make_shared<RSCurveAnimation<float>>(RSAnimatableProperty::ALPHA, 0.5f, 0.2f);
+    alphaAnimation->SetDuration(0);
+    alphaAnimation->Start(node);
+    EXPECT_TRUE(groupAnimation->IsFinished());
+}
+
 /**
  * @tc.name: MotionPathOptionTest001
  * @tc.desc: Verify the  parameter of MotionPathOption
@@ -669,6 +767,44 @@ HWTEST_F(RSAnimationTest, ImplicitAnimatorTest001, TestSize.Level1)
     RSImplicitAnimator::Instance().NeedImplicitAnimation();
 }
 
+/**
+ * @tc.name: ImplicitAnimatorTest002
+ * @tc.desc: Verify implicit keyframe animations are not grouped with the implicit curve animations of the node
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSAnimationTest, ImplicitAnimatorTest002, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RSAnimationTest ImplicitAnimatorTest002 start";
+    /**
+     * @tc.steps: step1. animate two properties with curves and one with keyframes
+     */
+    RSCanvasNode::SharedPtr node = RSCanvasNode::Create();
+    node->SetBoundsWidth(200);
+    node->SetBoundsHeight(200);
+    node->SetAlpha(1.0f);
+    RSAnimationTimingProtocol protocol;
+    protocol.SetDuration(1000);
+    RSNode::OpenImplicitAnimation(protocol, RSAnimationTimingCurve::EASE_IN_OUT);
+    RSNode::AddKeyFrame(0.5f, [&node]() { node->SetAlpha(0.5f); });
+    RSNode::AddKeyFrame(1.0f, [&node]() { node->SetAlpha(0.2f); });
+    node->SetBoundsWidth(500);
+    node->SetBoundsHeight(300);
+    auto animations = RSNode::CloseImplicitAnimation();
+    /**
+     * @tc.steps: step2. the keyframe animation and the group of curve animations are started once each
+     */
+    EXPECT_EQ(animations.size(), 2u);
+    for (const auto& animation : animations) {
+        ASSERT_TRUE(animation != nullptr);
+        EXPECT_TRUE(animation->IsRunning());
+    }
+    EXPECT_FLOAT_EQ(node->GetStagingProperties().GetAlpha(), 0.2f);
+    EXPECT_FLOAT_EQ(node->GetStagingProperties().GetBoundsWidth(), 500);
+    EXPECT_FLOAT_EQ(node->GetStagingProperties().GetBoundsHeight(), 300);
+}
+
 /**
  * @tc.name: KeyframeAnimationTest001
  * @tc.desc: Verify the  parameter and initial of KeyframeAnimation
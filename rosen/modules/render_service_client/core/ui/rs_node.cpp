@@ -141,8 +141,14 @@ void RSNode::RemoveAnimationInner(const std::shared_ptr<RSAnimation>& animation)
 void RSNode::FinishAnimationByProperty(const RSAnimatableProperty& property)
 {
     for (const auto& [animationId, animation] : animations_) {
-        if (animation->GetProperty() == property) {
+        auto animatingProperty = animation->GetProperty();
+        if (animatingProperty == property) {
             animation->Finish();
+        } else if ((static_cast<unsigned long long>(animatingProperty) & static_cast<unsigned long long>(property)) &&
+            animation->OnFinishProperty(property)) {
+            // a group curve animation finished the animation of property only and animates fewer properties now
+            animatingPropertyNum_[animatingProperty]--;
+            animatingPropertyNum_[animation->GetProperty()]++;
         }
     }
 }
@@ -214,6 +220,29 @@ bool RSNode::HasPropertyAnimation(const RSAnimatableProperty& property)
     return std::any_of(animatingPropertyNum_.begin(), animatingPropertyNum_.end(), pred);
 }
 
+template<typename Command, typename T>
+void RSNode::AddPropertyDelta(const T& delta)
+{
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    if (transactionProxy == nullptr) {
+        return;
+    }
+    if constexpr (RSNodeDeltaBundle::IsSupported<T>()) {
+        // deltas set one after another share one bundle command
+        transactionProxy->AddPropertyDelta(GetId(), RSCommandSubType<Command>::value, delta, IsRenderServiceNode());
+        if (NeedForcedSendToRemote()) {
+            transactionProxy->AddPropertyDelta(GetId(), RSCommandSubType<Command>::value, delta, true);
+        }
+    } else {
+        std::unique_ptr<RSCommand> command = std::make_unique<Command>(GetId(), delta);
+        transactionProxy->AddCommand(command, IsRenderServiceNode());
+        if (NeedForcedSendToRemote()) {
+            std::unique_ptr<RSCommand> commandForRemote = std::make_unique<Command>(GetId(), delta);
+            transactionProxy->AddCommand(commandForRemote, true);
+        }
+    }
+}
+
 namespace {
 template<typename T>
 bool IsValid(const T& value)
@@ -246,17 +275,7 @@ bool IsValid(const Vector4f& value)
         if (implicitAnimator_ && implicitAnimator_->NeedImplicitAnimation() && IsValid(currentValue)) {     \
             implicitAnimator_->CreateImplicitAnimation(*this, property, currentValue, value);               \
         } else if (HasPropertyAnimation(property)) {                                                        \
-            std::unique_ptr<RSCommand> command =                                                            \
-                std::make_unique<RSNodeSet##propertyName##Delta>(GetId(), (value)-currentValue);            \
-            auto transactionProxy = RSTransactionProxy::GetInstance();                                      \
-            if (transactionProxy != nullptr) {                                                              \
-                transactionProxy->AddCommand(command, IsRenderServiceNode());                               \
-                if (NeedForcedSendToRemote()) {                                                             \
-                    std::unique_ptr<RSCommand> commandForRemote =                                           \
-                        std::make_unique<RSNodeSet##propertyName##Delta>(GetId(), (value)-currentValue);    \
-                    transactionProxy->AddCommand(commandForRemote, true);                                   \
-                }                                                                                           \
-            }                                                                                               \
+            AddPropertyDelta<RSNodeSet##propertyName##Delta>(decltype(currentValue)((value)-currentValue)); \
             stagingProperties_.Set##propertyName(value);                                                    \
         } else {                                                                                            \
             std::unique_ptr<RSCommand> command = std::make_unique<RSNodeSet##propertyName>(GetId(), value); \
@@ -195,6 +195,8 @@ protected:
 
 private:
     bool HasPropertyAnimation(const RSAnimatableProperty& property);
+    template<typename Command, typename T>
+    void AddPropertyDelta(const T& delta);
     void FallbackAnimationsToRoot();
     void AddAnimationInner(const std::shared_ptr<RSAnimation>& animation);
     void RemoveAnimationInner(const std::shared_ptr<RSAnimation>& animation);
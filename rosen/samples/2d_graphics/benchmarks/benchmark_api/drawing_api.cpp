@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drawing_api.h"
+
+#include <chrono>
+
+#include "draw/brush.h"
+#include "draw/path.h"
+#include "draw/pen.h"
+#include "draw/recording_canvas.h"
+#include "image/bitmap.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int DRAW_COUNT = 100000;
+constexpr int SCENE_SHAPE_COUNT = 1000;
+constexpr int REPLAY_COUNT = 100;
+constexpr int SHAPE_SIZE = 16;
+constexpr int SHAPE_STEP = 7;
+constexpr int BYTES_PER_PIXEL = 4;
+constexpr double NS_PER_MS = 1000000.0;
+
+Drawing::scalar ShapeOffset(int index, int range)
+{
+    return static_cast<Drawing::scalar>((index * SHAPE_STEP) % (range > SHAPE_SIZE ? range - SHAPE_SIZE : 1));
+}
+}
+
+void DrawingApi::Start()
+{
+    std::cout << "DrawingApi::Start+" << std::endl;
+    results_.clear();
+    std::cout << "DrawingApi::Start-" << std::endl;
+}
+
+void DrawingApi::Stop()
+{
+    std::cout << "DrawingApi::Stop+" << std::endl;
+    std::cout << "DrawingApi::Stop-" << std::endl;
+}
+
+void DrawingApi::RunCase(const std::string& name, Drawing::Canvas& canvas, int count, const DrawFunc& draw)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        draw(canvas, i);
+    }
+    canvas.Flush();
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    results_.push_back({ name, count, ns / count });
+}
+
+void DrawingApi::Test(SkCanvas* canvas, int width, int height)
+{
+    std::cout << "DrawingApi::Test+" << std::endl;
+    Drawing::Bitmap bitmap;
+    Drawing::BitmapFormat format { Drawing::COLORTYPE_RGBA_8888, Drawing::ALPHATYPE_PREMUL };
+    bitmap.Build(width, height, format);
+    Drawing::Canvas drawingCanvas;
+    drawingCanvas.Bind(bitmap);
+    drawingCanvas.Clear(Drawing::Color::COLOR_WHITE);
+
+    TestDrawCalls(drawingCanvas, width, height);
+    TestPicture(drawingCanvas, width, height);
+
+    SkBitmap skBitmap;
+    skBitmap.installPixels(SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, kPremul_SkAlphaType),
+        bitmap.GetPixels(), width * BYTES_PER_PIXEL);
+    canvas->drawBitmap(skBitmap, 0, 0);
+    std::cout << "DrawingApi::Test-" << std::endl;
+}
+
+void DrawingApi::TestDrawCalls(Drawing::Canvas& canvas, int width, int height)
+{
+    Drawing::Pen pen;
+    pen.SetAntiAlias(true);
+    pen.SetColor(Drawing::Color::COLOR_BLUE);
+    pen.SetWidth(2); // stroke width
+    Drawing::Brush brush;
+    brush.SetColor(Drawing::Color::COLOR_RED);
+    Drawing::Path path;
+    path.MoveTo(0, 0);
+    path.LineTo(SHAPE_SIZE, 0);
+    path.LineTo(SHAPE_SIZE, SHAPE_SIZE);
+    path.Close();
+
+    RunCase("DrawRect", canvas, DRAW_COUNT, [&](Drawing::Canvas& c, int i) {
+        Drawing::scalar x = ShapeOffset(i, width);
+        Drawing::scalar y = ShapeOffset(i / SHAPE_SIZE, height);
+        c.AttachPen(pen);
+        c.AttachBrush(brush);
+        c.DrawRect(Drawing::Rect(x, y, x + SHAPE_SIZE, y + SHAPE_SIZE));
+        c.DetachBrush();
+        c.DetachPen();
+    });
+    RunCase("DrawLine", canvas, DRAW_COUNT, [&](Drawing::Canvas& c, int i) {
+        Drawing::scalar x = ShapeOffset(i, width);
+        Drawing::scalar y = ShapeOffset(i / SHAPE_SIZE, height);
+        c.AttachPen(pen);
+        c.DrawLine(Drawing::Point(x, y), Drawing::Point(x + SHAPE_SIZE, y + SHAPE_SIZE));
+        c.DetachPen();
+    });
+    RunCase("DrawPath", canvas, DRAW_COUNT, [&](Drawing::Canvas& c, int i) {
+        c.Save();
+        c.Translate(ShapeOffset(i, width), ShapeOffset(i / SHAPE_SIZE, height));
+        c.AttachPen(pen);
+        c.AttachBrush(brush);
+        c.DrawPath(path);
+        c.DetachBrush();
+        c.DetachPen();
+        c.Restore();
+    });
+}
+
+void DrawingApi::TestPicture(Drawing::Canvas& canvas, int width, int height)
+{
+    Drawing::Pen pen;
+    pen.SetAntiAlias(true);
+    pen.SetColor(Drawing::Color::COLOR_BLUE);
+    Drawing::Brush brush;
+    brush.SetColor(Drawing::Color::COLOR_RED);
+    auto drawScene = [&](Drawing::Canvas& c) {
+        for (int i = 0; i < SCENE_SHAPE_COUNT; i++) {
+            Drawing::scalar x = ShapeOffset(i, width);
+            Drawing::scalar y = ShapeOffset(i / SHAPE_SIZE, height);
+            c.AttachPen(pen);
+            c.AttachBrush(brush);
+            c.DrawRect(Drawing::Rect(x, y, x + SHAPE_SIZE, y + SHAPE_SIZE));
+            c.DrawCircle(Drawing::Point(x, y), SHAPE_SIZE / 2); // radius is half of the shape
+            c.DetachBrush();
+            c.DetachPen();
+        }
+    };
+
+    RunCase("DrawScene", canvas, REPLAY_COUNT, [&](Drawing::Canvas& c, int) { drawScene(c); });
+
+    std::shared_ptr<Drawing::Picture> picture;
+    RunCase("RecordScene", canvas, 1, [&](Drawing::Canvas&, int) {
+        Drawing::RecordingCanvas recordingCanvas(Drawing::Rect(0, 0, width, height));
+        drawScene(recordingCanvas);
+        picture = recordingCanvas.FinishRecording();
+    });
+    if (picture == nullptr) {
+        std::cout << "DrawingApi::TestPicture, recording failed" << std::endl;
+        return;
+    }
+    RunCase("ReplayScene", canvas, REPLAY_COUNT, [&](Drawing::Canvas& c, int) { c.DrawPicture(*picture); });
+    std::cout << "DrawingApi scene picture: " << picture->ApproximateOpCount() << " ops" << std::endl;
+}
+
+void DrawingApi::Output()
+{
+    for (auto& result : results_) {
+        std::cout << "DrawingApi " << result.name << ": " << result.count << " calls, " <<
+            result.nsPerCall * result.count / NS_PER_MS << " ms, " << result.nsPerCall << " ns/call" << std::endl;
+    }
+}
+}
+}
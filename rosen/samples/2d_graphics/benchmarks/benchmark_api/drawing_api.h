@@ -15,19 +15,41 @@
 
 #ifndef DRAWING_API_H
 #define DRAWING_API_H
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "benchmark.h"
+#include "draw/canvas.h"
 namespace OHOS {
 namespace Rosen {
+/*
+ * Times the dispatch of Drawing::Canvas draw calls, each with its pen and brush attached as the callers do, and
+ * drawing a scene immediately against replaying it from a Picture recorded once.
+ */
 class DrawingApi : public BenchMark {
 public:
     DrawingApi() {}
     ~DrawingApi() {}
 
-    virtual void Start() override {}
-    virtual void Stop() override {}
-    virtual void Test(SkCanvas* canvas, int width, int height) override {}
-    virtual void Output() override {}
+    virtual void Start() override;
+    virtual void Stop() override;
+    virtual void Test(SkCanvas* canvas, int width, int height) override;
+    virtual void Output() override;
+
+private:
+    using DrawFunc = std::function<void(Drawing::Canvas&, int)>;
+    void RunCase(const std::string& name, Drawing::Canvas& canvas, int count, const DrawFunc& draw);
+    void TestDrawCalls(Drawing::Canvas& canvas, int width, int height);
+    void TestPicture(Drawing::Canvas& canvas, int width, int height);
+
+    struct CaseResult {
+        std::string name;
+        int count;
+        double nsPerCall;
+    };
+    std::vector<CaseResult> results_;
 };
 }
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "typography_api.h"
+
+#include <chrono>
+
+#include "draw/canvas.h"
+#include "image/bitmap.h"
+#include "rosen_text/properties/typography_cache.h"
+#include "rosen_text/ui/font_collection.h"
+#include "rosen_text/ui/typography_create.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int ROUND_COUNT = 20;
+constexpr int RESIZE_STEPS = 4;
+constexpr double FONT_SIZE = 16.0;
+constexpr int LINE_HEIGHT = 24;
+constexpr int BYTES_PER_PIXEL = 4;
+constexpr double NS_PER_US = 1000.0;
+
+const std::vector<std::u16string> UI_STRINGS = {
+    u"Settings", u"Wi-Fi", u"Bluetooth", u"Mobile network", u"Airplane mode", u"Do not disturb",
+    u"Battery 85%", u"Display & brightness", u"Sounds & vibration", u"Notifications", u"Privacy",
+    u"OK", u"Cancel", u"Delete", u"Share", u"Copy", u"Paste", u"Select all", u"More",
+    u"Connected, no internet access", u"Tap to view all notifications from this app",
+    u"Your device will restart automatically at 02:00 to finish installing the update.",
+    u"The photo could not be saved because the storage is full. Free up some space and try again.",
+    u"设置", u"蓝牙", u"确定", u"取消", u"移动网络", u"飞行模式", u"勿扰模式", u"电池电量 85%",
+    u"存储空间不足，请清理后重试。", u"已连接，但无法访问互联网",
+};
+}
+
+void TypographyApi::Start()
+{
+    std::cout << "TypographyApi::Start+" << std::endl;
+    results_.clear();
+    corpus_ = UI_STRINGS;
+    rosen::TypographyCache::Instance().Clear();
+    rosen::TypographyCache::Instance().ResetStats();
+    std::cout << "TypographyApi::Start-" << std::endl;
+}
+
+void TypographyApi::Stop()
+{
+    std::cout << "TypographyApi::Stop+" << std::endl;
+    cacheStats_ = rosen::TypographyCache::Instance().GetStats();
+    rosen::TypographyCache::Instance().SetEnabled(true);
+    std::cout << "TypographyApi::Stop-" << std::endl;
+}
+
+std::unique_ptr<rosen::Typography> TypographyApi::BuildTypography(const std::u16string& text)
+{
+    rosen::TypographyStyle typographyStyle;
+    typographyStyle.fontSize_ = FONT_SIZE;
+    auto builder = rosen::TypographyCreate::CreateRosenBuilder(typographyStyle,
+        rosen::FontCollection::GetInstance());
+    rosen::TextStyle textStyle;
+    textStyle.color_ = Drawing::Color::COLOR_BLACK;
+    textStyle.fontSize_ = FONT_SIZE;
+    builder->PushStyle(textStyle);
+    builder->AddText(text);
+    builder->Pop();
+    return builder->Build();
+}
+
+void TypographyApi::RunCase(const std::string& name, int count, const LayoutFunc& layout)
+{
+    auto& cache = rosen::TypographyCache::Instance();
+    auto before = cache.GetStats();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        layout(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto after = cache.GetStats();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    results_.push_back({ name, count, ns / NS_PER_US / count, after.hitCount - before.hitCount,
+        after.missCount - before.missCount, after.skipCount - before.skipCount });
+}
+
+void TypographyApi::TestBuildAndLayout(int width)
+{
+    auto& cache = rosen::TypographyCache::Instance();
+    int count = ROUND_COUNT * static_cast<int>(corpus_.size());
+    auto buildAndLayout = [&](int i) {
+        auto typography = BuildTypography(corpus_[i % corpus_.size()]);
+        typography->Layout(width);
+    };
+
+    cache.SetEnabled(false);
+    RunCase("BuildLayoutUncached", count, buildAndLayout);
+    cache.SetEnabled(true);
+    cache.Clear();
+    RunCase("BuildLayoutCached", count, buildAndLayout);
+}
+
+void TypographyApi::TestRelayout(int width)
+{
+    auto& cache = rosen::TypographyCache::Instance();
+    std::vector<std::unique_ptr<rosen::Typography>> typographies;
+    for (auto& text : corpus_) {
+        typographies.push_back(BuildTypography(text));
+    }
+    int count = ROUND_COUNT * RESIZE_STEPS * static_cast<int>(typographies.size());
+    // a window dragged back and forth between its full and its half width
+    auto resize = [&](int i) {
+        int step = (i / static_cast<int>(typographies.size())) % RESIZE_STEPS;
+        typographies[i % typographies.size()]->Layout(width - step * width / (RESIZE_STEPS * 2));
+    };
+
+    cache.SetEnabled(false);
+    RunCase("ResizeUncached", count, resize);
+    cache.SetEnabled(true);
+    cache.Clear();
+    RunCase("ResizeCached", count, resize);
+    RunCase("SameWidth", count, [&](int i) { typographies[i % typographies.size()]->Layout(width); });
+}
+
+void TypographyApi::Test(SkCanvas* canvas, int width, int height)
+{
+    std::cout << "TypographyApi::Test+" << std::endl;
+    TestBuildAndLayout(width);
+    TestRelayout(width);
+
+    Drawing::Bitmap bitmap;
+    Drawing::BitmapFormat format { Drawing::COLORTYPE_RGBA_8888, Drawing::ALPHATYPE_PREMUL };
+    bitmap.Build(width, height, format);
+    Drawing::Canvas drawingCanvas;
+    drawingCanvas.Bind(bitmap);
+    drawingCanvas.Clear(Drawing::Color::COLOR_WHITE);
+    int y = 0;
+    for (auto& text : corpus_) {
+        if (y + LINE_HEIGHT > height) {
+            break;
+        }
+        auto typography = BuildTypography(text);
+        typography->Layout(width);
+        typography->Paint(&drawingCanvas, 0, y);
+        y += static_cast<int>(typography->GetHeight());
+    }
+
+    SkBitmap skBitmap;
+    skBitmap.installPixels(SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, kPremul_SkAlphaType),
+        bitmap.GetPixels(), width * BYTES_PER_PIXEL);
+    canvas->drawBitmap(skBitmap, 0, 0);
+    std::cout << "TypographyApi::Test-" << std::endl;
+}
+
+void TypographyApi::Output()
+{
+    for (auto& result : results_) {
+        std::cout << "TypographyApi " << result.name << ": " << result.count << " layouts, " <<
+            result.usPerLayout << " us/layout, hit " << result.hitCount << ", miss " << result.missCount <<
+            ", skipped " << result.skipCount << std::endl;
+    }
+    std::cout << "TypographyApi cache: " << cacheStats_.cachedCount << " entries, " << cacheStats_.memoryUsage <<
+        " / " << cacheStats_.memoryBudget << " bytes, insert " << cacheStats_.insertCount << ", evict " <<
+        cacheStats_.evictCount << ", reject " << cacheStats_.rejectCount << std::endl;
+}
+}
+}
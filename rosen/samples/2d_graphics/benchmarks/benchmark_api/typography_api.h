@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TYPOGRAPHY_API_H
+#define TYPOGRAPHY_API_H
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "rosen_text/properties/typography_cache.h"
+#include "rosen_text/ui/typography.h"
+namespace OHOS {
+namespace Rosen {
+/*
+ * Times building and laying out typographies for a corpus of UI strings, with the typography cache off and on,
+ * relaying them out at the widths of a resizing window and at an unchanged width.
+ */
+class TypographyApi : public BenchMark {
+public:
+    TypographyApi() {}
+    ~TypographyApi() {}
+
+    virtual void Start() override;
+    virtual void Stop() override;
+    virtual void Test(SkCanvas* canvas, int width, int height) override;
+    virtual void Output() override;
+
+private:
+    using LayoutFunc = std::function<void(int)>;
+    void RunCase(const std::string& name, int count, const LayoutFunc& layout);
+    std::unique_ptr<rosen::Typography> BuildTypography(const std::u16string& text);
+    void TestBuildAndLayout(int width);
+    void TestRelayout(int width);
+
+    struct CaseResult {
+        std::string name;
+        int count;
+        double usPerLayout;
+        uint64_t hitCount;
+        uint64_t missCount;
+        uint64_t skipCount;
+    };
+    std::vector<CaseResult> results_;
+    std::vector<std::u16string> corpus_;
+    rosen::TypographyCacheStats cacheStats_;
+};
+}
+}
+#endif
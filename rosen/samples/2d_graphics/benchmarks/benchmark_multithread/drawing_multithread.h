@@ -14,10 +14,16 @@
  */
 #ifndef DRAWING_MULTITHREAD_H
 #define DRAWING_MULTITHREAD_H
+#include <string>
+#include <vector>
+
 #include "benchmark.h"
+#include "draw/canvas.h"
+#include "image/bitmap.h"
 
 namespace OHOS {
 namespace Rosen {
+// Measures how the tiled raster of Drawing::Canvas scales from one thread to all cores.
 class DrawingMultithread : public BenchMark {
 public:
     DrawingMultithread() {}
@@ -26,7 +32,20 @@ public:
     virtual void Stop() override;
     virtual void Test(SkCanvas* canvas, int width, int height) override;
     virtual void Output() override;
+
+private:
+    void DrawScene(Drawing::Canvas& canvas, int width, int height);
+    // returns the average time of a frame in ms
+    double RunCase(Drawing::Bitmap& bitmap, uint32_t threadCount, int width, int height);
+
+    struct CaseResult {
+        std::string size;
+        uint32_t threadCount;
+        double frameTime;
+        bool isIdentical;
+    };
+    std::vector<CaseResult> results_;
 };
 }
 }
-#endif
\ No newline at end of file
+#endif
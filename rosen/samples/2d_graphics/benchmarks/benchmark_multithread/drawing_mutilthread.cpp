@@ -14,21 +14,136 @@
  */
 #include "drawing_multithread.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "draw/brush.h"
+#include "draw/path.h"
+#include "draw/pen.h"
+
 namespace OHOS {
 namespace Rosen {
+namespace {
+constexpr int SHAPE_COUNT = 2000;
+constexpr int FRAME_COUNT = 10;
+constexpr int UHD_WIDTH = 3840;
+constexpr int UHD_HEIGHT = 2160;
+constexpr int BYTES_PER_PIXEL = 4;
+constexpr int SHAPE_STEP = 37;
+constexpr int SHAPE_DIVISOR = 8;
+constexpr uint32_t COLOR_STEP = 0x00051A2B;
+constexpr uint32_t COLOR_ALPHA = 0xC0000000;
+}
+
 void DrawingMultithread::Start()
 {
+    std::cout << "DrawingMultithread::Start+" << std::endl;
+    results_.clear();
+    std::cout << "DrawingMultithread::Start-" << std::endl;
 }
 
 void DrawingMultithread::Stop()
 {
+    std::cout << "DrawingMultithread::Stop+" << std::endl;
+    std::cout << "DrawingMultithread::Stop-" << std::endl;
+}
+
+void DrawingMultithread::DrawScene(Drawing::Canvas& canvas, int width, int height)
+{
+    Drawing::scalar maxSize = static_cast<Drawing::scalar>(std::min(width, height)) / SHAPE_DIVISOR;
+    Drawing::Pen pen;
+    pen.SetAntiAlias(true);
+    pen.SetWidth(3); // stroke width
+    Drawing::Brush brush;
+    brush.SetAntiAlias(true);
+    canvas.Clear(Drawing::Color::COLOR_WHITE);
+    for (int i = 0; i < SHAPE_COUNT; i++) {
+        Drawing::scalar x = static_cast<Drawing::scalar>((i * SHAPE_STEP) % width);
+        Drawing::scalar y = static_cast<Drawing::scalar>((i * SHAPE_STEP / width * SHAPE_STEP + i) % height);
+        Drawing::scalar size = maxSize * ((i % SHAPE_DIVISOR) + 1) / SHAPE_DIVISOR;
+        brush.SetColor(static_cast<int>(COLOR_ALPHA | (COLOR_STEP * i & 0x00FFFFFF)));
+        pen.SetColor(static_cast<int>(COLOR_ALPHA | (~(COLOR_STEP * i) & 0x00FFFFFF)));
+        canvas.AttachBrush(brush);
+        canvas.AttachPen(pen);
+        if (i % 2 == 0) { // alternate circles and triangles
+            canvas.DrawCircle(Drawing::Point(x, y), size / 2); // radius is half of the size
+        } else {
+            Drawing::Path path;
+            path.MoveTo(x, y);
+            path.LineTo(x + size, y + size / 2); // the tip is in the middle of the right side
+            path.LineTo(x, y + size);
+            path.Close();
+            canvas.DrawPath(path);
+        }
+        canvas.DetachPen();
+        canvas.DetachBrush();
+    }
 }
+
+double DrawingMultithread::RunCase(Drawing::Bitmap& bitmap, uint32_t threadCount, int width, int height)
+{
+    Drawing::Canvas canvas;
+    canvas.SetRasterThreadCount(threadCount);
+    canvas.Bind(bitmap);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        DrawScene(canvas, width, height);
+        canvas.Flush();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / FRAME_COUNT;
+}
+
 void DrawingMultithread::Test(SkCanvas* canvas, int width, int height)
 {
+    std::cout << "DrawingMultithread::Test+" << std::endl;
+    uint32_t maxThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    Drawing::BitmapFormat format { Drawing::COLORTYPE_RGBA_8888, Drawing::ALPHATYPE_PREMUL };
+    std::vector<std::pair<int, int>> sizes = { { width, height }, { UHD_WIDTH, UHD_HEIGHT } };
+    Drawing::Bitmap screenBitmap;
+    for (auto& [w, h] : sizes) {
+        size_t bytes = static_cast<size_t>(w) * h * BYTES_PER_PIXEL;
+        Drawing::Bitmap reference;
+        reference.Build(w, h, format);
+        RunCase(reference, 1, w, h);
+
+        std::vector<uint32_t> threadCounts;
+        for (uint32_t count = 1; count < maxThreadCount; count *= 2) {
+            threadCounts.push_back(count);
+        }
+        threadCounts.push_back(maxThreadCount);
+        for (auto threadCount : threadCounts) {
+            Drawing::Bitmap bitmap;
+            bitmap.Build(w, h, format);
+            double frameTime = RunCase(bitmap, threadCount, w, h);
+            bool isIdentical = memcmp(bitmap.GetPixels(), reference.GetPixels(), bytes) == 0;
+            results_.push_back({ std::to_string(w) + "x" + std::to_string(h), threadCount, frameTime, isIdentical });
+        }
+        if (w == width && h == height) {
+            screenBitmap = reference;
+        }
+    }
+
+    SkBitmap skBitmap;
+    skBitmap.installPixels(SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, kPremul_SkAlphaType),
+        screenBitmap.GetPixels(), width * BYTES_PER_PIXEL);
+    canvas->drawBitmap(skBitmap, 0, 0);
+    std::cout << "DrawingMultithread::Test-" << std::endl;
 }
 
 void DrawingMultithread::Output()
 {
+    double baseTime = 0.0;
+    for (auto& result : results_) {
+        if (result.threadCount == 1) {
+            baseTime = result.frameTime;
+        }
+        std::cout << "DrawingMultithread " << result.size << ", " << result.threadCount << " threads: " <<
+            result.frameTime << " ms/frame, speedup " << (result.frameTime > 0 ? baseTime / result.frameTime : 0) <<
+            (result.isIdentical ? ", identical" : ", DIFFERS from single thread") << std::endl;
+    }
+}
 }
 }
-}
\ No newline at end of file
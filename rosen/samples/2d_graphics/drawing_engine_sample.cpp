@@ -178,6 +178,7 @@ void DrawingEngineSample::ExcuteBenchMark(SkCanvas* canvas)
     benchMark_->Start();
     benchMark_->Test(canvas, drawingWidth, drawingHeight);
     benchMark_->Stop();
+    benchMark_->Output();
 }
 
 SurfaceError DrawingEngineSample::DoDraw()
@@ -22,6 +22,7 @@
 #include "drawing_multithread.h"
 #include "drawing_singlethread.h"
 #include "drawing_api.h"
+#include "typography_api.h"
 
 #include "drawing_singlethread.h"
 
@@ -51,6 +52,10 @@ int32_t main(int32_t argc, char *argv[])
             std::cout << "new DrawingApi()" << std::endl;
             benchMark = new DrawingApi();
             break;
+        case BenchMarkName::TEXT:
+            std::cout << "new TypographyApi()" << std::endl;
+            benchMark = new TypographyApi();
+            break;
         default:
             break;
     }
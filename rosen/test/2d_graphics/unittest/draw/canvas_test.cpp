@@ -13,9 +13,19 @@
  * limitations under the License.
  */
 
+#include <cstring>
+#include <functional>
+
 #include "gtest/gtest.h"
 
+#include "c/drawing_canvas.h"
+#include "c/drawing_picture.h"
 #include "draw/canvas.h"
+#include "draw/recording_canvas.h"
+#include "effect/filter.h"
+#include "effect/mask_filter.h"
+#include "effect/shader_effect.h"
+#include "image/bitmap.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -36,6 +46,83 @@ void CanvasTest::TearDownTestCase() {}
 void CanvasTest::SetUp() {}
 void CanvasTest::TearDown() {}
 
+namespace {
+// not a multiple of the tile size, so the last row and column of tiles are cut
+constexpr int TILED_WIDTH = 700;
+constexpr int TILED_HEIGHT = 600;
+constexpr int TILE_EDGE = 256;
+constexpr uint32_t TILED_THREAD_COUNT = 4;
+
+// draws the scene once directly and once in tiles and compares the pixels
+bool IsTiledIdentical(const std::function<void(Canvas&)>& drawScene)
+{
+    BitmapFormat format { COLORTYPE_RGBA_8888, ALPHATYPE_PREMUL };
+    Bitmap direct;
+    direct.Build(TILED_WIDTH, TILED_HEIGHT, format);
+    Bitmap tiled;
+    tiled.Build(TILED_WIDTH, TILED_HEIGHT, format);
+    {
+        Canvas canvas;
+        canvas.Bind(direct);
+        drawScene(canvas);
+        canvas.Flush();
+    }
+    {
+        Canvas canvas;
+        canvas.SetRasterThreadCount(TILED_THREAD_COUNT);
+        canvas.Bind(tiled);
+        drawScene(canvas);
+        canvas.Flush();
+    }
+    size_t bytes = static_cast<size_t>(TILED_WIDTH) * TILED_HEIGHT * 4; // 4 bytes per RGBA pixel
+    return memcmp(direct.GetPixels(), tiled.GetPixels(), bytes) == 0;
+}
+
+// antialiased shapes, a gradient and transformed clips, all crossing tile edges
+void DrawTileSafeScene(Canvas& canvas)
+{
+    canvas.Clear(Color::COLOR_WHITE);
+    Brush brush;
+    brush.SetAntiAlias(true);
+    brush.SetColor(0x80FF8000);
+    canvas.AttachBrush(brush);
+    canvas.DrawCircle(Point(TILE_EDGE, TILE_EDGE), 100.5f);
+    canvas.DrawOval(Rect(TILE_EDGE - 90.3f, 20.7f, 2 * TILE_EDGE + 40.1f, 2 * TILE_EDGE + 33.3f));
+    canvas.DetachBrush();
+
+    canvas.Save();
+    canvas.Translate(13.5f, 7.25f);
+    canvas.Rotate(30.0f);
+    Path clip;
+    clip.AddCircle(TILE_EDGE + 50.0f, TILE_EDGE - 30.0f, 220.0f);
+    canvas.ClipPath(clip, ClipOp::INTERSECT);
+    brush.SetShaderEffect(ShaderEffect::CreateLinearGradient(Point(0, 0), Point(TILED_WIDTH, TILED_HEIGHT),
+        { Color::COLOR_RED, Color::COLOR_BLUE }, { 0.0f, 1.0f }, TileMode::CLAMP));
+    canvas.AttachBrush(brush);
+    canvas.DrawRect(Rect(0, 0, TILED_WIDTH, TILED_HEIGHT));
+    canvas.DetachBrush();
+    // the clip, the matrix and the save outlive the flush
+    canvas.Flush();
+    Pen pen;
+    pen.SetAntiAlias(true);
+    pen.SetWidth(3.5f);
+    pen.SetColor(Color::COLOR_GREEN);
+    canvas.AttachPen(pen);
+    canvas.DrawLine(Point(0, TILE_EDGE + 0.5f), Point(TILED_WIDTH, TILE_EDGE - 40.5f));
+    canvas.DetachPen();
+    canvas.Restore();
+
+    canvas.Save();
+    canvas.ClipRect(Rect(TILE_EDGE - 10, 0, TILED_WIDTH, TILE_EDGE + 100), ClipOp::DIFFERENCE);
+    brush.SetShaderEffect(nullptr);
+    brush.SetColor(0xC00080FF);
+    canvas.AttachBrush(brush);
+    canvas.DrawCircle(Point(TILE_EDGE, 2 * TILE_EDGE), 77.7f);
+    canvas.DetachBrush();
+    canvas.Restore();
+}
+}
+
 /**
  * @tc.name: CreateAndDestory001
  * @tc.desc:
@@ -48,6 +135,96 @@ HWTEST_F(CanvasTest, CreateAndDestory001, TestSize.Level1)
     auto canvas = std::make_unique<Canvas>();
     EXPECT_TRUE(nullptr != canvas);
 }
+
+/**
+ * @tc.name: GetType001
+ * @tc.desc: a recording canvas reports its type, a plain canvas does not
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CanvasTest, GetType001, TestSize.Level1)
+{
+    Canvas canvas;
+    EXPECT_EQ(canvas.GetType(), CanvasType::COMMON_CANVAS);
+    RecordingCanvas recordingCanvas(Rect(0, 0, 100, 100));
+    EXPECT_EQ(recordingCanvas.GetType(), CanvasType::RECORDING_CANVAS);
+    Canvas& base = recordingCanvas;
+    EXPECT_EQ(base.GetType(), CanvasType::RECORDING_CANVAS);
+}
+
+/**
+ * @tc.name: RecordingCanvasFinish001
+ * @tc.desc: OH_Drawing_RecordingCanvasFinish returns NULL for a canvas that is not a recording canvas
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CanvasTest, RecordingCanvasFinish001, TestSize.Level1)
+{
+    EXPECT_EQ(OH_Drawing_RecordingCanvasFinish(nullptr), nullptr);
+
+    OH_Drawing_Canvas* canvas = OH_Drawing_CanvasCreate();
+    ASSERT_NE(canvas, nullptr);
+    EXPECT_EQ(OH_Drawing_RecordingCanvasFinish(canvas), nullptr);
+    OH_Drawing_CanvasDestroy(canvas);
+
+    OH_Drawing_Canvas* recordingCanvas = OH_Drawing_RecordingCanvasCreate(100, 100);
+    ASSERT_NE(recordingCanvas, nullptr);
+    OH_Drawing_Picture* picture = OH_Drawing_RecordingCanvasFinish(recordingCanvas);
+    EXPECT_NE(picture, nullptr);
+    OH_Drawing_PictureDestroy(picture);
+    OH_Drawing_CanvasDestroy(recordingCanvas);
+}
+
+/**
+ * @tc.name: TiledRaster001
+ * @tc.desc: drawing in tiles gives the same pixels as drawing directly, also across a flush inside a saved clip
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CanvasTest, TiledRaster001, TestSize.Level1)
+{
+    EXPECT_TRUE(IsTiledIdentical(DrawTileSafeScene));
+}
+
+/**
+ * @tc.name: TiledRaster002
+ * @tc.desc: layers and blurs crossing tile edges give the same pixels as drawing directly
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CanvasTest, TiledRaster002, TestSize.Level1)
+{
+    EXPECT_TRUE(IsTiledIdentical([](Canvas& canvas) {
+        DrawTileSafeScene(canvas);
+        Brush layerBrush;
+        layerBrush.SetAlpha(0x80);
+        canvas.SaveLayer(Rect(TILE_EDGE - 50, TILE_EDGE - 50, TILE_EDGE + 50, TILE_EDGE + 50), layerBrush);
+        Brush brush;
+        brush.SetAntiAlias(true);
+        brush.SetColor(Color::COLOR_MAGENTA);
+        canvas.AttachBrush(brush);
+        canvas.DrawCircle(Point(TILE_EDGE, TILE_EDGE), 40.0f);
+        canvas.DetachBrush();
+        canvas.Restore();
+    }));
+
+    EXPECT_TRUE(IsTiledIdentical([](Canvas& canvas) {
+        DrawTileSafeScene(canvas);
+        Brush brush;
+        brush.SetAntiAlias(true);
+        brush.SetColor(Color::COLOR_BLACK);
+        Filter filter;
+        filter.SetMaskFilter(MaskFilter::CreateBlurMaskFilter(BlurType::NORMAL, 10.0f));
+        brush.SetFilter(filter);
+        canvas.AttachBrush(brush);
+        canvas.DrawRect(Rect(TILE_EDGE - 30, TILE_EDGE - 30, TILE_EDGE + 30, TILE_EDGE + 30));
+        canvas.DetachBrush();
+    }));
+}
 } // namespace Drawing
 } // namespace Rosen
 } // namespace OHOS
@@ -15,6 +15,11 @@
 
 #include "gtest/gtest.h"
 
+#include "draw/brush.h"
+#include "draw/canvas.h"
+#include "draw/color.h"
+#include "draw/recording_canvas.h"
+#include "image/bitmap.h"
 #include "image/picture.h"
 
 using namespace testing;
@@ -36,6 +41,32 @@ void PictureTest::TearDownTestCase() {}
 void PictureTest::SetUp() {}
 void PictureTest::TearDown() {}
 
+namespace {
+constexpr int CANVAS_SIZE = 100;
+
+// records a red square from (10, 10) to (30, 30).
+std::shared_ptr<Picture> RecordRedSquare()
+{
+    RecordingCanvas recordingCanvas(Rect(0, 0, CANVAS_SIZE, CANVAS_SIZE));
+    Brush brush(Color::COLOR_RED);
+    recordingCanvas.AttachBrush(brush);
+    recordingCanvas.DrawRect(Rect(10, 10, 30, 30));
+    recordingCanvas.DetachBrush();
+    return recordingCanvas.FinishRecording();
+}
+
+void Replay(const Picture& picture, Bitmap& bitmap)
+{
+    BitmapFormat format { COLORTYPE_RGBA_8888, ALPHATYPE_PREMUL };
+    bitmap.Build(CANVAS_SIZE, CANVAS_SIZE, format);
+    bitmap.ClearWithColor(Color::COLOR_TRANSPARENT);
+    Canvas canvas;
+    canvas.Bind(bitmap);
+    canvas.DrawPicture(picture);
+    canvas.Flush();
+}
+} // namespace
+
 /**
  * @tc.name: PictureCreateAndDestory001
  * @tc.desc:
@@ -49,6 +80,71 @@ HWTEST_F(PictureTest, PictureCreateAndDestory001, TestSize.Level1)
     std::unique_ptr<Picture> picture = std::make_unique<Picture>();
     ASSERT_TRUE(picture != nullptr);
 }
+
+/**
+ * @tc.name: RecordAndReplay001
+ * @tc.desc: a recorded picture draws what was recorded, and so does a copy of it
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PictureTest, RecordAndReplay001, TestSize.Level1)
+{
+    auto picture = RecordRedSquare();
+    ASSERT_TRUE(picture != nullptr);
+    EXPECT_GT(picture->ApproximateOpCount(), 0);
+
+    Bitmap bitmap;
+    Replay(*picture, bitmap);
+    EXPECT_EQ(bitmap.GetColor(20, 20), Color::COLOR_RED);
+    EXPECT_EQ(bitmap.GetColor(50, 50), Color::COLOR_TRANSPARENT);
+
+    Picture copy = *picture;
+    Bitmap copyBitmap;
+    Replay(copy, copyBitmap);
+    EXPECT_EQ(copyBitmap.GetColor(20, 20), Color::COLOR_RED);
+    EXPECT_EQ(copyBitmap.GetColor(50, 50), Color::COLOR_TRANSPARENT);
+}
+
+/**
+ * @tc.name: CullBounds001
+ * @tc.desc: the bounds of a picture cover what was drawn, not the whole recording canvas
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PictureTest, CullBounds001, TestSize.Level1)
+{
+    auto picture = RecordRedSquare();
+    ASSERT_TRUE(picture != nullptr);
+    // the recorder may pad the bounds by a pixel for antialiasing
+    constexpr scalar tolerance = 1.0f;
+    Rect bounds = picture->GetBounds();
+    EXPECT_NEAR(bounds.GetLeft(), 10.0f, tolerance);
+    EXPECT_NEAR(bounds.GetTop(), 10.0f, tolerance);
+    EXPECT_NEAR(bounds.GetRight(), 30.0f, tolerance);
+    EXPECT_NEAR(bounds.GetBottom(), 30.0f, tolerance);
+}
+
+/**
+ * @tc.name: FinishRecording001
+ * @tc.desc: finishing a recording starts a new, empty one
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PictureTest, FinishRecording001, TestSize.Level1)
+{
+    RecordingCanvas recordingCanvas(Rect(0, 0, CANVAS_SIZE, CANVAS_SIZE));
+    recordingCanvas.DrawRect(Rect(10, 10, 30, 30));
+    auto first = recordingCanvas.FinishRecording();
+    ASSERT_TRUE(first != nullptr);
+    EXPECT_GT(first->ApproximateOpCount(), 0);
+
+    auto second = recordingCanvas.FinishRecording();
+    ASSERT_TRUE(second != nullptr);
+    EXPECT_EQ(second->ApproximateOpCount(), 0);
+}
 } // namespace Drawing
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include "rosen_text/properties/font_collection_txt.h"
+#include "rosen_text/properties/indexed_font_manager.h"
+#include "rosen_text/properties/system_font_index.h"
+#include "rosen_text/ui/font_collection.h"
+#include "rosen_text/ui/typography_create.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace rosen {
+namespace {
+const std::string TEST_DIR = "/data/local/tmp/system_font_index_test";
+const std::string TEST_FONT_DIR = TEST_DIR + "/fonts";
+const std::string TEST_CACHE_PATH = TEST_DIR + "/index";
+constexpr uint16_t TEST_WEIGHT = 700;
+constexpr double MS_PER_S = 1000.0;
+constexpr size_t BYTES_PER_KB = 1024;
+
+void PutU16(std::string& out, uint16_t value)
+{
+    out.push_back(static_cast<char>(value >> 8));
+    out.push_back(static_cast<char>(value & 0xFF));
+}
+
+void PutU32(std::string& out, uint32_t value)
+{
+    PutU16(out, static_cast<uint16_t>(value >> 16));
+    PutU16(out, static_cast<uint16_t>(value & 0xFFFF));
+}
+
+// a font with only the tables the index reads: the family name, a bold italic OS/2 and a cmap mapping 'A'-'Z' and
+// U+4E2D
+std::string MakeTestFont(const std::string& family)
+{
+    std::string name;
+    PutU16(name, 0);                      // format
+    PutU16(name, 1);                      // count
+    PutU16(name, 6 + 12);                 // string offset after the header and one record
+    PutU16(name, 3);                      // windows
+    PutU16(name, 1);                      // unicode BMP
+    PutU16(name, 0x409);                  // english
+    PutU16(name, 1);                      // family name
+    PutU16(name, family.size() * 2);      // UTF-16 length
+    PutU16(name, 0);
+    for (char c : family) {
+        PutU16(name, static_cast<uint16_t>(c));
+    }
+
+    std::string os2(64, '\0');            // up to fsSelection
+    os2[4] = static_cast<char>(TEST_WEIGHT >> 8);
+    os2[5] = static_cast<char>(TEST_WEIGHT & 0xFF);
+    os2[7] = 5;                           // normal width
+    os2[63] = 1;                          // italic
+
+    std::string cmap;
+    PutU16(cmap, 0);                      // version
+    PutU16(cmap, 1);                      // one subtable
+    PutU16(cmap, 3);                      // windows
+    PutU16(cmap, 1);                      // unicode BMP
+    PutU32(cmap, 12);                     // subtable offset
+    const uint16_t segCount = 3;
+    PutU16(cmap, 4);                      // format 4
+    PutU16(cmap, 16 + segCount * 8);      // length
+    PutU16(cmap, 0);                      // language
+    PutU16(cmap, segCount * 2);
+    PutU16(cmap, 0);                      // search fields, unused by the index
+    PutU16(cmap, 0);
+    PutU16(cmap, 0);
+    for (uint16_t end : { 0x5A, 0x4E2D, 0xFFFF }) {
+        PutU16(cmap, end);
+    }
+    PutU16(cmap, 0);                      // reserved pad
+    for (uint16_t start : { 0x41, 0x4E2D, 0xFFFF }) {
+        PutU16(cmap, start);
+    }
+    for (uint16_t delta : { 0xFFC4, 0xB1D5, 0x0001 }) { // 'A' and U+4E2D to glyphs 5 and 2, 0xFFFF to glyph 0
+        PutU16(cmap, delta);
+    }
+    for (int i = 0; i < segCount; i++) {
+        PutU16(cmap, 0);                  // id range offsets
+    }
+
+    const std::vector<std::pair<uint32_t, std::string*>> tables = {
+        { 0x4f532f32, &os2 }, { 0x636d6170, &cmap }, { 0x6e616d65, &name } };
+    std::string font;
+    PutU32(font, 0x00010000);             // truetype outlines
+    PutU16(font, tables.size());
+    PutU16(font, 0);
+    PutU16(font, 0);
+    PutU16(font, 0);
+    uint32_t offset = 12 + tables.size() * 16;
+    for (auto& table : tables) {
+        PutU32(font, table.first);
+        PutU32(font, 0);                  // checksum
+        PutU32(font, offset);
+        PutU32(font, table.second->size());
+        offset += table.second->size();
+    }
+    for (auto& table : tables) {
+        font.append(*table.second);
+    }
+    return font;
+}
+
+void WriteFile(const std::string& path, const std::string& data)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size());
+}
+
+size_t GetRssKB()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t residentPages = 0;
+    statm >> pages >> residentPages;
+    return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / BYTES_PER_KB;
+}
+
+double GetElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * MS_PER_S;
+}
+}
+
+class SystemFontIndexTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void SystemFontIndexTest::SetUpTestCase() {}
+void SystemFontIndexTest::TearDownTestCase() {}
+
+void SystemFontIndexTest::SetUp()
+{
+    mkdir(TEST_DIR.c_str(), S_IRWXU);
+    mkdir(TEST_FONT_DIR.c_str(), S_IRWXU);
+    WriteFile(TEST_FONT_DIR + "/IndexTest-BoldItalic.ttf", MakeTestFont("Index Test"));
+    unlink(TEST_CACHE_PATH.c_str());
+}
+
+void SystemFontIndexTest::TearDown()
+{
+    unlink((TEST_FONT_DIR + "/IndexTest-BoldItalic.ttf").c_str());
+    unlink((TEST_FONT_DIR + "/IndexTest2.ttf").c_str());
+    unlink((TEST_FONT_DIR + "/FallbackSC.ttf").c_str());
+    unlink((TEST_FONT_DIR + "/FallbackTC.ttf").c_str());
+    unlink(TEST_CACHE_PATH.c_str());
+    rmdir(TEST_FONT_DIR.c_str());
+    rmdir(TEST_DIR.c_str());
+}
+
+/**
+ * @tc.name: ParseFont001
+ * @tc.desc: family, style and character coverage are read from the name, OS/2 and cmap tables
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemFontIndexTest, ParseFont001, TestSize.Level1)
+{
+    SystemFontIndex index;
+    ASSERT_TRUE(index.Load({ TEST_FONT_DIR }, ""));
+    ASSERT_EQ(index.GetFontCount(), 1u);
+    EXPECT_STREQ(index.GetFamily(0), "Index Test");
+    EXPECT_EQ(index.GetWeight(0), TEST_WEIGHT);
+    EXPECT_TRUE(index.IsItalic(0));
+    EXPECT_TRUE(index.HasCharacter(0, 'A'));
+    EXPECT_TRUE(index.HasCharacter(0, 'Z'));
+    EXPECT_TRUE(index.HasCharacter(0, 0x4E2D));
+    EXPECT_FALSE(index.HasCharacter(0, 'a'));
+    EXPECT_FALSE(index.HasCharacter(0, 0xFFFF));
+    EXPECT_EQ(index.FindFamily("index test").size(), 1u);
+    EXPECT_TRUE(index.FindFamily("sans-serif").empty());
+}
+
+/**
+ * @tc.name: ParseFont002
+ * @tc.desc: truncated and foreign files are skipped
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemFontIndexTest, ParseFont002, TestSize.Level1)
+{
+    std::string font = MakeTestFont("Index Test");
+    std::vector<FontIndexFace> faces;
+    for (size_t size = 0; size < font.size(); size++) {
+        SystemFontIndex::ParseFontData(reinterpret_cast<const uint8_t*>(font.data()), size, "", faces);
+    }
+    std::string text = "not a font file";
+    EXPECT_FALSE(SystemFontIndex::ParseFontData(reinterpret_cast<const uint8_t*>(text.data()), text.size(), "",
+        faces));
+    EXPECT_TRUE(SystemFontIndex::ParseFontData(reinterpret_cast<const uint8_t*>(font.data()), font.size(), "",
+        faces));
+}
+
+/**
+ * @tc.name: CacheFile001
+ * @tc.desc: the cache file is mapped while the fonts are unchanged and rebuilt once they change
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemFontIndexTest, CacheFile001, TestSize.Level1)
+{
+    {
+        SystemFontIndex index;
+        ASSERT_TRUE(index.Load({ TEST_FONT_DIR }, TEST_CACHE_PATH));
+        EXPECT_FALSE(index.IsLoadedFromCache());
+    }
+    {
+        SystemFontIndex index;
+        ASSERT_TRUE(index.Load({ TEST_FONT_DIR }, TEST_CACHE_PATH));
+        EXPECT_TRUE(index.IsLoadedFromCache());
+        EXPECT_STREQ(index.GetFamily(0), "Index Test");
+        EXPECT_TRUE(index.HasCharacter(0, 0x4E2D));
+    }
+
+    WriteFile(TEST_FONT_DIR + "/IndexTest2.ttf", MakeTestFont("Index Test 2"));
+    SystemFontIndex index;
+    ASSERT_TRUE(index.Load({ TEST_FONT_DIR }, TEST_CACHE_PATH));
+    EXPECT_FALSE(index.IsLoadedFromCache());
+    EXPECT_EQ(index.GetFontCount(), 2u);
+    EXPECT_EQ(index.GetFamilies().size(), 2u);
+
+    // a damaged cache file is ignored
+    WriteFile(TEST_CACHE_PATH, "RFIX");
+    SystemFontIndex damaged;
+    ASSERT_TRUE(damaged.Load({ TEST_FONT_DIR }, TEST_CACHE_PATH));
+    EXPECT_FALSE(damaged.IsLoadedFromCache());
+    EXPECT_EQ(damaged.GetFontCount(), 2u);
+}
+
+/**
+ * @tc.name: FallbackConfig001
+ * @tc.desc: the fallback families of a font config are read in file order, other sections are ignored
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemFontIndexTest, FallbackConfig001, TestSize.Level1)
+{
+    auto fallbacks = IndexedFontManager::ParseFallbackConfig(R"({
+        "fontdir": [ "/system/fonts/" ],
+        "generic": [ { "family": "HarmonyOS-Sans" } ],
+        "fallback": [ { "": [
+            { "und-Arab": "Fallback Arabic" },
+            { "zh-Hans": "Fallback SC" },
+            { "": "Fallback Symbols" }
+        ] } ]
+    })");
+    ASSERT_EQ(fallbacks.size(), 3u);
+    EXPECT_EQ(fallbacks[0].language, "und-Arab");
+    EXPECT_EQ(fallbacks[0].family, "Fallback Arabic");
+    EXPECT_EQ(fallbacks[1].family, "Fallback SC");
+    EXPECT_EQ(fallbacks[2].language, "");
+    EXPECT_TRUE(IndexedFontManager::ParseFallbackConfig("{ \"fallback\": ").empty());
+    EXPECT_TRUE(IndexedFontManager::LoadFallbackConfig(TEST_DIR + "/missing.json").empty());
+}
+
+/**
+ * @tc.name: Fallback001
+ * @tc.desc: fallback fonts follow the configured order, families of the requested languages first
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemFontIndexTest, Fallback001, TestSize.Level1)
+{
+    WriteFile(TEST_FONT_DIR + "/FallbackSC.ttf", MakeTestFont("Fallback SC"));
+    WriteFile(TEST_FONT_DIR + "/FallbackTC.ttf", MakeTestFont("Fallback TC"));
+    auto index = std::make_shared<SystemFontIndex>();
+    ASSERT_TRUE(index->Load({ TEST_FONT_DIR }, ""));
+    IndexedFontManager fontManager(index, { { "zh-Hans", "Fallback SC" }, { "zh-Hant", "Fallback TC" },
+        { "", "Not Installed" } });
+    SkFontStyle style;
+    auto match = [&fontManager, &index, &style](std::vector<const char*> bcp47, SkUnichar character) {
+        size_t font = fontManager.MatchFallbackFont(style, bcp47.data(), static_cast<int>(bcp47.size()), character);
+        return font < index->GetFontCount() ? std::string(index->GetFamily(font)) : std::string();
+    };
+
+    EXPECT_EQ(match({}, 0x4E2D), "Fallback SC");
+    EXPECT_EQ(match({ "zh-Hant-TW" }, 0x4E2D), "Fallback TC");
+    // the last language is the most significant one, languages without a family fall through to the next
+    EXPECT_EQ(match({ "zh-Hant", "zh-Hans" }, 0x4E2D), "Fallback SC");
+    EXPECT_EQ(match({ "zh-Hant", "ja" }, 0x4E2D), "Fallback TC");
+    // only the primary language matches, the configured order decides
+    EXPECT_EQ(match({ "zh-HK" }, 0x4E2D), "Fallback SC");
+    EXPECT_EQ(match({}, 'a'), "");
+
+    // without a fallback list any font covering the character is used
+    IndexedFontManager unconfigured(index);
+    EXPECT_LT(unconfigured.MatchFallbackFont(style, nullptr, 0, 0x4E2D), index->GetFontCount());
+}
+
+/**
+ * @tc.name: FirstTypography001
+ * @tc.desc: reports the time and memory the first typography costs with the indexed system fonts, and what
+ *           loading all system fonts eagerly adds on top
+ * @tc.type: PERF
+ */
+HWTEST_F(SystemFontIndexTest, FirstTypography001, TestSize.Level1)
+{
+    size_t rssBefore = GetRssKB();
+    auto start = std::chrono::steady_clock::now();
+    auto fontCollection = FontCollection::GetInstance();
+    TypographyStyle typographyStyle;
+    auto builder = TypographyCreate::CreateRosenBuilder(typographyStyle, fontCollection);
+    TextStyle textStyle;
+    builder->PushStyle(textStyle);
+    builder->AddText(u"Settings 设置");
+    builder->Pop();
+    auto typography = builder->Build();
+    typography->Layout(500); // 500: layout width
+    double firstTypographyMs = GetElapsedMs(start);
+    size_t rssFirstTypography = GetRssKB();
+    EXPECT_GT(typography->GetHeight(), 0);
+
+    auto fontCollectionTxt = static_cast<FontCollectionTxt*>(fontCollection->GetFontCollection().get());
+    auto indexedFontManager = fontCollectionTxt->GetIndexedFontManager();
+    start = std::chrono::steady_clock::now();
+    fontCollectionTxt->LoadSystemFont();
+    double loadSystemFontMs = GetElapsedMs(start);
+    size_t rssAllFonts = GetRssKB();
+
+    std::cout << "first typography: " << firstTypographyMs << " ms, +" << rssFirstTypography - rssBefore <<
+        " KB RSS, " << (indexedFontManager != nullptr ? "indexed system fonts, " +
+        std::to_string(indexedFontManager->GetMaterializedCount()) + " typefaces loaded" : "eager system fonts") <<
+        std::endl;
+    std::cout << "eager system font loading: +" << loadSystemFontMs << " ms, +" << rssAllFonts - rssFirstTypography <<
+        " KB RSS" << std::endl;
+}
+} // namespace rosen
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "rosen_text/properties/font_collection_txt.h"
+#include "rosen_text/properties/typography_cache.h"
+#include "rosen_text/ui/font_collection.h"
+#include "rosen_text/ui/typography_create.h"
+#include "txt/paragraph_txt.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace rosen {
+namespace {
+constexpr size_t ENTRY_BYTES = 1024;
+constexpr double LAYOUT_WIDTH = 300.25;
+}
+
+class TypographyCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<Typography> BuildTypography(const std::shared_ptr<FontCollection>& fontCollection);
+};
+
+void TypographyCacheTest::SetUpTestCase() {}
+void TypographyCacheTest::TearDownTestCase() {}
+
+void TypographyCacheTest::SetUp()
+{
+    TypographyCache::Instance().Clear();
+    TypographyCache::Instance().ResetStats();
+}
+
+void TypographyCacheTest::TearDown()
+{
+    TypographyCache::Instance().Clear();
+}
+
+std::unique_ptr<Typography> TypographyCacheTest::BuildTypography(const std::shared_ptr<FontCollection>& fontCollection)
+{
+    TypographyStyle typographyStyle;
+    auto builder = TypographyCreate::CreateRosenBuilder(typographyStyle, fontCollection);
+    TextStyle textStyle;
+    builder->PushStyle(textStyle);
+    builder->AddText(u"Settings 设置");
+    builder->Pop();
+    return builder->Build();
+}
+
+/**
+ * @tc.name: FindAndInsert001
+ * @tc.desc: a paragraph is found once inserted, and the lookups are counted as misses and hits
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(TypographyCacheTest, FindAndInsert001, TestSize.Level1)
+{
+    TypographyCache cache(ENTRY_BYTES * 4);
+    EXPECT_EQ(cache.Find("key", LAYOUT_WIDTH), nullptr);
+    auto paragraph = std::make_shared<txt::ParagraphTxt>();
+    EXPECT_TRUE(cache.Insert("key", LAYOUT_WIDTH, paragraph, ENTRY_BYTES));
+    EXPECT_EQ(cache.Find("key", LAYOUT_WIDTH), paragraph);
+    EXPECT_EQ(cache.Find("other key", LAYOUT_WIDTH), nullptr);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hitCount, 1u);
+    EXPECT_EQ(stats.missCount, 2u);
+    EXPECT_EQ(stats.insertCount, 1u);
+    EXPECT_EQ(stats.cachedCount, 1u);
+    EXPECT_EQ(stats.memoryUsage, ENTRY_BYTES);
+
+    // a paragraph bigger than the whole budget is not cached
+    EXPECT_FALSE(cache.Insert("big", LAYOUT_WIDTH, std::make_shared<txt::ParagraphTxt>(), ENTRY_BYTES * 5));
+    EXPECT_EQ(cache.GetStats().rejectCount, 1u);
+
+    cache.SetEnabled(false);
+    EXPECT_EQ(cache.Find("key", LAYOUT_WIDTH), nullptr);
+    EXPECT_EQ(cache.GetStats().cachedCount, 0u);
+}
+
+/**
+ * @tc.name: WidthBucket001
+ * @tc.desc: widths in the same pixel share an entry, widths in another pixel do not
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(TypographyCacheTest, WidthBucket001, TestSize.Level1)
+{
+    TypographyCache cache(ENTRY_BYTES * 4);
+    auto paragraph = std::make_shared<txt::ParagraphTxt>();
+    EXPECT_TRUE(cache.Insert("key", 300.0, paragraph, ENTRY_BYTES));
+    EXPECT_EQ(cache.Find("key", 300.0), paragraph);
+    EXPECT_EQ(cache.Find("key", 300.9), paragraph);
+    EXPECT_EQ(cache.Find("key", 299.9), nullptr);
+    EXPECT_EQ(cache.Find("key", 301.0), nullptr);
+}
+
+/**
+ * @tc.name: Evict001
+ * @tc.desc: going over the memory budget evicts the least recently used paragraphs first
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(TypographyCacheTest, Evict001, TestSize.Level1)
+{
+    TypographyCache cache(ENTRY_BYTES * 3);
+    for (auto key : { "a", "b", "c" }) {
+        EXPECT_TRUE(cache.Insert(key, LAYOUT_WIDTH, std::make_shared<txt::ParagraphTxt>(), ENTRY_BYTES));
+    }
+    // "a" becomes the most recently used, leaving "b" the least
+    EXPECT_NE(cache.Find("a", LAYOUT_WIDTH), nullptr);
+    EXPECT_TRUE(cache.Insert("d", LAYOUT_WIDTH, std::make_shared<txt::ParagraphTxt>(), ENTRY_BYTES));
+
+    EXPECT_EQ(cache.Find("b", LAYOUT_WIDTH), nullptr);
+    for (auto key : { "a", "c", "d" }) {
+        EXPECT_NE(cache.Find(key, LAYOUT_WIDTH), nullptr);
+    }
+    EXPECT_EQ(cache.GetStats().evictCount, 1u);
+    EXPECT_EQ(cache.GetStats().memoryUsage, ENTRY_BYTES * 3);
+
+    cache.SetMemoryBudget(ENTRY_BYTES);
+    EXPECT_EQ(cache.GetStats().cachedCount, 1u);
+    EXPECT_NE(cache.Find("d", LAYOUT_WIDTH), nullptr);
+}
+
+/**
+ * @tc.name: Thread001
+ * @tc.desc: a paragraph is only found on the thread which inserted it
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(TypographyCacheTest, Thread001, TestSize.Level1)
+{
+    TypographyCache cache(ENTRY_BYTES * 4);
+    auto paragraph = std::make_shared<txt::ParagraphTxt>();
+    EXPECT_TRUE(cache.Insert("key", LAYOUT_WIDTH, paragraph, ENTRY_BYTES));
+    std::shared_ptr<txt::Paragraph> found = paragraph;
+    std::thread([&cache, &found]() { found = cache.Find("key", LAYOUT_WIDTH); }).join();
+    EXPECT_EQ(found, nullptr);
+    EXPECT_EQ(cache.Find("key", LAYOUT_WIDTH), paragraph);
+}
+
+/**
+ * @tc.name: FontGeneration001
+ * @tc.desc: typographies built again share the cached paragraph until fonts are loaded into the collection
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(TypographyCacheTest, FontGeneration001, TestSize.Level1)
+{
+    auto fontCollection = std::make_shared<FontCollection>();
+    auto collectionTxt = std::static_pointer_cast<FontCollectionTxt>(fontCollection->GetFontCollection());
+    ASSERT_NE(collectionTxt, nullptr);
+    uint64_t generation = collectionTxt->GetGeneration();
+
+    auto first = BuildTypography(fontCollection);
+    first->Layout(LAYOUT_WIDTH);
+    auto second = BuildTypography(fontCollection);
+    second->Layout(LAYOUT_WIDTH);
+    auto stats = TypographyCache::Instance().GetStats();
+    EXPECT_EQ(stats.missCount, 1u);
+    EXPECT_EQ(stats.hitCount, 1u);
+    EXPECT_DOUBLE_EQ(second->GetHeight(), first->GetHeight());
+
+    // the data is no font, loading it still renews the generation as fonts may resolve differently afterwards
+    const uint8_t fontData[] = { 0, 1, 0, 0 };
+    fontCollection->LoadFontFromList(fontData, sizeof(fontData), "TypographyCacheTest");
+    EXPECT_NE(collectionTxt->GetGeneration(), generation);
+    EXPECT_EQ(TypographyCache::Instance().GetStats().cachedCount, 0u);
+
+    auto third = BuildTypography(fontCollection);
+    third->Layout(LAYOUT_WIDTH);
+    stats = TypographyCache::Instance().GetStats();
+    EXPECT_EQ(stats.missCount, 2u);
+    EXPECT_EQ(stats.hitCount, 1u);
+}
+} // namespace rosen
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "surface.h"
+#include "pipeline/rs_egl_image_manager.h"
+#include "render_context/render_context.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+class TestConsumerListener : public IBufferConsumerListener {
+public:
+    void OnBufferAvailable() override {}
+};
+}
+
+class RSEglImageManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // requests count buffers from fresh surfaces, the buffers stay alive until TearDown.
+    std::vector<sptr<SurfaceBuffer>> RequestBuffers(int count);
+    // maps every buffer for pid, then flushes one frame.
+    void DrawFrame(const std::vector<sptr<SurfaceBuffer>>& buffers, pid_t pid);
+    void SkipFrames(uint64_t count);
+
+    static inline BufferRequestConfig requestConfig = {
+        .width = 0x100,
+        .height = 0x100,
+        .strideAlignment = 0x8,
+        .format = PIXEL_FMT_RGBA_8888,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    static inline RenderContext* renderContext = nullptr;
+    std::shared_ptr<RSEglImageManager> manager;
+    std::vector<sptr<Surface>> surfaces;
+};
+
+void RSEglImageManagerTest::SetUpTestCase()
+{
+    renderContext = RenderContextFactory::GetInstance().CreateEngine();
+    renderContext->InitializeEglContext();
+}
+
+void RSEglImageManagerTest::TearDownTestCase() {}
+
+void RSEglImageManagerTest::SetUp()
+{
+    manager = std::make_shared<RSEglImageManager>(renderContext->GetEGLDisplay());
+}
+
+void RSEglImageManagerTest::TearDown()
+{
+    manager = nullptr;
+    surfaces.clear();
+}
+
+std::vector<sptr<SurfaceBuffer>> RSEglImageManagerTest::RequestBuffers(int count)
+{
+    std::vector<sptr<SurfaceBuffer>> buffers;
+    while (static_cast<int>(buffers.size()) < count) {
+        auto csurf = Surface::CreateSurfaceAsConsumer("RSEglImageManagerTest");
+        // the queue hands out no buffers without a consumer listener
+        sptr<IBufferConsumerListener> listener = new TestConsumerListener();
+        csurf->RegisterConsumerListener(listener);
+        auto psurf = Surface::CreateSurfaceAsProducer(csurf->GetProducer());
+        int queueSize = std::min(count - static_cast<int>(buffers.size()), SURFACE_MAX_QUEUE_SIZE);
+        psurf->SetQueueSize(queueSize);
+        for (int i = 0; i < queueSize; i++) {
+            sptr<SurfaceBuffer> buffer;
+            sptr<SyncFence> requestFence = SyncFence::INVALID_FENCE;
+            if (psurf->RequestBuffer(buffer, requestFence, requestConfig) != GSERROR_OK || buffer == nullptr) {
+                return buffers;
+            }
+            buffers.push_back(buffer);
+        }
+        surfaces.push_back(csurf);
+        surfaces.push_back(psurf);
+    }
+    return buffers;
+}
+
+void RSEglImageManagerTest::DrawFrame(const std::vector<sptr<SurfaceBuffer>>& buffers, pid_t pid)
+{
+    for (const auto& buffer : buffers) {
+        manager->MapEglImageFromSurfaceBuffer(buffer, SyncFence::INVALID_FENCE, pid);
+    }
+    manager->ShrinkCachesIfNeeded();
+}
+
+void RSEglImageManagerTest::SkipFrames(uint64_t count)
+{
+    for (uint64_t i = 0; i < count; i++) {
+        manager->ShrinkCachesIfNeeded();
+    }
+}
+
+/**
+ * @tc.name: MapHit001
+ * @tc.desc: mapping the same buffer again reuses its image and texture
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSEglImageManagerTest, MapHit001, TestSize.Level1)
+{
+    auto buffers = RequestBuffers(1);
+    ASSERT_EQ(buffers.size(), 1);
+    GLuint textureId = manager->MapEglImageFromSurfaceBuffer(buffers[0], SyncFence::INVALID_FENCE, 1);
+    EXPECT_NE(textureId, 0);
+    EXPECT_EQ(manager->MapEglImageFromSurfaceBuffer(buffers[0], SyncFence::INVALID_FENCE, 1), textureId);
+    EXPECT_EQ(manager->GetImageCacheCount(), 1);
+}
+
+/**
+ * @tc.name: Evict001
+ * @tc.desc: images over MAX_CACHE_SIZE are evicted least recently used first once they went unused
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSEglImageManagerTest, Evict001, TestSize.Level1)
+{
+    constexpr size_t extra = 4;
+    auto buffers = RequestBuffers(RSEglImageManager::MAX_CACHE_SIZE + extra);
+    ASSERT_EQ(buffers.size(), RSEglImageManager::MAX_CACHE_SIZE + extra);
+    DrawFrame(buffers, 0);
+    EXPECT_EQ(manager->GetImageCacheCount(), RSEglImageManager::MAX_CACHE_SIZE + extra);
+
+    SkipFrames(RSEglImageManager::RECENT_USE_FRAMES);
+    EXPECT_EQ(manager->GetImageCacheCount(), RSEglImageManager::MAX_CACHE_SIZE);
+    for (size_t i = 0; i < extra; i++) {
+        EXPECT_FALSE(manager->IsImageCached(buffers[i]->GetSeqNum()));
+    }
+    EXPECT_TRUE(manager->IsImageCached(buffers.back()->GetSeqNum()));
+}
+
+/**
+ * @tc.name: Evict002
+ * @tc.desc: images used in the last RECENT_USE_FRAMES frames are kept even over MAX_CACHE_SIZE
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSEglImageManagerTest, Evict002, TestSize.Level1)
+{
+    auto buffers = RequestBuffers(RSEglImageManager::MAX_CACHE_SIZE + 1);
+    ASSERT_EQ(buffers.size(), RSEglImageManager::MAX_CACHE_SIZE + 1);
+    for (uint64_t frame = 0; frame <= RSEglImageManager::RECENT_USE_FRAMES; frame++) {
+        DrawFrame(buffers, 0);
+    }
+    EXPECT_EQ(manager->GetImageCacheCount(), RSEglImageManager::MAX_CACHE_SIZE + 1);
+}
+
+/**
+ * @tc.name: Quota001
+ * @tc.desc: a process over MAX_CACHE_SIZE_PER_PROCESS loses its own unused images, not those of others
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSEglImageManagerTest, Quota001, TestSize.Level1)
+{
+    constexpr pid_t churningPid = 1;
+    constexpr pid_t otherPid = 2;
+    constexpr size_t extra = 2;
+    auto otherBuffers = RequestBuffers(1);
+    auto churningBuffers = RequestBuffers(RSEglImageManager::MAX_CACHE_SIZE_PER_PROCESS + extra);
+    ASSERT_EQ(otherBuffers.size(), 1);
+    ASSERT_EQ(churningBuffers.size(), RSEglImageManager::MAX_CACHE_SIZE_PER_PROCESS + extra);
+    DrawFrame(otherBuffers, otherPid);
+    DrawFrame(churningBuffers, churningPid);
+
+    SkipFrames(RSEglImageManager::RECENT_USE_FRAMES);
+    EXPECT_EQ(manager->GetImageCacheCount(), RSEglImageManager::MAX_CACHE_SIZE_PER_PROCESS + 1);
+    EXPECT_TRUE(manager->IsImageCached(otherBuffers[0]->GetSeqNum()));
+    for (size_t i = 0; i < extra; i++) {
+        EXPECT_FALSE(manager->IsImageCached(churningBuffers[i]->GetSeqNum()));
+    }
+}
+
+/**
+ * @tc.name: Quota002
+ * @tc.desc: a process drawing more live buffers than its quota every frame keeps all of their images
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSEglImageManagerTest, Quota002, TestSize.Level1)
+{
+    auto buffers = RequestBuffers(RSEglImageManager::MAX_CACHE_SIZE_PER_PROCESS + 1);
+    ASSERT_EQ(buffers.size(), RSEglImageManager::MAX_CACHE_SIZE_PER_PROCESS + 1);
+    DrawFrame(buffers, 1);
+    std::vector<GLuint> textureIds;
+    for (const auto& buffer : buffers) {
+        textureIds.push_back(manager->MapEglImageFromSurfaceBuffer(buffer, SyncFence::INVALID_FENCE, 1));
+    }
+    for (uint64_t frame = 0; frame <= RSEglImageManager::RECENT_USE_FRAMES; frame++) {
+        DrawFrame(buffers, 1);
+    }
+    for (size_t i = 0; i < buffers.size(); i++) {
+        EXPECT_EQ(manager->MapEglImageFromSurfaceBuffer(buffers[i], SyncFence::INVALID_FENCE, 1), textureIds[i]);
+    }
+}
+
+/**
+ * @tc.name: ReleaseImageCache001
+ * @tc.desc: the delete buffer listener drops the image of the deleted buffer only
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSEglImageManagerTest, ReleaseImageCache001, TestSize.Level1)
+{
+    auto buffers = RequestBuffers(2);
+    ASSERT_EQ(buffers.size(), 2);
+    DrawFrame(buffers, 1);
+    manager->ReleaseImageCache(buffers[0]->GetSeqNum());
+    EXPECT_FALSE(manager->IsImageCached(buffers[0]->GetSeqNum()));
+    EXPECT_TRUE(manager->IsImageCached(buffers[1]->GetSeqNum()));
+
+    // releasing twice or an unknown buffer is harmless
+    manager->ReleaseImageCache(buffers[0]->GetSeqNum());
+    EXPECT_EQ(manager->GetImageCacheCount(), 1);
+
+    // the released buffer gets a new image when it is drawn again
+    EXPECT_NE(manager->MapEglImageFromSurfaceBuffer(buffers[0], SyncFence::INVALID_FENCE, 1), 0);
+    EXPECT_EQ(manager->GetImageCacheCount(), 2);
+}
+} // namespace OHOS::Rosen
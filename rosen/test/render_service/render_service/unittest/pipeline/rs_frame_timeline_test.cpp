@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "pipeline/rs_frame_timeline.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSFrameTimelineTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSFrameTimelineTest::SetUpTestCase() {}
+void RSFrameTimelineTest::TearDownTestCase() {}
+void RSFrameTimelineTest::SetUp() {}
+void RSFrameTimelineTest::TearDown() {}
+
+/**
+ * @tc.name: RecordFrame001
+ * @tc.desc: counters and stage durations end up in the frame record
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSFrameTimelineTest, RecordFrame001, TestSize.Level1)
+{
+    RSFrameTimeline timeline;
+    timeline.BeginFrame(1000);
+    timeline.BeginStage(RSFrameStage::RENDER);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    timeline.EndStage(RSFrameStage::RENDER);
+    timeline.AddCommandCount(3);
+    timeline.AddCommandCount(2);
+    timeline.AddVisitedNodeCount(7);
+    timeline.AddDirtyArea(100);
+    timeline.AddComposedLayerCount(4);
+    timeline.EndFrame();
+
+    ASSERT_EQ(timeline.GetRecordCount(), 1u);
+    const auto& record = timeline.GetRecord(0);
+    EXPECT_EQ(record.vsyncTimestamp, 1000u);
+    EXPECT_EQ(record.commandCount, 5u);
+    EXPECT_EQ(record.visitedNodeCount, 7u);
+    EXPECT_EQ(record.dirtyArea, 100u);
+    EXPECT_EQ(record.composedLayerCount, 4u);
+    EXPECT_GE(record.stageDurations[static_cast<size_t>(RSFrameStage::RENDER)], 1000000u);
+    EXPECT_GE(record.totalDuration, record.stageDurations[static_cast<size_t>(RSFrameStage::RENDER)]);
+    EXPECT_GE(timeline.GetPercentile(RSFrameStage::RENDER, 50.0), 1000000u);
+}
+
+/**
+ * @tc.name: RingWrap001
+ * @tc.desc: the ring keeps the newest RING_SIZE frames, oldest first
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSFrameTimelineTest, RingWrap001, TestSize.Level1)
+{
+    RSFrameTimeline timeline;
+    const uint64_t frames = RSFrameTimeline::RING_SIZE + 10;
+    for (uint64_t i = 0; i < frames; i++) {
+        timeline.BeginFrame(i);
+        timeline.EndFrame();
+    }
+    ASSERT_EQ(timeline.GetRecordCount(), RSFrameTimeline::RING_SIZE);
+    EXPECT_EQ(timeline.GetRecord(0).vsyncTimestamp, 10u);
+    EXPECT_EQ(timeline.GetRecord(RSFrameTimeline::RING_SIZE - 1).vsyncTimestamp, frames - 1);
+
+    timeline.Reset();
+    EXPECT_EQ(timeline.GetRecordCount(), 0u);
+    EXPECT_EQ(timeline.GetPercentile(RSFrameStage::STAGE_COUNT, 99.0), 0u);
+}
+
+/**
+ * @tc.name: DumpAndExport001
+ * @tc.desc: dump prints the percentiles and export writes header plus records
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSFrameTimelineTest, DumpAndExport001, TestSize.Level1)
+{
+    RSFrameTimeline timeline;
+    for (uint64_t i = 0; i < 3; i++) {
+        timeline.BeginFrame(i);
+        timeline.EndFrame();
+    }
+    std::string dumpString;
+    timeline.Dump(dumpString);
+    EXPECT_NE(dumpString.find("FrameTimeline"), std::string::npos);
+    EXPECT_NE(dumpString.find("ProcessCommand"), std::string::npos);
+
+    const std::string path = "/data/rs_frame_timeline_test.bin";
+    ASSERT_TRUE(timeline.ExportToFile(path));
+    FILE* file = fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    uint32_t header[4] = {};
+    EXPECT_EQ(fread(header, sizeof(header), 1, file), 1u);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    remove(path.c_str());
+    EXPECT_EQ(header[0], RSFrameTimeline::EXPORT_MAGIC);
+    EXPECT_EQ(header[3], 3u);
+    EXPECT_EQ(static_cast<size_t>(size), sizeof(header) + 3 * sizeof(RSFrameRecord));
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "common/rs_obj_abs_geometry.h"
+#include "pipeline/rs_display_render_node.h"
+#include "pipeline/rs_occlusion_culling.h"
+#include "pipeline/rs_surface_render_node.h"
+#include "render/rs_filter.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSOcclusionCullingTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSOcclusionCullingTest::SetUpTestCase() {}
+void RSOcclusionCullingTest::TearDownTestCase() {}
+void RSOcclusionCullingTest::SetUp() {}
+void RSOcclusionCullingTest::TearDown() {}
+
+namespace {
+constexpr int SCREEN_WIDTH = 1080;
+constexpr int SCREEN_HEIGHT = 2340;
+constexpr int STATUS_BAR_HEIGHT = 100;
+const RectI FULL_SCREEN(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+RSOcclusionLayer OpaqueLayer(const RectI& rect)
+{
+    return { rect, rect, false };
+}
+
+RSOcclusionLayer TranslucentLayer(const RectI& rect)
+{
+    return { rect, RectI(), false };
+}
+
+std::shared_ptr<RSSurfaceRenderNode> FullScreenSurface(NodeId id, const Color& backgroundColor)
+{
+    RSSurfaceRenderNodeConfig config;
+    config.id = id;
+    auto node = std::make_shared<RSSurfaceRenderNode>(config);
+    auto& property = node->GetMutableRenderProperties();
+    property.SetBounds(Vector4f(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+    property.SetBackgroundColor(backgroundColor);
+    auto geoPtr = std::static_pointer_cast<RSObjAbsGeometry>(property.GetBoundsGeometry());
+    geoPtr->UpdateByMatrixFromParent(nullptr);
+    geoPtr->UpdateByMatrixFromSelf();
+    return node;
+}
+}
+
+/**
+ * @tc.name: Region001
+ * @tc.desc: a rect is covered only if the union of the region contains all of it
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, Region001, TestSize.Level1)
+{
+    RSOcclusionRegion region;
+    EXPECT_FALSE(region.Covers(RectI(0, 0, 10, 10)));
+    region.Add(RectI(0, 0, 10, 5));
+    EXPECT_FALSE(region.Covers(RectI(0, 0, 10, 10)));
+    region.Add(RectI(0, 5, 5, 5));
+    EXPECT_FALSE(region.Covers(RectI(0, 0, 10, 10)));
+    region.Add(RectI(5, 5, 5, 5));
+    EXPECT_TRUE(region.Covers(RectI(0, 0, 10, 10)));
+    EXPECT_TRUE(region.Covers(RectI(2, 2, 6, 6)));
+    EXPECT_FALSE(region.Covers(RectI(2, 2, 6, 9)));
+    EXPECT_FALSE(region.Covers(RectI()));
+}
+
+/**
+ * @tc.name: FullScreenApp001
+ * @tc.desc: an opaque full screen app hides the launcher and the wallpaper below, not the status bar above
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, FullScreenApp001, TestSize.Level1)
+{
+    std::vector<RSOcclusionLayer> layers = {
+        OpaqueLayer(FULL_SCREEN),                                // wallpaper
+        TranslucentLayer(FULL_SCREEN),                           // launcher
+        OpaqueLayer(FULL_SCREEN),                                // full screen app
+        TranslucentLayer(RectI(0, 0, SCREEN_WIDTH, STATUS_BAR_HEIGHT)), // status bar
+    };
+    auto stats = RSOcclusionCulling::CalcOcclusion(layers);
+    EXPECT_TRUE(layers[0].isOccluded);
+    EXPECT_TRUE(layers[1].isOccluded);
+    EXPECT_FALSE(layers[2].isOccluded);
+    EXPECT_FALSE(layers[3].isOccluded);
+    EXPECT_EQ(stats.layerCount, 4u);
+    EXPECT_EQ(stats.occludedCount, 2u);
+    EXPECT_EQ(stats.occludedArea, 2u * SCREEN_WIDTH * SCREEN_HEIGHT);
+}
+
+/**
+ * @tc.name: TranslucentApp001
+ * @tc.desc: a translucent full screen window hides nothing
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, TranslucentApp001, TestSize.Level1)
+{
+    std::vector<RSOcclusionLayer> layers = {
+        OpaqueLayer(FULL_SCREEN),
+        TranslucentLayer(FULL_SCREEN),
+    };
+    auto stats = RSOcclusionCulling::CalcOcclusion(layers);
+    EXPECT_FALSE(layers[0].isOccluded);
+    EXPECT_EQ(stats.occludedCount, 0u);
+}
+
+/**
+ * @tc.name: SplitScreen001
+ * @tc.desc: two opaque half screen windows together hide a window behind both of them
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, SplitScreen001, TestSize.Level1)
+{
+    std::vector<RSOcclusionLayer> layers = {
+        OpaqueLayer(FULL_SCREEN),
+        TranslucentLayer(RectI(100, 100, 500, 2000)),
+        OpaqueLayer(RectI(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT / 2)),
+        OpaqueLayer(RectI(0, SCREEN_HEIGHT / 2, SCREEN_WIDTH, SCREEN_HEIGHT / 2)),
+    };
+    auto stats = RSOcclusionCulling::CalcOcclusion(layers);
+    EXPECT_TRUE(layers[0].isOccluded);
+    EXPECT_TRUE(layers[1].isOccluded);
+    EXPECT_FALSE(layers[2].isOccluded);
+    EXPECT_FALSE(layers[3].isOccluded);
+    EXPECT_EQ(stats.occludedCount, 2u);
+}
+
+/**
+ * @tc.name: FloatingWindow001
+ * @tc.desc: a partially covered window is still drawn
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, FloatingWindow001, TestSize.Level1)
+{
+    std::vector<RSOcclusionLayer> layers = {
+        OpaqueLayer(RectI(0, 0, 500, 500)),
+        OpaqueLayer(RectI(100, 100, 500, 500)),
+        OpaqueLayer(RectI(200, 200, 100, 100)),
+    };
+    auto stats = RSOcclusionCulling::CalcOcclusion(layers);
+    EXPECT_FALSE(layers[0].isOccluded);
+    EXPECT_FALSE(layers[1].isOccluded);
+    EXPECT_FALSE(layers[2].isOccluded);
+    EXPECT_EQ(stats.occludedCount, 0u);
+}
+
+/**
+ * @tc.name: Apply001
+ * @tc.desc: surface nodes without buffers are never opaque, so nothing gets occluded
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, Apply001, TestSize.Level1)
+{
+    RSDisplayNodeConfig displayConfig;
+    auto displayNode = std::make_shared<RSDisplayRenderNode>(1, displayConfig);
+    RSSurfaceRenderNodeConfig config;
+    config.id = 2;
+    auto bottom = std::make_shared<RSSurfaceRenderNode>(config);
+    config.id = 3;
+    auto top = std::make_shared<RSSurfaceRenderNode>(config);
+    displayNode->AddChild(bottom);
+    displayNode->AddChild(top);
+    EXPECT_FALSE(RSOcclusionCulling::IsOpaque(*top));
+
+    auto stats = RSOcclusionCulling::Apply(*displayNode);
+    EXPECT_EQ(stats.occludedCount, 0u);
+    EXPECT_FALSE(bottom->IsOccluded());
+    EXPECT_FALSE(top->IsOccluded());
+}
+
+/**
+ * @tc.name: UniRender001
+ * @tc.desc: a uni rendered surface is opaque by its background color, not by its buffer
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, UniRender001, TestSize.Level1)
+{
+    RSDisplayNodeConfig displayConfig;
+    auto displayNode = std::make_shared<RSDisplayRenderNode>(1, displayConfig);
+    auto bottom = FullScreenSurface(2, Color(0, 0, 0, 0));
+    auto top = FullScreenSurface(3, Color(0xff, 0xff, 0xff, 0xff));
+    displayNode->AddChild(bottom);
+    displayNode->AddChild(top);
+    EXPECT_FALSE(RSOcclusionCulling::IsOpaque(*top, false));
+    EXPECT_TRUE(RSOcclusionCulling::IsOpaque(*top, true));
+    EXPECT_FALSE(RSOcclusionCulling::IsOpaque(*bottom, true));
+
+    auto stats = RSOcclusionCulling::Apply(*displayNode, [](const RSSurfaceRenderNode&) { return true; });
+    EXPECT_EQ(stats.occludedCount, 1u);
+    EXPECT_TRUE(bottom->IsOccluded());
+    EXPECT_FALSE(top->IsOccluded());
+}
+
+/**
+ * @tc.name: UniRender002
+ * @tc.desc: translucent background colors, corner radii and filters keep a uni rendered surface from occluding
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, UniRender002, TestSize.Level1)
+{
+    auto translucent = FullScreenSurface(1, Color(0xff, 0xff, 0xff, 0x80));
+    EXPECT_FALSE(RSOcclusionCulling::IsOpaque(*translucent, true));
+
+    auto rounded = FullScreenSurface(2, Color(0xff, 0xff, 0xff, 0xff));
+    rounded->GetMutableRenderProperties().SetCornerRadius(Vector4f(10.f));
+    EXPECT_FALSE(RSOcclusionCulling::IsOpaque(*rounded, true));
+
+    auto blurred = FullScreenSurface(3, Color(0xff, 0xff, 0xff, 0xff));
+    blurred->GetMutableRenderProperties().SetBackgroundFilter(RSFilter::CreateBlurFilter(10.f, 10.f));
+    EXPECT_FALSE(RSOcclusionCulling::IsOpaque(*blurred, true));
+
+    auto faded = FullScreenSurface(4, Color(0xff, 0xff, 0xff, 0xff));
+    faded->GetMutableRenderProperties().SetAlpha(0.5f);
+    EXPECT_FALSE(RSOcclusionCulling::IsOpaque(*faded, true));
+}
+
+/**
+ * @tc.name: Clip001
+ * @tc.desc: an opaque surface only occludes what is inside its clip region
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, Clip001, TestSize.Level1)
+{
+    RSDisplayNodeConfig displayConfig;
+    auto displayNode = std::make_shared<RSDisplayRenderNode>(1, displayConfig);
+    auto bottom = FullScreenSurface(2, Color(0, 0, 0, 0));
+    auto top = FullScreenSurface(3, Color(0xff, 0xff, 0xff, 0xff));
+    top->SetClipRegion(Vector4f(0, STATUS_BAR_HEIGHT, SCREEN_WIDTH, SCREEN_HEIGHT - STATUS_BAR_HEIGHT), false);
+    displayNode->AddChild(bottom);
+    displayNode->AddChild(top);
+
+    auto stats = RSOcclusionCulling::Apply(*displayNode, [](const RSSurfaceRenderNode&) { return true; });
+    EXPECT_EQ(stats.occludedCount, 0u);
+    EXPECT_FALSE(bottom->IsOccluded());
+
+    top->SetClipRegion(Vector4f(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT), false);
+    stats = RSOcclusionCulling::Apply(*displayNode, [](const RSSurfaceRenderNode&) { return true; });
+    EXPECT_EQ(stats.occludedCount, 1u);
+    EXPECT_TRUE(bottom->IsOccluded());
+}
+
+/**
+ * @tc.name: Transition001
+ * @tc.desc: a surface in a transition is transformed when drawn, so it occludes nothing
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSOcclusionCullingTest, Transition001, TestSize.Level1)
+{
+    RSDisplayNodeConfig displayConfig;
+    auto displayNode = std::make_shared<RSDisplayRenderNode>(1, displayConfig);
+    auto bottom = FullScreenSurface(2, Color(0, 0, 0, 0));
+    auto top = FullScreenSurface(3, Color(0xff, 0xff, 0xff, 0xff));
+    displayNode->AddChild(bottom);
+    displayNode->AddChild(top);
+    top->GetAnimationManager().RegisterTransition(1, [](const std::unique_ptr<RSTransitionProperties>&) {});
+
+    auto stats = RSOcclusionCulling::Apply(*displayNode, [](const RSSurfaceRenderNode&) { return true; });
+    EXPECT_EQ(stats.occludedCount, 0u);
+    EXPECT_FALSE(bottom->IsOccluded());
+
+    top->GetAnimationManager().UnregisterTransition(1);
+    stats = RSOcclusionCulling::Apply(*displayNode, [](const RSSurfaceRenderNode&) { return true; });
+    EXPECT_EQ(stats.occludedCount, 1u);
+    EXPECT_TRUE(bottom->IsOccluded());
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "pipeline/rs_surface_capture_pool.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSSurfaceCapturePoolTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSSurfaceCapturePoolTest::SetUpTestCase() {}
+void RSSurfaceCapturePoolTest::TearDownTestCase() {}
+void RSSurfaceCapturePoolTest::SetUp() {}
+void RSSurfaceCapturePoolTest::TearDown() {}
+
+/**
+ * @tc.name: AcquireAndRecycle001
+ * @tc.desc: a recycled pixelmap is handed out again for the same size
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCapturePoolTest, AcquireAndRecycle001, TestSize.Level1)
+{
+    RSSurfaceCapturePool pool;
+    auto pixelmap = pool.Acquire(100, 200);
+    ASSERT_NE(pixelmap, nullptr);
+    EXPECT_EQ(pixelmap->GetWidth(), 100);
+    EXPECT_EQ(pixelmap->GetHeight(), 200);
+    auto address = pixelmap->GetPixel32(0, 0);
+    pool.Recycle(std::move(pixelmap));
+    EXPECT_EQ(pool.GetPooledCount(), 1u);
+
+    auto reused = pool.Acquire(100, 200);
+    ASSERT_NE(reused, nullptr);
+    EXPECT_EQ(reused->GetPixel32(0, 0), address);
+    EXPECT_EQ(pool.GetPooledCount(), 0u);
+    EXPECT_EQ(pool.GetReuseCount(), 1u);
+    EXPECT_EQ(pool.GetAllocCount(), 1u);
+}
+
+/**
+ * @tc.name: AcquireAndRecycle002
+ * @tc.desc: a pixelmap of another size is not reused and a reused pixelmap is cleared
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCapturePoolTest, AcquireAndRecycle002, TestSize.Level1)
+{
+    RSSurfaceCapturePool pool;
+    auto pixelmap = pool.Acquire(16, 16);
+    ASSERT_NE(pixelmap, nullptr);
+    *const_cast<uint32_t*>(pixelmap->GetPixel32(0, 0)) = 0xFFFFFFFF;
+    pool.Recycle(std::move(pixelmap));
+
+    auto other = pool.Acquire(32, 32);
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(pool.GetReuseCount(), 0u);
+
+    auto reused = pool.Acquire(16, 16);
+    ASSERT_NE(reused, nullptr);
+    EXPECT_EQ(*reused->GetPixel32(0, 0), 0u);
+    EXPECT_EQ(pool.Acquire(0, 16), nullptr);
+}
+
+/**
+ * @tc.name: AcquireAndRecycle003
+ * @tc.desc: the pool never holds more pixelmaps than its limit
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCapturePoolTest, AcquireAndRecycle003, TestSize.Level1)
+{
+    RSSurfaceCapturePool pool(2);
+    for (int i = 0; i < 4; i++) {
+        pool.Recycle(pool.Acquire(8 + i, 8));
+    }
+    EXPECT_EQ(pool.GetPooledCount(), 2u);
+    pool.Clear();
+    EXPECT_EQ(pool.GetPooledCount(), 0u);
+}
+
+/**
+ * @tc.name: CapturedBuffer001
+ * @tc.desc: buffer records tell whether a node's buffer changed since its last capture
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCapturePoolTest, CapturedBuffer001, TestSize.Level1)
+{
+    RSSurfaceCapturePool pool;
+    NodeId id = 1;
+    EXPECT_FALSE(pool.IsBufferUnchanged(id, 3));
+    pool.UpdateCapturedBuffer(id, 3);
+    EXPECT_TRUE(pool.IsBufferUnchanged(id, 3));
+    EXPECT_FALSE(pool.IsBufferUnchanged(id, 4));
+    pool.RemoveCapturedBuffer(id);
+    EXPECT_FALSE(pool.IsBufferUnchanged(id, 3));
+}
+
+/**
+ * @tc.name: ByteBudget001
+ * @tc.desc: the pool never holds more bytes than its budget and does not keep pixelmaps over the budget at all
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCapturePoolTest, ByteBudget001, TestSize.Level1)
+{
+    constexpr int32_t side = 64;
+    constexpr size_t bytes = side * side * 4; // RGBA
+    RSSurfaceCapturePool pool(RSSurfaceCapturePool::DEFAULT_MAX_POOLED_PIXELMAPS, bytes * 2);
+    for (int i = 0; i < 3; i++) {
+        pool.Recycle(pool.Acquire(side, side - i));
+    }
+    EXPECT_EQ(pool.GetPooledCount(), 2u);
+    EXPECT_LE(pool.GetPooledBytes(), bytes * 2);
+    // the least recently recycled one went first
+    pool.Acquire(side, side);
+    EXPECT_EQ(pool.GetReuseCount(), 0u);
+
+    pool.Recycle(pool.Acquire(side * 2, side * 2));
+    EXPECT_EQ(pool.GetPooledCount(), 2u);
+    EXPECT_LE(pool.GetPooledBytes(), bytes * 2);
+}
+
+/**
+ * @tc.name: Trim001
+ * @tc.desc: trimming drops the least recently recycled pixelmaps down to the requested size
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCapturePoolTest, Trim001, TestSize.Level1)
+{
+    RSSurfaceCapturePool pool;
+    pool.Recycle(pool.Acquire(16, 16));
+    pool.Recycle(pool.Acquire(32, 32));
+    size_t newestBytes = pool.GetPooledBytes() - 16 * 16 * 4; // RGBA
+    pool.Trim(newestBytes);
+    EXPECT_EQ(pool.GetPooledCount(), 1u);
+    EXPECT_EQ(pool.GetPooledBytes(), newestBytes);
+    pool.UpdateCapturedBuffer(1, 1);
+    pool.Trim(0);
+    EXPECT_EQ(pool.GetPooledCount(), 0u);
+    EXPECT_EQ(pool.GetPooledBytes(), 0u);
+    // trimming only gives back pixels, the buffer records stay
+    EXPECT_TRUE(pool.IsBufferUnchanged(1, 1));
+}
+} // namespace OHOS::Rosen
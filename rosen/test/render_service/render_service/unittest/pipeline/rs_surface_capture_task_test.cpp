@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "surface.h"
+#include "pipeline/rs_main_thread.h"
+#include "pipeline/rs_surface_capture_pool.h"
+#include "pipeline/rs_surface_capture_task.h"
+#include "pipeline/rs_surface_render_node.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSSurfaceCaptureTaskTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // a registered top-level surface node showing one buffer of width x height filled with pixel.
+    std::shared_ptr<RSSurfaceRenderNode> CreateWindow(int32_t width, int32_t height, int32_t format, uint32_t pixel);
+
+    std::vector<sptr<Surface>> surfaces;
+    std::vector<sptr<SurfaceBuffer>> buffers;
+    std::vector<NodeId> nodeIds;
+};
+
+void RSSurfaceCaptureTaskTest::SetUpTestCase() {}
+void RSSurfaceCaptureTaskTest::TearDownTestCase() {}
+void RSSurfaceCaptureTaskTest::SetUp() {}
+
+void RSSurfaceCaptureTaskTest::TearDown()
+{
+    for (auto id : nodeIds) {
+        RSMainThread::Instance()->GetContext().GetMutableNodeMap().UnregisterRenderNode(id);
+    }
+    nodeIds.clear();
+    buffers.clear();
+    surfaces.clear();
+}
+
+namespace {
+constexpr int32_t WINDOW_WIDTH = 1260;
+constexpr int32_t WINDOW_HEIGHT = 2720;
+constexpr float THUMBNAIL_SCALE = 0.25f;
+constexpr int WINDOW_COUNT = 8;
+constexpr int CAPTURE_ROUNDS = 100; // 10 seconds of 10 Hz capture
+constexpr NodeId FIRST_NODE_ID = 0x7FFF0000;
+
+class TestConsumerListener : public IBufferConsumerListener {
+public:
+    void OnBufferAvailable() override {}
+};
+}
+
+std::shared_ptr<RSSurfaceRenderNode> RSSurfaceCaptureTaskTest::CreateWindow(int32_t width, int32_t height,
+    int32_t format, uint32_t pixel)
+{
+    auto csurf = Surface::CreateSurfaceAsConsumer("RSSurfaceCaptureTaskTest");
+    // the queue hands out no buffers without a consumer listener
+    sptr<IBufferConsumerListener> listener = new TestConsumerListener();
+    csurf->RegisterConsumerListener(listener);
+    auto psurf = Surface::CreateSurfaceAsProducer(csurf->GetProducer());
+    BufferRequestConfig requestConfig = {
+        .width = width,
+        .height = height,
+        .strideAlignment = 0x8,
+        .format = format,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    sptr<SurfaceBuffer> buffer;
+    sptr<SyncFence> requestFence = SyncFence::INVALID_FENCE;
+    if (psurf->RequestBuffer(buffer, requestFence, requestConfig) != GSERROR_OK || buffer == nullptr ||
+        buffer->GetVirAddr() == nullptr) {
+        return nullptr;
+    }
+    for (int32_t y = 0; y < height; y++) {
+        auto row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(buffer->GetVirAddr()) + y * buffer->GetStride());
+        std::fill(row, row + width, pixel);
+    }
+    surfaces.push_back(csurf);
+    surfaces.push_back(psurf);
+    buffers.push_back(buffer);
+
+    RSSurfaceRenderNodeConfig config;
+    config.id = FIRST_NODE_ID + nodeIds.size();
+    auto node = std::make_shared<RSSurfaceRenderNode>(config);
+    node->SetConsumer(csurf);
+    node->SetBuffer(buffer);
+    node->GetMutableRenderProperties().SetBoundsWidth(width);
+    node->GetMutableRenderProperties().SetBoundsHeight(height);
+    node->SetDstRect(RectI(0, 0, width, height));
+    RSMainThread::Instance()->GetContext().GetMutableNodeMap().RegisterRenderNode(node);
+    nodeIds.push_back(config.id);
+    return node;
+}
+
+/**
+ * @tc.name: CaptureByBlit001
+ * @tc.desc: an unchanged RGBX buffer is blitted as opaque, whatever its fourth byte holds
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCaptureTaskTest, CaptureByBlit001, TestSize.Level1)
+{
+    constexpr uint32_t rgbx = 0x00302010; // R 0x10, G 0x20, B 0x30, X 0
+    auto node = CreateWindow(64, 64, PIXEL_FMT_RGBX_8888, rgbx);
+    ASSERT_NE(node, nullptr);
+    RSSurfaceCapturePool pool;
+    RSSurfaceCaptureTask task(node->GetId(), 0.5f, 0.5f);
+    pool.Recycle(task.Run(pool));
+
+    auto pixelmap = task.Run(pool);
+    ASSERT_NE(pixelmap, nullptr);
+    EXPECT_EQ(pool.GetReuseCount(), 1u);
+    EXPECT_EQ(*pixelmap->GetPixel32(0, 0), 0xFF000000 | rgbx);
+    EXPECT_EQ(*pixelmap->GetPixel32(31, 31), 0xFF000000 | rgbx);
+}
+
+/**
+ * @tc.name: CaptureByBlit002
+ * @tc.desc: a node clipping to its frame is cropped to its dst rect on the blit path as on the visitor path
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCaptureTaskTest, CaptureByBlit002, TestSize.Level1)
+{
+    constexpr uint32_t rgba = 0xFF302010;
+    auto node = CreateWindow(64, 64, PIXEL_FMT_RGBA_8888, rgba);
+    ASSERT_NE(node, nullptr);
+    node->GetMutableRenderProperties().SetClipToFrame(true);
+    node->SetDstRect(RectI(0, 0, 16, 64)); // the window is mostly off screen
+    RSSurfaceCapturePool pool;
+    RSSurfaceCaptureTask task(node->GetId(), 0.5f, 0.5f);
+    auto replayed = task.Run(pool);
+    ASSERT_NE(replayed, nullptr);
+    auto blitted = task.Run(pool);
+    ASSERT_NE(blitted, nullptr);
+
+    EXPECT_EQ(*blitted->GetPixel32(8, 8), rgba);
+    EXPECT_EQ(*blitted->GetPixel32(24, 8), 0u);
+    for (int32_t x : { 0, 15, 16, 31 }) {
+        EXPECT_EQ(*blitted->GetPixel32(x, 8), *replayed->GetPixel32(x, 8));
+    }
+}
+
+/**
+ * @tc.name: ThumbnailThroughput001
+ * @tc.desc: 10 Hz thumbnail capture of 8 windows through RSSurfaceCaptureTask, without and with the pool
+ * @tc.type: PERF
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceCaptureTaskTest, ThumbnailThroughput001, TestSize.Level2)
+{
+    std::vector<NodeId> windows;
+    for (int i = 0; i < WINDOW_COUNT; i++) {
+        auto node = CreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, PIXEL_FMT_RGBA_8888, 0xFF000000 | (0x20 * i));
+        ASSERT_NE(node, nullptr);
+        windows.push_back(node->GetId());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < CAPTURE_ROUNDS; round++) {
+        for (auto id : windows) {
+            RSSurfaceCaptureTask task(id, THUMBNAIL_SCALE, THUMBNAIL_SCALE);
+            ASSERT_NE(task.Run(), nullptr);
+        }
+    }
+    auto freshCost = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    RSSurfaceCapturePool pool;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < CAPTURE_ROUNDS; round++) {
+        for (auto id : windows) {
+            RSSurfaceCaptureTask task(id, THUMBNAIL_SCALE, THUMBNAIL_SCALE);
+            auto pixelmap = task.Run(pool);
+            ASSERT_NE(pixelmap, nullptr);
+            pool.Recycle(std::move(pixelmap));
+        }
+    }
+    auto pooledCost = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    constexpr int captures = CAPTURE_ROUNDS * WINDOW_COUNT;
+    std::cout << "ThumbnailThroughput001: " << captures << " captures, fresh " << freshCost / captures
+        << " us/capture, pooled " << pooledCost / captures << " us/capture" << std::endl;
+    EXPECT_EQ(pool.GetAllocCount(), 1u);
+    EXPECT_EQ(pool.GetReuseCount(), static_cast<uint64_t>(captures - 1));
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pipeline/rs_transaction_queue.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSTransactionQueueTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSTransactionQueueTest::SetUpTestCase() {}
+void RSTransactionQueueTest::TearDownTestCase() {}
+void RSTransactionQueueTest::SetUp() {}
+void RSTransactionQueueTest::TearDown() {}
+
+namespace {
+constexpr int PRODUCER_COUNT = 32;
+constexpr int TRANSACTIONS_PER_PRODUCER = 10000;
+
+// the queue RSMainThread used before: a mutex protected std::queue swapped once per frame.
+class MutexTransactionQueue {
+public:
+    void Push(std::unique_ptr<RSTransactionData> transactionData)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cacheQueue_.push(std::move(transactionData));
+    }
+    size_t Drain()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::swap(cacheQueue_, effectQueue_);
+        }
+        size_t count = effectQueue_.size();
+        while (!effectQueue_.empty()) {
+            effectQueue_.pop();
+        }
+        return count;
+    }
+
+private:
+    std::mutex mutex_;
+    std::queue<std::unique_ptr<RSTransactionData>> cacheQueue_;
+    std::queue<std::unique_ptr<RSTransactionData>> effectQueue_;
+};
+
+template<typename PushFunc, typename DrainFunc>
+int64_t RunContention(PushFunc push, DrainFunc drain)
+{
+    constexpr size_t total = static_cast<size_t>(PRODUCER_COUNT) * TRANSACTIONS_PER_PRODUCER;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        producers.emplace_back([i, &push]() {
+            for (int j = 0; j < TRANSACTIONS_PER_PRODUCER; j++) {
+                push(i, std::make_unique<RSTransactionData>());
+            }
+        });
+    }
+    size_t consumed = 0;
+    while (consumed < total) {
+        consumed += drain();
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+/**
+ * @tc.name: PushAndPop001
+ * @tc.desc: only the first push after Collect asks for a wakeup
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSTransactionQueueTest, PushAndPop001, TestSize.Level1)
+{
+    RSTransactionQueue queue;
+    EXPECT_TRUE(queue.Push(1, std::make_unique<RSTransactionData>()));
+    EXPECT_FALSE(queue.Push(1, std::make_unique<RSTransactionData>()));
+    EXPECT_FALSE(queue.HasPending());
+    queue.Collect();
+    EXPECT_TRUE(queue.HasPending());
+    EXPECT_TRUE(queue.Push(1, std::make_unique<RSTransactionData>()));
+    EXPECT_NE(queue.Pop(), nullptr);
+    EXPECT_NE(queue.Pop(), nullptr);
+    EXPECT_EQ(queue.Pop(), nullptr);
+    queue.Collect();
+    EXPECT_NE(queue.Pop(), nullptr);
+    EXPECT_FALSE(queue.HasPending());
+}
+
+/**
+ * @tc.name: Fairness001
+ * @tc.desc: transactions keep their order per pid and pids are served round-robin
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSTransactionQueueTest, Fairness001, TestSize.Level1)
+{
+    RSTransactionQueue queue;
+    std::vector<RSTransactionData*> chatty;
+    for (int i = 0; i < 5; i++) {
+        auto data = std::make_unique<RSTransactionData>();
+        chatty.push_back(data.get());
+        queue.Push(1, std::move(data));
+    }
+    auto quiet = std::make_unique<RSTransactionData>();
+    RSTransactionData* quietPtr = quiet.get();
+    queue.Push(2, std::move(quiet));
+    queue.Collect();
+
+    auto first = queue.Pop();
+    auto second = queue.Pop();
+    EXPECT_EQ(first.get(), chatty[0]);
+    EXPECT_EQ(second.get(), quietPtr);
+    for (size_t i = 1; i < chatty.size(); i++) {
+        auto data = queue.Pop();
+        EXPECT_EQ(data.get(), chatty[i]);
+    }
+    EXPECT_FALSE(queue.HasPending());
+}
+
+/**
+ * @tc.name: Contention001
+ * @tc.desc: 32 producer threads against one consumer, lock-free queue versus the former mutex queue
+ * @tc.type: PERF
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSTransactionQueueTest, Contention001, TestSize.Level2)
+{
+    MutexTransactionQueue mutexQueue;
+    auto mutexCost = RunContention(
+        [&mutexQueue](int, std::unique_ptr<RSTransactionData> data) { mutexQueue.Push(std::move(data)); },
+        [&mutexQueue]() { return mutexQueue.Drain(); });
+
+    RSTransactionQueue queue;
+    std::atomic<int> wakeups { 0 };
+    auto lockFreeCost = RunContention(
+        [&queue, &wakeups](int producer, std::unique_ptr<RSTransactionData> data) {
+            if (queue.Push(producer, std::move(data))) {
+                wakeups++;
+            }
+        },
+        [&queue]() {
+            size_t count = 0;
+            queue.Collect();
+            while (queue.Pop() != nullptr) {
+                count++;
+            }
+            return count;
+        });
+
+    std::cout << "Contention001: " << PRODUCER_COUNT << " producers x " << TRANSACTIONS_PER_PRODUCER
+        << " transactions, mutex queue " << mutexCost << " us, lock-free queue " << lockFreeCost
+        << " us, wakeups " << wakeups.load() << std::endl;
+    EXPECT_FALSE(queue.HasPending());
+    EXPECT_LE(wakeups.load(), PRODUCER_COUNT * TRANSACTIONS_PER_PRODUCER);
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "command/rs_base_node_command.h"
+#include "command/rs_canvas_node_command.h"
+#include "command/rs_display_node_command.h"
+#include "command/rs_node_command.h"
+#include "command/rs_root_node_command.h"
+#include "command/rs_surface_node_command.h"
+#include "pipeline/rs_transaction_replayer.h"
+#include "transaction/rs_transaction_trace.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSTransactionReplayerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSTransactionReplayerTest::SetUpTestCase() {}
+void RSTransactionReplayerTest::TearDownTestCase() {}
+void RSTransactionReplayerTest::SetUp() {}
+void RSTransactionReplayerTest::TearDown() {}
+
+namespace {
+constexpr int32_t SCREEN_WIDTH = 64;
+constexpr int32_t SCREEN_HEIGHT = 64;
+constexpr NodeId DISPLAY_NODE_ID = 1;
+constexpr NodeId SURFACE_NODE_ID = 2;
+constexpr NodeId ROOT_NODE_ID = 3;
+constexpr NodeId CANVAS_NODE_ID = 4;
+constexpr uint64_t VSYNC_PERIOD = 16666667;
+const std::string TRACE_PATH = "/data/rs_transaction_replayer_test.bin";
+
+// a display showing one surface whose root has a colored canvas
+std::unique_ptr<RSTransactionData> CreateScene()
+{
+    auto transaction = std::make_unique<RSTransactionData>();
+    transaction->AddCommand(std::make_unique<RSDisplayNodeCreate>(DISPLAY_NODE_ID, RSDisplayNodeConfig {}));
+    transaction->AddCommand(std::make_unique<RSSurfaceNodeCreate>(SURFACE_NODE_ID));
+    transaction->AddCommand(std::make_unique<RSBaseNodeAddChild>(DISPLAY_NODE_ID, SURFACE_NODE_ID, 0));
+    transaction->AddCommand(std::make_unique<RSNodeSetBounds>(SURFACE_NODE_ID,
+        Vector4f(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT)));
+    transaction->AddCommand(std::make_unique<RSRootNodeCreate>(ROOT_NODE_ID));
+    transaction->AddCommand(std::make_unique<RSRootNodeAttachToUniSurfaceNode>(ROOT_NODE_ID, SURFACE_NODE_ID));
+    transaction->AddCommand(std::make_unique<RSNodeSetBounds>(ROOT_NODE_ID,
+        Vector4f(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT)));
+    transaction->AddCommand(std::make_unique<RSCanvasNodeCreate>(CANVAS_NODE_ID));
+    transaction->AddCommand(std::make_unique<RSBaseNodeAddChild>(ROOT_NODE_ID, CANVAS_NODE_ID, 0));
+    transaction->AddCommand(std::make_unique<RSNodeSetBounds>(CANVAS_NODE_ID,
+        Vector4f(0, 0, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2)));
+    transaction->AddCommand(std::make_unique<RSNodeSetBackgroundColor>(CANVAS_NODE_ID, Color(255, 0, 0, 255)));
+    return transaction;
+}
+
+std::unique_ptr<RSTransactionData> CreateColorChange(const Color& color)
+{
+    auto transaction = std::make_unique<RSTransactionData>();
+    transaction->AddCommand(std::make_unique<RSNodeSetBackgroundColor>(CANVAS_NODE_ID, color));
+    return transaction;
+}
+}
+
+/**
+ * @tc.name: ReplayFrame001
+ * @tc.desc: every frame is timed and its screen checksummed, the checksum changes with the pixels only
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSTransactionReplayerTest, ReplayFrame001, TestSize.Level1)
+{
+    RSTransactionReplayer replayer(SCREEN_WIDTH, SCREEN_HEIGHT);
+    uint64_t allocations = 0;
+    replayer.SetAllocationCounter([&allocations]() { return ++allocations; });
+
+    std::vector<std::unique_ptr<RSTransactionData>> transactions;
+    transactions.push_back(CreateScene());
+    replayer.ReplayFrame(VSYNC_PERIOD, transactions);
+    transactions.clear();
+    replayer.ReplayFrame(VSYNC_PERIOD * 2, transactions);
+    transactions.push_back(CreateColorChange(Color(0, 0, 255, 255)));
+    replayer.ReplayFrame(VSYNC_PERIOD * 3, transactions);
+
+    const auto& frames = replayer.GetFrames();
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0].commandCount, static_cast<uint32_t>(CreateScene()->GetCommandCount()));
+    EXPECT_EQ(frames[1].commandCount, 0u);
+    EXPECT_NE(frames[0].checksum, 0u);
+    EXPECT_EQ(frames[0].checksum, frames[1].checksum);
+    EXPECT_NE(frames[1].checksum, frames[2].checksum);
+    for (const auto& frame : frames) {
+        for (auto stageAllocations : frame.stageAllocations) {
+            EXPECT_EQ(stageAllocations, 1u);
+        }
+    }
+    EXPECT_LE(replayer.GetPercentile(RSReplayStage::PROCESS, 50.0), // 50.0: median
+        replayer.GetPercentile(RSReplayStage::PROCESS, 100.0));     // 100.0: max
+
+    std::string dumpString;
+    replayer.Dump(dumpString);
+    EXPECT_NE(dumpString.find("3 frames"), std::string::npos);
+    EXPECT_NE(dumpString.find(RSTransactionReplayer::GetStageName(RSReplayStage::PROCESS_COMMAND)),
+        std::string::npos);
+}
+
+/**
+ * @tc.name: Replay001
+ * @tc.desc: a recorded trace replays into the same frames and pixels as the transactions it was recorded from
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSTransactionReplayerTest, Replay001, TestSize.Level1)
+{
+    RSTransactionReplayer expected(SCREEN_WIDTH, SCREEN_HEIGHT);
+    RSTransactionTraceWriter writer;
+    ASSERT_TRUE(writer.Open(TRACE_PATH));
+    std::vector<std::unique_ptr<RSTransactionData>> frameTransactions[] = { {}, {}, {} };
+    frameTransactions[0].push_back(CreateScene());
+    frameTransactions[2].push_back(CreateColorChange(Color(0, 255, 0, 255)));
+    frameTransactions[2].push_back(CreateColorChange(Color(0, 0, 255, 128)));
+    uint64_t timestamp = 0;
+    for (auto& transactions : frameTransactions) {
+        timestamp += VSYNC_PERIOD;
+        ASSERT_TRUE(writer.WriteVsync(timestamp));
+        for (auto& transaction : transactions) {
+            ASSERT_TRUE(writer.WriteTransaction(*transaction));
+        }
+        expected.ReplayFrame(timestamp, transactions);
+    }
+    EXPECT_EQ(writer.GetRecordCount(), 6u);
+    ASSERT_TRUE(writer.Close());
+
+    RSTransactionReplayer replayer(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ASSERT_TRUE(replayer.Replay(TRACE_PATH));
+    unlink(TRACE_PATH.c_str());
+    ASSERT_EQ(replayer.GetFrames().size(), expected.GetFrames().size());
+    for (size_t i = 0; i < expected.GetFrames().size(); i++) {
+        EXPECT_EQ(replayer.GetFrames()[i].vsyncTimestamp, expected.GetFrames()[i].vsyncTimestamp);
+        EXPECT_EQ(replayer.GetFrames()[i].commandCount, expected.GetFrames()[i].commandCount);
+        EXPECT_EQ(replayer.GetFrames()[i].checksum, expected.GetFrames()[i].checksum);
+    }
+}
+
+/**
+ * @tc.name: Replay002
+ * @tc.desc: missing and damaged traces are rejected, an empty trace replays no frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSTransactionReplayerTest, Replay002, TestSize.Level1)
+{
+    RSTransactionReplayer replayer(SCREEN_WIDTH, SCREEN_HEIGHT);
+    EXPECT_FALSE(replayer.Replay(TRACE_PATH));
+
+    FILE* file = fopen(TRACE_PATH.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    fputs("not a trace", file);
+    fclose(file);
+    EXPECT_FALSE(replayer.Replay(TRACE_PATH));
+
+    RSTransactionTraceWriter writer;
+    ASSERT_TRUE(writer.Open(TRACE_PATH));
+    ASSERT_TRUE(writer.Close());
+    EXPECT_TRUE(replayer.Replay(TRACE_PATH));
+    EXPECT_TRUE(replayer.GetFrames().empty());
+    unlink(TRACE_PATH.c_str());
+}
+} // namespace OHOS::Rosen
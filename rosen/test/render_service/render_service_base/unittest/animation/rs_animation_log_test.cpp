@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "include/animation/rs_animation_log.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSAnimationLogTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSAnimationLogTest::SetUpTestCase() {}
+void RSAnimationLogTest::TearDownTestCase() {}
+void RSAnimationLogTest::SetUp() {}
+void RSAnimationLogTest::TearDown() {}
+
+/**
+ * @tc.name: Ring001
+ * @tc.desc: a full ring drops and counts records, a drain returns the others in order
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSAnimationLogTest, Ring001, TestSize.Level1)
+{
+    auto ring = std::make_unique<RSAnimationLogRing>();
+    RSAnimationLogRecord record;
+    for (uint32_t i = 0; i < RSAnimationLogRing::CAPACITY; i++) {
+        record.id = i;
+        EXPECT_TRUE(ring->Push(record));
+    }
+    EXPECT_FALSE(ring->Push(record));
+    EXPECT_EQ(ring->GetDroppedCount(), 1u);
+
+    std::vector<RSAnimationLogRecord> records;
+    ASSERT_EQ(ring->Drain(records), RSAnimationLogRing::CAPACITY);
+    for (uint32_t i = 0; i < RSAnimationLogRing::CAPACITY; i++) {
+        EXPECT_EQ(records[i].id, i);
+    }
+    EXPECT_TRUE(ring->Push(record));
+    EXPECT_EQ(ring->Drain(records), 1u);
+}
+
+/**
+ * @tc.name: Ring002
+ * @tc.desc: records pushed by one thread while another drains arrive once and in order
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSAnimationLogTest, Ring002, TestSize.Level1)
+{
+    constexpr uint64_t recordCount = 100000;
+    auto ring = std::make_unique<RSAnimationLogRing>();
+    std::thread producer([&ring]() {
+        RSAnimationLogRecord record;
+        for (uint64_t i = 0; i < recordCount; i++) {
+            record.id = i;
+            while (!ring->Push(record)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::vector<RSAnimationLogRecord> records;
+    while (records.size() < recordCount) {
+        ring->Drain(records);
+    }
+    producer.join();
+    for (uint64_t i = 0; i < recordCount; i++) {
+        ASSERT_EQ(records[i].id, i);
+    }
+}
+
+/**
+ * @tc.name: DecodeRecord001
+ * @tc.desc: records decode to the lines of the text log
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSAnimationLogTest, DecodeRecord001, TestSize.Level1)
+{
+    RSAnimationLogRecord record;
+    record.kind = RSAnimationLogRecordKind::VALUE;
+    record.valueType = RSAnimationLogValueType::VECTOR2F;
+    record.valueCount = 2;
+    record.time = 10;
+    record.id = 1;
+    record.property = 2;
+    record.values[0] = 0.5f;
+    record.values[1] = 1.f;
+    EXPECT_EQ(RSAnimationLog::DecodeRecord(record),
+        "RSAnimationValueLog NodeId:{1} time:{10} property:{2} value:{0.500000 1.000000}\n");
+
+    record.kind = RSAnimationLogRecordKind::INFO;
+    record.valueType = RSAnimationLogValueType::INT;
+    record.valueCount = 1;
+    int startValue = 16777217;
+    int endValue = -3;
+    std::memcpy(&record.values[0], &startValue, sizeof(int));
+    std::memcpy(&record.values[1], &endValue, sizeof(int));
+    EXPECT_EQ(RSAnimationLog::DecodeRecord(record),
+        "RSAnimationInfoLog AnimationId:{1} time:{10} property:{2} startValue:{16777217} endValue:{-3}\n");
+
+    record.valueType = RSAnimationLogValueType::FILTER;
+    record.valueCount = 0;
+    EXPECT_EQ(RSAnimationLog::DecodeRecord(record),
+        "RSAnimationInfoLog AnimationId:{1} time:{10} property:{2} startValue:{nullptr} endValue:{nullptr}\n");
+
+    record.kind = RSAnimationLogRecordKind::DROPPED;
+    record.id = 3;
+    EXPECT_EQ(RSAnimationLog::DecodeRecord(record), "RSAnimationLogDropped time:{10} count:{3}\n");
+
+    // more values than a record holds
+    record.kind = RSAnimationLogRecordKind::INFO;
+    record.valueCount = RSAnimationLogRecord::MAX_VALUES;
+    EXPECT_TRUE(RSAnimationLog::DecodeRecord(record).empty());
+}
+} // namespace OHOS::Rosen
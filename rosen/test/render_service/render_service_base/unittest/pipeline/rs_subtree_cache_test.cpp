@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "include/core/SkSurface.h"
+#include "include/pipeline/rs_canvas_render_node.h"
+#include "include/pipeline/rs_dirty_region_manager.h"
+#include "include/pipeline/rs_subtree_cache_manager.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int IMAGE_SIZE = 64;
+constexpr size_t IMAGE_BYTES = IMAGE_SIZE * IMAGE_SIZE * 4;
+
+sk_sp<SkImage> MakeImage(int width, int height)
+{
+    auto surface = SkSurface::MakeRasterN32Premul(width, height);
+    return surface ? surface->makeImageSnapshot() : nullptr;
+}
+}
+
+class RSSubtreeCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    void PrepareFrame(RSCanvasRenderNode& parent, RSCanvasRenderNode& child)
+    {
+        parent.Update(dirtyManager_, nullptr, false);
+        child.Update(dirtyManager_, &parent.GetRenderProperties(), false);
+        child.UpdateSubtreeCacheState();
+        parent.UpdateSubtreeCacheState();
+    }
+
+    RSDirtyRegionManager dirtyManager_;
+};
+
+void RSSubtreeCacheTest::SetUpTestCase() {}
+void RSSubtreeCacheTest::TearDownTestCase() {}
+void RSSubtreeCacheTest::SetUp() {}
+void RSSubtreeCacheTest::TearDown() {}
+
+/**
+ * @tc.name: PutAndGet001
+ * @tc.desc: a stored image is returned and counted as a hit, an unknown node as a miss
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, PutAndGet001, TestSize.Level1)
+{
+    RSSubtreeCacheManager cacheManager(IMAGE_BYTES * 4);
+    ASSERT_TRUE(cacheManager.Put(1, MakeImage(IMAGE_SIZE, IMAGE_SIZE)));
+    EXPECT_TRUE(cacheManager.Contains(1));
+    EXPECT_NE(cacheManager.Get(1), nullptr);
+    EXPECT_EQ(cacheManager.Get(2), nullptr);
+
+    auto stats = cacheManager.GetStats();
+    EXPECT_EQ(stats.hitCount, 1u);
+    EXPECT_EQ(stats.missCount, 1u);
+    EXPECT_EQ(stats.createCount, 1u);
+    EXPECT_EQ(stats.cachedCount, 1u);
+    EXPECT_EQ(stats.memoryUsage, IMAGE_BYTES);
+}
+
+/**
+ * @tc.name: MemoryBudget001
+ * @tc.desc: the least recently drawn image is evicted when the budget is exceeded
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, MemoryBudget001, TestSize.Level1)
+{
+    RSSubtreeCacheManager cacheManager(IMAGE_BYTES * 2);
+    ASSERT_TRUE(cacheManager.Put(1, MakeImage(IMAGE_SIZE, IMAGE_SIZE)));
+    ASSERT_TRUE(cacheManager.Put(2, MakeImage(IMAGE_SIZE, IMAGE_SIZE)));
+    // node 1 becomes the most recently used one
+    cacheManager.Get(1);
+    ASSERT_TRUE(cacheManager.Put(3, MakeImage(IMAGE_SIZE, IMAGE_SIZE)));
+
+    EXPECT_TRUE(cacheManager.Contains(1));
+    EXPECT_FALSE(cacheManager.Contains(2));
+    EXPECT_TRUE(cacheManager.Contains(3));
+    auto stats = cacheManager.GetStats();
+    EXPECT_EQ(stats.evictCount, 1u);
+    EXPECT_LE(stats.memoryUsage, stats.memoryBudget);
+
+    cacheManager.SetMemoryBudget(IMAGE_BYTES);
+    EXPECT_EQ(cacheManager.GetStats().cachedCount, 1u);
+    EXPECT_TRUE(cacheManager.Contains(3) || cacheManager.Contains(1));
+}
+
+/**
+ * @tc.name: MemoryBudget002
+ * @tc.desc: an image larger than the whole budget is rejected without evicting others
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, MemoryBudget002, TestSize.Level1)
+{
+    RSSubtreeCacheManager cacheManager(IMAGE_BYTES);
+    ASSERT_TRUE(cacheManager.Put(1, MakeImage(IMAGE_SIZE, IMAGE_SIZE)));
+    EXPECT_FALSE(cacheManager.CanFit(IMAGE_BYTES * 2));
+    EXPECT_FALSE(cacheManager.Put(2, MakeImage(IMAGE_SIZE * 2, IMAGE_SIZE)));
+    EXPECT_TRUE(cacheManager.Contains(1));
+    EXPECT_EQ(cacheManager.GetStats().rejectCount, 1u);
+}
+
+/**
+ * @tc.name: Invalidate001
+ * @tc.desc: invalidated and disabled caches release their memory
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, Invalidate001, TestSize.Level1)
+{
+    RSSubtreeCacheManager cacheManager(IMAGE_BYTES * 4);
+    cacheManager.Put(1, MakeImage(IMAGE_SIZE, IMAGE_SIZE));
+    cacheManager.Put(2, MakeImage(IMAGE_SIZE, IMAGE_SIZE));
+    cacheManager.Invalidate(1);
+    EXPECT_FALSE(cacheManager.Contains(1));
+    EXPECT_EQ(cacheManager.GetStats().invalidateCount, 1u);
+
+    cacheManager.SetEnabled(false);
+    EXPECT_FALSE(cacheManager.Contains(2));
+    EXPECT_EQ(cacheManager.GetStats().memoryUsage, 0u);
+    EXPECT_FALSE(cacheManager.ShouldCache(UINT32_MAX, INT32_MAX));
+
+    std::string dumpString;
+    cacheManager.Dump(dumpString);
+    EXPECT_NE(dumpString.find("SubtreeCache"), std::string::npos);
+}
+
+/**
+ * @tc.name: ShouldCache001
+ * @tc.desc: caching needs both enough stable frames and enough draw cost
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, ShouldCache001, TestSize.Level1)
+{
+    RSSubtreeCacheManager cacheManager;
+    cacheManager.SetStableFrameThreshold(3);
+    cacheManager.SetCostThreshold(10);
+    EXPECT_FALSE(cacheManager.ShouldCache(2, 100));
+    EXPECT_FALSE(cacheManager.ShouldCache(3, 9));
+    EXPECT_TRUE(cacheManager.ShouldCache(3, 10));
+}
+
+/**
+ * @tc.name: StableFrames001
+ * @tc.desc: a transform change keeps the subtree stable, a content change does not
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, StableFrames001, TestSize.Level1)
+{
+    auto parent = std::make_shared<RSCanvasRenderNode>(1);
+    auto child = std::make_shared<RSCanvasRenderNode>(2);
+    parent->AddChild(child);
+    parent->GetMutableRenderProperties().SetBounds({ 0.f, 0.f, 100.f, 100.f });
+    child->GetMutableRenderProperties().SetBounds({ 10.f, 10.f, 50.f, 50.f });
+
+    // new nodes are dirty in their first frame
+    PrepareFrame(*parent, *child);
+    EXPECT_TRUE(parent->IsSubtreeChanged());
+    EXPECT_EQ(parent->GetStableFrameCount(), 0u);
+
+    PrepareFrame(*parent, *child);
+    PrepareFrame(*parent, *child);
+    EXPECT_EQ(parent->GetStableFrameCount(), 2u);
+
+    // sliding the whole card keeps what it draws
+    parent->GetMutableRenderProperties().SetTranslate({ 20.f, 0.f });
+    parent->GetMutableRenderProperties().SetAlpha(0.5f);
+    PrepareFrame(*parent, *child);
+    EXPECT_FALSE(parent->IsSubtreeChanged());
+    EXPECT_EQ(parent->GetStableFrameCount(), 3u);
+
+    parent->GetMutableRenderProperties().SetBackgroundColor(Color(255, 0, 0));
+    PrepareFrame(*parent, *child);
+    EXPECT_TRUE(parent->IsSubtreeChanged());
+    EXPECT_EQ(parent->GetStableFrameCount(), 0u);
+}
+
+/**
+ * @tc.name: StableFrames002
+ * @tc.desc: any change below the node, even a transform, invalidates its subtree
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, StableFrames002, TestSize.Level1)
+{
+    auto parent = std::make_shared<RSCanvasRenderNode>(1);
+    auto child = std::make_shared<RSCanvasRenderNode>(2);
+    parent->AddChild(child);
+    PrepareFrame(*parent, *child);
+    PrepareFrame(*parent, *child);
+    EXPECT_EQ(parent->GetStableFrameCount(), 1u);
+
+    child->GetMutableRenderProperties().SetTranslate({ 5.f, 5.f });
+    PrepareFrame(*parent, *child);
+    EXPECT_EQ(child->GetStableFrameCount(), 2u);
+    EXPECT_EQ(parent->GetStableFrameCount(), 0u);
+
+    child->GetMutableRenderProperties().SetVisible(false);
+    PrepareFrame(*parent, *child);
+    EXPECT_EQ(parent->GetStableFrameCount(), 0u);
+    PrepareFrame(*parent, *child);
+    EXPECT_EQ(parent->GetStableFrameCount(), 1u);
+}
+
+/**
+ * @tc.name: SubtreeCost001
+ * @tc.desc: the cost of a subtree adds up the cost of its nodes
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSSubtreeCacheTest, SubtreeCost001, TestSize.Level1)
+{
+    auto parent = std::make_shared<RSCanvasRenderNode>(1);
+    auto child = std::make_shared<RSCanvasRenderNode>(2);
+    parent->AddChild(child);
+    PrepareFrame(*parent, *child);
+    EXPECT_EQ(child->GetSubtreeCost(), 1);
+    EXPECT_EQ(parent->GetSubtreeCost(), 2);
+}
+} // namespace OHOS::Rosen
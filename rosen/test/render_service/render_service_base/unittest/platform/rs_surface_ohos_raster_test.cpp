@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
+#include "platform/ohos/backend/rs_surface_frame_ohos_raster.h"
+#include "platform/ohos/backend/rs_surface_ohos_raster.h"
+#include "surface.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int32_t FRAME_SIZE = 64;
+
+class TestConsumerListener : public IBufferConsumerListener {
+public:
+    void OnBufferAvailable() override {}
+};
+}
+
+class RSSurfaceOhosRasterTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // flushes the frame and has the consumer take the buffer and give it back to the queue
+    void PresentFrame(std::unique_ptr<RSSurfaceFrame>& frame);
+
+    sptr<Surface> consumer_;
+    sptr<Surface> producer_;
+    std::shared_ptr<RSSurfaceOhosRaster> rsSurface_;
+};
+
+void RSSurfaceOhosRasterTest::SetUpTestCase() {}
+void RSSurfaceOhosRasterTest::TearDownTestCase() {}
+
+void RSSurfaceOhosRasterTest::SetUp()
+{
+    consumer_ = Surface::CreateSurfaceAsConsumer("RSSurfaceOhosRasterTest");
+    sptr<IBufferConsumerListener> listener = new TestConsumerListener();
+    consumer_->RegisterConsumerListener(listener);
+    producer_ = Surface::CreateSurfaceAsProducer(consumer_->GetProducer());
+    // one buffer, so every frame is drawn into the same one
+    producer_->SetQueueSize(1);
+    rsSurface_ = std::make_shared<RSSurfaceOhosRaster>(producer_);
+}
+
+void RSSurfaceOhosRasterTest::TearDown()
+{
+    rsSurface_ = nullptr;
+    producer_ = nullptr;
+    consumer_ = nullptr;
+}
+
+void RSSurfaceOhosRasterTest::PresentFrame(std::unique_ptr<RSSurfaceFrame>& frame)
+{
+    ASSERT_TRUE(rsSurface_->FlushFrame(frame));
+    sptr<SurfaceBuffer> buffer;
+    int32_t fence = -1;
+    int64_t timestamp = 0;
+    Rect damage = {};
+    ASSERT_EQ(consumer_->AcquireBuffer(buffer, fence, timestamp, damage), GSERROR_OK);
+    ASSERT_EQ(consumer_->ReleaseBuffer(buffer, -1), GSERROR_OK);
+}
+
+/**
+ * @tc.name: SurfaceCache001
+ * @tc.desc: a buffer drawn again reuses its SkSurface, with the matrix and clip of the last frame dropped
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceOhosRasterTest, SurfaceCache001, TestSize.Level1)
+{
+    auto frame = rsSurface_->RequestFrame(FRAME_SIZE, FRAME_SIZE);
+    ASSERT_NE(frame, nullptr);
+    sk_sp<SkSurface> skSurface = frame->GetSurface();
+    ASSERT_NE(skSurface, nullptr);
+    frame->GetCanvas()->translate(FRAME_SIZE / 2, FRAME_SIZE / 2);
+    frame->GetCanvas()->clipRect(SkRect::MakeWH(1, 1));
+    PresentFrame(frame);
+
+    frame = rsSurface_->RequestFrame(FRAME_SIZE, FRAME_SIZE);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetSurface(), skSurface);
+    SkCanvas* canvas = frame->GetCanvas();
+    EXPECT_TRUE(canvas->getTotalMatrix().isIdentity());
+    EXPECT_EQ(canvas->getDeviceClipBounds(), SkIRect::MakeWH(FRAME_SIZE, FRAME_SIZE));
+}
+
+/**
+ * @tc.name: SurfaceCache002
+ * @tc.desc: while a snapshot of the cached SkSurface is alive, the next frame still draws into the buffer
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSSurfaceOhosRasterTest, SurfaceCache002, TestSize.Level1)
+{
+    auto frame = rsSurface_->RequestFrame(FRAME_SIZE, FRAME_SIZE);
+    ASSERT_NE(frame, nullptr);
+    sk_sp<SkImage> snapshot = frame->GetSurface()->makeImageSnapshot();
+    ASSERT_NE(snapshot, nullptr);
+    PresentFrame(frame);
+
+    frame = rsSurface_->RequestFrame(FRAME_SIZE, FRAME_SIZE);
+    ASSERT_NE(frame, nullptr);
+    frame->GetCanvas()->clear(SK_ColorRED);
+    frame->GetSurface()->flush();
+    auto buffer = static_cast<RSSurfaceFrameOhosRaster*>(frame.get())->GetBuffer();
+    ASSERT_NE(buffer, nullptr);
+    ASSERT_NE(buffer->GetVirAddr(), nullptr);
+    // RGBA: red and alpha set
+    EXPECT_EQ(*static_cast<uint32_t*>(buffer->GetVirAddr()), 0xFF0000FF);
+}
+} // namespace OHOS::Rosen
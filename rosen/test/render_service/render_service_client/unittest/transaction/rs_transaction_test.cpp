@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 #include "gtest/gtest.h"
+#include "command/rs_node_command.h"
 #include "transaction/rs_transaction.h"
+#include "transaction/rs_transaction_proxy.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -46,4 +48,43 @@ HWTEST_F(RSTransactionTest, FlushImplicitTransaction001, TestSize.Level1)
     //      Only use its static function.
     RSTransaction::FlushImplicitTransaction();
 }
+
+/**
+ * @tc.name: DeltaBundle001
+ * @tc.desc: deltas of a bundle survive marshalling in order and the proxy accepts the deltas of a node
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSTransactionTest, DeltaBundle001, TestSize.Level1)
+{
+    EXPECT_TRUE(RSNodeDeltaBundle::IsSupported<float>());
+    EXPECT_FALSE(RSNodeDeltaBundle::IsSupported<bool>());
+
+    RSNodeDeltaBundle bundle;
+    bundle.AddDelta(RSCommandSubType<RSNodeSetAlphaDelta>::value, 0.5f);
+    bundle.AddDelta(RSCommandSubType<RSNodeSetBoundsDelta>::value, Vector4f(1.f, 2.f, 3.f, 4.f));
+    bundle.AddDelta(RSCommandSubType<RSNodeSetAlphaDelta>::value, 0.25f);
+    EXPECT_EQ(bundle.GetDeltaCount(), 3u);
+
+    Parcel parcel;
+    ASSERT_TRUE(bundle.Marshalling(parcel));
+    std::unique_ptr<RSNodeDeltaBundle> copy(RSNodeDeltaBundle::Unmarshalling(parcel));
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ(copy->GetDeltaCount(), 3u);
+    std::vector<float> alphaDeltas;
+    copy->ForEachDelta([&alphaDeltas](uint16_t type, const auto& delta) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(delta)>, float>) {
+            EXPECT_EQ(type, RSCommandSubType<RSNodeSetAlphaDelta>::value);
+            alphaDeltas.push_back(delta);
+        }
+    });
+    EXPECT_EQ(alphaDeltas, std::vector<float>({ 0.5f, 0.25f }));
+
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    ASSERT_NE(transactionProxy, nullptr);
+    transactionProxy->AddPropertyDelta(1, RSCommandSubType<RSNodeSetAlphaDelta>::value, 0.5f);
+    transactionProxy->AddPropertyDelta(1, RSCommandSubType<RSNodeSetAlphaDelta>::value, 0.25f);
+    RSTransaction::FlushImplicitTransaction();
+}
 } // namespace OHOS::Rosen
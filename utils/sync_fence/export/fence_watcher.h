@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_INCLUDE_FENCE_WATCHER_H
+#define UTILS_INCLUDE_FENCE_WATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <refbase.h>
+
+#include "sync_fence.h"
+
+namespace OHOS {
+// Watches fences on a single epoll thread and calls back once they signal, so that work depending on a fence does
+// not have to block a thread in SyncFence::Wait.
+class FenceWatcher {
+public:
+    // SIGNALED once the fence signals, ACTIVE if the timeout expired first and ERROR if the fence can not be watched.
+    // Callbacks run on the watcher thread, they must be short and must not wait for other fences.
+    using Callback = std::function<void(FenceStatus status)>;
+    static constexpr int32_t NO_TIMEOUT = -1;
+    static constexpr uint64_t INVALID_WATCH_ID = 0;
+
+    static FenceWatcher& GetInstance();
+
+    // an invalid fence counts as signaled, like in SyncFence::Wait
+    // returns the id to cancel the watch with
+    uint64_t Watch(const sptr<SyncFence>& fence, Callback callback, int32_t timeoutMs = NO_TIMEOUT);
+    // returns false if the callback already ran or is running
+    bool Cancel(uint64_t id);
+    size_t GetWatchCount() const;
+    // returns once the callbacks of all fences signaled before the call ran, including those of fences the callbacks
+    // signaled in turn; does nothing on the watcher thread
+    void Flush();
+
+    FenceWatcher(const FenceWatcher&) = delete;
+    FenceWatcher& operator=(const FenceWatcher&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct WatchEntry {
+        int32_t fd = -1;
+        Callback callback;
+        bool hasDeadline = false;
+        Clock::time_point deadline;
+    };
+
+    FenceWatcher();
+    ~FenceWatcher();
+
+    void ThreadMain();
+    int32_t GetEpollTimeoutLocked() const;
+    void CollectExpiredLocked(std::vector<std::pair<Callback, FenceStatus>>& fired);
+    void RemoveLocked(WatchEntry& entry);
+    void Wakeup();
+
+    int32_t epollFd_ = -1;
+    int32_t wakeupFd_ = -1;
+    mutable std::mutex mutex_;
+    uint64_t nextId_ = INVALID_WATCH_ID + 1;
+    std::unordered_map<uint64_t, WatchEntry> watches_;
+    // watches of invalid fences, called back on the next loop
+    std::vector<uint64_t> readyIds_;
+    bool stopped_ = false;
+    uint64_t flushRequested_ = 0;
+    uint64_t flushDone_ = 0;
+    std::condition_variable flushCond_;
+    std::thread thread_;
+};
+} // namespace OHOS
+
+#endif // UTILS_INCLUDE_FENCE_WATCHER_H
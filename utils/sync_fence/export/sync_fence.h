@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <string>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 #include <refbase.h>
@@ -42,6 +43,9 @@ struct SyncPointInfo {
     FenceStatus status;
 };
 
+// Timeline of the kernel sw_sync driver. When the kernel has no sw_sync, which is the case on most plain linux test
+// hosts, the timeline is kept in userspace and its fences are eventfds, signaled by writing their signal timestamp.
+// Both kinds of fences poll readable once signaled, so SyncFence and FenceWatcher handle them the same way.
 class SyncTimeline : public RefBase {
 public:
     SyncTimeline() noexcept;
@@ -53,6 +57,10 @@ public:
     SyncTimeline& operator=(SyncTimeline&& rhs) = delete;
 
     bool IsValid();
+    bool IsUserspace() const
+    {
+        return isUserspace_;
+    }
     int32_t IncreaseSyncPoint(uint32_t step = 1);
     int32_t GenerateFence(std::string name, uint32_t point);
     int32_t Dup() const;
@@ -60,9 +68,18 @@ public:
     int32_t Get() const;
 
 private:
+    int32_t GenerateUserspaceFence(uint32_t point);
+    int32_t IncreaseUserspaceSyncPoint(uint32_t step);
+
     int32_t timeLineFd_ = -1;
     int32_t timeLineNextPoint = 0;
     bool isValid_ = false;
+
+    bool isUserspace_ = false;
+    std::mutex userspaceMutex_;
+    uint32_t userspacePoint_ = 0;
+    // point and a dup of the eventfd of every fence not signaled yet
+    std::vector<std::pair<uint32_t, int32_t>> pendingFences_;
 };
 
 class SyncFence : public RefBase {
@@ -93,8 +110,13 @@ public:
     void ReadFromMessageParcel(MessageParcel &parcel);
 
 private:
+    static sptr<SyncFence> MergeUserspaceFence(const std::string &name,
+            const sptr<SyncFence>& fence1, const sptr<SyncFence>& fence2);
     std::vector<SyncPointInfo> GetFenceInfo();
     FenceStatus GetStatus();
+    // status and signal timestamp of fences which are not sync files, see SyncTimeline
+    FenceStatus PollStatus() const;
+    ns_sec_t ReadUserspaceTimestamp() const;
 
     UniqueFd fenceFd_;
 };
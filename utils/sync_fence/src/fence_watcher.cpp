@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fence_watcher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "hilog/log.h"
+
+namespace OHOS {
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr HiLogLabel LABEL = { LOG_CORE, 0xD001400, "FenceWatcher" };
+constexpr uint64_t WAKEUP_ID = std::numeric_limits<uint64_t>::max();
+constexpr int32_t MAX_EVENTS = 16;
+}  // namespace
+
+FenceWatcher& FenceWatcher::GetInstance()
+{
+    static FenceWatcher instance;
+    return instance;
+}
+
+FenceWatcher::FenceWatcher()
+{
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeupFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epollFd_ < 0 || wakeupFd_ < 0) {
+        HiLog::Error(LABEL, "FenceWatcher init failed, error: %{public}s", strerror(errno));
+        return;
+    }
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKEUP_ID;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeupFd_, &event) < 0) {
+        HiLog::Error(LABEL, "FenceWatcher add wakeup fd failed, error: %{public}s", strerror(errno));
+        return;
+    }
+    thread_ = std::thread(&FenceWatcher::ThreadMain, this);
+}
+
+FenceWatcher::~FenceWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    flushCond_.notify_all();
+    if (thread_.joinable()) {
+        Wakeup();
+        thread_.join();
+    }
+    for (auto &[id, entry] : watches_) {
+        if (entry.fd >= 0) {
+            close(entry.fd);
+        }
+    }
+    watches_.clear();
+    if (wakeupFd_ >= 0) {
+        close(wakeupFd_);
+    }
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+    }
+}
+
+uint64_t FenceWatcher::Watch(const sptr<SyncFence>& fence, Callback callback, int32_t timeoutMs)
+{
+    if (callback == nullptr) {
+        return INVALID_WATCH_ID;
+    }
+    WatchEntry entry;
+    entry.callback = std::move(callback);
+    if (timeoutMs >= 0) {
+        entry.hasDeadline = true;
+        entry.deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    }
+
+    bool valid = fence != nullptr && fence->IsValid();
+    if (valid) {
+        // a dup of its own, the fence may be closed or watched more than once meanwhile
+        entry.fd = fence->Dup();
+        if (entry.fd < 0) {
+            HiLog::Error(LABEL, "Watch dup fence failed, error: %{public}s", strerror(errno));
+            entry.callback(ERROR);
+            return INVALID_WATCH_ID;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_.joinable() || stopped_) {
+        lock.unlock();
+        if (entry.fd >= 0) {
+            close(entry.fd);
+        }
+        entry.callback(ERROR);
+        return INVALID_WATCH_ID;
+    }
+    uint64_t id = nextId_++;
+    if (valid) {
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, entry.fd, &event) < 0) {
+            HiLog::Error(LABEL, "Watch add fence failed, error: %{public}s", strerror(errno));
+            lock.unlock();
+            close(entry.fd);
+            entry.callback(ERROR);
+            return INVALID_WATCH_ID;
+        }
+    } else {
+        readyIds_.push_back(id);
+    }
+    bool needWakeup = !valid || entry.hasDeadline;
+    watches_.emplace(id, std::move(entry));
+    if (needWakeup) {
+        // the loop has to pick up the ready id or the new deadline
+        Wakeup();
+    }
+    return id;
+}
+
+bool FenceWatcher::Cancel(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = watches_.find(id);
+    if (it == watches_.end()) {
+        return false;
+    }
+    RemoveLocked(it->second);
+    watches_.erase(it);
+    return true;
+}
+
+size_t FenceWatcher::GetWatchCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return watches_.size();
+}
+
+void FenceWatcher::Flush()
+{
+    if (std::this_thread::get_id() == thread_.get_id()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_.joinable() || stopped_ || watches_.empty()) {
+        return;
+    }
+    uint64_t seq = ++flushRequested_;
+    Wakeup();
+    flushCond_.wait(lock, [this, seq] { return flushDone_ >= seq || stopped_; });
+}
+
+void FenceWatcher::ThreadMain()
+{
+    struct epoll_event events[MAX_EVENTS];
+    std::vector<std::pair<Callback, FenceStatus>> fired;
+    while (true) {
+        int32_t timeout = NO_TIMEOUT;
+        uint64_t flushSeq = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return;
+            }
+            flushSeq = flushRequested_;
+            timeout = flushSeq != flushDone_ ? 0 : GetEpollTimeoutLocked();
+        }
+        int32_t count = epoll_wait(epollFd_, events, MAX_EVENTS, timeout);
+        if (count < 0 && errno != EINTR) {
+            HiLog::Error(LABEL, "epoll_wait failed, error: %{public}s", strerror(errno));
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return;
+            }
+            for (int32_t i = 0; i < count; i++) {
+                if (events[i].data.u64 == WAKEUP_ID) {
+                    uint64_t value = 0;
+                    (void)read(wakeupFd_, &value, sizeof(value));
+                    continue;
+                }
+                auto it = watches_.find(events[i].data.u64);
+                if (it == watches_.end()) {
+                    continue;
+                }
+                FenceStatus status = (events[i].events & EPOLLERR) != 0 ? ERROR : SIGNALED;
+                fired.emplace_back(std::move(it->second.callback), status);
+                RemoveLocked(it->second);
+                watches_.erase(it);
+            }
+            for (uint64_t id : readyIds_) {
+                auto it = watches_.find(id);
+                if (it != watches_.end()) {
+                    fired.emplace_back(std::move(it->second.callback), SIGNALED);
+                    watches_.erase(it);
+                }
+            }
+            readyIds_.clear();
+            CollectExpiredLocked(fired);
+        }
+
+        // outside of the lock, callbacks may watch further fences
+        for (auto &[callback, status] : fired) {
+            callback(status);
+        }
+        // a flush is done once a pass finds nothing more to call back
+        bool idle = fired.empty() && count < MAX_EVENTS;
+        fired.clear();
+        if (idle) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (flushDone_ != flushSeq) {
+                flushDone_ = flushSeq;
+                flushCond_.notify_all();
+            }
+        }
+    }
+}
+
+int32_t FenceWatcher::GetEpollTimeoutLocked() const
+{
+    if (!readyIds_.empty()) {
+        return 0;
+    }
+    bool hasDeadline = false;
+    Clock::time_point deadline;
+    for (auto &[id, entry] : watches_) {
+        if (entry.hasDeadline && (!hasDeadline || entry.deadline < deadline)) {
+            hasDeadline = true;
+            deadline = entry.deadline;
+        }
+    }
+    if (!hasDeadline) {
+        return NO_TIMEOUT;
+    }
+    auto now = Clock::now();
+    if (deadline <= now) {
+        return 0;
+    }
+    // round up, epoll would otherwise wake up just before the deadline and spin
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - now + std::chrono::milliseconds(1) - std::chrono::nanoseconds(1));
+    return static_cast<int32_t>(std::min<int64_t>(remaining.count(), std::numeric_limits<int32_t>::max()));
+}
+
+void FenceWatcher::CollectExpiredLocked(std::vector<std::pair<Callback, FenceStatus>>& fired)
+{
+    auto now = Clock::now();
+    auto it = watches_.begin();
+    while (it != watches_.end()) {
+        if (it->second.hasDeadline && it->second.deadline <= now) {
+            fired.emplace_back(std::move(it->second.callback), ACTIVE);
+            RemoveLocked(it->second);
+            it = watches_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void FenceWatcher::RemoveLocked(WatchEntry& entry)
+{
+    if (entry.fd < 0) {
+        return;
+    }
+    if (epoll_ctl(epollFd_, EPOLL_CTL_DEL, entry.fd, nullptr) < 0) {
+        HiLog::Error(LABEL, "remove fence failed, error: %{public}s", strerror(errno));
+    }
+    close(entry.fd);
+    entry.fd = -1;
+}
+
+void FenceWatcher::Wakeup()
+{
+    uint64_t value = 1;
+    if (write(wakeupFd_, &value, sizeof(value)) != sizeof(value)) {
+        HiLog::Error(LABEL, "Wakeup failed, error: %{public}s", strerror(errno));
+    }
+}
+} // namespace OHOS
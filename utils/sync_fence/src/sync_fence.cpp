@@ -15,17 +15,24 @@
 
 #include "sync_fence.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <memory>
 #include <unistd.h>
 #include <errno.h>
+#include <poll.h>
 #include <securec.h>
 #include <fcntl.h>
+#include <sys/eventfd.h>
 
 #include <linux/sync_file.h>
 #include <libsync.h>
 
+#include "fence_watcher.h"
 #include "sw_sync.h"
 #include "hilog/log.h"
 
@@ -35,6 +42,30 @@ using namespace OHOS::HiviewDFX;
 namespace {
 constexpr HiLogLabel LABEL = { LOG_CORE, 0xD001400, "SyncFence" };
 constexpr int32_t INVALID_FD = -1;
+constexpr ns_sec_t NS_PER_SEC = 1000000000;
+
+ns_sec_t GetMonotonicNs()
+{
+    struct timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<ns_sec_t>(now.tv_sec) * NS_PER_SEC + now.tv_nsec;
+}
+
+// a userspace fence keeps its signal timestamp as eventfd counter, the same clock the kernel stamps sync files with
+void SignalUserspaceFence(int32_t fd, ns_sec_t timestamp)
+{
+    uint64_t value = static_cast<uint64_t>(timestamp > 0 ? timestamp : 1);
+    if (write(fd, &value, sizeof(value)) != sizeof(value)) {
+        HiLog::Error(LABEL, "SignalUserspaceFence write failed, error: %{public}s", strerror(errno));
+    }
+}
+
+bool IsSyncFile(int32_t fd)
+{
+    struct sync_file_info info;
+    (void)memset_s(&info, sizeof(info), 0, sizeof(info));
+    return ioctl(fd, SYNC_IOC_FILE_INFO, &info) == 0;
+}
 }  // namespace
 
 const sptr<SyncFence> SyncFence::INVALID_FENCE = sptr<SyncFence>(new SyncFence(INVALID_FD));
@@ -44,7 +75,8 @@ const ns_sec_t SyncFence::FENCE_PENDING_TIMESTAMP = INT64_MAX;
 SyncTimeline::SyncTimeline() noexcept
 {
     if (!IsSupportSoftwareSync()) {
-        HiLog::Error(LABEL, "don't support SyncTimeline");
+        HiLog::Info(LABEL, "sw_sync is not supported, SyncTimeline is kept in userspace");
+        isUserspace_ = true;
         return;
     }
     int32_t fd = CreateSyncTimeline();
@@ -55,6 +87,13 @@ SyncTimeline::SyncTimeline() noexcept
 
 SyncTimeline::~SyncTimeline() noexcept
 {
+    // like sw_sync does on release, do not leave the fences of a destroyed timeline pending forever
+    ns_sec_t now = GetMonotonicNs();
+    for (auto &[point, fd] : pendingFences_) {
+        SignalUserspaceFence(fd, now);
+        close(fd);
+    }
+    pendingFences_.clear();
     if (timeLineFd_ > 0) {
         close(timeLineFd_);
         timeLineFd_ = -1;
@@ -64,6 +103,9 @@ SyncTimeline::~SyncTimeline() noexcept
 
 int32_t SyncTimeline::IncreaseSyncPoint(uint32_t step)
 {
+    if (isUserspace_) {
+        return IncreaseUserspaceSyncPoint(step);
+    }
     if (timeLineFd_ < 0) {
         return -1;
     }
@@ -72,6 +114,9 @@ int32_t SyncTimeline::IncreaseSyncPoint(uint32_t step)
 
 bool SyncTimeline::IsValid()
 {
+    if (isUserspace_) {
+        return true;
+    }
     if (timeLineFd_ > 0) {
         if (fcntl(timeLineFd_, F_GETFD, 0) < 0) {
             return false;
@@ -85,6 +130,9 @@ bool SyncTimeline::IsValid()
 
 int32_t SyncTimeline::GenerateFence(std::string name, uint32_t point)
 {
+    if (isUserspace_) {
+        return GenerateUserspaceFence(point);
+    }
     if (timeLineFd_ < 0) {
         return -1;
     }
@@ -96,6 +144,56 @@ int32_t SyncTimeline::GenerateFence(std::string name, uint32_t point)
     return fd;
 }
 
+int32_t SyncTimeline::GenerateUserspaceFence(uint32_t point)
+{
+    int32_t fd = eventfd(0, EFD_CLOEXEC);
+    if (fd < 0) {
+        HiLog::Error(LABEL, "GenerateUserspaceFence eventfd failed, error: %{public}s", strerror(errno));
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(userspaceMutex_);
+    // same wrapping comparison as sw_sync
+    if (static_cast<int32_t>(point - userspacePoint_) <= 0) {
+        SignalUserspaceFence(fd, GetMonotonicNs());
+        return fd;
+    }
+    int32_t signalFd = dup(fd);
+    if (signalFd < 0) {
+        HiLog::Error(LABEL, "GenerateUserspaceFence dup failed, error: %{public}s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    pendingFences_.emplace_back(point, signalFd);
+    return fd;
+}
+
+int32_t SyncTimeline::IncreaseUserspaceSyncPoint(uint32_t step)
+{
+    bool signaled = false;
+    {
+        std::lock_guard<std::mutex> lock(userspaceMutex_);
+        userspacePoint_ += step;
+        ns_sec_t now = GetMonotonicNs();
+        auto it = pendingFences_.begin();
+        while (it != pendingFences_.end()) {
+            if (static_cast<int32_t>(it->first - userspacePoint_) <= 0) {
+                SignalUserspaceFence(it->second, now);
+                close(it->second);
+                it = pendingFences_.erase(it);
+                signaled = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (signaled) {
+        // fences merged from userspace fences are signaled by the FenceWatcher, they are signaled on return as well
+        // just like merged sync files
+        FenceWatcher::GetInstance().Flush();
+    }
+    return 0;
+}
+
 SyncFence::SyncFence(int32_t fenceFd) : fenceFd_(fenceFd)
 {
 }
@@ -122,11 +220,14 @@ sptr<SyncFence> SyncFence::MergeFence(const std::string &name,
     int32_t fenceFd2 = fence2->fenceFd_;
 
     if (fenceFd1 >= 0 && fenceFd2 >= 0) {
+        if (!IsSyncFile(fenceFd1) || !IsSyncFile(fenceFd2)) {
+            return MergeUserspaceFence(name, fence1, fence2);
+        }
         newFenceFd = sync_merge(name.c_str(), fenceFd1, fenceFd2);
     } else if (fenceFd1 >= 0) {
-        newFenceFd = sync_merge(name.c_str(), fenceFd1, fenceFd1);
+        newFenceFd = IsSyncFile(fenceFd1) ? sync_merge(name.c_str(), fenceFd1, fenceFd1) : fence1->Dup();
     } else if (fenceFd2 >= 0) {
-        newFenceFd = sync_merge(name.c_str(), fenceFd2, fenceFd2);
+        newFenceFd = IsSyncFile(fenceFd2) ? sync_merge(name.c_str(), fenceFd2, fenceFd2) : fence2->Dup();
     } else {
         return INVALID_FENCE;
     }
@@ -140,11 +241,48 @@ sptr<SyncFence> SyncFence::MergeFence(const std::string &name,
     return sptr<SyncFence>(new SyncFence(newFenceFd));
 }
 
+sptr<SyncFence> SyncFence::MergeUserspaceFence(const std::string &name,
+                const sptr<SyncFence>& fence1, const sptr<SyncFence>& fence2)
+{
+    // a sync file can not merge an eventfd, the merged fence is an eventfd signaled by the FenceWatcher instead
+    struct MergeState {
+        std::mutex mutex;
+        int32_t pendingCount = 2;
+        ns_sec_t timestamp = 0;
+        UniqueFd signalFd;
+    };
+    int32_t newFenceFd = eventfd(0, EFD_CLOEXEC);
+    if (newFenceFd < 0) {
+        HiLog::Error(LABEL, "MergeUserspaceFence(%{public}s) eventfd failed, error: %{public}s",
+                     name.c_str(), strerror(errno));
+        return INVALID_FENCE;
+    }
+    auto state = std::make_shared<MergeState>();
+    state->signalFd = UniqueFd(::dup(newFenceFd));
+    if (state->signalFd < 0) {
+        HiLog::Error(LABEL, "MergeUserspaceFence(%{public}s) dup failed, error: %{public}s",
+                     name.c_str(), strerror(errno));
+        close(newFenceFd);
+        return INVALID_FENCE;
+    }
+    for (const sptr<SyncFence>& fence : { fence1, fence2 }) {
+        FenceWatcher::GetInstance().Watch(fence, [state, fence](FenceStatus status) {
+            ns_sec_t timestamp = status == SIGNALED ? fence->SyncFileReadTimestamp() : GetMonotonicNs();
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->timestamp = std::max(state->timestamp, timestamp);
+            if (--state->pendingCount == 0) {
+                SignalUserspaceFence(state->signalFd, state->timestamp);
+            }
+        });
+    }
+    return sptr<SyncFence>(new SyncFence(newFenceFd));
+}
+
 ns_sec_t SyncFence::SyncFileReadTimestamp()
 {
     std::vector<SyncPointInfo> ptInfos = GetFenceInfo();
     if (ptInfos.empty()) {
-        return FENCE_PENDING_TIMESTAMP;
+        return PollStatus() == SIGNALED ? ReadUserspaceTimestamp() : FENCE_PENDING_TIMESTAMP;
     }
     size_t signalFenceCount = 0;
     for (auto &info : ptInfos) {
@@ -175,7 +313,10 @@ std::vector<SyncPointInfo> SyncFence::GetFenceInfo()
     (void)memset_s(&arg, sizeof(struct sync_file_info), 0, sizeof(struct sync_file_info));
     int32_t ret = ioctl(fenceFd_, SYNC_IOC_FILE_INFO, &arg);
     if (ret < 0) {
-        HiLog::Error(LABEL, "GetFenceInfo SYNC_IOC_FILE_INFO ioctl failed, ret: %{public}d", ret);
+        // a userspace fence is no sync file, its callers poll it instead
+        if (errno != ENOTTY) {
+            HiLog::Error(LABEL, "GetFenceInfo SYNC_IOC_FILE_INFO ioctl failed, ret: %{public}d", ret);
+        }
         return {};
     }
 
@@ -223,7 +364,7 @@ FenceStatus SyncFence::GetStatus()
     }
     std::vector<SyncPointInfo> ptInfos = GetFenceInfo();
     if (ptInfos.empty()) {
-        return ERROR;
+        return PollStatus();
     }
     size_t signalFenceCount = 0;
     for (auto &info : ptInfos) {
@@ -238,6 +379,38 @@ FenceStatus SyncFence::GetStatus()
     }
 }
 
+FenceStatus SyncFence::PollStatus() const
+{
+    if (fenceFd_ < 0) {
+        return ERROR;
+    }
+    struct pollfd pfd = { .fd = fenceFd_, .events = POLLIN };
+    int32_t ret = poll(&pfd, 1, 0);
+    if (ret < 0 || (pfd.revents & (POLLERR | POLLNVAL)) != 0) {
+        return ERROR;
+    }
+    return ret > 0 ? SIGNALED : ACTIVE;
+}
+
+ns_sec_t SyncFence::ReadUserspaceTimestamp() const
+{
+    // the eventfd counter can not be read without resetting it, which would unsignal the fence, so it is taken
+    // from the fdinfo of the fd
+    std::ifstream fdInfo("/proc/self/fdinfo/" + std::to_string(static_cast<int32_t>(fenceFd_)));
+    std::string key;
+    while (fdInfo >> key) {
+        if (key == "eventfd-count:") {
+            uint64_t count = 0;
+            if (fdInfo >> std::hex >> count && count > 0) {
+                return static_cast<ns_sec_t>(count);
+            }
+            break;
+        }
+    }
+    // signaled by someone else than SyncTimeline, the time it is seen signaled is the best guess
+    return GetMonotonicNs();
+}
+
 int32_t SyncFence::Get() const
 {
     return fenceFd_;
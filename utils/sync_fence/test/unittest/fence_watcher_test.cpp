@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fence_watcher.h"
+#include "refbase.h"
+#include "sync_fence.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+constexpr int32_t LATENCY_ROUNDS = 1000;
+constexpr int32_t WAIT_TIMEOUT_MS = 3000;
+constexpr double NS_PER_US = 1000.0;
+constexpr int32_t PERCENTILE_99 = 99;
+constexpr int32_t PERCENT = 100;
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class CallbackResult {
+public:
+    void Set(FenceStatus status)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        status_ = status;
+        count_++;
+        cond_.notify_all();
+    }
+
+    bool WaitFor(int32_t count, int32_t timeoutMs = WAIT_TIMEOUT_MS)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, count] { return count_ >= count; });
+    }
+
+    FenceStatus GetStatus()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return status_;
+    }
+
+    int32_t GetCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    FenceStatus status_ = ERROR;
+    int32_t count_ = 0;
+};
+
+void PrintLatency(const std::string& name, std::vector<int64_t>& latencies)
+{
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << name << ": median " << latencies[latencies.size() / 2] / NS_PER_US << " us, p99 " <<
+        latencies[latencies.size() * PERCENTILE_99 / PERCENT] / NS_PER_US << " us, max " <<
+        latencies.back() / NS_PER_US << " us" << std::endl;
+}
+
+// signal to return latency of a thread blocked in SyncFence::Wait
+std::vector<int64_t> MeasureWaitLatency(const sptr<SyncTimeline>& timeline)
+{
+    std::vector<int64_t> latencies;
+    for (int32_t i = 1; i <= LATENCY_ROUNDS; i++) {
+        sptr<SyncFence> fence = new SyncFence(timeline->GenerateFence("wait latency", i));
+        std::atomic<bool> waiting = false;
+        int64_t returned = 0;
+        std::thread waiter([&fence, &waiting, &returned] {
+            waiting = true;
+            fence->Wait(WAIT_TIMEOUT_MS);
+            returned = NowNs();
+        });
+        while (!waiting) {
+            std::this_thread::yield();
+        }
+        // let the waiter get into poll
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        int64_t signaled = NowNs();
+        timeline->IncreaseSyncPoint(1);
+        waiter.join();
+        latencies.push_back(returned - signaled);
+    }
+    return latencies;
+}
+
+// signal to callback latency of the FenceWatcher
+std::vector<int64_t> MeasureWatchLatency(const sptr<SyncTimeline>& timeline)
+{
+    std::vector<int64_t> latencies;
+    for (int32_t i = 1; i <= LATENCY_ROUNDS; i++) {
+        sptr<SyncFence> fence = new SyncFence(timeline->GenerateFence("watch latency", i));
+        CallbackResult result;
+        std::atomic<int64_t> called = 0;
+        FenceWatcher::GetInstance().Watch(fence, [&result, &called](FenceStatus status) {
+            called = NowNs();
+            result.Set(status);
+        });
+        int64_t signaled = NowNs();
+        timeline->IncreaseSyncPoint(1);
+        EXPECT_TRUE(result.WaitFor(1));
+        latencies.push_back(called - signaled);
+    }
+    return latencies;
+}
+}
+
+class FenceWatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+};
+
+void FenceWatcherTest::SetUpTestCase()
+{
+}
+
+void FenceWatcherTest::TearDownTestCase()
+{
+}
+
+/*
+* Function: Watch
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. watch a fence of a timeline
+*                  2. check the callback runs once the timeline reaches the fence, not before
+*/
+HWTEST_F(FenceWatcherTest, Watch001, Function | MediumTest | Level2)
+{
+    sptr<SyncTimeline> timeline = new SyncTimeline();
+    ASSERT_TRUE(timeline->IsValid());
+    sptr<SyncFence> fence = new SyncFence(timeline->GenerateFence("watch", 2));
+    ASSERT_TRUE(fence->IsValid());
+    CallbackResult result;
+    uint64_t id = FenceWatcher::GetInstance().Watch(fence, [&result](FenceStatus status) { result.Set(status); });
+    ASSERT_NE(id, FenceWatcher::INVALID_WATCH_ID);
+
+    ASSERT_EQ(timeline->IncreaseSyncPoint(1), 0);
+    FenceWatcher::GetInstance().Flush();
+    ASSERT_EQ(result.GetCount(), 0);
+    ASSERT_EQ(timeline->IncreaseSyncPoint(1), 0);
+    ASSERT_TRUE(result.WaitFor(1));
+    ASSERT_EQ(result.GetStatus(), FenceStatus::SIGNALED);
+    ASSERT_FALSE(FenceWatcher::GetInstance().Cancel(id));
+}
+
+/*
+* Function: Watch, Cancel
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. watch an invalid fence, a fence with a timeout and a canceled fence
+*                  2. check SIGNALED, ACTIVE and no callback
+*/
+HWTEST_F(FenceWatcherTest, Watch002, Function | MediumTest | Level2)
+{
+    CallbackResult invalidResult;
+    FenceWatcher::GetInstance().Watch(SyncFence::INVALID_FENCE,
+        [&invalidResult](FenceStatus status) { invalidResult.Set(status); });
+    ASSERT_TRUE(invalidResult.WaitFor(1));
+    ASSERT_EQ(invalidResult.GetStatus(), FenceStatus::SIGNALED);
+
+    sptr<SyncTimeline> timeline = new SyncTimeline();
+    ASSERT_TRUE(timeline->IsValid());
+    sptr<SyncFence> fence = new SyncFence(timeline->GenerateFence("watch", 1));
+    CallbackResult timeoutResult;
+    FenceWatcher::GetInstance().Watch(fence, [&timeoutResult](FenceStatus status) { timeoutResult.Set(status); }, 10);
+    ASSERT_TRUE(timeoutResult.WaitFor(1));
+    ASSERT_EQ(timeoutResult.GetStatus(), FenceStatus::ACTIVE);
+
+    CallbackResult canceledResult;
+    uint64_t id = FenceWatcher::GetInstance().Watch(fence,
+        [&canceledResult](FenceStatus status) { canceledResult.Set(status); });
+    ASSERT_TRUE(FenceWatcher::GetInstance().Cancel(id));
+    ASSERT_EQ(timeline->IncreaseSyncPoint(1), 0);
+    FenceWatcher::GetInstance().Flush();
+    ASSERT_EQ(canceledResult.GetCount(), 0);
+    ASSERT_EQ(FenceWatcher::GetInstance().GetWatchCount(), 0u);
+}
+
+/*
+* Function: GenerateFence, SyncFileReadTimestamp, MergeFence
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. signal fences of a timeline, merge them
+*                  2. check signal timestamps are kept and a merged fence signals with the later fence
+*/
+HWTEST_F(FenceWatcherTest, Timestamp001, Function | MediumTest | Level2)
+{
+    sptr<SyncTimeline> timeline = new SyncTimeline();
+    ASSERT_TRUE(timeline->IsValid());
+    sptr<SyncFence> fence1 = new SyncFence(timeline->GenerateFence("fence1", 1));
+    sptr<SyncFence> fence2 = new SyncFence(timeline->GenerateFence("fence2", 2));
+    sptr<SyncFence> merged = SyncFence::MergeFence("merged", fence1, fence2);
+    ASSERT_EQ(fence1->SyncFileReadTimestamp(), SyncFence::FENCE_PENDING_TIMESTAMP);
+
+    ASSERT_EQ(timeline->IncreaseSyncPoint(1), 0);
+    ns_sec_t timestamp1 = fence1->SyncFileReadTimestamp();
+    ASSERT_NE(timestamp1, SyncFence::FENCE_PENDING_TIMESTAMP);
+    ASSERT_GT(timestamp1, 0);
+    ASSERT_EQ(merged->GetStatus(), FenceStatus::ACTIVE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    // read again, still the time it signaled
+    ASSERT_EQ(fence1->SyncFileReadTimestamp(), timestamp1);
+
+    ASSERT_EQ(timeline->IncreaseSyncPoint(1), 0);
+    ASSERT_EQ(merged->GetStatus(), FenceStatus::SIGNALED);
+    ns_sec_t timestamp2 = fence2->SyncFileReadTimestamp();
+    ASSERT_GT(timestamp2, timestamp1);
+    ASSERT_EQ(merged->SyncFileReadTimestamp(), timestamp2);
+    ASSERT_EQ(merged->Wait(0), 0);
+}
+
+/*
+* Function: Wait, Watch
+* Type: Performance
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. signal fences waited for by a blocked thread and by the FenceWatcher
+*                  2. print the signal to wakeup latencies
+*/
+HWTEST_F(FenceWatcherTest, Latency001, Function | MediumTest | Level2)
+{
+    sptr<SyncTimeline> waitTimeline = new SyncTimeline();
+    ASSERT_TRUE(waitTimeline->IsValid());
+    std::string kind = waitTimeline->IsUserspace() ? "userspace fence" : "sw_sync fence";
+    auto waitLatencies = MeasureWaitLatency(waitTimeline);
+    PrintLatency(kind + ", SyncFence::Wait", waitLatencies);
+
+    sptr<SyncTimeline> watchTimeline = new SyncTimeline();
+    auto watchLatencies = MeasureWatchLatency(watchTimeline);
+    PrintLatency(kind + ", FenceWatcher", watchLatencies);
+}
+} // namespace OHOS